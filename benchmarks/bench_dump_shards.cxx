@@ -0,0 +1,153 @@
+// Sharded route dumps: one dump per table in turn vs all tables at once.
+//
+// Installs /32 routes on `lo` (198.18.0.0/15, the benchmarking range) spread
+// over several private tables, then dumps every table one after the other
+// and as one sharded dump, with the bulk lane of Control running on its own
+// io_context and threads. Needs CAP_NET_ADMIN.
+//
+// Usage: bench_dump_shards [routes per table] [tables] [bulk threads]
+//        bench_dump_shards 100000 4 4   (at most 131072 routes per table)
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <linux/rtnetlink.h>
+#include <net/if.h>
+
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/io_context.hpp>
+
+#include "rtaco/core/nl_control.hxx"
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+using llmx::rtaco::Control;
+using llmx::rtaco::ControlOptions;
+using llmx::rtaco::RouteDumpFilter;
+using llmx::rtaco::RouteOp;
+using llmx::rtaco::RouteSpec;
+using llmx::rtaco::ShardOrder;
+
+constexpr uint32_t BENCH_PREFIX = 0xC6120000U; // 198.18.0.0
+constexpr uint32_t BENCH_TABLE = 4242U;
+constexpr int ROUNDS = 5;
+
+auto make_routes(size_t count, uint32_t table, uint32_t oif) -> std::vector<RouteSpec> {
+    std::vector<RouteSpec> routes(count);
+    for (size_t i = 0; i < count; ++i) {
+        auto& route = routes[i];
+        route.dst_prefix_len = 32U;
+        route.scope = RT_SCOPE_LINK;
+        route.table = table;
+        route.oif_index = oif;
+        route.dst.family = AF_INET;
+
+        const auto dst = htonl(BENCH_PREFIX + static_cast<uint32_t>(i));
+        std::memcpy(route.dst.bytes.data(), &dst, sizeof(dst));
+    }
+    return routes;
+}
+
+auto elapsed_ms(clock_type::time_point start) -> double {
+    return std::chrono::duration<double, std::milli>(clock_type::now() - start).count();
+}
+
+} // namespace
+
+auto main(int argc, char** argv) -> int {
+    const size_t count = std::min<size_t>(
+            argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000U, 0x20000U);
+    const size_t tables = std::max<size_t>(
+            argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 4U, 1U);
+    const size_t threads = std::max<size_t>(argc > 3
+                    ? std::strtoul(argv[3], nullptr, 10)
+                    : std::thread::hardware_concurrency(),
+            1U);
+
+    const auto oif = ::if_nametoindex("lo");
+
+    boost::asio::io_context io{};
+    boost::asio::io_context bulk_io{};
+    auto work = boost::asio::make_work_guard(io);
+    auto bulk_work = boost::asio::make_work_guard(bulk_io);
+    std::thread runner{[&io]() { io.run(); }};
+    std::vector<std::thread> bulk_runners{};
+    for (size_t i = 0; i < threads; ++i) {
+        bulk_runners.emplace_back([&bulk_io]() { bulk_io.run(); });
+    }
+
+    {
+        ControlOptions options{};
+        options.bulk.sockets = tables;
+        options.bulk.context = &bulk_io;
+        Control control{io, options};
+
+        std::vector<std::vector<RouteSpec>> routes{};
+        std::vector<RouteDumpFilter> shards{};
+        for (size_t t = 0; t < tables; ++t) {
+            const auto table = BENCH_TABLE + static_cast<uint32_t>(t);
+            routes.push_back(make_routes(count, table, oif));
+            shards.push_back(RouteDumpFilter{.table = table});
+            if (auto added = control.apply_routes(RouteOp::ADD, routes.back()); !added) {
+                std::fprintf(stderr, "apply_routes: %s\n",
+                        added.error().message().c_str());
+            }
+        }
+
+        std::printf("%zu tables x %zu routes, %zu bulk threads (best of %d)\n\n", tables,
+                count, threads, ROUNDS);
+        std::printf("%-26s %10s %12s\n", "mode", "ms", "routes");
+
+        double sequential = 1e300;
+        size_t sequential_routes = 0U;
+        for (int round = 0; round < ROUNDS; ++round) {
+            const auto start = clock_type::now();
+            sequential_routes = 0U;
+            for (const auto& shard : shards) {
+                if (auto dumped = control.dump_routes_compact(shard); dumped) {
+                    sequential_routes += dumped->size();
+                }
+            }
+            sequential = std::min(sequential, elapsed_ms(start));
+        }
+        std::printf("%-26s %10.1f %12zu\n", "table by table", sequential,
+                sequential_routes);
+
+        for (const auto order : {ShardOrder::GIVEN, ShardOrder::COMPLETION}) {
+            double sharded = 1e300;
+            size_t sharded_routes = 0U;
+            for (int round = 0; round < ROUNDS; ++round) {
+                const auto start = clock_type::now();
+                const auto dumped = control.dump_routes_compact(shards, order);
+                sharded = std::min(sharded, elapsed_ms(start));
+                sharded_routes = dumped ? dumped->size() : 0U;
+            }
+            std::printf("%-26s %10.1f %12zu\n",
+                    order == ShardOrder::GIVEN ? "sharded, given order"
+                                               : "sharded, completion order",
+                    sharded, sharded_routes);
+        }
+
+        for (const auto& table : routes) {
+            control.apply_routes(RouteOp::DELETE, table);
+        }
+        control.stop();
+    }
+
+    work.reset();
+    bulk_work.reset();
+    runner.join();
+    for (auto& bulk_runner : bulk_runners) {
+        bulk_runner.join();
+    }
+    return EXIT_SUCCESS;
+}
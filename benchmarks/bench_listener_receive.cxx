@@ -0,0 +1,199 @@
+// Listener receive throughput: one receive per datagram vs recvmmsg batches.
+//
+// Installs and removes a burst of /32 routes on `lo` (198.18.0.0/15, the
+// benchmarking range) through a raw netlink socket and counts the route
+// notifications each Listener configuration sees. Needs CAP_NET_ADMIN.
+//
+// Usage: bench_listener_receive [routes] [batch sizes...]
+//        bench_listener_receive 20000 1 16 64
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <net/if.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/io_context.hpp>
+
+#include "rtaco/core/nl_listener.hxx"
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+constexpr uint32_t BENCH_PREFIX = 0xC6120000U; // 198.18.0.0
+constexpr uint32_t BENCH_MASK = 0xFFFE0000U;   // /15
+constexpr size_t MESSAGES_PER_SEND = 64U;
+
+void append_attr(std::vector<uint8_t>& message, uint16_t type, const void* data,
+        size_t size) {
+    const auto offset = message.size();
+    message.resize(offset + RTA_SPACE(size));
+
+    auto* attr = reinterpret_cast<rtattr*>(message.data() + offset);
+    attr->rta_type = type;
+    attr->rta_len = static_cast<uint16_t>(RTA_LENGTH(size));
+    std::memcpy(RTA_DATA(attr), data, size);
+}
+
+void append_route(std::vector<uint8_t>& out, uint16_t type, uint32_t dst,
+        uint32_t oif, uint32_t sequence) {
+    std::vector<uint8_t> message(NLMSG_SPACE(sizeof(rtmsg)));
+
+    auto* route = reinterpret_cast<rtmsg*>(NLMSG_DATA(message.data()));
+    route->rtm_family = AF_INET;
+    route->rtm_dst_len = 32U;
+    route->rtm_table = RT_TABLE_MAIN;
+    route->rtm_protocol = RTPROT_STATIC;
+    route->rtm_scope = RT_SCOPE_LINK;
+    route->rtm_type = RTN_UNICAST;
+
+    const auto dst_be = htonl(dst);
+    append_attr(message, RTA_DST, &dst_be, sizeof(dst_be));
+    append_attr(message, RTA_OIF, &oif, sizeof(oif));
+
+    auto* header = reinterpret_cast<nlmsghdr*>(message.data());
+    header->nlmsg_len = static_cast<uint32_t>(message.size());
+    header->nlmsg_type = type;
+    header->nlmsg_flags = NLM_F_REQUEST;
+    if (type == RTM_NEWROUTE) {
+        header->nlmsg_flags |= NLM_F_CREATE | NLM_F_REPLACE;
+    }
+    header->nlmsg_seq = sequence;
+
+    out.insert(out.end(), message.begin(), message.end());
+}
+
+// Sends `count` add (or delete) requests without acks, packed into large
+// datagrams so the kernel emits notifications as fast as it can.
+auto blast_routes(int fd, uint16_t type, size_t count, uint32_t oif) -> bool {
+    std::vector<uint8_t> batch;
+    for (size_t i = 0; i < count; ++i) {
+        append_route(batch, type, BENCH_PREFIX + 1U + static_cast<uint32_t>(i), oif,
+                static_cast<uint32_t>(i + 1U));
+
+        if ((i + 1U) % MESSAGES_PER_SEND == 0U || i + 1U == count) {
+            if (::send(fd, batch.data(), batch.size(), 0) < 0) {
+                std::perror("send");
+                return false;
+            }
+            batch.clear();
+        }
+    }
+
+    return true;
+}
+
+struct Result {
+    size_t received{0U};
+    std::chrono::duration<double> elapsed{};
+};
+
+auto run(size_t routes, size_t batch_size, int fd, uint32_t oif) -> Result {
+    boost::asio::io_context io;
+    auto work = boost::asio::make_work_guard(io);
+
+    llmx::rtaco::ListenerOptions options{};
+    options.batch_size = batch_size;
+    llmx::rtaco::Listener listener{io, options};
+
+    std::atomic_size_t received{0U};
+    std::atomic<clock_type::rep> last_event{0};
+
+    listener.connect_to_view([&](const llmx::rtaco::RouteEventView& view)
+    {
+        const auto dst = view.attribute(RTA_DST);
+        if (view.family() != AF_INET || dst.size() != sizeof(uint32_t)) {
+            return;
+        }
+
+        uint32_t address = 0U;
+        std::memcpy(&address, dst.data(), sizeof(address));
+        if ((ntohl(address) & BENCH_MASK) != BENCH_PREFIX) {
+            return;
+        }
+
+        received.fetch_add(1U, std::memory_order_relaxed);
+        last_event.store(clock_type::now().time_since_epoch().count(),
+                std::memory_order_relaxed);
+    });
+
+    listener.start();
+    std::thread io_thread([&io]() { io.run(); });
+
+    const auto start = clock_type::now();
+    blast_routes(fd, RTM_NEWROUTE, routes, oif);
+    blast_routes(fd, RTM_DELROUTE, routes, oif);
+
+    // Wait until every notification arrived or the stream has gone quiet.
+    const auto expected = routes * 2U;
+    auto quiet_since = clock_type::now();
+    auto seen = received.load();
+    while (seen < expected && clock_type::now() - quiet_since < std::chrono::seconds{1}) {
+        std::this_thread::sleep_for(std::chrono::milliseconds{10});
+        if (const auto now = received.load(); now != seen) {
+            seen = now;
+            quiet_since = clock_type::now();
+        }
+    }
+
+    listener.stop();
+    work.reset();
+    io_thread.join();
+
+    const auto end = clock_type::time_point{clock_type::duration{last_event.load()}};
+    return Result{received.load(), end > start ? end - start : clock_type::duration{}};
+}
+
+} // namespace
+
+auto main(int argc, char** argv) -> int {
+    const size_t routes = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 20000U;
+
+    std::vector<size_t> batch_sizes{};
+    for (int i = 2; i < argc; ++i) {
+        batch_sizes.push_back(std::strtoul(argv[i], nullptr, 10));
+    }
+    if (batch_sizes.empty()) {
+        batch_sizes = {1U, 16U, 64U};
+    }
+
+    const auto oif = if_nametoindex("lo");
+    const int fd = ::socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_ROUTE);
+    if (fd < 0 || oif == 0U) {
+        std::perror("setup");
+        return EXIT_FAILURE;
+    }
+
+    std::printf("%-8s %10s %10s %8s %14s\n", "batch", "expected", "received", "lost",
+            "events/s");
+
+    for (const auto batch_size : batch_sizes) {
+        const auto result = run(routes, batch_size, fd, oif);
+        const auto expected = routes * 2U;
+        const auto rate = result.elapsed.count() > 0.0
+                ? static_cast<double>(result.received) / result.elapsed.count()
+                : 0.0;
+
+        std::printf("%-8zu %10zu %10zu %7.2f%% %14.0f\n", batch_size, expected,
+                result.received,
+                100.0 * static_cast<double>(expected - result.received) /
+                        static_cast<double>(expected),
+                rate);
+    }
+
+    ::close(fd);
+    return EXIT_SUCCESS;
+}
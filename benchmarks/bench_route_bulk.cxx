@@ -0,0 +1,175 @@
+// Route programming throughput: one round trip per route vs bulk writes.
+//
+// Installs and removes /32 routes on `lo` (198.18.0.0/15, the benchmarking
+// range) in a private table through Control, first one `add_route` at a
+// time, then through `apply_routes` at each batch size, then posted without
+// acks through `post` and a closing `barrier`. Needs CAP_NET_ADMIN.
+//
+// Usage: bench_route_bulk [routes] [batch sizes...]
+//        bench_route_bulk 100000 1 8 32 128   (at most 131072 routes)
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <linux/rtnetlink.h>
+#include <net/if.h>
+
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/io_context.hpp>
+
+#include "rtaco/core/nl_control.hxx"
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+using llmx::rtaco::Control;
+using llmx::rtaco::RouteBulkOptions;
+using llmx::rtaco::RouteOp;
+using llmx::rtaco::RouteSpec;
+using llmx::rtaco::TransactionBuilder;
+using llmx::rtaco::Transport;
+using llmx::rtaco::WriteError;
+
+constexpr uint32_t BENCH_PREFIX = 0xC6120000U; // 198.18.0.0
+constexpr uint32_t BENCH_TABLE = 4242U;
+
+auto make_routes(size_t count, uint32_t oif) -> std::vector<RouteSpec> {
+    std::vector<RouteSpec> routes(count);
+    for (size_t i = 0; i < count; ++i) {
+        auto& route = routes[i];
+        route.dst_prefix_len = 32U;
+        route.scope = RT_SCOPE_LINK;
+        route.table = BENCH_TABLE;
+        route.oif_index = oif;
+        route.dst.family = AF_INET;
+
+        const auto dst = htonl(BENCH_PREFIX + static_cast<uint32_t>(i));
+        std::memcpy(route.dst.bytes.data(), &dst, sizeof(dst));
+    }
+    return routes;
+}
+
+auto rate(size_t routes, clock_type::time_point start) -> double {
+    const auto seconds = std::chrono::duration<double>(clock_type::now() - start).count();
+    return static_cast<double>(routes) / seconds;
+}
+
+void run_bulk(Control& control, const std::vector<RouteSpec>& routes, size_t batch) {
+    const RouteBulkOptions options{batch,
+            std::max<size_t>(1U, Transport::MAX_UNACKED / batch)};
+
+    auto start = clock_type::now();
+    const auto added = control.apply_routes(RouteOp::ADD, routes, options);
+    const auto add_rate = rate(routes.size(), start);
+
+    start = clock_type::now();
+    const auto deleted = control.apply_routes(RouteOp::DELETE, routes, options);
+    const auto delete_rate = rate(routes.size(), start);
+
+    if (!added || !deleted) {
+        std::fprintf(stderr, "batch %zu: %s\n", batch,
+                (!added ? added.error() : deleted.error()).message().c_str());
+        return;
+    }
+
+    std::printf("%-8zu %8zu %14.0f %14.0f %10zu\n", batch, options.window, add_rate,
+            delete_rate, added->failures.size() + deleted->failures.size());
+}
+
+void run_posted(Control& control, const std::vector<RouteSpec>& routes) {
+    size_t failures = 0U;
+    const auto count_failure = [&failures](const WriteError&) { ++failures; };
+
+    // Encoding is timed too: it is part of what a caller pays per route.
+    auto start = clock_type::now();
+    TransactionBuilder transaction{};
+    for (const auto& route : routes) {
+        transaction.add_route(route);
+    }
+    auto added = control.post(transaction, count_failure);
+    if (added) {
+        added = control.barrier();
+    }
+    const auto add_rate = rate(routes.size(), start);
+
+    start = clock_type::now();
+    transaction.clear();
+    for (const auto& route : routes) {
+        transaction.delete_route(route);
+    }
+    auto deleted = control.post(transaction, count_failure);
+    if (deleted) {
+        deleted = control.barrier();
+    }
+    const auto delete_rate = rate(routes.size(), start);
+
+    if (!added || !deleted) {
+        std::fprintf(stderr, "posted: %s\n",
+                (!added ? added.error() : deleted.error()).message().c_str());
+        return;
+    }
+
+    std::printf("%-8s %8s %14.0f %14.0f %10zu\n", "posted", "-", add_rate, delete_rate,
+            failures);
+}
+
+} // namespace
+
+auto main(int argc, char** argv) -> int {
+    const size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000U;
+    std::vector<size_t> batches{};
+    for (int i = 2; i < argc; ++i) {
+        batches.push_back(std::strtoul(argv[i], nullptr, 10));
+    }
+    if (batches.empty()) {
+        batches = {1U, 8U, 32U, 128U};
+    }
+
+    const auto oif = ::if_nametoindex("lo");
+    const auto routes = make_routes(std::min<size_t>(count, 0x20000U), oif);
+
+    boost::asio::io_context io{};
+    auto work = boost::asio::make_work_guard(io);
+    std::thread runner{[&io]() { io.run(); }};
+
+    {
+        Control control{io};
+
+        // Sequential round trips are slow, so time a tenth of the table.
+        const auto single = routes.size() / 10U;
+        auto start = clock_type::now();
+        for (size_t i = 0; i < single; ++i) {
+            if (auto added = control.add_route(routes[i]); !added) {
+                std::fprintf(stderr, "add_route: %s\n", added.error().message().c_str());
+                break;
+            }
+        }
+        const auto single_rate = rate(single, start);
+        for (size_t i = 0; i < single; ++i) {
+            control.delete_route(routes[i]);
+        }
+
+        std::printf("%zu routes, one add_route per round trip: %.0f routes/s\n\n",
+                routes.size(), single_rate);
+        std::printf("%-8s %8s %14s %14s %10s\n", "batch", "window", "add/s", "delete/s",
+                "failures");
+        for (const auto batch : batches) {
+            run_bulk(control, routes, batch);
+        }
+        run_posted(control, routes);
+
+        control.stop();
+    }
+
+    work.reset();
+    runner.join();
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,155 @@
+// Longest-prefix-match cost of RouteIndex on a synthetic, Internet-sized
+// table: bulk build time, incremental update rate, and single and batch
+// lookup latency for IPv4 and IPv6 destinations.
+//
+// Prefix lengths follow a rough BGP mix (mostly /24, then /22-/16); no
+// socket or privileges are needed.
+//
+// Usage: bench_route_index [ipv4_routes] [ipv6_routes] [lookups]
+//        bench_route_index 900000 200000 20000000
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <unordered_set>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <linux/rtnetlink.h>
+
+#include "rtaco/core/nl_route_index.hxx"
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+using llmx::rtaco::CompactRouteEvent;
+using llmx::rtaco::IpAddress;
+using llmx::rtaco::RouteEvent;
+using llmx::rtaco::RouteIndex;
+using llmx::rtaco::RouteKey;
+
+auto elapsed_ns(clock_type::time_point start) -> double {
+    return std::chrono::duration<double, std::nano>(clock_type::now() - start).count();
+}
+
+auto pick_length(std::mt19937_64& rng, uint8_t family) -> uint8_t {
+    const auto roll = rng() % 100U;
+    if (family == AF_INET) {
+        return roll < 60U ? 24U : roll < 75U ? 22U : roll < 90U ? 20U : 16U;
+    }
+    return roll < 50U ? 48U : roll < 80U ? 44U : roll < 95U ? 40U : 32U;
+}
+
+auto make_routes(std::mt19937_64& rng, size_t count, uint8_t family)
+        -> std::vector<CompactRouteEvent> {
+    std::vector<CompactRouteEvent> routes{};
+    std::unordered_set<RouteKey> seen{};
+    routes.reserve(count);
+
+    while (routes.size() < count) {
+        CompactRouteEvent route{};
+        route.type = RouteEvent::Type::NEW_ROUTE;
+        route.family = family;
+        route.table = RT_TABLE_MAIN;
+        route.oif_index = static_cast<uint32_t>(1U + rng() % 64U);
+        route.dst_prefix_len = pick_length(rng, family);
+        route.dst.family = family;
+
+        for (size_t bit = 0; bit < route.dst_prefix_len; ++bit) {
+            if ((rng() & 1U) != 0U) {
+                route.dst.bytes[bit / 8U] |= static_cast<uint8_t>(0x80U >> (bit % 8U));
+            }
+        }
+        if (family == AF_INET6) {
+            route.dst.bytes[0] = 0x20U; // keep it in 2000::/3
+        }
+
+        if (seen.insert(RouteKey::from(route)).second) {
+            routes.push_back(route);
+        }
+    }
+    return routes;
+}
+
+// Destinations inside the indexed prefixes, so every lookup walks deep.
+auto make_addresses(std::mt19937_64& rng, const std::vector<CompactRouteEvent>& routes,
+        size_t count) -> std::vector<IpAddress> {
+    std::vector<IpAddress> addresses{};
+    addresses.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        auto address = routes[rng() % routes.size()].dst;
+        for (size_t byte = 3U; byte < address.size(); ++byte) {
+            address.bytes[byte] ^= static_cast<uint8_t>(rng());
+        }
+        addresses.push_back(address);
+    }
+    return addresses;
+}
+
+void run_lookups(const char* name, const RouteIndex& index,
+        const std::vector<IpAddress>& addresses, size_t lookups) {
+    uint64_t checksum = 0U;
+
+    auto start = clock_type::now();
+    for (size_t i = 0; i < lookups; ++i) {
+        const auto* route = index.lookup(addresses[i % addresses.size()]);
+        checksum += route != nullptr ? route->oif_index : 0U;
+    }
+    const auto single = elapsed_ns(start) / static_cast<double>(lookups);
+
+    std::vector<const CompactRouteEvent*> results(addresses.size());
+    size_t done = 0U;
+    start = clock_type::now();
+    while (done < lookups) {
+        index.lookup(addresses, results);
+        checksum += results.front() != nullptr ? results.front()->oif_index : 0U;
+        done += addresses.size();
+    }
+    const auto batch = elapsed_ns(start) / static_cast<double>(done);
+
+    std::printf("%-6s %12zu %12.2f %12.2f %20llu\n", name, lookups, single, batch,
+            static_cast<unsigned long long>(checksum));
+}
+
+} // namespace
+
+auto main(int argc, char** argv) -> int {
+    const size_t v4_routes = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 900000U;
+    const size_t v6_routes = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 200000U;
+    const size_t lookups = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 20000000U;
+
+    std::mt19937_64 rng{7U};
+    auto routes = make_routes(rng, v4_routes, AF_INET);
+    const auto v6 = make_routes(rng, v6_routes, AF_INET6);
+    const auto v4_addresses = make_addresses(rng, routes, 4096U);
+    const auto v6_addresses = make_addresses(rng, v6, 4096U);
+    routes.insert(routes.end(), v6.begin(), v6.end());
+
+    auto start = clock_type::now();
+    RouteIndex index{routes};
+    std::printf("bulk build: %zu routes in %.1f ms\n", index.size(),
+            elapsed_ns(start) / 1e6);
+
+    // Withdraw and re-announce a tenth of the table one route at a time.
+    const size_t churn = routes.size() / 10U;
+    start = clock_type::now();
+    for (size_t i = 0; i < churn; ++i) {
+        auto route = routes[i * 10U];
+        route.type = RouteEvent::Type::DELETE_ROUTE;
+        index.update(route);
+        route.type = RouteEvent::Type::NEW_ROUTE;
+        index.update(route);
+    }
+    std::printf("updates:    %.0f ns per update\n\n",
+            elapsed_ns(start) / static_cast<double>(churn * 2U));
+
+    std::printf("%-6s %12s %12s %12s %20s\n", "family", "lookups", "ns/lookup",
+            "ns/batched", "checksum");
+    run_lookups("ipv4", index, v4_addresses, lookups);
+    run_lookups("ipv6", index, v6_addresses, lookups);
+
+    return EXIT_SUCCESS;
+}
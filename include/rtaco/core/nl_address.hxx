@@ -0,0 +1,225 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+
+#include <arpa/inet.h>
+#include <net/if.h>
+
+namespace llmx {
+namespace rtaco {
+
+/** @brief Mix `value`'s hash into `seed` (boost::hash_combine recipe). */
+template<typename T>
+inline void hash_combine(size_t& seed, const T& value) noexcept {
+    seed ^= std::hash<T>{}(value) + 0x9e3779b97f4a7c15ULL + (seed << 6U) + (seed >> 2U);
+}
+
+/** @brief FNV-1a over a byte range. */
+inline auto hash_bytes(std::span<const uint8_t> bytes) noexcept -> size_t {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (const auto byte : bytes) {
+        hash = (hash ^ byte) * 0x100000001b3ULL;
+    }
+    return static_cast<size_t>(hash);
+}
+
+/** @brief Inline IPv4/IPv6 address with a family tag.
+ *
+ * IPv4 addresses occupy the first four bytes; unused bytes stay zero so
+ * equal addresses compare and hash equal. `family == AF_UNSPEC` means the
+ * attribute was absent.
+ */
+struct IpAddress {
+    std::array<uint8_t, 16> bytes{};
+    uint8_t family{AF_UNSPEC};
+
+    /** @brief Build from raw attribute bytes; returns an empty address on mismatch. */
+    static auto from_bytes(std::span<const uint8_t> data, uint8_t family) noexcept
+            -> IpAddress {
+        IpAddress address{};
+        const size_t expected = family == AF_INET ? 4U : family == AF_INET6 ? 16U : 0U;
+        if (expected == 0U || data.size() < expected) {
+            return address;
+        }
+
+        std::copy_n(data.begin(), expected, address.bytes.begin());
+        address.family = family;
+        return address;
+    }
+
+    /** @brief Parse the printable form; returns an empty address if it is not
+     * a valid address of `family`. */
+    static auto from_string(std::string_view text, uint8_t family) noexcept
+            -> IpAddress {
+        std::array<char, INET6_ADDRSTRLEN> buffer{};
+        IpAddress address{};
+        if ((family != AF_INET && family != AF_INET6) || text.size() >= buffer.size()) {
+            return address;
+        }
+
+        std::copy_n(text.begin(), text.size(), buffer.begin());
+        if (::inet_pton(family, buffer.data(), address.bytes.data()) == 1) {
+            address.family = family;
+        }
+        return address;
+    }
+
+    auto empty() const noexcept -> bool {
+        return family == AF_UNSPEC;
+    }
+
+    /** @brief Number of significant bytes (4, 16, or 0 when empty). */
+    auto size() const noexcept -> size_t {
+        return family == AF_INET ? 4U : family == AF_INET6 ? 16U : 0U;
+    }
+
+    /** @brief Printable form, or an empty string when empty. */
+    template<typename Allocator = std::allocator<char>>
+    auto to_string(const Allocator& allocator = Allocator{}) const
+            -> std::basic_string<char, std::char_traits<char>, Allocator> {
+        using string_t = std::basic_string<char, std::char_traits<char>, Allocator>;
+
+        std::array<char, INET6_ADDRSTRLEN> buffer{};
+        if (empty() || ::inet_ntop(family, bytes.data(), buffer.data(),
+                               buffer.size()) == nullptr) {
+            return string_t{allocator};
+        }
+        return string_t{buffer.data(), allocator};
+    }
+
+    friend auto operator<=>(const IpAddress&, const IpAddress&) = default;
+};
+
+/** @brief Inline link-layer address (Ethernet is 6 bytes, InfiniBand 20). */
+struct LinkLayerAddress {
+    static constexpr size_t MAX_SIZE = 20U;
+
+    std::array<uint8_t, MAX_SIZE> bytes{};
+    uint8_t length{0U};
+
+    /** @brief Build from raw attribute bytes, truncating to `MAX_SIZE`. */
+    static auto from_bytes(std::span<const uint8_t> data) noexcept -> LinkLayerAddress {
+        LinkLayerAddress address{};
+        address.length = static_cast<uint8_t>(std::min(data.size(), MAX_SIZE));
+        std::copy_n(data.begin(), address.length, address.bytes.begin());
+        return address;
+    }
+
+    /** @brief Parse the colon-separated hex form; empty on malformed input. */
+    static auto from_string(std::string_view text) noexcept -> LinkLayerAddress {
+        const auto nibble = [](char c) -> int {
+            if (c >= '0' && c <= '9') {
+                return c - '0';
+            }
+            if (c >= 'a' && c <= 'f') {
+                return c - 'a' + 10;
+            }
+            if (c >= 'A' && c <= 'F') {
+                return c - 'A' + 10;
+            }
+            return -1;
+        };
+
+        LinkLayerAddress address{};
+        for (size_t pos = 0U; pos < text.size(); pos += 3U) {
+            const auto high = nibble(text[pos]);
+            const auto low = pos + 1U < text.size() ? nibble(text[pos + 1U]) : -1;
+            const bool separated = pos + 2U == text.size() || text[pos + 2U] == ':';
+            if (high < 0 || low < 0 || !separated || address.length == MAX_SIZE) {
+                return LinkLayerAddress{};
+            }
+            address.bytes[address.length++] = static_cast<uint8_t>((high << 4) | low);
+        }
+        return address;
+    }
+
+    auto empty() const noexcept -> bool {
+        return length == 0U;
+    }
+
+    /** @brief Colon-separated lowercase hex form. */
+    template<typename Allocator = std::allocator<char>>
+    auto to_string(const Allocator& allocator = Allocator{}) const
+            -> std::basic_string<char, std::char_traits<char>, Allocator> {
+        constexpr char kHex[] = "0123456789abcdef";
+
+        std::basic_string<char, std::char_traits<char>, Allocator> value{allocator};
+        value.reserve(length * 3U);
+        for (size_t i = 0; i < length; ++i) {
+            if (i != 0U) {
+                value.push_back(':');
+            }
+            value.push_back(kHex[(bytes[i] >> 4U) & 0x0FU]);
+            value.push_back(kHex[bytes[i] & 0x0FU]);
+        }
+        return value;
+    }
+
+    friend auto operator<=>(const LinkLayerAddress&, const LinkLayerAddress&) = default;
+};
+
+/** @brief Inline NUL-padded interface name of at most `IFNAMSIZ - 1` chars. */
+struct InterfaceName {
+    std::array<char, IFNAMSIZ> chars{};
+
+    /** @brief Build from text, truncating to fit. */
+    static auto from_string(std::string_view text) noexcept -> InterfaceName {
+        InterfaceName name{};
+        const auto length = std::min(text.size(), name.chars.size() - 1U);
+        std::copy_n(text.begin(), length, name.chars.begin());
+        return name;
+    }
+
+    auto view() const noexcept -> std::string_view {
+        return std::string_view{chars.data()};
+    }
+
+    auto empty() const noexcept -> bool {
+        return chars[0] == '\0';
+    }
+
+    template<typename Allocator = std::allocator<char>>
+    auto to_string(const Allocator& allocator = Allocator{}) const
+            -> std::basic_string<char, std::char_traits<char>, Allocator> {
+        return std::basic_string<char, std::char_traits<char>, Allocator>{view(),
+                allocator};
+    }
+
+    friend auto operator<=>(const InterfaceName&, const InterfaceName&) = default;
+};
+
+} // namespace rtaco
+} // namespace llmx
+
+template<>
+struct std::hash<llmx::rtaco::IpAddress> {
+    auto operator()(const llmx::rtaco::IpAddress& address) const noexcept -> size_t {
+        auto seed = llmx::rtaco::hash_bytes(address.bytes);
+        llmx::rtaco::hash_combine(seed, address.family);
+        return seed;
+    }
+};
+
+template<>
+struct std::hash<llmx::rtaco::LinkLayerAddress> {
+    auto operator()(const llmx::rtaco::LinkLayerAddress& address) const noexcept
+            -> size_t {
+        return llmx::rtaco::hash_bytes({address.bytes.data(), address.length});
+    }
+};
+
+template<>
+struct std::hash<llmx::rtaco::InterfaceName> {
+    auto operator()(const llmx::rtaco::InterfaceName& name) const noexcept -> size_t {
+        return std::hash<std::string_view>{}(name.view());
+    }
+};
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+
+namespace llmx {
+namespace rtaco {
+
+/** @brief Lazily built table of attribute offsets within one netlink message.
+ *
+ * The first lookup walks the attributes following the `MsgT` payload once
+ * and records, for every type up to `MaxType`, the offset of its last
+ * occurrence relative to the message header. Later lookups are a single
+ * array access. The index stores offsets only, so it never owns or copies
+ * message bytes; the header passed to `find` must be the one the index was
+ * first used with.
+ *
+ * @tparam MsgT Fixed message payload preceding the attributes (e.g. rtmsg).
+ * @tparam MaxType Highest attribute type to index (e.g. RTA_MAX).
+ */
+template<typename MsgT, uint16_t MaxType>
+class AttributeIndex {
+public:
+    /** @brief Return the attribute of `type`, or nullptr if it is absent. */
+    auto find(const nlmsghdr& header, uint16_t type) const noexcept -> const rtattr* {
+        if (!built_) {
+            build(header);
+        }
+
+        if (type > MaxType || offsets_[type] == 0U) {
+            return nullptr;
+        }
+
+        return reinterpret_cast<const rtattr*>(
+                reinterpret_cast<const uint8_t*>(&header) + offsets_[type]);
+    }
+
+    /** @brief Return the payload bytes of attribute `type` (empty if absent). */
+    auto payload(const nlmsghdr& header, uint16_t type) const noexcept
+            -> std::span<const uint8_t> {
+        const auto* attr = find(header, type);
+        if (attr == nullptr) {
+            return {};
+        }
+
+        return {reinterpret_cast<const uint8_t*>(RTA_DATA(attr)),
+                static_cast<size_t>(RTA_PAYLOAD(attr))};
+    }
+
+private:
+    void build(const nlmsghdr& header) const noexcept {
+        built_ = true;
+
+        if (header.nlmsg_len < NLMSG_LENGTH(sizeof(MsgT))) {
+            return;
+        }
+
+        const auto* base = reinterpret_cast<const uint8_t*>(&header);
+        const auto first = NLMSG_LENGTH(NLMSG_ALIGN(sizeof(MsgT)));
+        int attr_length = static_cast<int>(header.nlmsg_len) - static_cast<int>(first);
+
+        const auto* attr = reinterpret_cast<const rtattr*>(base + first);
+        for (; RTA_OK(attr, attr_length); attr = RTA_NEXT(attr, attr_length)) {
+            if (attr->rta_type <= MaxType) {
+                offsets_[attr->rta_type] = static_cast<uint32_t>(
+                        reinterpret_cast<const uint8_t*>(attr) - base);
+            }
+        }
+    }
+
+    mutable std::array<uint32_t, MaxType + 1U> offsets_{};
+    mutable bool built_{false};
+};
+
+} // namespace rtaco
+} // namespace llmx
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace llmx {
+namespace rtaco {
+
+/** @brief Net result of the notifications received for one entry in a window. */
+template<typename Event>
+struct Coalesced {
+    /** Last event received for the entry; earlier ones were superseded. */
+    Event event{};
+    /** Raw notifications folded into this one, itself included. */
+    uint32_t count{1U};
+};
+
+/** @brief Folds events with equal keys into the latest one.
+ *
+ * Events are kept in the order their key was first seen, so draining
+ * reports entries in the same relative order as the raw stream did.
+ *
+ * @tparam Key Entry identity (e.g. `RouteKey`); needs `std::hash`.
+ * @tparam Event Event type to fold.
+ */
+template<typename Key, typename Event, typename Hash = std::hash<Key>>
+class Coalescer {
+public:
+    /** @brief Record `event` for `key`, replacing any earlier one. */
+    void add(const Key& key, Event&& event) {
+        const auto [it, inserted] = index_.try_emplace(key, pending_.size());
+        if (inserted) {
+            pending_.push_back(Coalesced<Event>{std::move(event), 1U});
+            return;
+        }
+
+        auto& entry = pending_[it->second];
+        entry.event = std::move(event);
+        ++entry.count;
+    }
+
+    auto empty() const noexcept -> bool {
+        return pending_.empty();
+    }
+
+    /** @brief Hand over everything recorded so far and start a new window. */
+    auto take() -> std::vector<Coalesced<Event>> {
+        index_.clear();
+        return std::exchange(pending_, {});
+    }
+
+private:
+    std::unordered_map<Key, size_t, Hash> index_;
+    std::vector<Coalesced<Event>> pending_;
+};
+
+} // namespace rtaco
+} // namespace llmx
@@ -4,6 +4,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <type_traits>
@@ -106,6 +107,17 @@ inline auto attribute_string(const rtattr& attr) -> std::string {
     return trim_string(buffer);
 }
 
+/** @brief View an rtattr payload as a string without copying.
+ *
+ * The view stops at the first NUL and never extends past the payload; it is
+ * valid only as long as the message buffer the attribute lives in.
+ */
+inline auto attribute_string_view(const rtattr& attr) noexcept -> std::string_view {
+    const auto payload = static_cast<size_t>(RTA_PAYLOAD(&attr));
+    const auto* buffer = reinterpret_cast<const char*>(RTA_DATA(&attr));
+    return std::string_view{buffer, ::strnlen(buffer, payload)};
+}
+
 /** @brief Convert an rtattr payload to a text representation of an IP address.
  *
  * Supports IPv4 and IPv6 families.
@@ -136,6 +148,41 @@ inline auto attribute_address(const rtattr& attr, uint8_t family) -> std::string
     return trim_string(buffer);
 }
 
+/** @brief Parse a printable IPv4/IPv6 address into 16 address bytes.
+ *
+ * IPv4 addresses are returned in IPv4-mapped form (::ffff:a.b.c.d), which is
+ * the representation the neighbor APIs expect.
+ *
+ * @param text Printable address as produced by `attribute_address`.
+ * @param family Address family (AF_INET or AF_INET6).
+ * @return Address bytes or std::nullopt if the text cannot be parsed.
+ */
+inline auto parse_address(std::string_view text, uint8_t family)
+        -> std::optional<std::array<uint8_t, 16>> {
+    std::array<char, INET6_ADDRSTRLEN> buffer{};
+    if (text.empty() || text.size() >= buffer.size()) {
+        return std::nullopt;
+    }
+    std::memcpy(buffer.data(), text.data(), text.size());
+
+    std::array<uint8_t, 16> address{};
+    switch (family) {
+    case AF_INET:
+        address[10] = 0xff;
+        address[11] = 0xff;
+        if (::inet_pton(AF_INET, buffer.data(), address.data() + 12) != 1) {
+            return std::nullopt;
+        }
+        return address;
+    case AF_INET6:
+        if (::inet_pton(AF_INET6, buffer.data(), address.data()) != 1) {
+            return std::nullopt;
+        }
+        return address;
+    default: return std::nullopt;
+    }
+}
+
 /** @brief Read a uint32_t value from an rtattr payload.
  *
  * Returns 0 on insufficient payload length.
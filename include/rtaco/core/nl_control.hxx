@@ -1,32 +1,101 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <expected>
+#include <memory>
+#include <memory_resource>
 #include <span>
 #include <system_error>
+#include <vector>
 
 #include <boost/asio/awaitable.hpp>
 #include <boost/asio/io_context.hpp>
 #include <boost/asio/strand.hpp>
-#include <boost/asio/steady_timer.hpp>
 
 #include "rtaco/events/nl_address_event.hxx"
 #include "rtaco/events/nl_link_event.hxx"
 #include "rtaco/events/nl_neighbor_event.hxx"
+#include "rtaco/core/nl_transport.hxx"
+#include "rtaco/core/nl_transport_pool.hxx"
 #include "rtaco/events/nl_route_event.hxx"
-#include "rtaco/socket/nl_socket_guard.hxx"
+#include "rtaco/tasks/nl_dump_filter.hxx"
+#include "rtaco/tasks/nl_route_bulk_task.hxx"
+#include "rtaco/tasks/nl_route_message.hxx"
+#include "rtaco/tasks/nl_transaction.hxx"
+#include "rtaco/tasks/nl_transaction_task.hxx"
 
 namespace llmx {
 namespace rtaco {
 
+/** @brief Sizing of the lane `Control` runs neighbor requests and single
+ * writes on. */
+struct InteractiveLaneOptions {
+    /** Maximum number of requests awaiting replies on the lane's socket. */
+    size_t max_in_flight{Transport::DEFAULT_MAX_IN_FLIGHT};
+};
+
+/** @brief Sizing and scheduling of the lane `Control` runs dumps and bulk
+ * route writes on. */
+struct BulkLaneOptions {
+    /** Sockets kept for the lane, and so the number of dumps and
+     *  `apply_routes` calls that run at once. */
+    size_t sockets{4U};
+    /** Maximum number of requests awaiting replies on each of the sockets;
+     *  bounds the datagrams one `apply_routes` keeps in flight. */
+    size_t max_in_flight{Transport::DEFAULT_MAX_IN_FLIGHT};
+    /** Longest the lane handles one reply datagram before other work on the
+     *  thread gets a turn; zero handles each datagram in one go. This is the
+     *  lane's priority: the shorter the slice, the sooner interactive work
+     *  sharing the thread runs. */
+    std::chrono::microseconds time_slice{100};
+    /** io_context running the dumps, e.g. one with a thread of its own;
+     *  nullptr shares the Control's io_context. */
+    boost::asio::io_context* context{nullptr};
+};
+
+/** @brief Order in which a sharded dump concatenates its shards. */
+enum class ShardOrder : uint8_t {
+    /** Shard by shard as given, so equal kernel state gives an equal list. */
+    GIVEN,
+    /** Shard by shard as they finish; nothing waits for a slow first shard. */
+    COMPLETION,
+};
+
+/** @brief Tuning knobs for `Control`. */
+struct ControlOptions {
+    /** Neighbor requests and single writes. */
+    InteractiveLaneOptions interactive{};
+    /** Reply buffer sizing of every socket. */
+    ReceiveBufferOptions receive_buffer{};
+    /** Dumps and `apply_routes`. */
+    BulkLaneOptions bulk{};
+};
+
 /** @brief High-level control interface for kernel netlink operations.
  *
  * The `Control` class provides synchronous and asynchronous methods to query
- * kernel networking state (routes, addresses, links, neighbors) and to perform
- * neighbor-related operations such as probe, flush, and get. It owns a
- * `SocketGuard`, manages sequencing for netlink requests, and exposes both
- * blocking and awaitable APIs to callers.
+ * kernel networking state (routes, addresses, links, neighbors), to add,
+ * replace and delete routes, and to perform neighbor-related operations such
+ * as probe, flush, and get. It owns a
+ * `Transport` over one persistent request socket, manages sequencing for
+ * netlink requests, and exposes both blocking and awaitable APIs to callers.
+ *
+ * Operations run in two lanes so that small requests are not held up by
+ * dumps. The interactive lane carries neighbor gets/probes/flushes, single
+ * route writes and transactions over that socket: concurrent requests are
+ * pipelined and replies are routed back to the awaiting coroutine by
+ * sequence number. The bulk lane runs dumps and `apply_routes` on a capped
+ * pool of further sockets, one operation per socket at a time, each socket
+ * on a strand of its own (`ControlOptions::bulk`), so a large route write
+ * does not use up the interactive socket's window and ack budget. Bulk work
+ * yields after each `time_slice`, so an interactive request sharing the
+ * thread waits for a slice of a reply datagram rather than for all of it;
+ * giving the bulk lane its own io_context takes it off the interactive
+ * thread altogether, and running that context on several threads lets
+ * concurrent or sharded dumps use several cores.
  */
 class Control {
     using route_list_result_t = std::expected<RouteEventList, std::error_code>;
@@ -35,13 +104,24 @@ class Control {
     using neighbor_result_t = std::expected<NeighborEvent, std::error_code>;
     using neighbor_list_result = std::expected<NeighborEventList, std::error_code>;
     using void_result_t = std::expected<void, std::error_code>;
+    using compact_route_list_result_t =
+            std::expected<CompactRouteEventList, std::error_code>;
+    using compact_address_list_result_t =
+            std::expected<CompactAddressEventList, std::error_code>;
+    using compact_link_list_result_t =
+            std::expected<CompactLinkEventList, std::error_code>;
+    using compact_neighbor_list_result_t =
+            std::expected<CompactNeighborEventList, std::error_code>;
+    using route_bulk_result_t = std::expected<RouteBulkResult, std::error_code>;
+    using transaction_result_t = std::expected<TransactionResult, std::error_code>;
 
 public:
     /** @brief Construct a Control instance attached to an io_context.
      *
      * @param io The Boost.Asio io_context used for async operations.
+     * @param options Lane sizing and scheduling.
      */
-    Control(boost::asio::io_context& io) noexcept;
+    Control(boost::asio::io_context& io, ControlOptions options = {}) noexcept;
 
     /** @brief Destroy the Control object and release resources. */
     ~Control();
@@ -53,38 +133,354 @@ public:
 
     /** @brief Synchronously dump routes from the kernel.
      *
+     * Every dump accepts a memory resource that backs the returned list and
+     * every string inside its events, so a dump can be built in an arena
+     * (e.g. `std::pmr::monotonic_buffer_resource`) and released at once.
+     * The resource must outlive the result.
+     *
+     * @param pmr Memory resource for the list and its events.
      * @return Expected RouteEventList or an error_code on failure.
      */
-    auto dump_routes() -> route_list_result_t;
+    auto dump_routes(
+            std::pmr::memory_resource* pmr = std::pmr::get_default_resource())
+            -> route_list_result_t;
+
+    /** @brief Synchronously dump the routes matching `filter`.
+     *
+     * Every dump has an overload taking a filter. It is encoded as
+     * strict-check request fields and attributes, so the kernel skips
+     * non-matching entries instead of sending them: dumping one VRF's table
+     * costs in proportion to that table, not to the whole FIB.
+     */
+    auto dump_routes(const RouteDumpFilter& filter,
+            std::pmr::memory_resource* pmr = std::pmr::get_default_resource())
+            -> route_list_result_t;
 
     /** @brief Synchronously dump addresses from the kernel. */
-    auto dump_addresses() -> address_list_result_t;
+    auto dump_addresses(
+            std::pmr::memory_resource* pmr = std::pmr::get_default_resource())
+            -> address_list_result_t;
+
+    /** @brief Synchronously dump the addresses matching `filter`. */
+    auto dump_addresses(const AddressDumpFilter& filter,
+            std::pmr::memory_resource* pmr = std::pmr::get_default_resource())
+            -> address_list_result_t;
 
     /** @brief Synchronously dump links from the kernel. */
-    auto dump_links() -> link_list_result_t;
+    auto dump_links(
+            std::pmr::memory_resource* pmr = std::pmr::get_default_resource())
+            -> link_list_result_t;
+
+    /** @brief Synchronously dump the links matching `filter`. */
+    auto dump_links(const LinkDumpFilter& filter,
+            std::pmr::memory_resource* pmr = std::pmr::get_default_resource())
+            -> link_list_result_t;
 
     /** @brief Synchronously dump neighbor entries from the kernel. */
-    auto dump_neighbors() -> neighbor_list_result;
+    auto dump_neighbors(
+            std::pmr::memory_resource* pmr = std::pmr::get_default_resource())
+            -> neighbor_list_result;
+
+    /** @brief Synchronously dump the neighbors matching `filter`. */
+    auto dump_neighbors(const NeighborDumpFilter& filter,
+            std::pmr::memory_resource* pmr = std::pmr::get_default_resource())
+            -> neighbor_list_result;
 
     /** @brief Asynchronously dump routes.
      *
      * @return Awaitable that yields the route list result.
      */
-    auto async_dump_routes() -> boost::asio::awaitable<route_list_result_t>;
+    auto async_dump_routes(
+            std::pmr::memory_resource* pmr = std::pmr::get_default_resource())
+            -> boost::asio::awaitable<route_list_result_t>;
+
+    /** @brief Asynchronously dump the routes matching `filter`. */
+    auto async_dump_routes(const RouteDumpFilter& filter,
+            std::pmr::memory_resource* pmr = std::pmr::get_default_resource())
+            -> boost::asio::awaitable<route_list_result_t>;
 
     /** @brief Asynchronously dump addresses. */
-    auto async_dump_addresses() -> boost::asio::awaitable<address_list_result_t>;
+    auto async_dump_addresses(
+            std::pmr::memory_resource* pmr = std::pmr::get_default_resource())
+            -> boost::asio::awaitable<address_list_result_t>;
+
+    /** @brief Asynchronously dump the addresses matching `filter`. */
+    auto async_dump_addresses(const AddressDumpFilter& filter,
+            std::pmr::memory_resource* pmr = std::pmr::get_default_resource())
+            -> boost::asio::awaitable<address_list_result_t>;
 
     /** @brief Asynchronously dump links. */
-    auto async_dump_links() -> boost::asio::awaitable<link_list_result_t>;
+    auto async_dump_links(
+            std::pmr::memory_resource* pmr = std::pmr::get_default_resource())
+            -> boost::asio::awaitable<link_list_result_t>;
+
+    /** @brief Asynchronously dump the links matching `filter`. */
+    auto async_dump_links(const LinkDumpFilter& filter,
+            std::pmr::memory_resource* pmr = std::pmr::get_default_resource())
+            -> boost::asio::awaitable<link_list_result_t>;
 
     /** @brief Asynchronously dump neighbors. */
-    auto async_dump_neighbors() -> boost::asio::awaitable<neighbor_list_result>;
+    auto async_dump_neighbors(
+            std::pmr::memory_resource* pmr = std::pmr::get_default_resource())
+            -> boost::asio::awaitable<neighbor_list_result>;
+
+    /** @brief Asynchronously dump the neighbors matching `filter`. */
+    auto async_dump_neighbors(const NeighborDumpFilter& filter,
+            std::pmr::memory_resource* pmr = std::pmr::get_default_resource())
+            -> boost::asio::awaitable<neighbor_list_result>;
+
+    /** @brief Stream a route dump to `on_chunk` (synchronous).
+     *
+     * Instead of collecting the whole table, the events decoded from each
+     * received datagram are passed to `on_chunk` and released afterwards, so
+     * memory use stays bounded by one receive batch regardless of table size.
+     * `on_chunk` runs on the bulk lane and must not block.
+     *
+     * @param on_chunk Callback invoked once per non-empty batch.
+     * @return Expected void or error on failure.
+     */
+    auto dump_routes(RouteEventChunkHandler on_chunk,
+            std::pmr::memory_resource* pmr = std::pmr::get_default_resource())
+            -> void_result_t;
+
+    /** @brief Stream the routes matching `filter` (synchronous). */
+    auto dump_routes(const RouteDumpFilter& filter, RouteEventChunkHandler on_chunk,
+            std::pmr::memory_resource* pmr = std::pmr::get_default_resource())
+            -> void_result_t;
+
+    /** @brief Stream an address dump to `on_chunk` (synchronous). */
+    auto dump_addresses(AddressEventChunkHandler on_chunk,
+            std::pmr::memory_resource* pmr = std::pmr::get_default_resource())
+            -> void_result_t;
+
+    /** @brief Stream the addresses matching `filter` (synchronous). */
+    auto dump_addresses(const AddressDumpFilter& filter,
+            AddressEventChunkHandler on_chunk,
+            std::pmr::memory_resource* pmr = std::pmr::get_default_resource())
+            -> void_result_t;
+
+    /** @brief Stream a link dump to `on_chunk` (synchronous). */
+    auto dump_links(LinkEventChunkHandler on_chunk,
+            std::pmr::memory_resource* pmr = std::pmr::get_default_resource())
+            -> void_result_t;
+
+    /** @brief Stream the links matching `filter` (synchronous). */
+    auto dump_links(const LinkDumpFilter& filter, LinkEventChunkHandler on_chunk,
+            std::pmr::memory_resource* pmr = std::pmr::get_default_resource())
+            -> void_result_t;
+
+    /** @brief Stream a neighbor dump to `on_chunk` (synchronous). */
+    auto dump_neighbors(NeighborEventChunkHandler on_chunk,
+            std::pmr::memory_resource* pmr = std::pmr::get_default_resource())
+            -> void_result_t;
+
+    /** @brief Stream the neighbors matching `filter` (synchronous). */
+    auto dump_neighbors(const NeighborDumpFilter& filter,
+            NeighborEventChunkHandler on_chunk,
+            std::pmr::memory_resource* pmr = std::pmr::get_default_resource())
+            -> void_result_t;
+
+    /** @brief Asynchronously stream a route dump to `on_chunk`.
+     *
+     * @see dump_routes(RouteEventChunkHandler)
+     */
+    auto async_dump_routes(RouteEventChunkHandler on_chunk,
+            std::pmr::memory_resource* pmr = std::pmr::get_default_resource())
+            -> boost::asio::awaitable<void_result_t>;
+
+    /** @brief Asynchronously stream the routes matching `filter`. */
+    auto async_dump_routes(const RouteDumpFilter& filter, RouteEventChunkHandler on_chunk,
+            std::pmr::memory_resource* pmr = std::pmr::get_default_resource())
+            -> boost::asio::awaitable<void_result_t>;
+
+    /** @brief Asynchronously stream an address dump to `on_chunk`. */
+    auto async_dump_addresses(AddressEventChunkHandler on_chunk,
+            std::pmr::memory_resource* pmr = std::pmr::get_default_resource())
+            -> boost::asio::awaitable<void_result_t>;
+
+    /** @brief Asynchronously stream the addresses matching `filter`. */
+    auto async_dump_addresses(const AddressDumpFilter& filter,
+            AddressEventChunkHandler on_chunk,
+            std::pmr::memory_resource* pmr = std::pmr::get_default_resource())
+            -> boost::asio::awaitable<void_result_t>;
+
+    /** @brief Asynchronously stream a link dump to `on_chunk`. */
+    auto async_dump_links(LinkEventChunkHandler on_chunk,
+            std::pmr::memory_resource* pmr = std::pmr::get_default_resource())
+            -> boost::asio::awaitable<void_result_t>;
+
+    /** @brief Asynchronously stream the links matching `filter`. */
+    auto async_dump_links(const LinkDumpFilter& filter, LinkEventChunkHandler on_chunk,
+            std::pmr::memory_resource* pmr = std::pmr::get_default_resource())
+            -> boost::asio::awaitable<void_result_t>;
+
+    /** @brief Asynchronously stream a neighbor dump to `on_chunk`. */
+    auto async_dump_neighbors(NeighborEventChunkHandler on_chunk,
+            std::pmr::memory_resource* pmr = std::pmr::get_default_resource())
+            -> boost::asio::awaitable<void_result_t>;
+
+    /** @brief Asynchronously stream the neighbors matching `filter`. */
+    auto async_dump_neighbors(const NeighborDumpFilter& filter,
+            NeighborEventChunkHandler on_chunk,
+            std::pmr::memory_resource* pmr = std::pmr::get_default_resource())
+            -> boost::asio::awaitable<void_result_t>;
+
+    /** @brief Dump routes into fixed-size `CompactRouteEvent`s (synchronous).
+     *
+     * Entries are decoded straight from the reply buffer into the compact
+     * layout, so the only allocation is the returned list itself.
+     */
+    auto dump_routes_compact(
+            std::pmr::memory_resource* pmr = std::pmr::get_default_resource())
+            -> compact_route_list_result_t;
+
+    /** @brief Compact dump of the routes matching `filter` (synchronous). */
+    auto dump_routes_compact(const RouteDumpFilter& filter,
+            std::pmr::memory_resource* pmr = std::pmr::get_default_resource())
+            -> compact_route_list_result_t;
+
+    /** @brief Dump addresses into `CompactAddressEvent`s (synchronous). */
+    auto dump_addresses_compact(
+            std::pmr::memory_resource* pmr = std::pmr::get_default_resource())
+            -> compact_address_list_result_t;
+
+    /** @brief Compact dump of the addresses matching `filter` (synchronous). */
+    auto dump_addresses_compact(const AddressDumpFilter& filter,
+            std::pmr::memory_resource* pmr = std::pmr::get_default_resource())
+            -> compact_address_list_result_t;
+
+    /** @brief Dump links into `CompactLinkEvent`s (synchronous). */
+    auto dump_links_compact(
+            std::pmr::memory_resource* pmr = std::pmr::get_default_resource())
+            -> compact_link_list_result_t;
+
+    /** @brief Compact dump of the links matching `filter` (synchronous). */
+    auto dump_links_compact(const LinkDumpFilter& filter,
+            std::pmr::memory_resource* pmr = std::pmr::get_default_resource())
+            -> compact_link_list_result_t;
+
+    /** @brief Dump neighbors into `CompactNeighborEvent`s (synchronous). */
+    auto dump_neighbors_compact(
+            std::pmr::memory_resource* pmr = std::pmr::get_default_resource())
+            -> compact_neighbor_list_result_t;
+
+    /** @brief Compact dump of the neighbors matching `filter` (synchronous). */
+    auto dump_neighbors_compact(const NeighborDumpFilter& filter,
+            std::pmr::memory_resource* pmr = std::pmr::get_default_resource())
+            -> compact_neighbor_list_result_t;
+
+    /** @brief Asynchronously dump routes into `CompactRouteEvent`s. */
+    auto async_dump_routes_compact(
+            std::pmr::memory_resource* pmr = std::pmr::get_default_resource())
+            -> boost::asio::awaitable<compact_route_list_result_t>;
+
+    /** @brief Asynchronous compact dump of the routes matching `filter`. */
+    auto async_dump_routes_compact(const RouteDumpFilter& filter,
+            std::pmr::memory_resource* pmr = std::pmr::get_default_resource())
+            -> boost::asio::awaitable<compact_route_list_result_t>;
+
+    /** @brief Asynchronously dump addresses into `CompactAddressEvent`s. */
+    auto async_dump_addresses_compact(
+            std::pmr::memory_resource* pmr = std::pmr::get_default_resource())
+            -> boost::asio::awaitable<compact_address_list_result_t>;
+
+    /** @brief Asynchronous compact dump of the addresses matching `filter`. */
+    auto async_dump_addresses_compact(const AddressDumpFilter& filter,
+            std::pmr::memory_resource* pmr = std::pmr::get_default_resource())
+            -> boost::asio::awaitable<compact_address_list_result_t>;
+
+    /** @brief Asynchronously dump links into `CompactLinkEvent`s. */
+    auto async_dump_links_compact(
+            std::pmr::memory_resource* pmr = std::pmr::get_default_resource())
+            -> boost::asio::awaitable<compact_link_list_result_t>;
+
+    /** @brief Asynchronous compact dump of the links matching `filter`. */
+    auto async_dump_links_compact(const LinkDumpFilter& filter,
+            std::pmr::memory_resource* pmr = std::pmr::get_default_resource())
+            -> boost::asio::awaitable<compact_link_list_result_t>;
+
+    /** @brief Asynchronously dump neighbors into `CompactNeighborEvent`s. */
+    auto async_dump_neighbors_compact(
+            std::pmr::memory_resource* pmr = std::pmr::get_default_resource())
+            -> boost::asio::awaitable<compact_neighbor_list_result_t>;
+
+    /** @brief Asynchronous compact dump of the neighbors matching `filter`. */
+    auto async_dump_neighbors_compact(const NeighborDumpFilter& filter,
+            std::pmr::memory_resource* pmr = std::pmr::get_default_resource())
+            -> boost::asio::awaitable<compact_neighbor_list_result_t>;
+
+    /** @brief Dump routes as several kernel dumps running side by side.
+     *
+     * Each filter in `shards` (e.g. one per family or per VRF table) is
+     * dumped on a bulk-lane socket of its own. Up to `BulkLaneOptions::sockets`
+     * shards run at once, on as many threads as run the bulk lane's
+     * io_context, and their lists are concatenated in `order`. Shards should
+     * not overlap, or routes they share are returned twice. A failed shard
+     * fails the dump once every shard has finished.
+     *
+     * With several bulk threads the shards allocate from `pmr` concurrently,
+     * so it must then be thread-safe, as the default resource is.
+     *
+     * @param shards Filters splitting the dump.
+     * @param order Order of the shards in the result.
+     * @param pmr Memory resource for the list and its events.
+     * @return Expected RouteEventList or the first shard error.
+     */
+    auto dump_routes(std::span<const RouteDumpFilter> shards,
+            ShardOrder order = ShardOrder::GIVEN,
+            std::pmr::memory_resource* pmr = std::pmr::get_default_resource())
+            -> route_list_result_t;
+
+    /** @brief Asynchronously dump routes in parallel shards. */
+    auto async_dump_routes(std::span<const RouteDumpFilter> shards,
+            ShardOrder order = ShardOrder::GIVEN,
+            std::pmr::memory_resource* pmr = std::pmr::get_default_resource())
+            -> boost::asio::awaitable<route_list_result_t>;
+
+    /** @brief Compact dump of routes in parallel shards (synchronous). */
+    auto dump_routes_compact(std::span<const RouteDumpFilter> shards,
+            ShardOrder order = ShardOrder::GIVEN,
+            std::pmr::memory_resource* pmr = std::pmr::get_default_resource())
+            -> compact_route_list_result_t;
+
+    /** @brief Asynchronous compact dump of routes in parallel shards. */
+    auto async_dump_routes_compact(std::span<const RouteDumpFilter> shards,
+            ShardOrder order = ShardOrder::GIVEN,
+            std::pmr::memory_resource* pmr = std::pmr::get_default_resource())
+            -> boost::asio::awaitable<compact_route_list_result_t>;
+
+    /** @brief Dump neighbors in parallel shards, e.g. one per interface.
+     *
+     * See the sharded `dump_routes`.
+     */
+    auto dump_neighbors(std::span<const NeighborDumpFilter> shards,
+            ShardOrder order = ShardOrder::GIVEN,
+            std::pmr::memory_resource* pmr = std::pmr::get_default_resource())
+            -> neighbor_list_result;
+
+    /** @brief Asynchronously dump neighbors in parallel shards. */
+    auto async_dump_neighbors(std::span<const NeighborDumpFilter> shards,
+            ShardOrder order = ShardOrder::GIVEN,
+            std::pmr::memory_resource* pmr = std::pmr::get_default_resource())
+            -> boost::asio::awaitable<neighbor_list_result>;
+
+    /** @brief Compact dump of neighbors in parallel shards (synchronous). */
+    auto dump_neighbors_compact(std::span<const NeighborDumpFilter> shards,
+            ShardOrder order = ShardOrder::GIVEN,
+            std::pmr::memory_resource* pmr = std::pmr::get_default_resource())
+            -> compact_neighbor_list_result_t;
+
+    /** @brief Asynchronous compact dump of neighbors in parallel shards. */
+    auto async_dump_neighbors_compact(std::span<const NeighborDumpFilter> shards,
+            ShardOrder order = ShardOrder::GIVEN,
+            std::pmr::memory_resource* pmr = std::pmr::get_default_resource())
+            -> boost::asio::awaitable<compact_neighbor_list_result_t>;
 
     /** @brief Probe a neighbor entry (synchronous).
      *
      * @param ifindex Interface index to probe on.
-     * @param address IPv6/IPv4 address bytes (16-byte span).
+     * @param address IPv6 address bytes, or an IPv4-mapped address
+     *        (::ffff:a.b.c.d) for IPv4 neighbors.
      * @return Expected void or error on failure.
      */
     auto probe_neighbor(uint16_t ifindex, std::span<uint8_t, 16> address)
@@ -110,16 +506,165 @@ public:
     auto async_get_neighbor(uint16_t ifindex, std::span<uint8_t, 16> address)
             -> boost::asio::awaitable<neighbor_result_t>;
 
+    /** @brief Add a route; fails with EEXIST if it exists (synchronous). */
+    auto add_route(const RouteSpec& route) -> void_result_t;
+
+    /** @brief Add a route or replace the existing one (synchronous). */
+    auto replace_route(const RouteSpec& route) -> void_result_t;
+
+    /** @brief Delete a route (synchronous). */
+    auto delete_route(const RouteSpec& route) -> void_result_t;
+
+    /** @brief Asynchronously add a route. */
+    auto async_add_route(const RouteSpec& route)
+            -> boost::asio::awaitable<void_result_t>;
+
+    /** @brief Asynchronously add or replace a route. */
+    auto async_replace_route(const RouteSpec& route)
+            -> boost::asio::awaitable<void_result_t>;
+
+    /** @brief Asynchronously delete a route. */
+    auto async_delete_route(const RouteSpec& route)
+            -> boost::asio::awaitable<void_result_t>;
+
+    /** @brief Add, replace or delete many routes (synchronous).
+     *
+     * Routes are packed many to a datagram and several datagrams are kept
+     * in flight (see `RouteBulkOptions`), so installing a full table costs
+     * a few thousand system calls rather than a round trip per route. Each
+     * route is acknowledged on its own; failures are reported with the
+     * route's index and sequence number and do not stop the others. Runs
+     * on the bulk lane.
+     *
+     * @param op Kind of write applied to every route.
+     * @param routes Routes to write; must stay valid until the call returns.
+     * @param options Batch size and window.
+     * @return Per-route outcome, or the transport error that aborted it.
+     */
+    auto apply_routes(RouteOp op, std::span<const RouteSpec> routes,
+            RouteBulkOptions options = {}) -> route_bulk_result_t;
+
+    /** @brief Asynchronously add, replace or delete many routes.
+     *
+     * @see apply_routes
+     */
+    auto async_apply_routes(RouteOp op, std::span<const RouteSpec> routes,
+            RouteBulkOptions options = {})
+            -> boost::asio::awaitable<route_bulk_result_t>;
+
+    /** @brief Send a batch of mixed writes and await every ack (synchronous).
+     *
+     * The operations (links, addresses, neighbors, routes) go out in the
+     * order they were queued, packed into as few datagrams as possible, and
+     * are acknowledged one by one. The kernel has no rollback: a failing
+     * operation is reported in its slot while the others still apply.
+     *
+     * @param transaction Operations to send.
+     * @return One result per operation, or the transport error that aborted
+     *         the batch.
+     */
+    auto commit(const TransactionBuilder& transaction) -> transaction_result_t;
+
+    /** @brief Asynchronously send a batch of mixed writes.
+     *
+     * @see commit
+     */
+    auto async_commit(const TransactionBuilder& transaction)
+            -> boost::asio::awaitable<transaction_result_t>;
+
+    /** @brief Send a batch of mixed writes without waiting for acks (synchronous).
+     *
+     * The messages go out without `NLM_F_ACK`, so the kernel only answers
+     * the operations it refuses; a successful write costs no reply at all.
+     * Returns once everything is sent. Each failure reaches `on_error` on
+     * the control strand, with the operation's index, sequence and message
+     * type. Call `barrier()` to wait until every earlier write was processed
+     * and its failure, if any, reported.
+     *
+     * @param transaction Operations to send.
+     * @param on_error Called once per failed operation.
+     * @return Expected void once sent, or the transport error.
+     */
+    auto post(const TransactionBuilder& transaction, WriteErrorHandler on_error)
+            -> void_result_t;
+
+    /** @brief Asynchronously send a batch of mixed writes without acks.
+     *
+     * @see post
+     */
+    auto async_post(const TransactionBuilder& transaction, WriteErrorHandler on_error)
+            -> boost::asio::awaitable<void_result_t>;
+
+    /** @brief Wait until the kernel processed every earlier request (synchronous).
+     *
+     * Sends an acked NLMSG_NOOP: the kernel handles the socket's messages in
+     * order, so by the time its ack arrives, every failure of an earlier
+     * `post()` has been delivered. Only the interactive lane's socket is
+     * covered; `apply_routes` reports its own outcome.
+     */
+    auto barrier() -> void_result_t;
+
+    /** @brief Asynchronously wait for every earlier request.
+     *
+     * @see barrier
+     */
+    auto async_barrier() -> boost::asio::awaitable<void_result_t>;
+
     /** @brief Stop ongoing operations and release control resources. */
     void stop();
 
 private:
-    auto acquire_socket_token() -> boost::asio::awaitable<void>;
+    auto async_dump_routes_impl(RouteDumpFilter filter, std::pmr::memory_resource* pmr)
+            -> boost::asio::awaitable<route_list_result_t>;
+    auto async_dump_addresses_impl(AddressDumpFilter filter,
+            std::pmr::memory_resource* pmr)
+            -> boost::asio::awaitable<address_list_result_t>;
+    auto async_dump_links_impl(LinkDumpFilter filter, std::pmr::memory_resource* pmr)
+            -> boost::asio::awaitable<link_list_result_t>;
+    auto async_dump_neighbors_impl(NeighborDumpFilter filter,
+            std::pmr::memory_resource* pmr)
+            -> boost::asio::awaitable<neighbor_list_result>;
 
-    auto async_dump_routes_impl() -> boost::asio::awaitable<route_list_result_t>;
-    auto async_dump_addresses_impl() -> boost::asio::awaitable<address_list_result_t>;
-    auto async_dump_links_impl() -> boost::asio::awaitable<link_list_result_t>;
-    auto async_dump_neighbors_impl() -> boost::asio::awaitable<neighbor_list_result>;
+    auto async_stream_routes_impl(RouteDumpFilter filter, RouteEventChunkHandler on_chunk,
+            std::pmr::memory_resource* pmr)
+            -> boost::asio::awaitable<void_result_t>;
+    auto async_stream_addresses_impl(AddressDumpFilter filter,
+            AddressEventChunkHandler on_chunk,
+            std::pmr::memory_resource* pmr)
+            -> boost::asio::awaitable<void_result_t>;
+    auto async_stream_links_impl(LinkDumpFilter filter, LinkEventChunkHandler on_chunk,
+            std::pmr::memory_resource* pmr)
+            -> boost::asio::awaitable<void_result_t>;
+    auto async_stream_neighbors_impl(NeighborDumpFilter filter,
+            NeighborEventChunkHandler on_chunk,
+            std::pmr::memory_resource* pmr)
+            -> boost::asio::awaitable<void_result_t>;
+
+    auto async_dump_routes_compact_impl(RouteDumpFilter filter,
+            std::pmr::memory_resource* pmr)
+            -> boost::asio::awaitable<compact_route_list_result_t>;
+    auto async_dump_addresses_compact_impl(AddressDumpFilter filter,
+            std::pmr::memory_resource* pmr)
+            -> boost::asio::awaitable<compact_address_list_result_t>;
+    auto async_dump_links_compact_impl(LinkDumpFilter filter,
+            std::pmr::memory_resource* pmr)
+            -> boost::asio::awaitable<compact_link_list_result_t>;
+    auto async_dump_neighbors_compact_impl(NeighborDumpFilter filter,
+            std::pmr::memory_resource* pmr)
+            -> boost::asio::awaitable<compact_neighbor_list_result_t>;
+
+    auto async_dump_route_shards_impl(std::vector<RouteDumpFilter> shards,
+            ShardOrder order, std::pmr::memory_resource* pmr)
+            -> boost::asio::awaitable<route_list_result_t>;
+    auto async_dump_route_shards_compact_impl(std::vector<RouteDumpFilter> shards,
+            ShardOrder order, std::pmr::memory_resource* pmr)
+            -> boost::asio::awaitable<compact_route_list_result_t>;
+    auto async_dump_neighbor_shards_impl(std::vector<NeighborDumpFilter> shards,
+            ShardOrder order, std::pmr::memory_resource* pmr)
+            -> boost::asio::awaitable<neighbor_list_result>;
+    auto async_dump_neighbor_shards_compact_impl(std::vector<NeighborDumpFilter> shards,
+            ShardOrder order, std::pmr::memory_resource* pmr)
+            -> boost::asio::awaitable<compact_neighbor_list_result_t>;
 
     auto async_probe_neighbor_impl(uint16_t ifindex, std::span<uint8_t, 16> address)
             -> boost::asio::awaitable<void_result_t>;
@@ -130,11 +675,27 @@ private:
     auto async_get_neighbor_impl(uint16_t ifindex, std::span<uint8_t, 16> address)
             -> boost::asio::awaitable<neighbor_result_t>;
 
+    auto async_route_impl(RouteOp op, RouteSpec route)
+            -> boost::asio::awaitable<void_result_t>;
+
+    auto async_apply_routes_impl(RouteOp op, std::span<const RouteSpec> routes,
+            RouteBulkOptions options) -> boost::asio::awaitable<route_bulk_result_t>;
+
+    auto async_commit_impl(const TransactionBuilder& transaction)
+            -> boost::asio::awaitable<transaction_result_t>;
+
+    auto async_post_impl(const TransactionBuilder& transaction,
+            WriteErrorHandler on_error) -> boost::asio::awaitable<void_result_t>;
+
+    auto async_barrier_impl() -> boost::asio::awaitable<void_result_t>;
+
     boost::asio::io_context& io_;
     boost::asio::strand<boost::asio::io_context::executor_type> strand_;
-    boost::asio::steady_timer gate_;
-    SocketGuard socket_guard_;
+    Transport transport_;
+    boost::asio::strand<boost::asio::io_context::executor_type> bulk_strand_;
+    TransportPool bulk_pool_;
     std::atomic_uint32_t sequence_{1U};
+    std::shared_ptr<bool> alive_;
 };
 
 } // namespace rtaco
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+
+namespace llmx {
+namespace rtaco {
+
+/** @brief Routes netlink messages of type `Type` to member function `Handler`.
+ *
+ * Messages too short to hold a header and a `Payload` (e.g. rtmsg) are
+ * dropped before the handler runs; `void` accepts any length.
+ */
+template<uint16_t Type, typename Payload, auto Handler>
+struct MessageRoute {
+    static constexpr uint16_t type = Type;
+    static constexpr uint32_t min_length = [] {
+        if constexpr (std::is_void_v<Payload>) {
+            return static_cast<uint32_t>(NLMSG_LENGTH(0));
+        } else {
+            return static_cast<uint32_t>(NLMSG_LENGTH(sizeof(Payload)));
+        }
+    }();
+    static constexpr auto handler = Handler;
+};
+
+/** @brief Constant table mapping `nlmsg_type` to a handler of `Owner`.
+ *
+ * Built at compile time from `MessageRoute`s and indexed directly by message
+ * type, so dispatching costs one bounds check, one array load and one
+ * length comparison. New message families are plugged in by adding a route
+ * to the list passed to `make`.
+ *
+ * @tparam Owner Class whose member functions handle the messages.
+ * @tparam Capacity One past the highest routable message type.
+ */
+template<typename Owner, size_t Capacity = RTM_MAX + 1U>
+class DispatchTable {
+public:
+    using handler_t = void (Owner::*)(const nlmsghdr&);
+
+    /** @brief Build a table from `Routes`; types must be distinct. */
+    template<typename... Routes>
+    static consteval auto make() -> DispatchTable {
+        static_assert(((Routes::type < Capacity) && ...),
+                "message type outside the dispatch table");
+        static_assert(distinct(std::array<uint16_t, sizeof...(Routes)>{Routes::type...}),
+                "message type routed twice");
+
+        DispatchTable table{};
+        ((table.entries_[Routes::type] = Entry{Routes::handler, Routes::min_length}),
+                ...);
+        return table;
+    }
+
+    /** @brief Whether a handler is registered for `type`. */
+    constexpr auto contains(uint16_t type) const noexcept -> bool {
+        return type < Capacity && entries_[type].handler != nullptr;
+    }
+
+    /** @brief Pass `header` to the handler registered for its type.
+     *
+     * @return false if no handler is registered, leaving the message to the
+     *         caller; true otherwise, including when it was too short.
+     */
+    auto dispatch(Owner& owner, const nlmsghdr& header) const -> bool {
+        if (header.nlmsg_type >= Capacity) {
+            return false;
+        }
+
+        const auto& entry = entries_[header.nlmsg_type];
+        if (entry.handler == nullptr) {
+            return false;
+        }
+
+        if (header.nlmsg_len >= entry.min_length) {
+            (owner.*entry.handler)(header);
+        }
+
+        return true;
+    }
+
+private:
+    struct Entry {
+        handler_t handler{nullptr};
+        uint32_t min_length{0U};
+    };
+
+    template<size_t N>
+    static consteval auto distinct(const std::array<uint16_t, N>& types) -> bool {
+        for (size_t i = 0; i < N; ++i) {
+            for (size_t j = i + 1U; j < N; ++j) {
+                if (types[i] == types[j]) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    std::array<Entry, Capacity> entries_{};
+};
+
+} // namespace rtaco
+} // namespace llmx
@@ -0,0 +1,438 @@
+#pragma once
+
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <boost/asio/any_io_executor.hpp>
+#include <boost/asio/post.hpp>
+
+#include "rtaco/core/nl_exec_policy.hxx"
+
+namespace llmx {
+namespace rtaco {
+
+template<typename Signature, size_t Capacity = 64U>
+class Delegate;
+
+/** @brief Move-only callable with inline storage.
+ *
+ * Callables of up to `Capacity` bytes that can be moved without throwing
+ * live inside the delegate; larger ones are allocated once when the
+ * delegate is built. Calling never allocates.
+ */
+template<typename R, typename... Args, size_t Capacity>
+class Delegate<R(Args...), Capacity> {
+public:
+    Delegate() noexcept = default;
+
+    template<typename F>
+        requires(!std::same_as<std::decay_t<F>, Delegate> &&
+                 std::is_invocable_r_v<R, std::decay_t<F>&, Args...>)
+    Delegate(F&& fn) {
+        using callable_t = std::decay_t<F>;
+
+        if constexpr (fits_inline<callable_t>) {
+            ::new (static_cast<void*>(storage_)) callable_t(std::forward<F>(fn));
+            invoke_ = &invoke_inline<callable_t>;
+            manage_ = &manage_inline<callable_t>;
+        } else {
+            ::new (static_cast<void*>(storage_)) callable_t*(
+                    new callable_t(std::forward<F>(fn)));
+            invoke_ = &invoke_heap<callable_t>;
+            manage_ = &manage_heap<callable_t>;
+        }
+    }
+
+    Delegate(Delegate&& other) noexcept
+        : invoke_{other.invoke_}
+        , manage_{other.manage_} {
+        if (manage_ != nullptr) {
+            manage_(Operation::Move, storage_, other.storage_);
+        }
+        other.invoke_ = nullptr;
+        other.manage_ = nullptr;
+    }
+
+    Delegate& operator=(Delegate&& other) noexcept {
+        if (this != &other) {
+            reset();
+            invoke_ = other.invoke_;
+            manage_ = other.manage_;
+            if (manage_ != nullptr) {
+                manage_(Operation::Move, storage_, other.storage_);
+            }
+            other.invoke_ = nullptr;
+            other.manage_ = nullptr;
+        }
+        return *this;
+    }
+
+    Delegate(const Delegate&) = delete;
+    Delegate& operator=(const Delegate&) = delete;
+
+    ~Delegate() {
+        reset();
+    }
+
+    explicit operator bool() const noexcept {
+        return invoke_ != nullptr;
+    }
+
+    auto operator()(Args... args) const -> R {
+        return invoke_(storage_, std::forward<Args>(args)...);
+    }
+
+private:
+    enum class Operation {
+        Move,
+        Destroy
+    };
+
+    using invoke_t = R (*)(void*, Args&&...);
+    using manage_t = void (*)(Operation, void*, void*) noexcept;
+
+    template<typename F>
+    static constexpr bool fits_inline = sizeof(F) <= Capacity &&
+            alignof(F) <= alignof(std::max_align_t) &&
+            std::is_nothrow_move_constructible_v<F>;
+
+    template<typename F>
+    static auto invoke_inline(void* storage, Args&&... args) -> R {
+        return std::invoke(*std::launder(static_cast<F*>(storage)),
+                std::forward<Args>(args)...);
+    }
+
+    template<typename F>
+    static auto invoke_heap(void* storage, Args&&... args) -> R {
+        return std::invoke(**std::launder(static_cast<F**>(storage)),
+                std::forward<Args>(args)...);
+    }
+
+    template<typename F>
+    static void manage_inline(Operation operation, void* self, void* other) noexcept {
+        if (operation == Operation::Move) {
+            auto* source = std::launder(static_cast<F*>(other));
+            ::new (self) F(std::move(*source));
+            source->~F();
+        } else {
+            std::launder(static_cast<F*>(self))->~F();
+        }
+    }
+
+    template<typename F>
+    static void manage_heap(Operation operation, void* self, void* other) noexcept {
+        if (operation == Operation::Move) {
+            ::new (self) F*(*std::launder(static_cast<F**>(other)));
+        } else {
+            delete *std::launder(static_cast<F**>(self));
+        }
+    }
+
+    void reset() noexcept {
+        if (manage_ != nullptr) {
+            manage_(Operation::Destroy, storage_, nullptr);
+        }
+        invoke_ = nullptr;
+        manage_ = nullptr;
+    }
+
+    alignas(std::max_align_t) mutable std::byte storage_[Capacity];
+    invoke_t invoke_{nullptr};
+    manage_t manage_{nullptr};
+};
+
+namespace detail {
+
+/** Shared state of one connected slot, independent of its signature. */
+class ConnectionBody {
+public:
+    virtual ~ConnectionBody() = default;
+
+    auto connected() const noexcept -> bool {
+        return connected_.load(std::memory_order_acquire);
+    }
+
+    void disconnect() {
+        if (connected_.exchange(false, std::memory_order_acq_rel)) {
+            detach();
+        }
+    }
+
+protected:
+    virtual void detach() = 0;
+
+private:
+    std::atomic_bool connected_{true};
+};
+
+} // namespace detail
+
+/** @brief Handle to a slot connected to a `Dispatcher`.
+ *
+ * Copies refer to the same slot. Dropping a handle does not disconnect.
+ */
+class Connection {
+public:
+    Connection() noexcept = default;
+
+    explicit Connection(std::weak_ptr<detail::ConnectionBody> body) noexcept
+        : body_{std::move(body)} {}
+
+    /** @brief Stop delivering to the slot; pending async calls are skipped. */
+    void disconnect() {
+        if (auto body = body_.lock()) {
+            body->disconnect();
+        }
+    }
+
+    /** @brief Whether the slot is still connected. */
+    auto connected() const noexcept -> bool {
+        const auto body = body_.lock();
+        return body && body->connected();
+    }
+
+private:
+    std::weak_ptr<detail::ConnectionBody> body_;
+};
+
+/** @brief Move-only `Connection` that disconnects when it goes out of scope.
+ *
+ * Stands in for `boost::signals2::scoped_connection`.
+ */
+class ScopedConnection {
+public:
+    ScopedConnection() noexcept = default;
+
+    ScopedConnection(Connection connection) noexcept
+        : connection_{std::move(connection)} {}
+
+    ScopedConnection(const ScopedConnection&) = delete;
+    ScopedConnection& operator=(const ScopedConnection&) = delete;
+
+    ScopedConnection(ScopedConnection&& other) noexcept
+        : connection_{other.release()} {}
+
+    ScopedConnection& operator=(ScopedConnection&& other) {
+        if (this != &other) {
+            disconnect();
+            connection_ = other.release();
+        }
+        return *this;
+    }
+
+    ~ScopedConnection() {
+        disconnect();
+    }
+
+    /** @brief Disconnect the slot now. */
+    void disconnect() {
+        connection_.disconnect();
+    }
+
+    /** @brief Whether the slot is still connected. */
+    auto connected() const noexcept -> bool {
+        return connection_.connected();
+    }
+
+    /** @brief Give up ownership; the slot stays connected. */
+    auto release() noexcept -> Connection {
+        return std::exchange(connection_, Connection{});
+    }
+
+private:
+    Connection connection_;
+};
+
+template<typename Signature>
+class Dispatcher;
+
+/** @brief Copy-on-write fan-out of `void` events to slots.
+ *
+ * `connect` and `disconnect` publish a new immutable slot list under a
+ * mutex, and `emit` only loads the current one, so emitting never waits for
+ * subscribers being added or removed. Loading the list is not lock-free:
+ * `std::atomic<std::shared_ptr>` guards the refcount with a short internal
+ * lock. Sync slots (and Batched or Sharded ones, which the emitter posts
+ * itself) are called in place through a small-buffer `Delegate`. Async
+ * slots of one emission share a single refcounted, immutable copy of the
+ * arguments, which each of them receives through one `post` to the
+ * executor; that copy and every posted handler are allocated per emission.
+ *
+ * A slot is destroyed once it is disconnected and no emission or pending
+ * async call still refers to it.
+ */
+template<typename... Args>
+class Dispatcher<void(Args...)> {
+public:
+    using slot_t = std::function<void(Args...)>;
+    using connection_t = Connection;
+
+    /** @brief Construct a dispatcher posting async slots to `executor`. */
+    explicit Dispatcher(boost::asio::any_io_executor executor)
+        : core_{std::make_shared<Core>(std::move(executor))} {}
+
+    Dispatcher(const Dispatcher&) = delete;
+    Dispatcher& operator=(const Dispatcher&) = delete;
+
+    /** @brief Connect a slot.
+     *
+     * @param slot Callable invoked for every emission.
+     * @param policy Post the slot (Async) or run it inline (any other).
+     * @return A connection that can be used to disconnect.
+     */
+    template<typename Slot>
+    auto connect(Slot&& slot, ExecPolicy policy = ExecPolicy::Sync) -> connection_t {
+        auto body = std::make_shared<SlotBody>(std::forward<Slot>(slot), policy, core_);
+        core_->add(body);
+        return Connection{body};
+    }
+
+    /** @brief True when no slot is connected, so emitting would be a no-op. */
+    auto empty() const noexcept -> bool {
+        return core_->size.load(std::memory_order_acquire) == 0U;
+    }
+
+    /** @brief Call every connected slot with `args`. */
+    void emit(Args... args) const {
+        core_->emit(args...);
+    }
+
+    /** @brief Shortcut to emit. */
+    void operator()(Args... args) const {
+        emit(args...);
+    }
+
+private:
+    struct Core;
+
+public:
+    /** @brief Emits to the slots of a dispatcher, sharing ownership of them.
+     *
+     * Handlers that run on another executor hold an emitter rather than
+     * the dispatcher, which may be destroyed before they run.
+     */
+    class Emitter {
+    public:
+        Emitter() noexcept = default;
+
+        void operator()(Args... args) const {
+            if (core_) {
+                core_->emit(args...);
+            }
+        }
+
+    private:
+        friend class Dispatcher;
+
+        explicit Emitter(std::shared_ptr<const Core> core) noexcept
+            : core_{std::move(core)} {}
+
+        std::shared_ptr<const Core> core_;
+    };
+
+    /** @brief Emitter that stays valid after the dispatcher is destroyed. */
+    auto emitter() const -> Emitter {
+        return Emitter{core_};
+    }
+
+private:
+    struct SlotBody final : detail::ConnectionBody {
+        template<typename Slot>
+        SlotBody(Slot&& slot, ExecPolicy exec_policy, const std::shared_ptr<Core>& owner)
+            : fn{std::forward<Slot>(slot)}
+            , policy{exec_policy}
+            , core{owner} {}
+
+        Delegate<void(Args...)> fn;
+        ExecPolicy policy;
+        std::weak_ptr<Core> core;
+
+    protected:
+        void detach() override {
+            if (auto owner = core.lock()) {
+                owner->remove(this);
+            }
+        }
+    };
+
+    using slot_list_t = std::vector<std::shared_ptr<SlotBody>>;
+
+    struct Core {
+        explicit Core(boost::asio::any_io_executor exec)
+            : executor{std::move(exec)} {}
+
+        void add(std::shared_ptr<SlotBody> body) {
+            std::lock_guard lock{mutex};
+            auto next = std::make_shared<slot_list_t>(*slots.load());
+            next->push_back(std::move(body));
+            size.store(next->size(), std::memory_order_release);
+            slots.store(std::move(next), std::memory_order_release);
+        }
+
+        void remove(const SlotBody* body) {
+            std::shared_ptr<const slot_list_t> previous{};
+            {
+                std::lock_guard lock{mutex};
+                previous = slots.load();
+                auto next = std::make_shared<slot_list_t>();
+                next->reserve(previous->size());
+                for (const auto& slot : *previous) {
+                    if (slot.get() != body) {
+                        next->push_back(slot);
+                    }
+                }
+                size.store(next->size(), std::memory_order_release);
+                slots.store(std::move(next), std::memory_order_release);
+            }
+            // The last reference to the slot may go with `previous`; drop it
+            // outside the lock, slot destructors may take locks of their own.
+        }
+
+        void emit(Args... args) const {
+            const auto current = slots.load(std::memory_order_acquire);
+            std::shared_ptr<const std::tuple<std::decay_t<Args>...>> shared{};
+
+            for (const auto& slot : *current) {
+                if (!slot->connected()) {
+                    continue;
+                }
+
+                if (slot->policy != ExecPolicy::Async) {
+                    slot->fn(args...);
+                    continue;
+                }
+
+                if (!shared) {
+                    shared = std::make_shared<const std::tuple<std::decay_t<Args>...>>(
+                            args...);
+                }
+
+                boost::asio::post(executor, [slot, shared]() {
+                    if (slot->connected()) {
+                        std::apply(slot->fn, *shared);
+                    }
+                });
+            }
+        }
+
+        boost::asio::any_io_executor executor;
+        std::mutex mutex;
+        std::atomic<std::shared_ptr<const slot_list_t>> slots{
+                std::make_shared<const slot_list_t>()};
+        std::atomic_size_t size{0U};
+    };
+
+    std::shared_ptr<Core> core_;
+};
+
+} // namespace rtaco
+} // namespace llmx
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstdint>
+#include <expected>
+#include <optional>
+#include <system_error>
+#include <vector>
+
+#include <linux/filter.h>
+#include <sys/socket.h>
+
+#include "rtaco/events/nl_address_event.hxx"
+#include "rtaco/events/nl_link_event.hxx"
+#include "rtaco/events/nl_neighbor_event.hxx"
+#include "rtaco/events/nl_route_event.hxx"
+
+namespace llmx {
+namespace rtaco {
+
+/** @brief Predicate on link notifications; empty fields match anything. */
+struct LinkFilter {
+    /** Interface indexes to keep. */
+    std::vector<int> indexes{};
+
+    auto matches(const LinkEventView& view) const noexcept -> bool;
+    auto matches(const CompactLinkEvent& event) const noexcept -> bool;
+};
+
+/** @brief Predicate on address notifications; empty fields match anything. */
+struct AddressFilter {
+    /** Interface indexes to keep. */
+    std::vector<int> indexes{};
+    /** AF_INET or AF_INET6; AF_UNSPEC keeps both. */
+    uint8_t family{AF_UNSPEC};
+
+    auto matches(const AddressEventView& view) const noexcept -> bool;
+    auto matches(const CompactAddressEvent& event) const noexcept -> bool;
+};
+
+/** @brief Predicate on route notifications; empty fields match anything.
+ *
+ * Interfaces are matched against RTA_OIF, so multipath routes (which carry
+ * their next hops in RTA_MULTIPATH) never match a non-empty `oif_indexes`.
+ */
+struct RouteFilter {
+    /** Output interface indexes to keep. */
+    std::vector<int> oif_indexes{};
+    /** AF_INET or AF_INET6; AF_UNSPEC keeps both. */
+    uint8_t family{AF_UNSPEC};
+    /** Routing table (RT_TABLE_* or any id); 0 keeps every table. */
+    uint32_t table{0U};
+    /** Route origin (RTPROT_*); RTPROT_UNSPEC keeps every protocol. */
+    uint8_t protocol{0U};
+
+    auto matches(const RouteEventView& view) const noexcept -> bool;
+    auto matches(const CompactRouteEvent& event) const noexcept -> bool;
+};
+
+/** @brief Predicate on neighbor notifications; empty fields match anything. */
+struct NeighborFilter {
+    /** Interface indexes to keep. */
+    std::vector<int> indexes{};
+    /** AF_INET or AF_INET6; AF_UNSPEC keeps both. */
+    uint8_t family{AF_UNSPEC};
+    /** NUD_* bits; an entry matches if its state has any of them set. */
+    uint16_t states{0U};
+
+    auto matches(const NeighborEventView& view) const noexcept -> bool;
+    auto matches(const CompactNeighborEvent& event) const noexcept -> bool;
+};
+
+/** @brief Per-event-type predicates evaluated in the kernel.
+ *
+ * A message kind without a predicate is delivered unchanged, as is every
+ * message that is not a link, address, route or neighbor notification.
+ */
+struct EventFilter {
+    std::optional<LinkFilter> link{};
+    std::optional<AddressFilter> address{};
+    std::optional<RouteFilter> route{};
+    std::optional<NeighborFilter> neighbor{};
+
+    /** @brief True when no predicate is set, i.e. the filter keeps everything. */
+    auto empty() const noexcept -> bool {
+        return !link && !address && !route && !neighbor;
+    }
+};
+
+/**
+ * @brief Compile `filter` into a classic BPF socket filter program.
+ *
+ * The program inspects the first message of each datagram, which is all a
+ * multicast notification carries, and keeps or drops the whole datagram.
+ * Route tables above 255 and output interfaces are read from the RTA_TABLE
+ * and RTA_OIF attributes, searched among the first 16 attributes of the
+ * message; the kernel emits both well within that range.
+ *
+ * @return The program for SO_ATTACH_FILTER, or `std::errc::value_too_large`
+ *         if it would exceed BPF_MAXINSNS instructions.
+ */
+auto compile_filter(const EventFilter& filter)
+        -> std::expected<std::vector<sock_filter>, std::error_code>;
+
+} // namespace rtaco
+} // namespace llmx
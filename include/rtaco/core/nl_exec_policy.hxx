@@ -0,0 +1,23 @@
+#pragma once
+
+namespace llmx {
+namespace rtaco {
+
+/** @brief Where a connected slot runs when its signal is emitted. */
+enum class ExecPolicy {
+    /** Inline, on the emitting thread. */
+    Sync,
+    /** Posted to the signal's executor. */
+    Async,
+    /** Collected into batches that are posted once each; a source that
+     * batches its own events (`Listener`) calls the slot inline from the
+     * posted handler. `Signal` treats it like Async. */
+    Batched,
+    /** Posted to one of several strands picked by a per-event key, so equal
+     * keys stay ordered while different keys run in parallel. Like Batched,
+     * the source does the posting; `Signal` treats it like Async. */
+    Sharded
+};
+
+} // namespace rtaco
+} // namespace llmx
@@ -1,50 +1,158 @@
 #pragma once
 
-#include <array>
 #include <atomic>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <expected>
+#include <functional>
 #include <list>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <span>
+#include <system_error>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/any_io_executor.hpp>
 #include <boost/asio/io_context.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/strand.hpp>
 #include <boost/iterator/iterator_facade.hpp>
 #include <boost/move/utility_core.hpp>
-#include <boost/signals2/connection.hpp>
 #include <boost/system/error_code.hpp>
 
 #include <linux/netlink.h>
+#include <sys/socket.h>
 
-#include "rtaco/core/nl_signal.hxx"
+#include "rtaco/core/nl_coalescer.hxx"
+#include "rtaco/core/nl_dispatcher.hxx"
+#include "rtaco/core/nl_event_filter.hxx"
+#include "rtaco/core/nl_transport.hxx"
 #include "rtaco/events/nl_address_event.hxx"
+#include "rtaco/events/nl_event_key.hxx"
 #include "rtaco/events/nl_link_event.hxx"
 #include "rtaco/events/nl_neighbor_event.hxx"
 #include "rtaco/events/nl_route_event.hxx"
+#include "rtaco/socket/nl_receive_batch.hxx"
+#include "rtaco/socket/nl_receive_buffer.hxx"
 #include "rtaco/socket/nl_socket_guard.hxx"
 
 namespace llmx {
 namespace rtaco {
 
+/** @brief When `ExecPolicy::Batched` subscribers receive their events. */
+struct BatchOptions {
+    /** A batch is posted as soon as it holds this many events. */
+    size_t max_events{1024U};
+    /** How long events may wait for more to join their batch; zero posts
+     * what every receive produced as soon as it is processed. */
+    std::chrono::microseconds max_delay{0};
+};
+
+/** @brief Window of `connect_to_coalesced` subscribers. */
+struct CoalesceOptions {
+    /** How long notifications are held, counted from the first one of a
+     * window; every entry changed during it is then reported once. */
+    std::chrono::milliseconds window{50};
+};
+
+/** @brief How `ExecPolicy::Sharded` subscribers are spread over strands.
+ *
+ * Each event is posted to the strand picked by its key modulo `count`;
+ * events with equal keys are delivered in order, others may run in
+ * parallel on the executor's threads. Empty key functions use the
+ * interface index for links, addresses and neighbors, and the destination
+ * prefix and table for routes (a route may change interface, its prefix
+ * may not).
+ */
+struct ShardOptions {
+    /** Number of strands; 0 uses one per hardware thread. */
+    size_t count{0U};
+    /** Executor the strands run on (e.g. a thread_pool's); defaults to the
+     * listener's io_context, which then needs several threads. Handlers
+     * still queued when the listener is destroyed are dropped; one already
+     * running finishes with the slots it holds. */
+    boost::asio::any_io_executor executor{};
+    std::function<size_t(const LinkEvent&)> link_key{};
+    std::function<size_t(const AddressEvent&)> address_key{};
+    std::function<size_t(const RouteEvent&)> route_key{};
+    std::function<size_t(const NeighborEvent&)> neighbor_key{};
+};
+
+/** @brief Tuning knobs for `Listener`. */
+struct ListenerOptions {
+    /** Notification buffer sizing; multicast datagrams are usually one page. */
+    ReceiveBufferOptions receive_buffer{32U * 1024U, 1024U * 1024U};
+    /** Datagrams drained with one `recvmmsg` per wakeup; 1 receives them one
+     * at a time. Each batch slot starts at `receive_buffer.initial_size`. */
+    size_t batch_size{1U};
+    /** Keep ENOBUFS reporting on and resynchronize after lost notifications;
+     * see `Listener` for what this costs. */
+    bool resync_on_overrun{false};
+    /** In-kernel predicates installed when the socket opens; see
+     * `Listener::set_filter`. */
+    EventFilter filter{};
+    /** Batch size and latency for `ExecPolicy::Batched` subscribers. */
+    BatchOptions batch{};
+    /** Strands and keys for `ExecPolicy::Sharded` subscribers. */
+    ShardOptions shards{};
+    /** Window for `connect_to_coalesced` subscribers. */
+    CoalesceOptions coalesce{};
+};
+
 /** @brief Asynchronous netlink message listener and event dispatcher.
  *
  * Listens on netlink multicast groups and dispatches typed events
- * (link/address/route/neighbor) via `Signal` instances. Manages a
+ * (link/address/route/neighbor) via `Dispatcher` instances. Manages a
  * `SocketGuard`, an internal read buffer and sequence numbering for
  * netlink messages.
+ *
+ * The socket binds to no multicast group; groups are joined and left with
+ * NETLINK_ADD_MEMBERSHIP / NETLINK_DROP_MEMBERSHIP as connections that need
+ * them come and go.
+ *
+ * By default the socket uses `NETLINK_NO_ENOBUFS`: notifications that
+ * overflow the receive buffer are lost without notice. With
+ * `ListenerOptions::resync_on_overrun` the listener instead keeps a compact
+ * copy of every link, address, route and neighbor entry in the scope of
+ * the corresponding dump task. When a receive reports ENOBUFS (or a
+ * datagram is truncated because it did not fit the buffer) it discards
+ * whatever is still queued, re-dumps the four tables and emits synthetic
+ * NEW/DELETE events (to `connect_to_event` subscribers only) for every
+ * entry that changed during the gap, then resumes reading. The initial
+ * state is dumped silently on `start()`.
  */
 class Listener {
-    static constexpr auto BUFFER_SIZE = 32U * 1024U;
-
 public:
-    using link_signal_t = Signal<void(const LinkEvent&)>;
-    using address_signal_t = Signal<void(const AddressEvent&)>;
-    using route_signal_t = Signal<void(const RouteEvent&)>;
-    using neighbor_signal_t = Signal<void(const NeighborEvent&)>;
-    using nlmsgerr_signal_t = Signal<void(const nlmsgerr&, const nlmsghdr&)>;
+    using link_signal_t = Dispatcher<void(const LinkEvent&)>;
+    using address_signal_t = Dispatcher<void(const AddressEvent&)>;
+    using route_signal_t = Dispatcher<void(const RouteEvent&)>;
+    using neighbor_signal_t = Dispatcher<void(const NeighborEvent&)>;
+    using nlmsgerr_signal_t = Dispatcher<void(const nlmsgerr&, const nlmsghdr&)>;
+
+    using link_view_signal_t = Dispatcher<void(const LinkEventView&)>;
+    using address_view_signal_t = Dispatcher<void(const AddressEventView&)>;
+    using route_view_signal_t = Dispatcher<void(const RouteEventView&)>;
+    using neighbor_view_signal_t = Dispatcher<void(const NeighborEventView&)>;
+    using message_signal_t = Dispatcher<void(const nlmsghdr&)>;
+
+    using link_batch_signal_t = Dispatcher<void(std::span<const LinkEvent>)>;
+    using address_batch_signal_t = Dispatcher<void(std::span<const AddressEvent>)>;
+    using route_batch_signal_t = Dispatcher<void(std::span<const RouteEvent>)>;
+    using neighbor_batch_signal_t = Dispatcher<void(std::span<const NeighborEvent>)>;
+
+    using link_coalesced_signal_t = Dispatcher<void(const Coalesced<LinkEvent>&)>;
+    using address_coalesced_signal_t = Dispatcher<void(const Coalesced<AddressEvent>&)>;
+    using route_coalesced_signal_t = Dispatcher<void(const Coalesced<RouteEvent>&)>;
+    using neighbor_coalesced_signal_t =
+            Dispatcher<void(const Coalesced<NeighborEvent>&)>;
 
     /** @brief Construct a Listener bound to an io_context. */
-    Listener(boost::asio::io_context& io) noexcept;
+    Listener(boost::asio::io_context& io, ListenerOptions options = {}) noexcept;
 
     /** @brief Destroy the Listener and stop any background activity. */
     ~Listener();
@@ -63,41 +171,167 @@ public:
     /** @brief Check whether listener is currently running. */
     bool running() const noexcept;
 
+    /** @brief Number of receive buffer overruns detected since construction.
+     *
+     * With `resync_on_overrun`, datagrams dropped because they did not fit
+     * the receive buffer are counted (and resynchronized) as overruns too.
+     */
+    auto overruns() const noexcept -> uint64_t;
+
+    /** @brief Replace the predicates notifications must satisfy to be received.
+     *
+     * The filter is compiled to a classic BPF program attached to the
+     * listener socket, so non-matching notifications are dropped by the
+     * kernel before they are queued: they cost neither a wakeup nor a copy.
+     * The new program replaces the old one atomically; an empty filter
+     * removes it. With `resync_on_overrun`, resynchronization applies the
+     * same predicates to its dumps.
+     *
+     * Safe to call from any thread, before or after `start()`.
+     *
+     * @return Empty on success, `std::errc::value_too_large` if the program
+     *         is too long, or the error from attaching it.
+     */
+    auto set_filter(EventFilter filter) -> std::expected<void, std::error_code>;
+
+    /** @brief The predicates currently in effect. */
+    auto filter() const -> EventFilter;
+
     /** @brief Connect a handler to link events.
+     *
+     * The listener joins the netlink multicast groups a connection needs
+     * while it is connected and leaves them once the last connection that
+     * needs a group is gone, so the kernel never wakes the listener for
+     * message kinds nobody consumes.
+     *
+     * With `ExecPolicy::Batched` the slot still sees one event at a time,
+     * but events are collected per receive (see `BatchOptions`) and each
+     * batch reaches the slot through a single posted handler instead of one
+     * coroutine and post per event.
+     *
+     * With `ExecPolicy::Sharded` the slot runs on the strand `ShardOptions`
+     * assigns to each event's key: strictly ordered per key, concurrently
+     * across keys, so the slot must be safe to call from several threads.
      *
      * @param slot Handler callable invoked when a link event is emitted.
-     * @param policy Execution policy (Sync or Async).
+     * @param policy Execution policy (Sync, Async, Batched or Sharded).
      * @return A connection object that can be used to disconnect.
      */
     auto connect_to_event(link_signal_t::slot_t&& slot,
-            ExecPolicy policy = ExecPolicy::Sync) -> boost::signals2::connection {
-        return on_link_event_.connect(std::move(slot), policy);
-    }
+            ExecPolicy policy = ExecPolicy::Sync) -> Connection;
 
-    /** @brief Connect a handler to address events. */
+    /** @brief Connect a handler to address events.
+     *
+     * @param family AF_INET or AF_INET6 to join only that family's group and
+     *        receive only its events; AF_UNSPEC for both.
+     */
     auto connect_to_event(address_signal_t::slot_t&& slot,
-            ExecPolicy policy = ExecPolicy::Sync) -> boost::signals2::connection {
-        return on_address_event_.connect(std::move(slot), policy);
-    }
+            ExecPolicy policy = ExecPolicy::Sync, uint8_t family = AF_UNSPEC)
+            -> Connection;
 
-    /** @brief Connect a handler to route events. */
+    /** @brief Connect a handler to route events.
+     *
+     * @param family AF_INET or AF_INET6 to join only that family's group and
+     *        receive only its events; AF_UNSPEC for both.
+     */
     auto connect_to_event(route_signal_t::slot_t&& slot,
-            ExecPolicy policy = ExecPolicy::Sync) -> boost::signals2::connection {
-        return on_route_event_.connect(std::move(slot), policy);
-    }
+            ExecPolicy policy = ExecPolicy::Sync, uint8_t family = AF_UNSPEC)
+            -> Connection;
 
-    /** @brief Connect a handler to neighbor events. */
+    /** @brief Connect a handler to neighbor events.
+     *
+     * @param family AF_INET or AF_INET6 to receive only that family's
+     *        events; the kernel has a single neighbor group for both.
+     */
     auto connect_to_event(neighbor_signal_t::slot_t&& slot,
-            ExecPolicy policy = ExecPolicy::Sync) -> boost::signals2::connection {
-        return on_neighbor_event_.connect(std::move(slot), policy);
-    }
+            ExecPolicy policy = ExecPolicy::Sync, uint8_t family = AF_UNSPEC)
+            -> Connection;
+
+    /** @brief Connect a handler to whole batches of link events.
+     *
+     * Events decoded from one receive (or, with `BatchOptions::max_delay`,
+     * from every receive within that delay) are posted once as a span, so a
+     * consumer can apply them under one lock. The span is only valid for
+     * the duration of the call. Synthetic events from a resync arrive as
+     * one batch of their own.
+     */
+    auto connect_to_batch(link_batch_signal_t::slot_t&& slot) -> Connection;
+
+    /** @brief Connect a handler to whole batches of address events of both
+     * families. */
+    auto connect_to_batch(address_batch_signal_t::slot_t&& slot) -> Connection;
+
+    /** @brief Connect a handler to whole batches of route events of both
+     * families. */
+    auto connect_to_batch(route_batch_signal_t::slot_t&& slot) -> Connection;
+
+    /** @brief Connect a handler to whole batches of neighbor events. */
+    auto connect_to_batch(neighbor_batch_signal_t::slot_t&& slot) -> Connection;
+
+    /** @brief Connect a handler to the net change of each link per window.
+     *
+     * Notifications are held for `CoalesceOptions::window` and folded by
+     * entry identity (`LinkKey`, `AddressKey`, `RouteKey`, `NeighborKey`):
+     * a flapping entry is reported once, with its last event and the number
+     * of raw notifications folded into it. Entries are reported in the
+     * order they first changed; synthetic resync events are folded too.
+     */
+    auto connect_to_coalesced(link_coalesced_signal_t::slot_t&& slot,
+            ExecPolicy policy = ExecPolicy::Sync) -> Connection;
+
+    /** @brief Connect a handler to the net change of each address per window. */
+    auto connect_to_coalesced(address_coalesced_signal_t::slot_t&& slot,
+            ExecPolicy policy = ExecPolicy::Sync) -> Connection;
+
+    /** @brief Connect a handler to the net change of each route per window. */
+    auto connect_to_coalesced(route_coalesced_signal_t::slot_t&& slot,
+            ExecPolicy policy = ExecPolicy::Sync) -> Connection;
+
+    /** @brief Connect a handler to the net change of each neighbor per window. */
+    auto connect_to_coalesced(neighbor_coalesced_signal_t::slot_t&& slot,
+            ExecPolicy policy = ExecPolicy::Sync) -> Connection;
 
     /** @brief Connect a handler to raw netlink error messages. */
     auto connect_to_error(nlmsgerr_signal_t::slot_t&& slot,
-            ExecPolicy policy = ExecPolicy::Sync) -> boost::signals2::connection {
+            ExecPolicy policy = ExecPolicy::Sync) -> Connection {
         return on_nlmsgerr_event_.connect(std::move(slot), policy);
     }
 
+    /** @brief Connect a synchronous handler to lazily decoded link messages.
+     *
+     * The view points into the listener's receive buffer and is only valid
+     * for the duration of the call; call `materialize()` to keep a copy.
+     * Messages are decoded into owning events only when `connect_to_event`
+     * subscribers exist, so view-only consumers pay no per-message
+     * allocation or formatting. Group membership follows the connection as
+     * for `connect_to_event`.
+     */
+    auto connect_to_view(link_view_signal_t::slot_t&& slot) -> Connection;
+
+    /** @brief Connect a synchronous handler to lazily decoded address messages. */
+    auto connect_to_view(address_view_signal_t::slot_t&& slot,
+            uint8_t family = AF_UNSPEC) -> Connection;
+
+    /** @brief Connect a synchronous handler to lazily decoded route messages. */
+    auto connect_to_view(route_view_signal_t::slot_t&& slot, uint8_t family = AF_UNSPEC)
+            -> Connection;
+
+    /** @brief Connect a synchronous handler to lazily decoded neighbor messages. */
+    auto connect_to_view(neighbor_view_signal_t::slot_t&& slot,
+            uint8_t family = AF_UNSPEC) -> Connection;
+
+    /** @brief Join any RTNLGRP_* group and receive its raw messages.
+     *
+     * Gives access to groups without a typed event (e.g. RTNLGRP_NEXTHOP,
+     * which lies beyond the legacy 32-bit bind mask). The slot runs
+     * synchronously for every received message whose type has no typed
+     * handler; the header is only valid for the duration of the call.
+     *
+     * @param group RTNLGRP_* group number to join while connected.
+     * @param slot Handler for raw messages.
+     */
+    auto connect_to_group(uint32_t group, message_signal_t::slot_t&& slot) -> Connection;
+
 private:
     boost::asio::io_context& io_;
     SocketGuard socket_guard_;
@@ -108,22 +342,113 @@ private:
     neighbor_signal_t on_neighbor_event_;
     nlmsgerr_signal_t on_nlmsgerr_event_;
 
-    std::array<uint8_t, BUFFER_SIZE> buffer_{};
+    link_view_signal_t on_link_view_;
+    address_view_signal_t on_address_view_;
+    route_view_signal_t on_route_view_;
+    neighbor_view_signal_t on_neighbor_view_;
+    message_signal_t on_message_;
+
+    link_batch_signal_t on_link_batch_;
+    address_batch_signal_t on_address_batch_;
+    route_batch_signal_t on_route_batch_;
+    neighbor_batch_signal_t on_neighbor_batch_;
+
+    link_signal_t on_link_sharded_;
+    address_signal_t on_address_sharded_;
+    route_signal_t on_route_sharded_;
+    neighbor_signal_t on_neighbor_sharded_;
+
+    link_coalesced_signal_t on_link_coalesced_;
+    address_coalesced_signal_t on_address_coalesced_;
+    route_coalesced_signal_t on_route_coalesced_;
+    neighbor_coalesced_signal_t on_neighbor_coalesced_;
+
+    ReceiveBuffer buffer_;
+    ReceiveBatch batch_;
+    bool batched_;
+    bool resync_on_overrun_;
     std::atomic_uint32_t sequence_{1U};
     std::atomic_bool running_{false};
+    std::atomic_uint64_t overruns_{0U};
+
+    boost::asio::strand<boost::asio::io_context::executor_type> resync_strand_;
+    std::shared_ptr<Transport> resync_transport_;
+    std::shared_ptr<std::atomic_bool> alive_;
+    std::unordered_map<LinkKey, CompactLinkEvent> known_links_;
+    std::unordered_map<AddressKey, CompactAddressEvent> known_addresses_;
+    std::unordered_map<RouteKey, CompactRouteEvent> known_routes_;
+    std::unordered_map<NeighborKey, CompactNeighborEvent> known_neighbors_;
+
+    BatchOptions batch_options_;
+    std::mutex batch_mutex_;
+    boost::asio::steady_timer batch_timer_;
+    bool batch_timer_armed_{false};
+    std::vector<LinkEvent> link_batch_;
+    std::vector<AddressEvent> address_batch_;
+    std::vector<RouteEvent> route_batch_;
+    std::vector<NeighborEvent> neighbor_batch_;
+
+    ShardOptions shard_options_;
+    std::vector<boost::asio::strand<boost::asio::any_io_executor>> shards_;
+
+    CoalesceOptions coalesce_options_;
+    std::mutex coalesce_mutex_;
+    boost::asio::steady_timer coalesce_timer_;
+    bool coalesce_timer_armed_{false};
+    Coalescer<LinkKey, LinkEvent> link_coalescer_;
+    Coalescer<AddressKey, AddressEvent> address_coalescer_;
+    Coalescer<RouteKey, RouteEvent> route_coalescer_;
+    Coalescer<NeighborKey, NeighborEvent> neighbor_coalescer_;
+
+    mutable std::mutex filter_mutex_;
+    EventFilter filter_;
+
+    class GroupLease;
+    std::mutex groups_mutex_;
+    std::map<uint32_t, size_t> group_refs_;
 
     auto open_socket() -> std::expected<void, std::error_code>;
+    auto apply_filter(const EventFilter& filter) -> std::expected<void, std::error_code>;
+    auto lease_groups(std::vector<uint32_t> groups) -> std::shared_ptr<GroupLease>;
+    void join_groups(const std::vector<uint32_t>& groups);
+    void leave_groups(const std::vector<uint32_t>& groups);
     void request_read();
+    void handle_peek(const boost::system::error_code& ec, size_t pending);
+    void receive_datagram();
     void handle_read(const boost::system::error_code& ec, size_t bytes);
+    void handle_readable(const boost::system::error_code& ec);
+    void handle_receive_error(int error);
+    auto resync_after_loss() -> bool;
     void process_messages(std::span<const uint8_t> data);
 
     void handle_message(const nlmsghdr& header);
     void handle_error_message(const nlmsghdr& header);
 
+    template<typename Event>
+    void enqueue(std::vector<Event>& pending, Event&& event,
+            Dispatcher<void(std::span<const Event>)>& signal);
+    void schedule_batches();
+    void flush_batches();
+    template<typename Key, typename Event>
+    void coalesce(Coalescer<Key, Event>& coalescer, const Key& key, Event&& event);
+    void flush_coalesced();
+    template<typename Event>
+    void post_sharded(Event&& event, Dispatcher<void(const Event&)>& signal,
+            const std::function<size_t(const Event&)>& key);
+
     void handle_link_message(const nlmsghdr& header);
     void handle_address_message(const nlmsghdr& header);
     void handle_route_message(const nlmsghdr& header);
     void handle_neighbor_message(const nlmsghdr& header);
+
+    void start_resync(bool emit);
+    auto resync(std::shared_ptr<Transport> transport,
+            std::shared_ptr<std::atomic_bool> alive, bool emit, EventFilter filter)
+            -> boost::asio::awaitable<void>;
+    void track(const LinkEventView& view);
+    void track(const AddressEventView& view);
+    void track(const RouteEventView& view);
+    void track(const NeighborEventView& view);
 };
 
 } // namespace rtaco
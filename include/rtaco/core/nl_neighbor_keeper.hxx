@@ -0,0 +1,145 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <span>
+#include <unordered_map>
+
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/strand.hpp>
+
+#include "rtaco/core/nl_dispatcher.hxx"
+#include "rtaco/events/nl_neighbor_event.hxx"
+
+namespace llmx {
+namespace rtaco {
+
+class Control;
+class Listener;
+
+/** @brief Tuning knobs for `NeighborKeeper`. */
+struct NeighborKeeperOptions {
+    /** Maximum probes sent per second across all entries. */
+    uint32_t probes_per_second{200U};
+    /** Maximum probes awaiting a kernel ack at the same time. */
+    uint32_t max_outstanding{32U};
+    /** Minimum delay between two probes of the same entry. */
+    std::chrono::milliseconds min_reprobe_interval{std::chrono::milliseconds{500}};
+};
+
+/** @brief Keeps registered neighbor entries in the REACHABLE state.
+ *
+ * Callers register (ifindex, address) pairs. The keeper follows
+ * `NeighborEvent`s from a `Listener` and, whenever a registered entry turns
+ * STALE or DELAY (or FAILED / is deleted), queues an `NUD_PROBE` through
+ * `Control::async_probe_neighbor` so the kernel revalidates it before
+ * traffic hits an unresolved entry. Newly registered entries are probed
+ * once up front. Probes are drained in FIFO order at a fixed pace so
+ * thousands of entries aging together do not turn into a burst; an entry
+ * probed less than `min_reprobe_interval` ago waits aside until it is due
+ * instead of holding up the entries queued behind it.
+ *
+ * Addresses are 16 bytes; IPv4 neighbors use the IPv4-mapped form.
+ * All public members are thread-safe; internal state lives on a strand.
+ */
+class NeighborKeeper {
+public:
+    using address_t = std::array<uint8_t, 16>;
+
+    /** @brief Construct a keeper using `control` for probes and `listener` for events.
+     *
+     * Both referenced objects must outlive the keeper.
+     */
+    NeighborKeeper(boost::asio::io_context& io, Control& control, Listener& listener,
+            NeighborKeeperOptions options = {});
+
+    /** @brief Stop the keeper and disconnect from the listener. */
+    ~NeighborKeeper();
+
+    NeighborKeeper(const NeighborKeeper&) = delete;
+    NeighborKeeper& operator=(const NeighborKeeper&) = delete;
+    NeighborKeeper(NeighborKeeper&&) = delete;
+    NeighborKeeper& operator=(NeighborKeeper&&) = delete;
+
+    /** @brief Start following neighbor events and pacing probes. */
+    void start();
+
+    /** @brief Stop probing and drop queued work; registrations are kept. */
+    void stop();
+
+    /** @brief Register a neighbor to keep warm and schedule an initial probe. */
+    void add(uint16_t ifindex, std::span<const uint8_t, 16> address);
+
+    /** @brief Stop keeping the given neighbor warm. */
+    void remove(uint16_t ifindex, std::span<const uint8_t, 16> address);
+
+    /** @brief Number of registered entries. */
+    auto size() const noexcept -> size_t;
+
+    /** @brief Total probes handed to the kernel since construction. */
+    auto probes_sent() const noexcept -> uint64_t;
+
+    /** @brief Total probes rejected by the kernel since construction. */
+    auto probe_errors() const noexcept -> uint64_t;
+
+private:
+    struct Key {
+        uint16_t ifindex;
+        address_t address;
+
+        friend bool operator==(const Key&, const Key&) = default;
+    };
+
+    struct KeyHash {
+        auto operator()(const Key& key) const noexcept -> size_t;
+    };
+
+    struct Entry {
+        NeighborEvent::State state{NeighborEvent::State::NONE};
+        std::chrono::steady_clock::time_point last_probe{};
+        bool queued{false};
+    };
+
+    void on_neighbor_event(const NeighborEvent& event);
+    void update_state(const Key& key, NeighborEvent::Type type,
+            NeighborEvent::State state);
+    void enqueue(const Key& key);
+    auto pace_loop(uint64_t generation) -> boost::asio::awaitable<void>;
+    auto probe(Key key) -> boost::asio::awaitable<void>;
+
+    boost::asio::io_context& io_;
+    boost::asio::strand<boost::asio::io_context::executor_type> strand_;
+    Control& control_;
+    Listener& listener_;
+    NeighborKeeperOptions options_;
+
+    std::unordered_map<Key, Entry, KeyHash> entries_;
+    /** Entries that may be probed now, in the order they were queued. */
+    std::deque<Key> queue_;
+    /** Queued entries still inside `min_reprobe_interval`, by the time they
+     * join `queue_`. */
+    std::multimap<std::chrono::steady_clock::time_point, Key> deferred_;
+    /** Shared with the pace loop, which may outlive the keeper. */
+    std::shared_ptr<boost::asio::steady_timer> wakeup_;
+    Connection connection_;
+    std::shared_ptr<std::atomic_bool> alive_;
+
+    std::atomic_size_t size_{0U};
+    std::atomic_uint64_t probes_sent_{0U};
+    std::atomic_uint64_t probe_errors_{0U};
+    uint32_t outstanding_{0U};
+    /** Incremented by every start(); a pace loop of an older one exits. */
+    uint64_t generation_{0U};
+    bool running_{false};
+};
+
+} // namespace rtaco
+} // namespace llmx
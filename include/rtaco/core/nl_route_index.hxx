@@ -0,0 +1,150 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <linux/rtnetlink.h>
+
+#include "rtaco/events/nl_event_key.hxx"
+
+namespace llmx {
+namespace rtaco {
+
+/** @brief Tuning knobs for `RouteIndex`. */
+struct RouteIndexOptions {
+    /** Tables consulted in order, first match wins. The default mirrors the
+     * kernel's default policy rules (local, main, default); routes in other
+     * tables are ignored. */
+    std::vector<uint32_t> tables{RT_TABLE_LOCAL, RT_TABLE_MAIN, RT_TABLE_DEFAULT};
+};
+
+/** @brief Longest-prefix-match index over IPv4 and IPv6 routes.
+ *
+ * Each table holds one multibit trie per family with a stride of 8 bits,
+ * so a lookup reads at most 4 (IPv4) or 16 (IPv6) nodes. Nodes are
+ * compressed as in a poptrie: a 256-bit map marks the slots with a child
+ * and another marks where the best match changes, and popcount turns a slot
+ * into an index into dense child and match arrays. A full IPv4 table fits
+ * in a few megabytes.
+ *
+ * Among routes for the same prefix the lowest metric wins, as in the FIB.
+ * A throw route (RTN_THROW) takes part in the match like any other, but when
+ * it is the best one the lookup moves on to the next table. Cached clones
+ * and IPv6 source-specific routes are not indexed. The index is a plain
+ * value: lookups on a const index may run concurrently, updates need
+ * exclusive access.
+ */
+class RouteIndex {
+public:
+    /** @brief Construct an empty index. */
+    explicit RouteIndex(RouteIndexOptions options = {});
+
+    /** @brief Build an index from a compact route dump in one pass. */
+    explicit RouteIndex(std::span<const CompactRouteEvent> routes,
+            RouteIndexOptions options = {});
+
+    /** @brief Build an index from a route dump in one pass. */
+    explicit RouteIndex(const RouteEventList& routes, RouteIndexOptions options = {});
+
+    /** @brief Apply a route notification: NEW inserts or replaces the route
+     * with the same `RouteKey`, DELETE removes it. */
+    void update(const CompactRouteEvent& event);
+
+    /** @brief Apply a route notification. */
+    void update(const RouteEvent& event);
+
+    /** @brief Best route for `address`, or null if none matches.
+     *
+     * The pointer stays valid until the index is next modified. Check
+     * `route_type` before using the answer: unreachable, prohibit and
+     * blackhole routes are returned like unicast ones, where the kernel
+     * would fail the lookup or drop the packet. For a unicast route with a
+     * single next hop, `gateway` and `oif_index` match what the kernel picks
+     * under the default policy. Multipath routes carry their next hops in
+     * RTA_MULTIPATH, which is not indexed: they come back with no gateway
+     * and `oif_index` 0, and choosing among the next hops is left to the
+     * caller.
+     */
+    auto lookup(const IpAddress& address) const noexcept -> const CompactRouteEvent*;
+
+    /** @brief Look up every address of `addresses` into the matching slot of
+     * `results`, which must be at least as large. */
+    void lookup(std::span<const IpAddress> addresses,
+            std::span<const CompactRouteEvent*> results) const noexcept;
+
+    /** @brief Number of indexed routes. */
+    auto size() const noexcept -> size_t {
+        return ids_.size();
+    }
+
+    /** @brief Remove every route. */
+    void clear();
+
+private:
+    static constexpr uint32_t NONE = std::numeric_limits<uint32_t>::max();
+
+    using bitmap_t = std::array<uint64_t, 4>;
+
+    /** A prefix ending in a node: its top `bits` bits of the node's byte. */
+    struct Prefix {
+        uint8_t value;
+        uint8_t bits;
+        uint32_t priority;
+        uint32_t route;
+    };
+
+    struct Node {
+        bitmap_t child_bits{};
+        bitmap_t leaf_bits{};
+        // Children are stored next to each other from `child_base`, in slot
+        // order; `leaf_base` is NONE when no prefix ends in the node.
+        uint32_t child_base{NONE};
+        uint32_t leaf_base{NONE};
+    };
+
+    // Blocks of 1, 2, 4, ... 256 entries; a block holding `n` entries
+    // always has `std::bit_ceil(n)` of them.
+    using free_lists_t = std::array<std::vector<uint32_t>, 9>;
+
+    struct Trie {
+        std::vector<Node> nodes{Node{}};
+        // Prefixes ending in each node, parallel to `nodes`; only updates
+        // read them.
+        std::vector<std::vector<Prefix>> prefixes{1U};
+        std::vector<uint32_t> leaves;
+        free_lists_t free_nodes;
+        free_lists_t free_leaves;
+    };
+
+    struct Table {
+        uint32_t id;
+        Trie v4;
+        Trie v6;
+    };
+
+    auto trie_for(uint32_t table, uint8_t family) noexcept -> Trie*;
+    auto indexable(const CompactRouteEvent& event) const noexcept -> bool;
+    auto insert(const CompactRouteEvent& event, bool repaint_node) -> bool;
+    void erase(const CompactRouteEvent& event);
+    void repaint_all();
+
+    static auto child_or_create(Trie& trie, uint32_t node, uint8_t slot) -> uint32_t;
+    static void remove_child(Trie& trie, uint32_t node, uint8_t slot);
+    static void prune(Trie& trie, std::span<const std::pair<uint32_t, uint8_t>> path);
+    static void repaint(Trie& trie, uint32_t node);
+    static auto find(const Trie& trie, const IpAddress& address) noexcept -> uint32_t;
+
+    std::vector<Table> tables_;
+    std::vector<CompactRouteEvent> routes_;
+    std::vector<uint32_t> free_routes_;
+    std::unordered_map<RouteKey, uint32_t> ids_;
+};
+
+} // namespace rtaco
+} // namespace llmx
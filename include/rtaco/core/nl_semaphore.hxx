@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <expected>
+#include <memory>
+#include <system_error>
+#include <utility>
+
+#include <boost/asio/any_io_executor.hpp>
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/steady_timer.hpp>
+
+namespace llmx {
+namespace rtaco {
+
+/** @brief Counting semaphore for coroutines confined to a single strand.
+ *
+ * `Semaphore` hands out up to `capacity` permits and queues further
+ * acquirers in FIFO order. Waiters park on a `steady_timer` that is
+ * cancelled when a permit is handed over, the same wake-up technique the
+ * rest of the library uses for coroutine gating. All members must be used
+ * from the strand that owns the semaphore.
+ */
+class Semaphore {
+public:
+    /** @brief Construct a semaphore with the given number of permits. */
+    Semaphore(boost::asio::any_io_executor executor, size_t capacity) noexcept;
+
+    Semaphore(const Semaphore&) = delete;
+    Semaphore& operator=(const Semaphore&) = delete;
+    Semaphore(Semaphore&&) = delete;
+    Semaphore& operator=(Semaphore&&) = delete;
+
+    /** @brief Wait until a permit is available and take it.
+     *
+     * @return Expected void, or `operation_canceled` if `cancel()` was called
+     *         while waiting.
+     */
+    auto async_acquire() -> boost::asio::awaitable<std::expected<void, std::error_code>>;
+
+    /** @brief Take a permit if one is immediately available. */
+    auto try_acquire() noexcept -> bool;
+
+    /** @brief Return a permit, waking the oldest waiter if any. */
+    void release();
+
+    /** @brief Fail all current waiters with `operation_canceled`. */
+    void cancel();
+
+    /** @brief Change the number of permits; extra permits wake waiters. */
+    void set_capacity(size_t capacity);
+
+    /** @brief Number of permits that can currently be taken without waiting. */
+    auto available() const noexcept -> size_t;
+
+    /** @brief Number of coroutines currently queued for a permit. */
+    auto waiting() const noexcept -> size_t;
+
+private:
+    struct Waiter {
+        explicit Waiter(const boost::asio::any_io_executor& executor)
+            : timer{executor} {}
+
+        boost::asio::steady_timer timer;
+        bool granted{false};
+        bool cancelled{false};
+    };
+
+    boost::asio::any_io_executor executor_;
+    std::deque<std::shared_ptr<Waiter>> waiters_;
+    size_t capacity_;
+    size_t in_use_{0};
+};
+
+/** @brief RAII holder that releases a `Semaphore` permit on scope exit. */
+class SemaphorePermit {
+public:
+    SemaphorePermit() noexcept = default;
+
+    explicit SemaphorePermit(Semaphore& semaphore) noexcept
+        : semaphore_{&semaphore} {}
+
+    ~SemaphorePermit() {
+        reset();
+    }
+
+    SemaphorePermit(const SemaphorePermit&) = delete;
+    SemaphorePermit& operator=(const SemaphorePermit&) = delete;
+
+    SemaphorePermit(SemaphorePermit&& other) noexcept
+        : semaphore_{std::exchange(other.semaphore_, nullptr)} {}
+
+    SemaphorePermit& operator=(SemaphorePermit&& other) noexcept {
+        if (this != &other) {
+            reset();
+            semaphore_ = std::exchange(other.semaphore_, nullptr);
+        }
+        return *this;
+    }
+
+    /** @brief Release the held permit early. */
+    void reset() {
+        if (semaphore_ != nullptr) {
+            std::exchange(semaphore_, nullptr)->release();
+        }
+    }
+
+    /** @brief Drop the permit without returning it, for when the semaphore
+     * has already been destroyed. */
+    void abandon() noexcept {
+        semaphore_ = nullptr;
+    }
+
+private:
+    Semaphore* semaphore_{nullptr};
+};
+
+} // namespace rtaco
+} // namespace llmx
@@ -18,14 +18,11 @@
 #include <boost/signals2/connection.hpp>
 #include <boost/signals2/signal.hpp>
 
+#include "rtaco/core/nl_exec_policy.hxx"
+
 namespace llmx {
 namespace rtaco {
 
-enum class ExecPolicy {
-    Sync,
-    Async
-};
-
 namespace detail {
 
 template<typename T>
@@ -117,19 +114,21 @@ public:
                 .connect([slot_fn = std::move(slot_fn), policy, executor = executor_](
                                  Args... args) mutable -> future_t
         {
-            auto args_pack = std::make_shared<std::tuple<std::decay_t<Args>...>>(
-                    std::forward<Args>(args)...);
-
+            // Synchronous slots see the caller's arguments directly; only
+            // deferred execution needs its own copy.
             if (policy == ExecPolicy::Sync) {
                 if constexpr (std::is_void_v<R>) {
-                    std::apply(slot_fn, *args_pack);
+                    slot_fn(std::forward<Args>(args)...);
                     return detail::make_ready_shared_future();
                 } else {
                     return detail::make_ready_shared_future(
-                            std::apply(slot_fn, *args_pack));
+                            slot_fn(std::forward<Args>(args)...));
                 }
             }
 
+            auto args_pack = std::make_shared<std::tuple<std::decay_t<Args>...>>(
+                    std::forward<Args>(args)...);
+
             if constexpr (std::is_void_v<R>) {
                 auto coroutine =
                         [slot_fn, args_pack,
@@ -157,6 +156,11 @@ public:
         });
     }
 
+    /** @brief True when no slot is connected, so emitting would be a no-op. */
+    auto empty() const -> bool {
+        return signal_.empty();
+    }
+
     /** @brief Emit the signal and run all connected slots. */
     auto emit(Args... args) -> result_t {
         return signal_(std::forward<Args>(args)...);
@@ -0,0 +1,185 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/strand.hpp>
+
+#include "rtaco/core/nl_dispatcher.hxx"
+#include "rtaco/events/nl_event_key.hxx"
+
+namespace llmx {
+namespace rtaco {
+
+class Control;
+class Listener;
+
+/** @brief Immutable picture of the kernel's links, addresses and neighbors.
+ *
+ * A snapshot is never modified once built, so any number of threads may
+ * read it without locking. `apply` returns a new snapshot that shares
+ * every table the changes did not touch with this one.
+ */
+class StateSnapshot {
+public:
+    /** @brief Links by interface index, plus a name → index map. */
+    struct LinkTable {
+        std::unordered_map<int, CompactLinkEvent> by_index;
+        std::unordered_map<InterfaceName, int> by_name;
+    };
+
+    using AddressTable = std::unordered_map<AddressKey, CompactAddressEvent>;
+    using NeighborTable = std::unordered_map<NeighborKey, CompactNeighborEvent>;
+
+    /** @brief Construct an empty snapshot (generation 0). */
+    StateSnapshot();
+
+    /** @brief Number of change sets applied since the empty snapshot. */
+    auto generation() const noexcept -> uint64_t {
+        return generation_;
+    }
+
+    /** @brief Link with interface index `index`, or null. */
+    auto link(int index) const noexcept -> const CompactLinkEvent*;
+
+    /** @brief Link named `name`, or null. */
+    auto link(std::string_view name) const noexcept -> const CompactLinkEvent*;
+
+    /** @brief Name of interface `index`; empty if unknown. */
+    auto name_of(int index) const noexcept -> std::string_view;
+
+    /** @brief Index of the interface named `name`; 0 if unknown. */
+    auto index_of(std::string_view name) const noexcept -> int;
+
+    /** @brief Address entry identified by `key`, or null. */
+    auto address(const AddressKey& key) const noexcept -> const CompactAddressEvent*;
+
+    /** @brief Every address assigned to interface `index`. */
+    auto addresses_of(int index) const -> std::vector<CompactAddressEvent>;
+
+    /** @brief Neighbor entry for `address` on interface `index`, or null. */
+    auto neighbor(int index, const IpAddress& address) const noexcept
+            -> const CompactNeighborEvent*;
+
+    auto links() const noexcept -> const LinkTable& {
+        return *links_;
+    }
+
+    auto addresses() const noexcept -> const AddressTable& {
+        return *addresses_;
+    }
+
+    auto neighbors() const noexcept -> const NeighborTable& {
+        return *neighbors_;
+    }
+
+    /** @brief Set `event.oif` to the name of `event.oif_index`.
+     *
+     * @return False, leaving `event` untouched, if the index is unknown.
+     */
+    auto resolve(RouteEvent& event) const -> bool;
+
+    /** @brief Copy of this snapshot with link changes applied.
+     *
+     * Deleting a link also drops the addresses and neighbors left on it.
+     */
+    auto apply(std::span<const CompactLinkEvent> events) const
+            -> std::shared_ptr<const StateSnapshot>;
+
+    /** @brief Copy of this snapshot with address changes applied. */
+    auto apply(std::span<const CompactAddressEvent> events) const
+            -> std::shared_ptr<const StateSnapshot>;
+
+    /** @brief Copy of this snapshot with neighbor changes applied. */
+    auto apply(std::span<const CompactNeighborEvent> events) const
+            -> std::shared_ptr<const StateSnapshot>;
+
+private:
+    std::shared_ptr<const LinkTable> links_;
+    std::shared_ptr<const AddressTable> addresses_;
+    std::shared_ptr<const NeighborTable> neighbors_;
+    uint64_t generation_{0U};
+};
+
+/** @brief Library-maintained mirror of links, addresses and neighbors.
+ *
+ * `start()` subscribes to the listener's batch signals first and then
+ * dumps the three tables through `control`; changes that arrive while the
+ * dumps run are replayed on top of them, so nothing is lost in between.
+ * From then on every listener batch becomes one new `StateSnapshot`,
+ * published with an atomic store. Readers call `snapshot()` from any
+ * thread and keep the returned pointer for as long as they need a
+ * consistent view; they never block the writer or each other.
+ *
+ * Enable `ListenerOptions::resync_on_overrun` to keep the mirror exact
+ * across receive buffer overruns.
+ */
+class StateMirror {
+public:
+    /** @brief Construct a mirror fed by `listener` and seeded through `control`.
+     *
+     * Both referenced objects must outlive the mirror.
+     */
+    StateMirror(boost::asio::io_context& io, Control& control, Listener& listener);
+
+    /** @brief Disconnect from the listener. */
+    ~StateMirror();
+
+    StateMirror(const StateMirror&) = delete;
+    StateMirror& operator=(const StateMirror&) = delete;
+    StateMirror(StateMirror&&) = delete;
+    StateMirror& operator=(StateMirror&&) = delete;
+
+    /** @brief Subscribe to the listener and seed the mirror from dumps. */
+    void start();
+
+    /** @brief Stop following the listener; the last snapshot stays readable. */
+    void stop();
+
+    /** @brief Whether the initial dumps have been applied. */
+    auto ready() const noexcept -> bool;
+
+    /** @brief Current snapshot; never null. */
+    auto snapshot() const noexcept -> std::shared_ptr<const StateSnapshot>;
+
+    /** @brief Shortcut for `snapshot()->resolve(event)`. */
+    auto resolve(RouteEvent& event) const -> bool;
+
+private:
+    template<typename Compact>
+    void on_changes(std::vector<Compact> events);
+    auto seed() -> boost::asio::awaitable<void>;
+    void publish(std::shared_ptr<const StateSnapshot> next);
+
+    boost::asio::io_context& io_;
+    boost::asio::strand<boost::asio::io_context::executor_type> strand_;
+    Control& control_;
+    Listener& listener_;
+
+    Connection link_connection_;
+    Connection address_connection_;
+    Connection neighbor_connection_;
+
+    std::atomic<std::shared_ptr<const StateSnapshot>> snapshot_;
+    std::atomic_bool ready_{false};
+
+    // Strand-only: the snapshot being built on and changes held back until
+    // the seed dumps are in.
+    std::shared_ptr<const StateSnapshot> current_;
+    std::vector<CompactLinkEvent> pending_links_;
+    std::vector<CompactAddressEvent> pending_addresses_;
+    std::vector<CompactNeighborEvent> pending_neighbors_;
+    bool seeding_{false};
+
+    std::shared_ptr<bool> alive_;
+};
+
+} // namespace rtaco
+} // namespace llmx
@@ -0,0 +1,207 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <functional>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <system_error>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/asio/any_io_executor.hpp>
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/steady_timer.hpp>
+
+#include <linux/netlink.h>
+
+#include "rtaco/core/nl_semaphore.hxx"
+#include "rtaco/socket/nl_receive_buffer.hxx"
+#include "rtaco/socket/nl_socket_guard.hxx"
+
+namespace llmx {
+namespace rtaco {
+
+/** @brief Multiplexing request transport over one persistent netlink socket.
+ *
+ * `Transport` keeps a single long-lived request socket (bound without any
+ * multicast groups) and lets many request/response transactions share it.
+ * Each transaction registers its `nlmsg_seq`; a single reader coroutine
+ * receives datagrams and routes every message to the transaction that owns
+ * its sequence number, so replies for concurrently running requests never
+ * have to wait for each other.
+ *
+ * The kernel allows only one dump per netlink socket at a time, so requests
+ * carrying `NLM_F_DUMP` are admitted one by one while non-dump requests
+ * (get/probe/flush) are pipelined alongside them. The number of transactions
+ * in flight is bounded by a window: replies that do not fit into the socket
+ * receive buffer are dropped by the kernel, so an unbounded pipeline would
+ * lose answers under load.
+ *
+ * A dump datagram can carry hundreds of messages. With a `time_slice` set,
+ * the reader reposts itself whenever a datagram has taken that long so far,
+ * so other coroutines sharing the thread are not held up for all of it.
+ *
+ * All members must be used from the executor passed at construction, which
+ * is expected to be a strand when the io_context runs on several threads.
+ */
+class Transport {
+public:
+    static constexpr size_t DEFAULT_MAX_IN_FLIGHT = 64U;
+
+    /** @brief Most acked messages to keep outstanding at once.
+     *
+     * The kernel queues one ack per message while it processes a datagram,
+     * and the request socket silently drops what does not fit its 64 KiB
+     * receive buffer (about 150 acks). Writers packing many messages per
+     * datagram stay below this.
+     */
+    static constexpr size_t MAX_UNACKED = 128U;
+
+    /** @brief Per-message callback; returns true once the transaction is complete. */
+    using message_handler_t = std::function<bool(const nlmsghdr&)>;
+
+    /** @brief Called after the last message of a received datagram was handled. */
+    using batch_handler_t = std::function<void()>;
+
+    /** @brief Construct a transport for the given executor.
+     *
+     * @param io io_context the underlying socket is registered with.
+     * @param executor Executor (usually a strand) that serializes the transport.
+     * @param label Label used for socket diagnostics.
+     * @param max_in_flight Maximum number of transactions awaiting replies.
+     * @param receive_buffer Sizing of the reply buffer.
+     * @param time_slice Longest the reader handles one datagram before other
+     *        work on the executor gets a turn; zero handles it in one go.
+     */
+    Transport(boost::asio::io_context& io, boost::asio::any_io_executor executor,
+            std::string_view label, size_t max_in_flight = DEFAULT_MAX_IN_FLIGHT,
+            ReceiveBufferOptions receive_buffer = {},
+            std::chrono::steady_clock::duration time_slice = {}) noexcept;
+
+    ~Transport();
+
+    Transport(const Transport&) = delete;
+    Transport& operator=(const Transport&) = delete;
+    Transport(Transport&&) = delete;
+    Transport& operator=(Transport&&) = delete;
+
+    /** @brief Access the guard owning the transport socket. */
+    auto socket_guard() noexcept -> SocketGuard&;
+
+    /** @brief Executor every member must be used from. */
+    auto get_executor() const noexcept -> const boost::asio::any_io_executor& {
+        return executor_;
+    }
+
+    /** @brief Send a request and feed every reply to `handler`.
+     *
+     * The request header's `nlmsg_seq` identifies the transaction. The
+     * awaitable completes when `handler` returns true, or with an error when
+     * the socket fails or the transport is stopped. A reply datagram
+     * exceeding the receive buffer's maximum size fails every outstanding
+     * transaction with `std::errc::message_size`.
+     *
+     * `request` may pack several messages with distinct sequence numbers;
+     * they are sent in one datagram, take one slot of the window, and the
+     * replies to all of them reach `handler`.
+     *
+     * @param request Serialized messages, each starting with an `nlmsghdr`.
+     * @param handler Callback invoked for each reply carrying the sequence.
+     * @param on_batch Optional callback invoked once per received datagram
+     *        that carried replies for this transaction, while it is still
+     *        incomplete.
+     * @return Expected void or the transport error.
+     */
+    auto async_transact(std::span<const uint8_t> request, message_handler_t handler,
+            batch_handler_t on_batch = {})
+            -> boost::asio::awaitable<std::expected<void, std::error_code>>;
+
+    /** @brief Send messages that are only answered when they fail.
+     *
+     * For writes sent without `NLM_F_ACK`: the kernel replies to those only
+     * with an error. `request` must end with a message that does ask for an
+     * ack (a barrier); the kernel processes a datagram in order, so that ack
+     * arrives after every error the datagram produced. `handler` gets each
+     * of those replies and returns true on the barrier's ack.
+     *
+     * Unlike `async_transact`, the awaitable completes as soon as the request
+     * is sent. Posted messages awaiting their barrier count against
+     * `MAX_UNACKED`, so a post first waits until enough of them have
+     * settled; a reply that does not fit the socket buffer would be lost.
+     *
+     * @param request Serialized messages ending with the barrier; at most
+     *        `MAX_UNACKED` of them and no dump.
+     * @param handler Callback invoked for each reply carrying the sequence.
+     * @return Expected void once sent, or the transport error.
+     */
+    auto async_post(std::span<const uint8_t> request, message_handler_t handler)
+            -> boost::asio::awaitable<std::expected<void, std::error_code>>;
+
+    /** @brief Number of transactions currently waiting for replies. */
+    auto pending() const noexcept -> size_t;
+
+    /** @brief Fail all outstanding transactions and close the socket. */
+    void stop();
+
+private:
+    struct Transaction {
+        Transaction(const boost::asio::any_io_executor& executor,
+                message_handler_t&& message_handler, batch_handler_t&& batch_handler)
+            : handler{std::move(message_handler)}
+            , on_batch{std::move(batch_handler)}
+            , wakeup{executor} {}
+
+        message_handler_t handler;
+        batch_handler_t on_batch;
+        std::vector<uint32_t> sequences;
+        /** Messages counted against `MAX_UNACKED` until the transaction settles. */
+        size_t posted{0};
+        boost::asio::steady_timer wakeup;
+        std::error_code error{};
+        bool done{false};
+    };
+
+    using transaction_ptr = std::shared_ptr<Transaction>;
+
+    /** @brief Record the sequences of `request`; returns false if it has none. */
+    static auto parse(std::span<const uint8_t> request, Transaction& transaction,
+            bool& dump) -> bool;
+
+    auto enlist(const transaction_ptr& transaction)
+            -> std::expected<void, std::error_code>;
+    auto send(std::span<const uint8_t> request)
+            -> boost::asio::awaitable<std::expected<void, std::error_code>>;
+    void ensure_reader();
+    auto read_loop() -> boost::asio::awaitable<void>;
+    void dispatch(const nlmsghdr& header);
+    void unregister(const transaction_ptr& transaction);
+    void complete(const transaction_ptr& transaction, std::error_code error);
+    void settle(Transaction& transaction);
+    void fail_all(std::error_code error);
+
+    boost::asio::any_io_executor executor_;
+    SocketGuard socket_guard_;
+    Semaphore dump_gate_;
+    Semaphore window_;
+    std::unordered_map<uint32_t, transaction_ptr> pending_;
+    ReceiveBuffer buffer_;
+    std::vector<transaction_ptr> batch_;
+    std::chrono::steady_clock::duration time_slice_;
+    boost::asio::steady_timer post_room_;
+    size_t posted_{0};
+    uint64_t stops_{0};
+    /** Set when the socket may still carry an unfinished dump. */
+    bool stale_{false};
+    /** Incremented whenever a stale socket is replaced. */
+    uint64_t generation_{0};
+    std::shared_ptr<bool> alive_;
+    bool reading_{false};
+};
+
+} // namespace rtaco
+} // namespace llmx
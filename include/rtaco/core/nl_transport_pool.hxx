@@ -0,0 +1,145 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <expected>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <boost/asio/any_io_executor.hpp>
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/io_context.hpp>
+
+#include "rtaco/core/nl_semaphore.hxx"
+#include "rtaco/core/nl_transport.hxx"
+#include "rtaco/socket/nl_receive_buffer.hxx"
+
+namespace llmx {
+namespace rtaco {
+
+/** @brief Sizing of a `TransportPool`. */
+struct TransportPoolOptions {
+    /** Most sockets the pool opens; further acquirers wait for a lease. */
+    size_t max_sockets{4U};
+    /** Window of each pooled transport. */
+    size_t max_in_flight{Transport::DEFAULT_MAX_IN_FLIGHT};
+    /** Reply buffer of each pooled transport. */
+    ReceiveBufferOptions receive_buffer{};
+    /** Time slice of each pooled transport's reader; zero means no limit. */
+    std::chrono::steady_clock::duration time_slice{};
+};
+
+/** @brief Capped set of request transports handed out one caller at a time.
+ *
+ * The kernel runs one dump per netlink socket, so dumps sharing a socket
+ * queue behind each other. A pool keeps up to `max_sockets` persistent
+ * request sockets, each bound without multicast groups, and leases each to
+ * one caller at a time. Sockets are opened on first use and reused
+ * afterwards; one left with an unfinished dump is replaced before its next
+ * request (see `Transport`).
+ *
+ * Every transport runs on a strand of its own, so leased transports make
+ * progress in parallel when the io_context runs on several threads; use a
+ * transport from its `get_executor()`. All members of the pool, and the
+ * destruction of leases, must run on the executor passed at construction.
+ * Leases must not outlive the pool.
+ */
+class TransportPool {
+public:
+    /** @brief Exclusive use of one pooled transport until destroyed. */
+    class Lease {
+    public:
+        Lease() noexcept = default;
+
+        ~Lease() {
+            reset();
+        }
+
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+
+        Lease(Lease&& other) noexcept
+            : pool_{std::exchange(other.pool_, nullptr)}
+            , transport_{std::exchange(other.transport_, nullptr)} {}
+
+        Lease& operator=(Lease&& other) noexcept {
+            if (this != &other) {
+                reset();
+                pool_ = std::exchange(other.pool_, nullptr);
+                transport_ = std::exchange(other.transport_, nullptr);
+            }
+            return *this;
+        }
+
+        auto transport() const noexcept -> Transport& {
+            return *transport_;
+        }
+
+        /** @brief Return the transport to the pool early. */
+        void reset();
+
+    private:
+        friend class TransportPool;
+
+        Lease(TransportPool& pool, Transport& transport) noexcept
+            : pool_{&pool}
+            , transport_{&transport} {}
+
+        TransportPool* pool_{nullptr};
+        Transport* transport_{nullptr};
+    };
+
+    /** @brief Construct an empty pool; sockets are opened as leases need them.
+     *
+     * @param io io_context the sockets are registered with.
+     * @param executor Executor (usually a strand) serializing the pool.
+     * @param label Label used for socket diagnostics.
+     * @param options Socket cap and per-transport sizing.
+     */
+    TransportPool(boost::asio::io_context& io, boost::asio::any_io_executor executor,
+            std::string_view label, TransportPoolOptions options = {}) noexcept;
+
+    ~TransportPool();
+
+    TransportPool(const TransportPool&) = delete;
+    TransportPool& operator=(const TransportPool&) = delete;
+    TransportPool(TransportPool&&) = delete;
+    TransportPool& operator=(TransportPool&&) = delete;
+
+    /** @brief Wait for a free transport and lease it.
+     *
+     * @return The lease, or `operation_canceled` once the pool is stopped.
+     */
+    auto async_acquire() -> boost::asio::awaitable<std::expected<Lease, std::error_code>>;
+
+    /** @brief Number of transports created so far. */
+    auto size() const noexcept -> size_t {
+        return transports_.size();
+    }
+
+    /** @brief Number of created transports not currently leased. */
+    auto idle() const noexcept -> size_t {
+        return idle_.size();
+    }
+
+    /** @brief Fail waiting acquirers and stop every transport on its strand. */
+    void stop();
+
+private:
+    void release(Transport& transport);
+
+    boost::asio::io_context& io_;
+    boost::asio::any_io_executor executor_;
+    std::string label_;
+    TransportPoolOptions options_;
+    Semaphore slots_;
+    std::vector<std::shared_ptr<Transport>> transports_;
+    std::vector<Transport*> idle_;
+};
+
+} // namespace rtaco
+} // namespace llmx
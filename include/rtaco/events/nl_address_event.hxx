@@ -1,11 +1,19 @@
 #pragma once
 
 #include <cstdint>
+#include <functional>
+#include <memory_resource>
+#include <span>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <vector>
 
+#include <linux/if_addr.h>
 #include <linux/rtnetlink.h>
 
+#include "rtaco/core/nl_address.hxx"
+#include "rtaco/core/nl_attribute_index.hxx"
 #include "rtaco/core/nl_utils.hxx"
 
 struct nlmsghdr;
@@ -37,14 +45,35 @@ struct AddressEvent {
         STABLE_PRIVACY = (1u << 11), // 0x800
     };
 
+    using allocator_type = std::pmr::polymorphic_allocator<>;
+
+    AddressEvent() = default;
+    AddressEvent(const AddressEvent&) = default;
+    AddressEvent(AddressEvent&&) noexcept = default;
+    AddressEvent& operator=(const AddressEvent&) = default;
+    AddressEvent& operator=(AddressEvent&&) = default;
+
+    /** @brief Construct an empty event whose strings allocate from `allocator`. */
+    explicit AddressEvent(const allocator_type& allocator) noexcept;
+
+    /** @brief Allocator-extended copy, used by pmr containers. */
+    AddressEvent(const AddressEvent& other, const allocator_type& allocator);
+
+    /** @brief Allocator-extended move; steals storage when allocators match. */
+    AddressEvent(AddressEvent&& other, const allocator_type& allocator);
+
+    auto get_allocator() const noexcept -> allocator_type {
+        return address.get_allocator();
+    }
+
     Type type{Type::UNKNOWN};
     int index{0};
     uint8_t prefix_len{0};
     uint8_t scope{0};
     Flags flags{Flags::NONE};
     uint8_t family{0};
-    std::string address{};
-    std::string label{};
+    std::pmr::string address{};
+    std::pmr::string label{};
 
     /** @brief Construct an AddressEvent from a netlink message header.
      *
@@ -54,13 +83,138 @@ struct AddressEvent {
      * @param header The netlink message header to parse.
      * @return Parsed AddressEvent.
      */
-    static auto from_nlmsghdr(const nlmsghdr& header) -> AddressEvent;
+    static auto from_nlmsghdr(const nlmsghdr& header,
+            const allocator_type& allocator = {}) -> AddressEvent;
+};
+
+/** @brief Fixed-size, trivially copyable form of `AddressEvent`.
+ *
+ * Carries the same information without heap storage: the address and label
+ * are kept inline and are only formatted on demand by `to_event()`. Lists of
+ * compact events can be copied with memcpy, sorted and hashed without
+ * touching the allocator.
+ */
+struct CompactAddressEvent {
+    AddressEvent::Type type{AddressEvent::Type::UNKNOWN};
+    int index{0};
+    uint8_t prefix_len{0};
+    uint8_t scope{0};
+    uint8_t family{0};
+    AddressEvent::Flags flags{AddressEvent::Flags::NONE};
+    IpAddress address{};
+    InterfaceName label{};
+
+    /** @brief Decode a address message without allocating. */
+    static auto from_nlmsghdr(const nlmsghdr& header) noexcept -> CompactAddressEvent;
+
+    /** @brief Format into an owning `AddressEvent` allocating from `allocator`. */
+    auto to_event(const AddressEvent::allocator_type& allocator = {}) const
+            -> AddressEvent;
+
+    /** @brief Parse an owning `AddressEvent` back into the compact layout. */
+    static auto from_event(const AddressEvent& event) noexcept -> CompactAddressEvent;
+
+    friend auto operator<=>(const CompactAddressEvent&,
+            const CompactAddressEvent&) = default;
+};
+
+static_assert(std::is_trivially_copyable_v<CompactAddressEvent>);
+
+/** @brief Non-owning, lazily decoded view of an address message.
+ *
+ * Reads `ifaddrmsg` fields directly and looks attributes up through an
+ * offset index built on first access. Valid only while the underlying
+ * receive buffer is; `materialize()` yields an owning `AddressEvent`.
+ */
+class AddressEventView {
+public:
+    /** @brief Wrap an address message; `type()` is UNKNOWN if it is not one. */
+    explicit AddressEventView(const nlmsghdr& header) noexcept;
+
+    auto header() const noexcept -> const nlmsghdr& {
+        return *header_;
+    }
+
+    auto type() const noexcept -> AddressEvent::Type {
+        return type_;
+    }
+
+    auto index() const noexcept -> int {
+        return static_cast<int>(info_.ifa_index);
+    }
+
+    auto prefix_len() const noexcept -> uint8_t {
+        return info_.ifa_prefixlen;
+    }
+
+    auto scope() const noexcept -> uint8_t {
+        return info_.ifa_scope;
+    }
+
+    auto flags() const noexcept -> AddressEvent::Flags {
+        return static_cast<AddressEvent::Flags>(info_.ifa_flags);
+    }
+
+    auto family() const noexcept -> uint8_t {
+        return info_.ifa_family;
+    }
+
+    /** @brief Printable address, IFA_LOCAL if present, IFA_ADDRESS otherwise. */
+    auto address() const -> std::string;
+
+    /** @brief Address label pointing into the message (IFA_LABEL). */
+    auto label() const noexcept -> std::string_view;
+
+    /** @brief Raw payload of attribute `type` (IFA_*), empty if absent. */
+    auto attribute(uint16_t type) const noexcept -> std::span<const uint8_t> {
+        return index_.payload(*header_, type);
+    }
+
+    /** @brief Decode every field into an owning `AddressEvent`.
+     *
+     * @param allocator Allocator for the event's strings.
+     */
+    auto materialize(const AddressEvent::allocator_type& allocator = {}) const
+            -> AddressEvent;
+
+    /** @brief Decode every field into a `CompactAddressEvent` without allocating. */
+    auto compact() const noexcept -> CompactAddressEvent;
+
+private:
+    const nlmsghdr* header_;
+    AddressEvent::Type type_{AddressEvent::Type::UNKNOWN};
+    ifaddrmsg info_{};
+    AttributeIndex<ifaddrmsg, IFA_MAX> index_{};
 };
 
 using AddressEventList = std::pmr::vector<AddressEvent>;
+using CompactAddressEventList = std::pmr::vector<CompactAddressEvent>;
+
+/** @brief Callback receiving one receive batch of a streamed address dump. */
+using AddressEventChunkHandler = std::function<void(std::span<const AddressEvent>)>;
+
+/** @brief Callback receiving each address of a dump as a view into the reply. */
+using AddressEventViewHandler = std::function<void(const AddressEventView&)>;
 
 template<>
 struct enable_bitmask_operators<AddressEvent::Flags> : std::true_type {};
 
 } // namespace rtaco
 } // namespace llmx
+
+template<>
+struct std::hash<llmx::rtaco::CompactAddressEvent> {
+    auto operator()(const llmx::rtaco::CompactAddressEvent& event) const noexcept
+            -> size_t {
+        size_t seed = 0U;
+        llmx::rtaco::hash_combine(seed, event.type);
+        llmx::rtaco::hash_combine(seed, event.index);
+        llmx::rtaco::hash_combine(seed, event.prefix_len);
+        llmx::rtaco::hash_combine(seed, event.scope);
+        llmx::rtaco::hash_combine(seed, event.family);
+        llmx::rtaco::hash_combine(seed, event.flags);
+        llmx::rtaco::hash_combine(seed, event.address);
+        llmx::rtaco::hash_combine(seed, event.label);
+        return seed;
+    }
+};
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+#include "rtaco/core/nl_address.hxx"
+#include "rtaco/events/nl_address_event.hxx"
+#include "rtaco/events/nl_link_event.hxx"
+#include "rtaco/events/nl_neighbor_event.hxx"
+#include "rtaco/events/nl_route_event.hxx"
+
+namespace llmx {
+namespace rtaco {
+
+/** @brief Identity of a kernel route: what a NEW replaces and a DELETE removes.
+ *
+ * Mirrors the FIB lookup key (table, destination prefix, source prefix for
+ * IPv6 source routing, and metric). Attributes such as the gateway or the
+ * output interface are part of the entry's value, not of its identity.
+ */
+struct RouteKey {
+    uint8_t family{0};
+    uint8_t dst_prefix_len{0};
+    uint8_t src_prefix_len{0};
+    uint32_t table{0};
+    uint32_t priority{0};
+    IpAddress dst{};
+    IpAddress src{};
+
+    static auto from(const CompactRouteEvent& event) noexcept -> RouteKey {
+        return RouteKey{event.family, event.dst_prefix_len, event.src_prefix_len,
+                event.table, event.priority, event.dst, event.src};
+    }
+
+    friend auto operator<=>(const RouteKey&, const RouteKey&) = default;
+};
+
+/** @brief Identity of a link: its interface index. */
+struct LinkKey {
+    int index{0};
+
+    static auto from(const CompactLinkEvent& event) noexcept -> LinkKey {
+        return LinkKey{event.index};
+    }
+
+    friend auto operator<=>(const LinkKey&, const LinkKey&) = default;
+};
+
+/** @brief Identity of an interface address: (ifindex, address, prefix). */
+struct AddressKey {
+    int index{0};
+    uint8_t prefix_len{0};
+    IpAddress address{};
+
+    static auto from(const CompactAddressEvent& event) noexcept -> AddressKey {
+        return AddressKey{event.index, event.prefix_len, event.address};
+    }
+
+    friend auto operator<=>(const AddressKey&, const AddressKey&) = default;
+};
+
+/** @brief Identity of a neighbor entry: (ifindex, protocol address). */
+struct NeighborKey {
+    int index{0};
+    IpAddress address{};
+
+    static auto from(const CompactNeighborEvent& event) noexcept -> NeighborKey {
+        return NeighborKey{event.index, event.address};
+    }
+
+    friend auto operator<=>(const NeighborKey&, const NeighborKey&) = default;
+};
+
+} // namespace rtaco
+} // namespace llmx
+
+template<>
+struct std::hash<llmx::rtaco::RouteKey> {
+    auto operator()(const llmx::rtaco::RouteKey& key) const noexcept -> size_t {
+        auto seed = std::hash<llmx::rtaco::IpAddress>{}(key.dst);
+        llmx::rtaco::hash_combine(seed, key.family);
+        llmx::rtaco::hash_combine(seed, key.dst_prefix_len);
+        llmx::rtaco::hash_combine(seed, key.table);
+        llmx::rtaco::hash_combine(seed, key.priority);
+        llmx::rtaco::hash_combine(seed, key.src);
+        llmx::rtaco::hash_combine(seed, key.src_prefix_len);
+        return seed;
+    }
+};
+
+template<>
+struct std::hash<llmx::rtaco::LinkKey> {
+    auto operator()(const llmx::rtaco::LinkKey& key) const noexcept -> size_t {
+        return std::hash<int>{}(key.index);
+    }
+};
+
+template<>
+struct std::hash<llmx::rtaco::AddressKey> {
+    auto operator()(const llmx::rtaco::AddressKey& key) const noexcept -> size_t {
+        auto seed = std::hash<llmx::rtaco::IpAddress>{}(key.address);
+        llmx::rtaco::hash_combine(seed, key.index);
+        llmx::rtaco::hash_combine(seed, key.prefix_len);
+        return seed;
+    }
+};
+
+template<>
+struct std::hash<llmx::rtaco::NeighborKey> {
+    auto operator()(const llmx::rtaco::NeighborKey& key) const noexcept -> size_t {
+        auto seed = std::hash<llmx::rtaco::IpAddress>{}(key.address);
+        llmx::rtaco::hash_combine(seed, key.index);
+        return seed;
+    }
+};
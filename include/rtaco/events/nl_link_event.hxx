@@ -1,11 +1,19 @@
 #pragma once
 
 #include <cstdint>
+#include <functional>
+#include <memory_resource>
+#include <span>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <vector>
 
+#include <linux/if_link.h>
 #include <linux/rtnetlink.h>
 
+#include "rtaco/core/nl_address.hxx"
+#include "rtaco/core/nl_attribute_index.hxx"
 #include "rtaco/core/nl_utils.hxx"
 
 struct nlmsghdr;
@@ -43,11 +51,32 @@ struct LinkEvent {
         ECHO = (1u << 18),       // 0x00040000
     };
 
+    using allocator_type = std::pmr::polymorphic_allocator<>;
+
+    LinkEvent() = default;
+    LinkEvent(const LinkEvent&) = default;
+    LinkEvent(LinkEvent&&) noexcept = default;
+    LinkEvent& operator=(const LinkEvent&) = default;
+    LinkEvent& operator=(LinkEvent&&) = default;
+
+    /** @brief Construct an empty event whose strings allocate from `allocator`. */
+    explicit LinkEvent(const allocator_type& allocator) noexcept;
+
+    /** @brief Allocator-extended copy, used by pmr containers. */
+    LinkEvent(const LinkEvent& other, const allocator_type& allocator);
+
+    /** @brief Allocator-extended move; steals storage when allocators match. */
+    LinkEvent(LinkEvent&& other, const allocator_type& allocator);
+
+    auto get_allocator() const noexcept -> allocator_type {
+        return name.get_allocator();
+    }
+
     Type type{Type::UNKNOWN};
     int index{0};
     Flags flags{Flags::UNKNOWN};
     uint32_t change{0};
-    std::string name{};
+    std::pmr::string name{};
 
     /** @brief Parse a LinkEvent from a netlink message header.
      *
@@ -56,13 +85,117 @@ struct LinkEvent {
      * @param header Netlink message header to parse.
      * @return Parsed LinkEvent object.
      */
-    static auto from_nlmsghdr(const nlmsghdr& header) -> LinkEvent;
+    static auto from_nlmsghdr(const nlmsghdr& header,
+            const allocator_type& allocator = {}) -> LinkEvent;
+};
+
+/** @brief Fixed-size, trivially copyable form of `LinkEvent`.
+ *
+ * Carries the same information without heap storage: the name is kept inline
+ * in an `IFNAMSIZ` buffer and are only formatted on demand by `to_event()`.
+ * Lists of compact events can be copied with memcpy, sorted and hashed
+ * without touching the allocator.
+ */
+struct CompactLinkEvent {
+    LinkEvent::Type type{LinkEvent::Type::UNKNOWN};
+    int index{0};
+    LinkEvent::Flags flags{LinkEvent::Flags::UNKNOWN};
+    uint32_t change{0};
+    InterfaceName name{};
+
+    /** @brief Decode a link message without allocating. */
+    static auto from_nlmsghdr(const nlmsghdr& header) noexcept -> CompactLinkEvent;
+
+    /** @brief Format into an owning `LinkEvent` allocating from `allocator`. */
+    auto to_event(const LinkEvent::allocator_type& allocator = {}) const -> LinkEvent;
+
+    /** @brief Parse an owning `LinkEvent` back into the compact layout. */
+    static auto from_event(const LinkEvent& event) noexcept -> CompactLinkEvent;
+
+    friend auto operator<=>(const CompactLinkEvent&, const CompactLinkEvent&) = default;
+};
+
+static_assert(std::is_trivially_copyable_v<CompactLinkEvent>);
+
+/** @brief Non-owning, lazily decoded view of a link message.
+ *
+ * Reads `ifinfomsg` fields directly and looks attributes up through an
+ * offset index built on first access. Valid only while the underlying
+ * receive buffer is; `materialize()` yields an owning `LinkEvent`.
+ */
+class LinkEventView {
+public:
+    /** @brief Wrap a link message; `type()` is UNKNOWN if it is not one. */
+    explicit LinkEventView(const nlmsghdr& header) noexcept;
+
+    auto header() const noexcept -> const nlmsghdr& {
+        return *header_;
+    }
+
+    auto type() const noexcept -> LinkEvent::Type {
+        return type_;
+    }
+
+    auto index() const noexcept -> int {
+        return info_.ifi_index;
+    }
+
+    auto flags() const noexcept -> LinkEvent::Flags {
+        return static_cast<LinkEvent::Flags>(info_.ifi_flags);
+    }
+
+    auto change() const noexcept -> uint32_t {
+        return info_.ifi_change;
+    }
+
+    /** @brief Interface name pointing into the message (IFLA_IFNAME). */
+    auto name() const noexcept -> std::string_view;
+
+    /** @brief Raw payload of attribute `type` (IFLA_*), empty if absent. */
+    auto attribute(uint16_t type) const noexcept -> std::span<const uint8_t> {
+        return index_.payload(*header_, type);
+    }
+
+    /** @brief Decode every field into an owning `LinkEvent`.
+     *
+     * @param allocator Allocator for the event's strings.
+     */
+    auto materialize(const LinkEvent::allocator_type& allocator = {}) const -> LinkEvent;
+
+    /** @brief Decode every field into a `CompactLinkEvent` without allocating. */
+    auto compact() const noexcept -> CompactLinkEvent;
+
+private:
+    const nlmsghdr* header_;
+    LinkEvent::Type type_{LinkEvent::Type::UNKNOWN};
+    ifinfomsg info_{};
+    AttributeIndex<ifinfomsg, IFLA_MAX> index_{};
 };
 
 using LinkEventList = std::pmr::vector<LinkEvent>;
+using CompactLinkEventList = std::pmr::vector<CompactLinkEvent>;
+
+/** @brief Callback receiving one receive batch of a streamed link dump. */
+using LinkEventChunkHandler = std::function<void(std::span<const LinkEvent>)>;
+
+/** @brief Callback receiving each link of a dump as a view into the reply. */
+using LinkEventViewHandler = std::function<void(const LinkEventView&)>;
 
 template<>
 struct enable_bitmask_operators<LinkEvent::Flags> : std::true_type {};
 
 } // namespace rtaco
 } // namespace llmx
+
+template<>
+struct std::hash<llmx::rtaco::CompactLinkEvent> {
+    auto operator()(const llmx::rtaco::CompactLinkEvent& event) const noexcept -> size_t {
+        size_t seed = 0U;
+        llmx::rtaco::hash_combine(seed, event.type);
+        llmx::rtaco::hash_combine(seed, event.index);
+        llmx::rtaco::hash_combine(seed, event.flags);
+        llmx::rtaco::hash_combine(seed, event.change);
+        llmx::rtaco::hash_combine(seed, event.name);
+        return seed;
+    }
+};
@@ -2,14 +2,21 @@
 
 #include <array>
 #include <cstdint>
+#include <functional>
+#include <memory_resource>
+#include <span>
 #include <string>
 #include <string_view>
 #include <utility>
+#include <type_traits>
 #include <vector>
 
 #include <linux/neighbour.h>
 #include <linux/rtnetlink.h>
 
+#include "rtaco/core/nl_address.hxx"
+#include "rtaco/core/nl_attribute_index.hxx"
+
 struct nlmsghdr;
 
 namespace llmx {
@@ -34,14 +41,35 @@ struct NeighborEvent {
         PERMANENT = NUD_PERMANENT,
     };
 
+    using allocator_type = std::pmr::polymorphic_allocator<>;
+
+    NeighborEvent() = default;
+    NeighborEvent(const NeighborEvent&) = default;
+    NeighborEvent(NeighborEvent&&) noexcept = default;
+    NeighborEvent& operator=(const NeighborEvent&) = default;
+    NeighborEvent& operator=(NeighborEvent&&) = default;
+
+    /** @brief Construct an empty event whose strings allocate from `allocator`. */
+    explicit NeighborEvent(const allocator_type& allocator) noexcept;
+
+    /** @brief Allocator-extended copy, used by pmr containers. */
+    NeighborEvent(const NeighborEvent& other, const allocator_type& allocator);
+
+    /** @brief Allocator-extended move; steals storage when allocators match. */
+    NeighborEvent(NeighborEvent&& other, const allocator_type& allocator);
+
+    auto get_allocator() const noexcept -> allocator_type {
+        return address.get_allocator();
+    }
+
     Type type{Type::UNKNOWN};
     int index{0};
     uint8_t family{0U};
     State state{State::NONE};
     uint8_t flags{0U};
     uint8_t neighbor_type{0U};
-    std::string address{};
-    std::string lladdr{};
+    std::pmr::string address{};
+    std::pmr::string lladdr{};
 
     /** @brief Convert the Neighbor state enum to a readable string.
      *
@@ -82,10 +110,135 @@ struct NeighborEvent {
     }
 
     /** @brief Parse a NeighborEvent from a netlink message header. */
-    static auto from_nlmsghdr(const nlmsghdr& header) -> NeighborEvent;
+    static auto from_nlmsghdr(const nlmsghdr& header,
+            const allocator_type& allocator = {}) -> NeighborEvent;
+};
+
+/** @brief Fixed-size, trivially copyable form of `NeighborEvent`.
+ *
+ * Carries the same information without heap storage: addresses are kept
+ * inline and are only formatted on demand by `to_event()`. Lists of compact
+ * events can be copied with memcpy, sorted and hashed without touching the
+ * allocator.
+ */
+struct CompactNeighborEvent {
+    NeighborEvent::Type type{NeighborEvent::Type::UNKNOWN};
+    int index{0};
+    uint8_t family{0U};
+    NeighborEvent::State state{NeighborEvent::State::NONE};
+    uint8_t flags{0U};
+    uint8_t neighbor_type{0U};
+    IpAddress address{};
+    LinkLayerAddress lladdr{};
+
+    /** @brief Decode a neighbor message without allocating. */
+    static auto from_nlmsghdr(const nlmsghdr& header) noexcept -> CompactNeighborEvent;
+
+    /** @brief Format into an owning `NeighborEvent` allocating from `allocator`. */
+    auto to_event(const NeighborEvent::allocator_type& allocator = {}) const
+            -> NeighborEvent;
+
+    /** @brief Parse an owning `NeighborEvent` back into the compact layout. */
+    static auto from_event(const NeighborEvent& event) noexcept -> CompactNeighborEvent;
+
+    friend auto operator<=>(const CompactNeighborEvent&,
+            const CompactNeighborEvent&) = default;
+};
+
+static_assert(std::is_trivially_copyable_v<CompactNeighborEvent>);
+
+/** @brief Non-owning, lazily decoded view of a neighbor message.
+ *
+ * Reads `ndmsg` fields directly and looks attributes up through an offset
+ * index built on first access. Valid only while the underlying receive
+ * buffer is; `materialize()` yields an owning `NeighborEvent`.
+ */
+class NeighborEventView {
+public:
+    /** @brief Wrap a neighbor message; `type()` is UNKNOWN if it is not one. */
+    explicit NeighborEventView(const nlmsghdr& header) noexcept;
+
+    auto header() const noexcept -> const nlmsghdr& {
+        return *header_;
+    }
+
+    auto type() const noexcept -> NeighborEvent::Type {
+        return type_;
+    }
+
+    auto index() const noexcept -> int {
+        return info_.ndm_ifindex;
+    }
+
+    auto family() const noexcept -> uint8_t {
+        return info_.ndm_family;
+    }
+
+    auto state() const noexcept -> NeighborEvent::State {
+        return static_cast<NeighborEvent::State>(info_.ndm_state);
+    }
+
+    auto flags() const noexcept -> uint8_t {
+        return info_.ndm_flags;
+    }
+
+    auto neighbor_type() const noexcept -> uint8_t {
+        return info_.ndm_type;
+    }
+
+    /** @brief Printable neighbor address (NDA_DST). */
+    auto address() const -> std::string;
+
+    /** @brief Printable link-layer address (NDA_LLADDR). */
+    auto lladdr() const -> std::string;
+
+    /** @brief Raw payload of attribute `type` (NDA_*), empty if absent. */
+    auto attribute(uint16_t type) const noexcept -> std::span<const uint8_t> {
+        return index_.payload(*header_, type);
+    }
+
+    /** @brief Decode every field into an owning `NeighborEvent`.
+     *
+     * @param allocator Allocator for the event's strings.
+     */
+    auto materialize(const NeighborEvent::allocator_type& allocator = {}) const
+            -> NeighborEvent;
+
+    /** @brief Decode every field into a `CompactNeighborEvent` without allocating. */
+    auto compact() const noexcept -> CompactNeighborEvent;
+
+private:
+    const nlmsghdr* header_;
+    NeighborEvent::Type type_{NeighborEvent::Type::UNKNOWN};
+    ndmsg info_{};
+    AttributeIndex<ndmsg, NDA_MAX> index_{};
 };
 
 using NeighborEventList = std::pmr::vector<NeighborEvent>;
+using CompactNeighborEventList = std::pmr::vector<CompactNeighborEvent>;
+
+/** @brief Callback receiving one receive batch of a streamed neighbor dump. */
+using NeighborEventChunkHandler = std::function<void(std::span<const NeighborEvent>)>;
+
+/** @brief Callback receiving each neighbor of a dump as a view into the reply. */
+using NeighborEventViewHandler = std::function<void(const NeighborEventView&)>;
 
 } // namespace rtaco
 } // namespace llmx
+
+template<>
+struct std::hash<llmx::rtaco::CompactNeighborEvent> {
+    auto operator()(const llmx::rtaco::CompactNeighborEvent& event) const noexcept
+            -> size_t {
+        size_t seed = 0U;
+        llmx::rtaco::hash_combine(seed, event.type);
+        llmx::rtaco::hash_combine(seed, event.index);
+        llmx::rtaco::hash_combine(seed, event.family);
+        llmx::rtaco::hash_combine(seed, event.state);
+        llmx::rtaco::hash_combine(seed, event.flags);
+        llmx::rtaco::hash_combine(seed, event.neighbor_type);
+        llmx::rtaco::hash_combine(seed, event.address);
+        llmx::rtaco::hash_combine(seed, event.lladdr);
+        return seed;
+    }
+};
@@ -1,11 +1,17 @@
 #pragma once
 
 #include <cstdint>
+#include <functional>
+#include <memory_resource>
+#include <span>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 #include <linux/rtnetlink.h>
 
+#include "rtaco/core/nl_address.hxx"
+#include "rtaco/core/nl_attribute_index.hxx"
 #include "rtaco/core/nl_utils.hxx"
 
 struct nlmsghdr;
@@ -33,6 +39,27 @@ struct RouteEvent {
         OFFLOAD_FAILED = (1u << 29), // 0x20000000 route offload failed
     };
 
+    using allocator_type = std::pmr::polymorphic_allocator<>;
+
+    RouteEvent() = default;
+    RouteEvent(const RouteEvent&) = default;
+    RouteEvent(RouteEvent&&) noexcept = default;
+    RouteEvent& operator=(const RouteEvent&) = default;
+    RouteEvent& operator=(RouteEvent&&) = default;
+
+    /** @brief Construct an empty event whose strings allocate from `allocator`. */
+    explicit RouteEvent(const allocator_type& allocator) noexcept;
+
+    /** @brief Allocator-extended copy, used by pmr containers. */
+    RouteEvent(const RouteEvent& other, const allocator_type& allocator);
+
+    /** @brief Allocator-extended move; steals storage when allocators match. */
+    RouteEvent(RouteEvent&& other, const allocator_type& allocator);
+
+    auto get_allocator() const noexcept -> allocator_type {
+        return dst.get_allocator();
+    }
+
     Type type{Type::UNKNOWN};
     uint8_t family{0};
     uint8_t dst_prefix_len{0};
@@ -44,23 +71,177 @@ struct RouteEvent {
     uint32_t table{0};
     uint32_t priority{0};
     uint32_t oif_index{0};
-    std::string dst{};
-    std::string src{};
-    std::string gateway{};
-    std::string prefsrc{};
-    std::string oif{};
+    std::pmr::string dst{};
+    std::pmr::string src{};
+    std::pmr::string gateway{};
+    std::pmr::string prefsrc{};
+    std::pmr::string oif{};
 
     /** @brief Parse a RouteEvent from a netlink message header.
      *
      * Extracts route attributes and fills a RouteEvent structure.
      */
-    static auto from_nlmsghdr(const nlmsghdr& header) -> RouteEvent;
+    static auto from_nlmsghdr(const nlmsghdr& header,
+            const allocator_type& allocator = {}) -> RouteEvent;
+};
+
+/** @brief Fixed-size, trivially copyable form of `RouteEvent`.
+ *
+ * Carries the same information without heap storage: addresses are kept
+ * inline with their family tag and are only formatted on demand by
+ * `to_event()`. Lists of compact events can be copied with memcpy, sorted
+ * and hashed without touching the allocator.
+ */
+struct CompactRouteEvent {
+    RouteEvent::Type type{RouteEvent::Type::UNKNOWN};
+    uint8_t family{0};
+    uint8_t dst_prefix_len{0};
+    uint8_t src_prefix_len{0};
+    uint8_t scope{0};
+    uint8_t protocol{0};
+    uint8_t route_type{0};
+    RouteEvent::Flags flags{RouteEvent::Flags::NONE};
+    uint32_t table{0};
+    uint32_t priority{0};
+    uint32_t oif_index{0};
+    IpAddress dst{};
+    IpAddress src{};
+    IpAddress gateway{};
+    IpAddress prefsrc{};
+
+    /** @brief Decode a route message without allocating. */
+    static auto from_nlmsghdr(const nlmsghdr& header) noexcept -> CompactRouteEvent;
+
+    /** @brief Format into an owning `RouteEvent` allocating from `allocator`. */
+    auto to_event(const RouteEvent::allocator_type& allocator = {}) const -> RouteEvent;
+
+    /** @brief Parse an owning `RouteEvent` back into the compact layout. */
+    static auto from_event(const RouteEvent& event) noexcept -> CompactRouteEvent;
+
+    friend auto operator<=>(const CompactRouteEvent&, const CompactRouteEvent&) = default;
+};
+
+static_assert(std::is_trivially_copyable_v<CompactRouteEvent>);
+
+/** @brief Non-owning, lazily decoded view of a route message.
+ *
+ * Fixed `rtmsg` fields are read directly; attributes are located through an
+ * offset index built on first access and decoded only when their accessor
+ * is called. The view points into the receive buffer and is valid only
+ * while that buffer is (e.g. for the duration of a synchronous slot). Use
+ * `materialize()` to obtain an owning `RouteEvent`.
+ */
+class RouteEventView {
+public:
+    /** @brief Wrap a route message; `type()` is UNKNOWN if it is not one. */
+    explicit RouteEventView(const nlmsghdr& header) noexcept;
+
+    auto header() const noexcept -> const nlmsghdr& {
+        return *header_;
+    }
+
+    auto type() const noexcept -> RouteEvent::Type {
+        return type_;
+    }
+
+    auto family() const noexcept -> uint8_t {
+        return info_.rtm_family;
+    }
+
+    auto dst_prefix_len() const noexcept -> uint8_t {
+        return info_.rtm_dst_len;
+    }
+
+    auto src_prefix_len() const noexcept -> uint8_t {
+        return info_.rtm_src_len;
+    }
+
+    auto scope() const noexcept -> uint8_t {
+        return info_.rtm_scope;
+    }
+
+    auto protocol() const noexcept -> uint8_t {
+        return info_.rtm_protocol;
+    }
+
+    auto route_type() const noexcept -> uint8_t {
+        return info_.rtm_type;
+    }
+
+    auto flags() const noexcept -> RouteEvent::Flags {
+        return static_cast<RouteEvent::Flags>(info_.rtm_flags);
+    }
+
+    /** @brief Routing table, preferring RTA_TABLE over the 8-bit header field. */
+    auto table() const noexcept -> uint32_t;
+    auto priority() const noexcept -> uint32_t;
+    auto oif_index() const noexcept -> uint32_t;
+
+    auto dst() const -> std::string;
+    auto src() const -> std::string;
+    auto gateway() const -> std::string;
+    auto prefsrc() const -> std::string;
+
+    /** @brief Raw payload of attribute `type` (RTA_*), empty if absent. */
+    auto attribute(uint16_t type) const noexcept -> std::span<const uint8_t> {
+        return index_.payload(*header_, type);
+    }
+
+    /** @brief Decode every field into an owning `RouteEvent`.
+     *
+     * @param allocator Allocator for the event's strings.
+     */
+    auto materialize(const RouteEvent::allocator_type& allocator = {}) const
+            -> RouteEvent;
+
+    /** @brief Decode every field into a `CompactRouteEvent` without allocating. */
+    auto compact() const noexcept -> CompactRouteEvent;
+
+private:
+    auto address(uint16_t type) const -> std::string;
+    auto uint32(uint16_t type) const noexcept -> uint32_t;
+
+    const nlmsghdr* header_;
+    RouteEvent::Type type_{RouteEvent::Type::UNKNOWN};
+    rtmsg info_{};
+    AttributeIndex<rtmsg, RTA_MAX> index_{};
 };
 
 using RouteEventList = std::pmr::vector<RouteEvent>;
+using CompactRouteEventList = std::pmr::vector<CompactRouteEvent>;
+
+/** @brief Callback receiving one receive batch of a streamed route dump. */
+using RouteEventChunkHandler = std::function<void(std::span<const RouteEvent>)>;
+
+/** @brief Callback receiving each route of a dump as a view into the reply. */
+using RouteEventViewHandler = std::function<void(const RouteEventView&)>;
 
 template<>
 struct enable_bitmask_operators<RouteEvent::Flags> : std::true_type {};
 
 } // namespace rtaco
 } // namespace llmx
+
+template<>
+struct std::hash<llmx::rtaco::CompactRouteEvent> {
+    auto operator()(const llmx::rtaco::CompactRouteEvent& event) const noexcept
+            -> size_t {
+        size_t seed = 0U;
+        llmx::rtaco::hash_combine(seed, event.type);
+        llmx::rtaco::hash_combine(seed, event.family);
+        llmx::rtaco::hash_combine(seed, event.dst_prefix_len);
+        llmx::rtaco::hash_combine(seed, event.src_prefix_len);
+        llmx::rtaco::hash_combine(seed, event.scope);
+        llmx::rtaco::hash_combine(seed, event.protocol);
+        llmx::rtaco::hash_combine(seed, event.route_type);
+        llmx::rtaco::hash_combine(seed, event.flags);
+        llmx::rtaco::hash_combine(seed, event.table);
+        llmx::rtaco::hash_combine(seed, event.priority);
+        llmx::rtaco::hash_combine(seed, event.oif_index);
+        llmx::rtaco::hash_combine(seed, event.dst);
+        llmx::rtaco::hash_combine(seed, event.src);
+        llmx::rtaco::hash_combine(seed, event.gateway);
+        llmx::rtaco::hash_combine(seed, event.prefsrc);
+        return seed;
+    }
+};
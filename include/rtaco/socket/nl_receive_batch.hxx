@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <span>
+#include <system_error>
+#include <vector>
+
+#include <sys/socket.h>
+
+#include "rtaco/socket/nl_receive_buffer.hxx"
+
+namespace llmx {
+namespace rtaco {
+
+/** @brief Ring of datagram buffers filled by a single `recvmmsg` call.
+ *
+ * Draining a burst of notifications one `recvmsg` at a time costs a
+ * syscall and a reactor round trip per datagram. `ReceiveBatch` instead
+ * receives up to `count` queued datagrams at once into equally sized slots.
+ *
+ * Every slot starts at `options.initial_size`. `recvmmsg` cannot peek, so a
+ * datagram larger than its slot is cut by the kernel; such a datagram is
+ * reported as `std::errc::message_size` and the slots are grown (up to
+ * `options.max_size`) before the next receive. Memory is allocated on the
+ * first receive.
+ */
+class ReceiveBatch {
+public:
+    /** @brief Construct a batch of `count` slots sized by `options`. */
+    ReceiveBatch(size_t count, ReceiveBufferOptions options = {}) noexcept;
+
+    /** @brief Number of slots, i.e. the most datagrams one receive can return. */
+    auto count() const noexcept -> size_t;
+
+    /** @brief Current size of each slot. */
+    auto slot_size() const noexcept -> size_t;
+
+    /** @brief Receive the datagrams already queued on `fd` without blocking.
+     *
+     * @param fd Native netlink socket handle.
+     * @return Number of datagrams received (at least one), or the socket
+     *         error; `std::errc::resource_unavailable_try_again` when
+     *         nothing was queued.
+     */
+    auto receive(int fd) -> std::expected<size_t, std::error_code>;
+
+    /** @brief Bytes of datagram `index` from the last receive.
+     *
+     * @return The datagram, or `std::errc::message_size` if it was cut.
+     */
+    auto datagram(size_t index) const
+            -> std::expected<std::span<const uint8_t>, std::error_code>;
+
+private:
+    void allocate(size_t slot_size);
+
+    size_t count_;
+    ReceiveBufferOptions options_;
+    size_t slot_size_{0U};
+    size_t wanted_slot_size_{0U};
+    std::vector<uint8_t> storage_;
+    std::vector<iovec> iovecs_;
+    std::vector<mmsghdr> headers_;
+};
+
+} // namespace rtaco
+} // namespace llmx
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <span>
+#include <system_error>
+#include <vector>
+
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/buffer.hpp>
+
+namespace llmx {
+namespace rtaco {
+
+class Socket;
+
+/** @brief Sizing of a `ReceiveBuffer`. */
+struct ReceiveBufferOptions {
+    /** Size allocated for the first receive. */
+    size_t initial_size{64U * 1024U};
+    /** Upper bound the buffer may grow to; larger datagrams are reported as
+     * truncated. */
+    size_t max_size{1024U * 1024U};
+};
+
+/** @brief Reusable datagram buffer that grows to fit the pending message.
+ *
+ * Netlink silently cuts a datagram that does not fit the buffer passed to
+ * recvmsg, and the cut-off tail would otherwise be parsed as garbage. Before
+ * each receive the buffer peeks the pending datagram length with
+ * `MSG_PEEK | MSG_TRUNC` and grows to fit, up to `max_size`. The receive
+ * itself also passes `MSG_TRUNC` so that a datagram which still does not fit
+ * is detected and reported as `std::errc::message_size`.
+ *
+ * Memory is allocated on the first receive, so a buffer that is never used
+ * costs nothing. Once the buffer has reached `max_size` the peek is skipped.
+ */
+class ReceiveBuffer {
+public:
+    explicit ReceiveBuffer(ReceiveBufferOptions options = {}) noexcept;
+
+    /** @brief Whether a peek could still make the buffer grow. */
+    auto needs_peek() const noexcept -> bool;
+
+    /** @brief Grow the buffer so that a datagram of `pending` bytes fits. */
+    void reserve(size_t pending);
+
+    /** @brief Whole buffer as a receive target (allocated on first use). */
+    auto buffer() -> boost::asio::mutable_buffer;
+
+    /** @brief Bytes currently allocated. */
+    auto capacity() const noexcept -> size_t;
+
+    /** @brief Validate a `MSG_TRUNC` receive length and return the payload.
+     *
+     * @param bytes Length reported by the receive (the full datagram size).
+     * @return The received bytes, or `std::errc::message_size` when the
+     *         datagram did not fit.
+     */
+    auto received(size_t bytes) const
+            -> std::expected<std::span<const uint8_t>, std::error_code>;
+
+    /** @brief Receive one whole datagram from `socket`.
+     *
+     * @return The datagram bytes (valid until the next receive), the socket
+     *         error, or `std::errc::message_size` on truncation.
+     */
+    auto async_receive(Socket& socket) -> boost::asio::awaitable<
+            std::expected<std::span<const uint8_t>, std::error_code>>;
+
+private:
+    ReceiveBufferOptions options_;
+    std::vector<uint8_t> storage_;
+};
+
+} // namespace rtaco
+} // namespace llmx
@@ -10,11 +10,13 @@
 
 #include <cstddef>
 #include <expected>
+#include <span>
 #include <string>
 #include <string_view>
 #include <system_error>
 #include <utility>
 
+#include <linux/filter.h>
 #include <linux/netlink.h>
 #include <stdint.h>
 #include <sys/socket.h>
@@ -91,6 +93,64 @@ public:
      */
     auto open(int proto, uint32_t groups) -> std::expected<void, std::error_code>;
 
+    /**
+     * @brief Choose whether receive buffer overruns are reported.
+     *
+     * `open` sets `NETLINK_NO_ENOBUFS`, so notifications that do not fit the
+     * receive buffer are dropped silently. With reporting enabled the next
+     * receive fails with ENOBUFS instead, telling the caller its view of
+     * kernel state is stale.
+     *
+     * @return std::expected<void, std::error_code> Empty on success or contains
+     *         the encountered error on failure.
+     */
+    auto set_overrun_reporting(bool enabled) -> std::expected<void, std::error_code>;
+
+    /**
+     * @brief Join a netlink multicast group by number.
+     *
+     * Unlike the bind-time mask this accepts any group, including those
+     * above 32 (e.g. RTNLGRP_NEXTHOP).
+     *
+     * @return std::expected<void, std::error_code> Empty on success or contains
+     *         the encountered error on failure.
+     */
+    auto join_group(uint32_t group) -> std::expected<void, std::error_code>;
+
+    /**
+     * @brief Leave a netlink multicast group joined with `join_group`.
+     *
+     * @return std::expected<void, std::error_code> Empty on success or contains
+     *         the encountered error on failure.
+     */
+    auto leave_group(uint32_t group) -> std::expected<void, std::error_code>;
+
+    /**
+     * @brief Install a classic BPF program that drops unwanted datagrams.
+     *
+     * Replaces any program attached before; the kernel swaps them
+     * atomically, so every datagram is checked by exactly one of them.
+     *
+     * @return std::expected<void, std::error_code> Empty on success or contains
+     *         the encountered error on failure.
+     */
+    auto attach_filter(std::span<const sock_filter> program)
+            -> std::expected<void, std::error_code>;
+
+    /**
+     * @brief Remove the program installed with `attach_filter`, if any.
+     *
+     * @return std::expected<void, std::error_code> Empty on success or contains
+     *         the encountered error on failure.
+     */
+    auto detach_filter() -> std::expected<void, std::error_code>;
+
+    /** @brief Discard every datagram already queued, without blocking.
+     *
+     * @return Number of datagrams dropped.
+     */
+    auto discard_pending() -> size_t;
+
     template<typename Option>
     void set_option(const Option& option, boost::system::error_code& ec) {
         socket_.set_option(option, ec);
@@ -113,12 +173,28 @@ public:
         return socket_.async_receive(buffers, std::forward<CompletionToken>(token));
     }
 
+    template<typename MutableBufferSequence, typename CompletionToken>
+    auto async_receive(const MutableBufferSequence& buffers,
+            socket_t::message_flags flags, CompletionToken&& token)
+            -> decltype(std::declval<socket_t>().async_receive(buffers, flags,
+                    std::forward<CompletionToken>(token))) {
+        return socket_.async_receive(buffers, flags,
+                std::forward<CompletionToken>(token));
+    }
+
     template<typename MutableBufferSequence>
     auto receive(const MutableBufferSequence& buffers, boost::system::error_code& ec)
             -> size_t {
         return socket_.receive(buffers, 0, ec);
     }
 
+    template<typename CompletionToken>
+    auto async_wait(socket_t::wait_type type, CompletionToken&& token)
+            -> decltype(std::declval<socket_t>().async_wait(type,
+                    std::forward<CompletionToken>(token))) {
+        return socket_.async_wait(type, std::forward<CompletionToken>(token));
+    }
+
     template<typename ConstBufferSequence, typename CompletionToken>
     auto async_send(const ConstBufferSequence& buffers, CompletionToken&& token)
             -> decltype(std::declval<socket_t>()
@@ -152,6 +228,12 @@ private:
     using no_enobufs_option =
             boost::asio::detail::socket_option::integer<SOL_NETLINK, NETLINK_NO_ENOBUFS>;
 
+    using add_membership_option = boost::asio::detail::socket_option::integer<SOL_NETLINK,
+            NETLINK_ADD_MEMBERSHIP>;
+
+    using drop_membership_option = boost::asio::detail::socket_option::integer<
+            SOL_NETLINK, NETLINK_DROP_MEMBERSHIP>;
+
     socket_t socket_;
     std::string label_;
 };
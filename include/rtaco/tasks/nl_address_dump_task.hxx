@@ -11,6 +11,7 @@
 #include <linux/netlink.h>
 
 #include "rtaco/events/nl_address_event.hxx"
+#include "rtaco/tasks/nl_dump_filter.hxx"
 #include "rtaco/tasks/nl_address_task.hxx"
 
 namespace llmx {
@@ -26,6 +27,9 @@ class SocketGuard;
  */
 class AddressDumpTask : public AddressTask<AddressDumpTask, AddressEventList> {
     AddressEventList learned_;
+    AddressEventChunkHandler on_chunk_;
+    AddressEventViewHandler on_view_;
+    AddressDumpFilter filter_;
 
 public:
     /** @brief Construct an AddressDumpTask.
@@ -42,6 +46,41 @@ public:
     /** @brief Prepare the netlink request to perform an address dump. */
     void prepare_request();
 
+    /** @brief Stream results to `on_chunk` instead of returning them.
+     *
+     * When set, events collected from each received datagram are handed to
+     * `on_chunk` and then discarded, so memory stays bounded by one batch;
+     * the list returned on completion is empty.
+     */
+    void set_chunk_handler(AddressEventChunkHandler on_chunk);
+
+    /** @brief Pass every matching entry to `on_view` instead of collecting it.
+     *
+     * The view is only valid during the call. Nothing is materialized, so
+     * callers can build their own representation (e.g. compact events)
+     * directly from the reply buffer.
+     */
+    void set_view_handler(AddressEventViewHandler on_view);
+
+    /** @brief Restrict the dump to entries matching `filter`.
+     *
+     * The filter is sent with the request so the kernel skips everything
+     * else; replies are checked against it again, which keeps the result
+     * right on kernels without strict dump checking.
+     */
+    void set_filter(AddressDumpFilter filter);
+
+    /** @brief Whether an entry falls inside what this dump reports.
+     *
+     * Lets consumers that mix dumps with notifications (e.g. a resync after
+     * an overrun) apply the same scope to both.
+     */
+    static auto in_scope(const AddressEventView& view,
+            const AddressDumpFilter& filter = {}) noexcept -> bool;
+
+    /** @brief Hand events collected so far to the chunk handler, if any. */
+    void flush_batch();
+
     /** @brief Process a received netlink message for address dump responses.
      *
      * @param header Reference to the received netlink message header.
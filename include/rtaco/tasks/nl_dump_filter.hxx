@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include <linux/rtnetlink.h>
+#include <sys/socket.h>
+
+namespace llmx {
+namespace rtaco {
+
+/** @brief Selects the routes a route dump returns.
+ *
+ * Sent as strict-check request fields and attributes (`rtm_family`,
+ * `rtm_table`/RTA_TABLE, `rtm_protocol`, `rtm_type`, RTA_OIF), so the kernel
+ * only walks and sends matching entries. Zero fields match anything.
+ */
+struct RouteDumpFilter {
+    /** AF_INET or AF_INET6; AF_UNSPEC dumps both. */
+    uint8_t family{AF_UNSPEC};
+    /** Table id, e.g. a VRF's table; RT_TABLE_UNSPEC dumps every table. */
+    uint32_t table{RT_TABLE_MAIN};
+    /** Output interface index; 0 also keeps routes without one (multipath,
+     * blackhole, unreachable, prohibit). */
+    uint32_t oif{0U};
+    /** Route origin (RTPROT_*). */
+    uint8_t protocol{RTPROT_UNSPEC};
+    /** Route type (RTN_*). */
+    uint8_t type{RTN_UNSPEC};
+};
+
+/** @brief Selects the addresses an address dump returns (`ifa_family`,
+ * `ifa_index`). Zero fields match anything. */
+struct AddressDumpFilter {
+    /** AF_INET or AF_INET6; AF_UNSPEC dumps both. */
+    uint8_t family{AF_UNSPEC};
+    /** Interface index. */
+    uint32_t index{0U};
+};
+
+/** @brief Selects the links a link dump returns (IFLA_MASTER, IFLA_LINKINFO).
+ *
+ * Link dumps cannot be narrowed to one ifindex; use the master device
+ * (e.g. a bridge or VRF) or the link kind instead. Empty fields match
+ * anything.
+ */
+struct LinkDumpFilter {
+    /** Index of the master device the links are enslaved to. */
+    uint32_t master{0U};
+    /** Link kind as in `ip link add type <kind>`, e.g. "veth" or "vrf". */
+    std::string kind{};
+};
+
+/** @brief Selects the entries a neighbor dump returns (`ndm_family`,
+ * NDA_IFINDEX, NDA_MASTER). Zero fields match anything. */
+struct NeighborDumpFilter {
+    /** AF_INET or AF_INET6; AF_UNSPEC dumps both. */
+    uint8_t family{AF_UNSPEC};
+    /** Interface index. */
+    uint32_t index{0U};
+    /** Index of the master device (bridge or VRF) of the entry's interface. */
+    uint32_t master{0U};
+};
+
+} // namespace rtaco
+} // namespace llmx
@@ -7,6 +7,7 @@
 #include <system_error>
 
 #include "rtaco/events/nl_link_event.hxx"
+#include "rtaco/tasks/nl_dump_filter.hxx"
 #include "rtaco/tasks/nl_link_task.hxx"
 
 struct nlmsghdr;
@@ -23,6 +24,9 @@ class SocketGuard;
  */
 class LinkDumpTask : public LinkTask<LinkDumpTask, LinkEventList> {
     LinkEventList learned_;
+    LinkEventChunkHandler on_chunk_;
+    LinkEventViewHandler on_view_;
+    LinkDumpFilter filter_;
 
 public:
     /** @brief Construct a LinkDumpTask.
@@ -38,6 +42,41 @@ public:
     /** @brief Prepare the netlink request to dump links. */
     void prepare_request();
 
+    /** @brief Stream results to `on_chunk` instead of returning them.
+     *
+     * When set, events collected from each received datagram are handed to
+     * `on_chunk` and then discarded, so memory stays bounded by one batch;
+     * the list returned on completion is empty.
+     */
+    void set_chunk_handler(LinkEventChunkHandler on_chunk);
+
+    /** @brief Pass every matching entry to `on_view` instead of collecting it.
+     *
+     * The view is only valid during the call. Nothing is materialized, so
+     * callers can build their own representation (e.g. compact events)
+     * directly from the reply buffer.
+     */
+    void set_view_handler(LinkEventViewHandler on_view);
+
+    /** @brief Restrict the dump to entries matching `filter`.
+     *
+     * The filter is sent with the request so the kernel skips everything
+     * else; replies are checked against it again, which keeps the result
+     * right on kernels without strict dump checking.
+     */
+    void set_filter(LinkDumpFilter filter);
+
+    /** @brief Whether an entry falls inside what this dump reports.
+     *
+     * Lets consumers that mix dumps with notifications (e.g. a resync after
+     * an overrun) apply the same scope to both.
+     */
+    static auto in_scope(const LinkEventView& view,
+            const LinkDumpFilter& filter = {}) noexcept -> bool;
+
+    /** @brief Hand events collected so far to the chunk handler, if any. */
+    void flush_batch();
+
     /** @brief Process a received netlink message for link dump responses.
      *
      * @param header Netlink message header.
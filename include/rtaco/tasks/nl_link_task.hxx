@@ -1,8 +1,10 @@
 #pragma once
 
+#include <array>
 #include <cstdint>
 #include <span>
 
+#include <net/if.h>
 #include <linux/netlink.h>
 #include <linux/rtnetlink.h>
 
@@ -14,6 +16,9 @@ namespace rtaco {
 struct LinkRequest {
     nlmsghdr header;
     ifinfomsg message;
+    /** Room for IFLA_MASTER and IFLA_LINKINFO { IFLA_INFO_KIND }. */
+    std::array<uint8_t, RTA_SPACE(sizeof(uint32_t)) + RTA_SPACE(RTA_SPACE(IFNAMSIZ))>
+            attributes;
 };
 
 /** @brief Base task type for link-related netlink operations.
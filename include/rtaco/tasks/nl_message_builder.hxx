@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <linux/netlink.h>
+
+namespace llmx {
+namespace rtaco {
+
+/** @brief Serializes netlink requests back to back into one buffer.
+ *
+ * The kernel processes every message of a datagram in one `sendmsg`, so a
+ * buffer of many requests costs one system call instead of one per request.
+ * A message is written in place: `begin` appends the `nlmsghdr` and the
+ * family header (e.g. `rtmsg`), `attribute` appends to it and `end` closes
+ * it. Positions are kept as offsets, so the buffer may grow freely.
+ */
+class MessageBuilder {
+public:
+    /** @brief Reserve room for `bytes` of messages. */
+    void reserve(size_t bytes);
+
+    /** @brief Drop every message, keeping the allocation. */
+    void clear() noexcept;
+
+    /** @brief Open a message and return its zeroed family header.
+     *
+     * The reference is invalidated by the next append; fill the header
+     * before adding attributes.
+     */
+    template<typename Family>
+    auto begin(uint16_t type, uint16_t flags, uint32_t sequence) -> Family& {
+        open(type, flags, sequence, sizeof(Family));
+        return *reinterpret_cast<Family*>(buffer_.data() + start_ + NLMSG_HDRLEN);
+    }
+
+    /** @brief Open a message without a family header, e.g. NLMSG_NOOP. */
+    void begin(uint16_t type, uint16_t flags, uint32_t sequence);
+
+    /** @brief Append an attribute to the open message. */
+    void attribute(uint16_t type, std::span<const uint8_t> payload);
+
+    /** @brief Append a u32 attribute to the open message. */
+    void attribute(uint16_t type, uint32_t value);
+
+    /** @brief Open a nested attribute; returns the handle for `end_nested`. */
+    auto begin_nested(uint16_t type) -> size_t;
+
+    /** @brief Close the nested attribute opened at `nest`, dropping it if empty. */
+    void end_nested(size_t nest);
+
+    /** @brief Close the open message. */
+    void end();
+
+    /** @brief Append already encoded messages as they are. */
+    void append(std::span<const uint8_t> messages);
+
+    /** @brief Add `base` to the `nlmsg_seq` of every message. */
+    void rebase(uint32_t base) noexcept;
+
+    /** @brief Clear `flags` from the `nlmsg_flags` of every message. */
+    void clear_flags(uint16_t flags) noexcept;
+
+    /** @brief The packed messages. */
+    auto data() const noexcept -> std::span<const uint8_t> {
+        return {buffer_.data(), end_};
+    }
+
+    /** @brief Number of closed messages. */
+    auto count() const noexcept -> size_t {
+        return count_;
+    }
+
+    auto empty() const noexcept -> bool {
+        return count_ == 0U;
+    }
+
+private:
+    void open(uint16_t type, uint16_t flags, uint32_t sequence, size_t family_size);
+    auto header() noexcept -> nlmsghdr&;
+
+    std::vector<uint8_t> buffer_;
+    size_t start_{0};
+    size_t end_{0};
+    size_t count_{0};
+};
+
+} // namespace rtaco
+} // namespace llmx
@@ -7,6 +7,7 @@
 #include <system_error>
 
 #include "rtaco/events/nl_neighbor_event.hxx"
+#include "rtaco/tasks/nl_dump_filter.hxx"
 #include "rtaco/tasks/nl_neighbor_task.hxx"
 
 struct nlmsghdr;
@@ -23,6 +24,9 @@ class SocketGuard;
  */
 class NeighborDumpTask : public NeighborTask<NeighborDumpTask, NeighborEventList> {
     NeighborEventList learned_;
+    NeighborEventChunkHandler on_chunk_;
+    NeighborEventViewHandler on_view_;
+    NeighborDumpFilter filter_;
 
 public:
     /** @brief Construct a NeighborDumpTask.
@@ -38,6 +42,41 @@ public:
     /** @brief Prepare the netlink request to dump neighbor entries. */
     void prepare_request();
 
+    /** @brief Stream results to `on_chunk` instead of returning them.
+     *
+     * When set, events collected from each received datagram are handed to
+     * `on_chunk` and then discarded, so memory stays bounded by one batch;
+     * the list returned on completion is empty.
+     */
+    void set_chunk_handler(NeighborEventChunkHandler on_chunk);
+
+    /** @brief Pass every matching entry to `on_view` instead of collecting it.
+     *
+     * The view is only valid during the call. Nothing is materialized, so
+     * callers can build their own representation (e.g. compact events)
+     * directly from the reply buffer.
+     */
+    void set_view_handler(NeighborEventViewHandler on_view);
+
+    /** @brief Restrict the dump to entries matching `filter`.
+     *
+     * The filter is sent with the request so the kernel skips everything
+     * else; replies are checked against it again, which keeps the result
+     * right on kernels without strict dump checking.
+     */
+    void set_filter(NeighborDumpFilter filter);
+
+    /** @brief Whether an entry falls inside what this dump reports.
+     *
+     * Lets consumers that mix dumps with notifications (e.g. a resync after
+     * an overrun) apply the same scope to both.
+     */
+    static auto in_scope(const NeighborEventView& view,
+            const NeighborDumpFilter& filter = {}) noexcept -> bool;
+
+    /** @brief Hand events collected so far to the chunk handler, if any. */
+    void flush_batch();
+
     /** @brief Process a received neighbor-related netlink message.
      *
      * @param header Netlink message header.
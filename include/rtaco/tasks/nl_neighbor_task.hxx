@@ -2,6 +2,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <array>
 #include <cstring>
 #include <span>
 
@@ -17,13 +18,24 @@ struct NeighborRequest {
     ndmsg message;
     rtattr dst_attr;
     std::array<uint8_t, 16> dst;
+    /** Room for the NDA_IFINDEX / NDA_MASTER filters of dump requests. */
+    std::array<uint8_t, 2U * RTA_SPACE(sizeof(uint32_t))> attributes;
 };
 
+/** @brief Detect an IPv4-mapped IPv6 address (::ffff:a.b.c.d). */
+inline auto is_v4_mapped(std::span<const uint8_t, 16> address) noexcept -> bool {
+    constexpr std::array<uint8_t, 12> prefix{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0xff, 0xff};
+    return std::memcmp(address.data(), prefix.data(), prefix.size()) == 0;
+}
+
 /** @brief Base task type for neighbor-related netlink operations.
  *
  * `NeighborTask` prepares neighbor-specific requests (ndmsg and NDA_DST)
  * and provides `request_payload()` for transmission. Derived tasks implement
  * request preparation and response parsing for neighbor probe/get/flush/etc.
+ *
+ * Addresses are always passed as 16 bytes; IPv4 neighbors use the
+ * IPv4-mapped form (::ffff:a.b.c.d) and are sent as AF_INET requests.
  */
 template<typename Derived, typename Result>
 class NeighborTask : public RequestTask<Derived, Result> {
@@ -57,10 +69,20 @@ protected:
             return;
         }
 
+        request_.message.ndm_family = AF_INET6;
         request_.dst_attr.rta_type = NDA_DST;
         request_.dst_attr.rta_len = RTA_LENGTH(request_.dst.size());
 
-        std::memcpy(request_.dst.data(), address.data(), address.size());
+        if (is_v4_mapped(address)) {
+            constexpr size_t V4_OFFSET = 12U;
+            constexpr size_t V4_LENGTH = 4U;
+
+            request_.message.ndm_family = AF_INET;
+            request_.dst_attr.rta_len = RTA_LENGTH(V4_LENGTH);
+            std::memcpy(request_.dst.data(), address.data() + V4_OFFSET, V4_LENGTH);
+        } else {
+            std::memcpy(request_.dst.data(), address.data(), address.size());
+        }
 
         const auto payload = NLMSG_ALIGN(request_.header.nlmsg_len);
         request_.header.nlmsg_len = payload + RTA_ALIGN(request_.dst_attr.rta_len);
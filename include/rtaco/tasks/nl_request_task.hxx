@@ -3,6 +3,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <concepts>
+#include <cstring>
 #include <optional>
 #include <span>
 #include <system_error>
@@ -10,6 +11,7 @@
 #include <vector>
 
 #include <linux/netlink.h>
+#include <linux/rtnetlink.h>
 
 #include <boost/asio/async_result.hpp>
 #include <boost/asio/awaitable.hpp>
@@ -18,11 +20,51 @@
 #include <boost/asio/use_awaitable.hpp>
 #include <boost/system/error_code.hpp>
 
+#include "rtaco/core/nl_transport.hxx"
+#include "rtaco/socket/nl_receive_buffer.hxx"
 #include "rtaco/socket/nl_socket_guard.hxx"
 
 namespace llmx {
 namespace rtaco {
 
+/** @brief Append attribute `type` to the message at the start of `request`.
+ *
+ * Request structs reserve room for optional attributes with trailing
+ * storage; `nlmsg_len` is extended to cover the attribute.
+ *
+ * @return false (leaving the request unchanged) if the attribute does not fit.
+ */
+template<typename Request>
+auto append_attribute(Request& request, uint16_t type,
+        std::span<const uint8_t> payload) noexcept -> bool {
+    const auto offset = NLMSG_ALIGN(request.header.nlmsg_len);
+    if (offset + RTA_SPACE(payload.size()) > sizeof(Request)) {
+        return false;
+    }
+
+    auto* attr = reinterpret_cast<rtattr*>(reinterpret_cast<uint8_t*>(&request) + offset);
+    attr->rta_type = type;
+    attr->rta_len = static_cast<unsigned short>(RTA_LENGTH(payload.size()));
+    std::memcpy(RTA_DATA(attr), payload.data(), payload.size());
+
+    request.header.nlmsg_len = static_cast<uint32_t>(offset + RTA_ALIGN(attr->rta_len));
+    return true;
+}
+
+/** @brief Append a u32 attribute; see `append_attribute`. */
+template<typename Request>
+auto append_attribute(Request& request, uint16_t type, uint32_t value) noexcept -> bool {
+    return append_attribute(request, type,
+            std::span<const uint8_t>{reinterpret_cast<const uint8_t*>(&value),
+                    sizeof(value)});
+}
+
+/** @brief Tasks that want to be told when a received datagram was consumed. */
+template<typename Derived>
+concept batch_behavior = requires(Derived& derived) {
+    { derived.flush_batch() } -> std::same_as<void>;
+};
+
 template<typename Derived, typename Result>
 concept request_behavior =
         requires(Derived& derived, const Derived& const_derived, const nlmsghdr& header) {
@@ -44,8 +86,7 @@ concept request_behavior =
  */
 template<typename Derived, typename Result>
 class RequestTask {
-    static constexpr size_t MAX_RESPONSE_BYTES = 64U * 1024U;
-    std::array<uint8_t, MAX_RESPONSE_BYTES> receive_buffer_;
+    ReceiveBuffer receive_buffer_;
 
     SocketGuard& socket_guard_;
     uint16_t ifindex_;
@@ -81,6 +122,40 @@ public:
         co_return co_await read_loop();
     }
 
+    /** @brief Run the request as one transaction on a shared transport.
+     *
+     * Instead of owning the socket for the whole exchange, the request is
+     * sent through `transport` and replies are routed back by sequence
+     * number, so other transactions can be in flight at the same time.
+     */
+    auto async_run(Transport& transport)
+            -> boost::asio::awaitable<std::expected<Result, std::error_code>> {
+        impl().prepare_request();
+
+        Transport::batch_handler_t on_batch{};
+        if constexpr (batch_behavior<Derived>) {
+            on_batch = [this]() { impl().flush_batch(); };
+        }
+
+        std::optional<std::expected<Result, std::error_code>> result{};
+        auto status = co_await transport.async_transact(impl().request_payload(),
+                [this, &result](const nlmsghdr& header) -> bool
+        {
+            result = impl().process_message(header);
+            return result.has_value();
+        }, std::move(on_batch));
+
+        if (!status) {
+            co_return std::unexpected(status.error());
+        }
+
+        if (!result) {
+            co_return std::unexpected(std::make_error_code(std::errc::protocol_error));
+        }
+
+        co_return std::move(*result);
+    }
+
 protected:
     auto socket() noexcept -> Socket& {
         return socket_guard_.socket();
@@ -126,23 +201,15 @@ private:
 
     auto read_loop() -> boost::asio::awaitable<std::expected<Result, std::error_code>> {
         while (true) {
-            boost::system::error_code ec{};
-            const auto bytes = co_await socket().async_receive(
-                    boost::asio::buffer(receive_buffer_),
-                    boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+            const auto datagram = co_await receive_buffer_.async_receive(socket());
 
-            if (ec) {
-                co_return std::unexpected(
-                        std::error_code{ec.value(), std::generic_category()});
+            if (!datagram) {
+                co_return std::unexpected(datagram.error());
             }
 
-            if (bytes >= receive_buffer_.size()) {
-            }
-
-            auto remaining = static_cast<unsigned int>(bytes);
+            auto remaining = static_cast<unsigned int>(datagram->size());
             const auto header_size = static_cast<unsigned int>(sizeof(nlmsghdr));
-            const auto* header = reinterpret_cast<const nlmsghdr*>(receive_buffer_
-                            .data());
+            const auto* header = reinterpret_cast<const nlmsghdr*>(datagram->data());
 
             while (remaining >= header_size && NLMSG_OK(header, remaining)) {
                 if (auto result = impl().process_message(*header)) {
@@ -151,6 +218,10 @@ private:
 
                 header = NLMSG_NEXT(header, remaining);
             }
+
+            if constexpr (batch_behavior<Derived>) {
+                impl().flush_batch();
+            }
         }
     }
 };
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <span>
+#include <system_error>
+#include <vector>
+
+#include <boost/asio/awaitable.hpp>
+
+#include "rtaco/core/nl_transport.hxx"
+#include "rtaco/tasks/nl_route_message.hxx"
+
+namespace llmx {
+namespace rtaco {
+
+/** @brief Tuning knobs for bulk route writes. */
+struct RouteBulkOptions {
+    /** Route messages packed into one datagram. */
+    size_t batch_size{32U};
+    /** Datagrams awaiting their acks at once. */
+    size_t window{4U};
+};
+
+/** @brief A route that was refused by the kernel or could not be encoded. */
+struct RouteFailure {
+    /** Position of the route in the submitted span. */
+    size_t index{0};
+    /** `nlmsg_seq` the route was sent with; 0 if it was never sent. */
+    uint32_t sequence{0};
+    std::error_code error{};
+};
+
+/** @brief Outcome of a bulk route write. */
+struct RouteBulkResult {
+    /** Routes the kernel acknowledged. */
+    size_t succeeded{0};
+    /** Routes that failed, ordered by index. */
+    std::vector<RouteFailure> failures;
+
+    auto ok() const noexcept -> bool {
+        return failures.empty();
+    }
+};
+
+/** @brief Writes many routes over a shared `Transport`.
+ *
+ * Routes are packed `batch_size` to a datagram with consecutive sequence
+ * numbers starting at `first_sequence`, and up to `window` datagrams are in
+ * flight at once. Every message asks for an ack, so a failing route is
+ * reported on its own and does not stop the others.
+ *
+ * `batch_size * window` is capped at `Transport::MAX_UNACKED`.
+ */
+class RouteBulkTask {
+public:
+    /** @brief Construct a task writing `routes`, which must outlive it.
+     *
+     * @param transport Transport to send through.
+     * @param op Add, replace or delete.
+     * @param routes Routes to write.
+     * @param first_sequence Sequence number of the first route; the task
+     *        uses `routes.size()` consecutive numbers.
+     * @param options Batch size and window.
+     */
+    RouteBulkTask(Transport& transport, RouteOp op, std::span<const RouteSpec> routes,
+            uint32_t first_sequence, RouteBulkOptions options = {}) noexcept;
+
+    /** @brief Write every route and collect the per-route outcome.
+     *
+     * Must run on the transport's executor. Fails as a whole only when the
+     * transport does (socket error or stop).
+     */
+    auto async_run()
+            -> boost::asio::awaitable<std::expected<RouteBulkResult, std::error_code>>;
+
+private:
+    struct State;
+
+    auto worker(std::shared_ptr<State> state, size_t batch_size)
+            -> boost::asio::awaitable<void>;
+
+    Transport& transport_;
+    RouteOp op_;
+    std::span<const RouteSpec> routes_;
+    uint32_t first_sequence_;
+    RouteBulkOptions options_;
+};
+
+} // namespace rtaco
+} // namespace llmx
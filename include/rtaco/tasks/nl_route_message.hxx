@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <span>
+#include <system_error>
+
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+
+#include "rtaco/core/nl_address.hxx"
+#include "rtaco/events/nl_route_event.hxx"
+#include "rtaco/tasks/nl_message_builder.hxx"
+
+namespace llmx {
+namespace rtaco {
+
+/** @brief Route metrics carried in RTA_METRICS; zero leaves a metric unset. */
+struct RouteMetrics {
+    uint32_t mtu{0};
+    uint32_t advmss{0};
+    uint32_t hoplimit{0};
+    uint32_t initcwnd{0};
+
+    friend auto operator==(const RouteMetrics&, const RouteMetrics&) -> bool = default;
+};
+
+/** @brief A route to add, replace or delete.
+ *
+ * Mirrors the fields `ip route` takes: an empty `gateway` or `prefsrc` and
+ * a zero `oif_index` or `priority` are left out of the request. For a
+ * delete, the kernel matches `protocol` and `route_type` when non-zero and
+ * ignores `scope`.
+ */
+struct RouteSpec {
+    uint8_t family{AF_INET};
+    uint8_t dst_prefix_len{0};
+    uint8_t scope{RT_SCOPE_UNIVERSE};
+    uint8_t protocol{RTPROT_STATIC};
+    uint8_t route_type{RTN_UNICAST};
+    uint32_t table{RT_TABLE_MAIN};
+    uint32_t priority{0};
+    uint32_t oif_index{0};
+    IpAddress dst{};
+    IpAddress gateway{};
+    IpAddress prefsrc{};
+    RouteMetrics metrics{};
+
+    /** @brief Route with the destination, next hop and table of `event`. */
+    static auto from_event(const CompactRouteEvent& event) noexcept -> RouteSpec;
+
+    friend auto operator==(const RouteSpec&, const RouteSpec&) -> bool = default;
+};
+
+/** @brief Kind of route write. */
+enum class RouteOp : uint8_t {
+    ADD,     ///< RTM_NEWROUTE, fails with EEXIST if the route exists
+    REPLACE, ///< RTM_NEWROUTE, creates or replaces
+    DELETE,  ///< RTM_DELROUTE
+};
+
+/** @brief Upper bound of one encoded route message. */
+inline constexpr size_t MAX_ROUTE_MESSAGE_SIZE = NLMSG_SPACE(sizeof(rtmsg)) +
+        RTA_SPACE(sizeof(uint32_t)) * 3U + RTA_SPACE(16U) * 3U +
+        RTA_SPACE(RTA_SPACE(sizeof(uint32_t)) * 4U);
+
+/** @brief Append an RTM_NEWROUTE or RTM_DELROUTE message to `builder`.
+ *
+ * @param builder Buffer the message is appended to.
+ * @param op Kind of write.
+ * @param route Route to encode.
+ * @param sequence `nlmsg_seq` of the message.
+ * @param flags Extra `nlmsg_flags`; NLM_F_ACK asks for a reply on success.
+ * @return `std::errc::invalid_argument` (leaving the buffer unchanged) if
+ *         the family, prefix length or addresses do not fit together.
+ */
+auto append_route(MessageBuilder& builder, RouteOp op, const RouteSpec& route,
+        uint32_t sequence, uint16_t flags = NLM_F_ACK)
+        -> std::expected<void, std::error_code>;
+
+} // namespace rtaco
+} // namespace llmx
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <cstddef>
 #include <cstdint>
 #include <optional>
@@ -15,6 +16,8 @@ namespace rtaco {
 struct RouteRequest {
     nlmsghdr header;
     rtmsg message;
+    /** Room for RTA_TABLE and RTA_OIF. */
+    std::array<uint8_t, 2U * RTA_SPACE(sizeof(uint32_t))> attributes;
 };
 
 /** @brief Base task type for route-related netlink operations.
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <system_error>
+#include <vector>
+
+#include <linux/neighbour.h>
+#include <linux/rtnetlink.h>
+
+#include "rtaco/core/nl_address.hxx"
+#include "rtaco/tasks/nl_message_builder.hxx"
+#include "rtaco/tasks/nl_route_message.hxx"
+
+namespace llmx {
+namespace rtaco {
+
+/** @brief An interface address to add, replace or delete.
+ *
+ * `peer` sets the remote end of a point-to-point address; without it the
+ * prefix is `address` itself. `broadcast` and `label` apply to IPv4 only.
+ */
+struct AddressSpec {
+    int index{0};
+    uint8_t family{AF_INET};
+    uint8_t prefix_len{0};
+    uint8_t scope{RT_SCOPE_UNIVERSE};
+    /** IFA_F_* flags, e.g. IFA_F_NODAD or IFA_F_NOPREFIXROUTE. */
+    uint32_t flags{0};
+    IpAddress address{};
+    IpAddress peer{};
+    IpAddress broadcast{};
+    InterfaceName label{};
+};
+
+/** @brief A neighbor entry to add, replace or delete. */
+struct NeighborSpec {
+    int index{0};
+    IpAddress address{};
+    /** Left out when empty, e.g. for NUD_NOARP entries. */
+    LinkLayerAddress lladdr{};
+    /** NUD_* state of the entry. */
+    uint16_t state{NUD_PERMANENT};
+    /** NTF_* flags. */
+    uint8_t flags{0};
+};
+
+/** @brief Changes to an existing link; unset fields are left alone. */
+struct LinkSpec {
+    int index{0};
+    std::optional<bool> up{};
+    uint32_t mtu{0};
+    InterfaceName name{};
+    LinkLayerAddress address{};
+};
+
+/** @brief Queues heterogeneous rtnetlink writes to send in one go.
+ *
+ * Every operation becomes one message that asks for an ack; `Control::commit`
+ * packs them into as few datagrams as the ack budget allows and returns one
+ * result per operation, in the order they were queued. Each method returns
+ * the operation's index into that result. An operation that cannot be
+ * encoded is kept with its error and never sent.
+ *
+ * The kernel applies the messages in order but has no rollback: operations
+ * before and after a failing one still take effect.
+ */
+class TransactionBuilder {
+public:
+    auto add_route(const RouteSpec& route) -> size_t;
+    auto replace_route(const RouteSpec& route) -> size_t;
+    auto delete_route(const RouteSpec& route) -> size_t;
+
+    auto add_address(const AddressSpec& address) -> size_t;
+    auto replace_address(const AddressSpec& address) -> size_t;
+    auto delete_address(const AddressSpec& address) -> size_t;
+
+    auto add_neighbor(const NeighborSpec& neighbor) -> size_t;
+    auto replace_neighbor(const NeighborSpec& neighbor) -> size_t;
+    auto delete_neighbor(const NeighborSpec& neighbor) -> size_t;
+
+    /** @brief Ask the kernel to re-resolve a neighbor, as `Control::probe_neighbor`. */
+    auto probe_neighbor(int index, const IpAddress& address) -> size_t;
+
+    /** @brief Change the state, MTU, name or address of a link. */
+    auto set_link(const LinkSpec& link) -> size_t;
+
+    /** @brief Number of queued operations. */
+    auto size() const noexcept -> size_t {
+        return errors_.size();
+    }
+
+    auto empty() const noexcept -> bool {
+        return errors_.empty();
+    }
+
+    /** @brief Drop every operation. */
+    void clear() noexcept;
+
+    /** @brief Encoded messages; operation `i` is sent with sequence `i`. */
+    auto messages() const noexcept -> const MessageBuilder& {
+        return messages_;
+    }
+
+    /** @brief Why operation `index` could not be encoded, or no error. */
+    auto rejected(size_t index) const noexcept -> std::error_code {
+        return errors_[index];
+    }
+
+private:
+    auto route(RouteOp op, const RouteSpec& route) -> size_t;
+    auto address(uint16_t type, uint16_t flags, const AddressSpec& address) -> size_t;
+    auto neighbor(uint16_t type, uint16_t flags, const NeighborSpec& neighbor) -> size_t;
+    auto push(bool encoded) -> size_t;
+
+    MessageBuilder messages_;
+    std::vector<std::error_code> errors_;
+};
+
+} // namespace rtaco
+} // namespace llmx
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <functional>
+#include <system_error>
+#include <vector>
+
+#include <boost/asio/awaitable.hpp>
+
+#include "rtaco/core/nl_transport.hxx"
+#include "rtaco/tasks/nl_transaction.hxx"
+
+namespace llmx {
+namespace rtaco {
+
+/** @brief Outcome of one operation of a transaction. */
+struct OperationResult {
+    /** `nlmsg_seq` the operation was sent with; 0 if it was never sent. */
+    uint32_t sequence{0};
+    std::error_code error{};
+
+    auto ok() const noexcept -> bool {
+        return !error;
+    }
+};
+
+/** @brief One result per operation, in the order they were queued. */
+using TransactionResult = std::vector<OperationResult>;
+
+/** @brief A posted operation that failed. */
+struct WriteError {
+    /** Position of the operation in its transaction. */
+    size_t index{0};
+    /** `nlmsg_seq` the operation was sent with; 0 if it was never sent. */
+    uint32_t sequence{0};
+    /** `nlmsg_type` of the failed request (e.g. RTM_NEWROUTE); 0 if never sent. */
+    uint16_t type{0};
+    std::error_code error{};
+};
+
+/** @brief Receives the failures of posted operations. */
+using WriteErrorHandler = std::function<void(const WriteError&)>;
+
+/** @brief Sends the operations of a `TransactionBuilder` over a `Transport`.
+ *
+ * Operation `i` is sent with sequence `first_sequence + i`, so every reply
+ * maps straight back to its operation. `async_run` sends the messages in
+ * order, at most `Transport::MAX_UNACKED` to a datagram, and sends each
+ * datagram only once the previous one is fully acked.
+ *
+ * `async_post` sends them without `NLM_F_ACK`, so the kernel answers only
+ * the ones that fail. Each datagram ends with an acked NLMSG_NOOP barrier
+ * numbered after the operations, which lets the transport know when every
+ * error of the datagram has arrived.
+ */
+class TransactionTask {
+public:
+    /** @brief Construct a task sending `transaction`, which must outlive it.
+     *
+     * @param transport Transport to send through.
+     * @param transaction Operations to send.
+     * @param first_sequence Sequence number of the first operation;
+     *        `async_run` uses `transaction.size()` consecutive numbers and
+     *        `async_post` uses `sequences(transaction)`.
+     */
+    TransactionTask(Transport& transport, const TransactionBuilder& transaction,
+            uint32_t first_sequence) noexcept;
+
+    /** @brief Send every operation and collect the per-operation outcome.
+     *
+     * Must run on the transport's executor. Fails as a whole only when the
+     * transport does (socket error or stop).
+     */
+    auto async_run()
+            -> boost::asio::awaitable<std::expected<TransactionResult, std::error_code>>;
+
+    /** @brief Send every operation without waiting for the kernel.
+     *
+     * Completes once the messages are sent. `on_error` is called on the
+     * transport's executor for every operation the kernel refuses, and right
+     * away for the ones that could not be encoded; operations it is never
+     * called for have succeeded once a later barrier completes.
+     */
+    auto async_post(WriteErrorHandler on_error)
+            -> boost::asio::awaitable<std::expected<void, std::error_code>>;
+
+    /** @brief Sequence numbers `async_post` uses, barriers included. */
+    static auto sequences(const TransactionBuilder& transaction) noexcept -> size_t;
+
+private:
+    Transport& transport_;
+    const TransactionBuilder& transaction_;
+    uint32_t first_sequence_;
+};
+
+} // namespace rtaco
+} // namespace llmx
@@ -1,18 +1,22 @@
 #include "rtaco/core/nl_control.hxx"
 
 #include <atomic>
-#include <chrono>
 #include <cstdint>
+#include <exception>
 #include <expected>
 #include <future>
+#include <iterator>
+#include <memory>
 #include <memory_resource>
+#include <optional>
 #include <span>
-#include <stdexcept>
 #include <system_error>
+#include <utility>
+#include <vector>
 
 #include <boost/asio/awaitable.hpp>
 #include <boost/asio/co_spawn.hpp>
-#include <boost/asio/error.hpp>
+#include <boost/asio/dispatch.hpp>
 #include <boost/asio/io_context.hpp>
 #include <boost/asio/redirect_error.hpp>
 #include <boost/asio/steady_timer.hpp>
@@ -30,65 +34,550 @@
 #include "rtaco/tasks/nl_neighbor_flush_task.hxx"
 #include "rtaco/tasks/nl_neighbor_get_task.hxx"
 #include "rtaco/tasks/nl_neighbor_probe_task.hxx"
+#include "rtaco/tasks/nl_route_bulk_task.hxx"
 #include "rtaco/tasks/nl_route_dump_task.hxx"
 #include "rtaco/tasks/nl_link_dump_task.hxx"
+#include "rtaco/tasks/nl_transaction_task.hxx"
 
 namespace llmx {
 namespace rtaco {
 
 namespace asio = boost::asio;
 
-Control::Control(asio::io_context& io) noexcept
+namespace {
+
+/** Run `work` on the strand of `transport`, so dumps on separate sockets can
+ *  use separate threads, and resume the caller where it was. */
+template <typename T>
+auto run_on(Transport& transport, asio::awaitable<T> work) -> asio::awaitable<T> {
+    co_return co_await asio::co_spawn(transport.get_executor(), std::move(work),
+            asio::use_awaitable);
+}
+
+/** Start `dump` for every shard at once on `executor` and concatenate the
+ *  lists in `order` as the shards finish. Must run on `executor`. */
+template <typename List, typename Filter, typename Dump>
+auto dump_shards(asio::any_io_executor executor, std::vector<Filter> shards,
+        ShardOrder order, std::pmr::memory_resource* pmr, Dump dump)
+        -> asio::awaitable<std::expected<List, std::error_code>> {
+    using result_t = std::expected<List, std::error_code>;
+
+    // Shared with the shard completions, which may outlive this frame.
+    struct Progress {
+        Progress(const asio::any_io_executor& executor, size_t count)
+            : results(count)
+            , wakeup{executor} {}
+
+        std::vector<std::optional<result_t>> results;
+        std::vector<size_t> finished;
+        std::exception_ptr exception{};
+        asio::steady_timer wakeup;
+    };
+
+    const auto count = shards.size();
+    auto progress = std::make_shared<Progress>(executor, count);
+    progress->wakeup.expires_at(asio::steady_timer::time_point::max());
+
+    for (size_t i = 0; i < count; ++i) {
+        asio::co_spawn(executor, dump(std::move(shards[i])),
+                [progress, i](std::exception_ptr exception, result_t result)
+        {
+            if (exception && !progress->exception) {
+                progress->exception = exception;
+            }
+            progress->results[i] = std::move(result);
+            progress->finished.push_back(i);
+            progress->wakeup.cancel();
+        });
+    }
+
+    List merged{pmr};
+    std::error_code error{};
+    const auto take = [&merged, &error](std::optional<result_t>& slot)
+    {
+        auto& result = *slot;
+        if (!result) {
+            if (!error) {
+                error = result.error();
+            }
+        } else if (!error) {
+            if (merged.empty()) {
+                merged = std::move(*result);
+            } else {
+                merged.insert(merged.end(), std::make_move_iterator(result->begin()),
+                        std::make_move_iterator(result->end()));
+            }
+        }
+        slot.reset();
+    };
+
+    size_t settled = 0U;
+    size_t next = 0U;
+    while (settled < count) {
+        if (progress->finished.empty()) {
+            boost::system::error_code ignored{};
+            co_await progress->wakeup.async_wait(
+                    asio::redirect_error(asio::use_awaitable, ignored));
+            progress->wakeup.expires_at(asio::steady_timer::time_point::max());
+            continue;
+        }
+
+        for (const auto i : std::exchange(progress->finished, {})) {
+            ++settled;
+            if (order == ShardOrder::COMPLETION) {
+                take(progress->results[i]);
+            }
+        }
+
+        // In the given order, merge every shard whose predecessors are in.
+        while (order == ShardOrder::GIVEN && next < count &&
+                progress->results[next].has_value()) {
+            take(progress->results[next++]);
+        }
+    }
+
+    if (progress->exception) {
+        std::rethrow_exception(progress->exception);
+    }
+
+    if (error) {
+        co_return std::unexpected{error};
+    }
+
+    co_return merged;
+}
+
+} // namespace
+
+Control::Control(asio::io_context& io, ControlOptions options) noexcept
     : io_{io}
     , strand_{asio::make_strand(io_)}
-    , gate_{io_}
-    , socket_guard_{io_, "nl-control"} {
-    gate_.expires_at(asio::steady_timer::time_point::min());
+    , transport_{io_, strand_, "nl-control", options.interactive.max_in_flight,
+              options.receive_buffer}
+    , bulk_strand_{asio::make_strand(
+              options.bulk.context != nullptr ? *options.bulk.context : io_)}
+    , bulk_pool_{options.bulk.context != nullptr ? *options.bulk.context : io_,
+              bulk_strand_, "nl-control-bulk",
+              TransportPoolOptions{options.bulk.sockets, options.bulk.max_in_flight,
+                      options.receive_buffer, options.bulk.time_slice}}
+    , alive_{std::make_shared<bool>(true)} {}
+
+Control::~Control() {
+    *alive_ = false;
 }
 
-Control::~Control() = default;
+auto Control::dump_routes(std::pmr::memory_resource* pmr)
+        -> std::expected<RouteEventList, std::error_code> {
+    return dump_routes(RouteDumpFilter{}, pmr);
+}
 
-auto Control::dump_routes() -> std::expected<RouteEventList, std::error_code> {
-    auto future = asio::co_spawn(strand_, async_dump_routes_impl(), asio::use_future);
+auto Control::dump_routes(const RouteDumpFilter& filter, std::pmr::memory_resource* pmr)
+        -> std::expected<RouteEventList, std::error_code> {
+    auto future = asio::co_spawn(bulk_strand_, async_dump_routes_impl(filter, pmr),
+            asio::use_future);
     return future.get();
 }
 
-auto Control::dump_addresses() -> std::expected<AddressEventList, std::error_code> {
-    auto future = asio::co_spawn(strand_, async_dump_addresses_impl(), asio::use_future);
-    return future.get();
+auto Control::async_dump_routes(std::pmr::memory_resource* pmr)
+        -> asio::awaitable<std::expected<RouteEventList, std::error_code>> {
+    const RouteDumpFilter filter{};
+    co_return co_await async_dump_routes(filter, pmr);
 }
 
-auto Control::dump_neighbors() -> std::expected<NeighborEventList, std::error_code> {
-    auto future = asio::co_spawn(strand_, async_dump_neighbors_impl(), asio::use_future);
+auto Control::async_dump_routes(const RouteDumpFilter& filter,
+        std::pmr::memory_resource* pmr)
+        -> asio::awaitable<std::expected<RouteEventList, std::error_code>> {
+    co_return co_await asio::co_spawn(bulk_strand_, async_dump_routes_impl(filter, pmr),
+            asio::use_awaitable);
+}
+
+auto Control::dump_routes(RouteEventChunkHandler on_chunk,
+        std::pmr::memory_resource* pmr)
+        -> std::expected<void, std::error_code> {
+    return dump_routes(RouteDumpFilter{}, std::move(on_chunk), pmr);
+}
+
+auto Control::dump_routes(const RouteDumpFilter& filter, RouteEventChunkHandler on_chunk,
+        std::pmr::memory_resource* pmr)
+        -> std::expected<void, std::error_code> {
+    auto future = asio::co_spawn(bulk_strand_,
+            async_stream_routes_impl(filter, std::move(on_chunk), pmr), asio::use_future);
+
     return future.get();
 }
 
-auto Control::dump_links() -> std::expected<LinkEventList, std::error_code> {
-    auto future = asio::co_spawn(strand_, async_dump_links_impl(), asio::use_future);
+auto Control::async_dump_routes(RouteEventChunkHandler on_chunk,
+        std::pmr::memory_resource* pmr)
+        -> asio::awaitable<std::expected<void, std::error_code>> {
+    const RouteDumpFilter filter{};
+    co_return co_await async_dump_routes(filter, std::move(on_chunk), pmr);
+}
+
+auto Control::async_dump_routes(const RouteDumpFilter& filter,
+        RouteEventChunkHandler on_chunk,
+        std::pmr::memory_resource* pmr)
+        -> asio::awaitable<std::expected<void, std::error_code>> {
+    co_return co_await asio::co_spawn(bulk_strand_,
+            async_stream_routes_impl(filter, std::move(on_chunk), pmr),
+            asio::use_awaitable);
+}
+
+auto Control::dump_routes_compact(std::pmr::memory_resource* pmr)
+        -> compact_route_list_result_t {
+    return dump_routes_compact(RouteDumpFilter{}, pmr);
+}
+
+auto Control::dump_routes_compact(const RouteDumpFilter& filter,
+        std::pmr::memory_resource* pmr)
+        -> compact_route_list_result_t {
+    auto future = asio::co_spawn(bulk_strand_,
+            async_dump_routes_compact_impl(filter, pmr), asio::use_future);
+
     return future.get();
 }
 
-auto Control::async_dump_routes()
-        -> asio::awaitable<std::expected<RouteEventList, std::error_code>> {
-    co_return co_await asio::co_spawn(strand_, async_dump_routes_impl(),
+auto Control::async_dump_routes_compact(std::pmr::memory_resource* pmr)
+        -> asio::awaitable<compact_route_list_result_t> {
+    const RouteDumpFilter filter{};
+    co_return co_await async_dump_routes_compact(filter, pmr);
+}
+
+auto Control::async_dump_routes_compact(const RouteDumpFilter& filter,
+        std::pmr::memory_resource* pmr)
+        -> asio::awaitable<compact_route_list_result_t> {
+    co_return co_await asio::co_spawn(bulk_strand_,
+            async_dump_routes_compact_impl(filter, pmr),
             asio::use_awaitable);
 }
 
-auto Control::async_dump_addresses()
+auto Control::dump_addresses(std::pmr::memory_resource* pmr)
+        -> std::expected<AddressEventList, std::error_code> {
+    return dump_addresses(AddressDumpFilter{}, pmr);
+}
+
+auto Control::dump_addresses(const AddressDumpFilter& filter,
+        std::pmr::memory_resource* pmr)
+        -> std::expected<AddressEventList, std::error_code> {
+    auto future = asio::co_spawn(bulk_strand_, async_dump_addresses_impl(filter, pmr),
+            asio::use_future);
+    return future.get();
+}
+
+auto Control::async_dump_addresses(std::pmr::memory_resource* pmr)
+        -> asio::awaitable<std::expected<AddressEventList, std::error_code>> {
+    const AddressDumpFilter filter{};
+    co_return co_await async_dump_addresses(filter, pmr);
+}
+
+auto Control::async_dump_addresses(const AddressDumpFilter& filter,
+        std::pmr::memory_resource* pmr)
         -> asio::awaitable<std::expected<AddressEventList, std::error_code>> {
-    co_return co_await asio::co_spawn(strand_, async_dump_addresses_impl(),
+    co_return co_await asio::co_spawn(bulk_strand_,
+            async_dump_addresses_impl(filter, pmr), asio::use_awaitable);
+}
+
+auto Control::dump_addresses(AddressEventChunkHandler on_chunk,
+        std::pmr::memory_resource* pmr)
+        -> std::expected<void, std::error_code> {
+    return dump_addresses(AddressDumpFilter{}, std::move(on_chunk), pmr);
+}
+
+auto Control::dump_addresses(const AddressDumpFilter& filter,
+        AddressEventChunkHandler on_chunk,
+        std::pmr::memory_resource* pmr)
+        -> std::expected<void, std::error_code> {
+    auto future = asio::co_spawn(bulk_strand_,
+            async_stream_addresses_impl(filter, std::move(on_chunk), pmr),
+            asio::use_future);
+
+    return future.get();
+}
+
+auto Control::async_dump_addresses(AddressEventChunkHandler on_chunk,
+        std::pmr::memory_resource* pmr)
+        -> asio::awaitable<std::expected<void, std::error_code>> {
+    const AddressDumpFilter filter{};
+    co_return co_await async_dump_addresses(filter, std::move(on_chunk), pmr);
+}
+
+auto Control::async_dump_addresses(const AddressDumpFilter& filter,
+        AddressEventChunkHandler on_chunk,
+        std::pmr::memory_resource* pmr)
+        -> asio::awaitable<std::expected<void, std::error_code>> {
+    co_return co_await asio::co_spawn(bulk_strand_,
+            async_stream_addresses_impl(filter, std::move(on_chunk), pmr),
             asio::use_awaitable);
 }
 
-auto Control::async_dump_links()
+auto Control::dump_addresses_compact(std::pmr::memory_resource* pmr)
+        -> compact_address_list_result_t {
+    return dump_addresses_compact(AddressDumpFilter{}, pmr);
+}
+
+auto Control::dump_addresses_compact(const AddressDumpFilter& filter,
+        std::pmr::memory_resource* pmr)
+        -> compact_address_list_result_t {
+    auto future = asio::co_spawn(bulk_strand_,
+            async_dump_addresses_compact_impl(filter, pmr), asio::use_future);
+
+    return future.get();
+}
+
+auto Control::async_dump_addresses_compact(std::pmr::memory_resource* pmr)
+        -> asio::awaitable<compact_address_list_result_t> {
+    const AddressDumpFilter filter{};
+    co_return co_await async_dump_addresses_compact(filter, pmr);
+}
+
+auto Control::async_dump_addresses_compact(const AddressDumpFilter& filter,
+        std::pmr::memory_resource* pmr)
+        -> asio::awaitable<compact_address_list_result_t> {
+    co_return co_await asio::co_spawn(bulk_strand_,
+            async_dump_addresses_compact_impl(filter, pmr),
+            asio::use_awaitable);
+}
+
+auto Control::dump_links(std::pmr::memory_resource* pmr)
+        -> std::expected<LinkEventList, std::error_code> {
+    return dump_links(LinkDumpFilter{}, pmr);
+}
+
+auto Control::dump_links(const LinkDumpFilter& filter, std::pmr::memory_resource* pmr)
+        -> std::expected<LinkEventList, std::error_code> {
+    auto future = asio::co_spawn(bulk_strand_, async_dump_links_impl(filter, pmr),
+            asio::use_future);
+    return future.get();
+}
+
+auto Control::async_dump_links(std::pmr::memory_resource* pmr)
         -> asio::awaitable<std::expected<LinkEventList, std::error_code>> {
-    co_return co_await asio::co_spawn(strand_, async_dump_links_impl(),
+    const LinkDumpFilter filter{};
+    co_return co_await async_dump_links(filter, pmr);
+}
+
+auto Control::async_dump_links(const LinkDumpFilter& filter,
+        std::pmr::memory_resource* pmr)
+        -> asio::awaitable<std::expected<LinkEventList, std::error_code>> {
+    co_return co_await asio::co_spawn(bulk_strand_, async_dump_links_impl(filter, pmr),
+            asio::use_awaitable);
+}
+
+auto Control::dump_links(LinkEventChunkHandler on_chunk,
+        std::pmr::memory_resource* pmr)
+        -> std::expected<void, std::error_code> {
+    return dump_links(LinkDumpFilter{}, std::move(on_chunk), pmr);
+}
+
+auto Control::dump_links(const LinkDumpFilter& filter, LinkEventChunkHandler on_chunk,
+        std::pmr::memory_resource* pmr)
+        -> std::expected<void, std::error_code> {
+    auto future = asio::co_spawn(bulk_strand_,
+            async_stream_links_impl(filter, std::move(on_chunk), pmr), asio::use_future);
+
+    return future.get();
+}
+
+auto Control::async_dump_links(LinkEventChunkHandler on_chunk,
+        std::pmr::memory_resource* pmr)
+        -> asio::awaitable<std::expected<void, std::error_code>> {
+    const LinkDumpFilter filter{};
+    co_return co_await async_dump_links(filter, std::move(on_chunk), pmr);
+}
+
+auto Control::async_dump_links(const LinkDumpFilter& filter,
+        LinkEventChunkHandler on_chunk,
+        std::pmr::memory_resource* pmr)
+        -> asio::awaitable<std::expected<void, std::error_code>> {
+    co_return co_await asio::co_spawn(bulk_strand_,
+            async_stream_links_impl(filter, std::move(on_chunk), pmr),
             asio::use_awaitable);
 }
 
-auto Control::async_dump_neighbors()
+auto Control::dump_links_compact(std::pmr::memory_resource* pmr)
+        -> compact_link_list_result_t {
+    return dump_links_compact(LinkDumpFilter{}, pmr);
+}
+
+auto Control::dump_links_compact(const LinkDumpFilter& filter,
+        std::pmr::memory_resource* pmr)
+        -> compact_link_list_result_t {
+    auto future = asio::co_spawn(bulk_strand_, async_dump_links_compact_impl(filter, pmr),
+            asio::use_future);
+
+    return future.get();
+}
+
+auto Control::async_dump_links_compact(std::pmr::memory_resource* pmr)
+        -> asio::awaitable<compact_link_list_result_t> {
+    const LinkDumpFilter filter{};
+    co_return co_await async_dump_links_compact(filter, pmr);
+}
+
+auto Control::async_dump_links_compact(const LinkDumpFilter& filter,
+        std::pmr::memory_resource* pmr)
+        -> asio::awaitable<compact_link_list_result_t> {
+    co_return co_await asio::co_spawn(bulk_strand_,
+            async_dump_links_compact_impl(filter, pmr), asio::use_awaitable);
+}
+
+auto Control::dump_neighbors(std::pmr::memory_resource* pmr)
+        -> std::expected<NeighborEventList, std::error_code> {
+    return dump_neighbors(NeighborDumpFilter{}, pmr);
+}
+
+auto Control::dump_neighbors(const NeighborDumpFilter& filter,
+        std::pmr::memory_resource* pmr)
+        -> std::expected<NeighborEventList, std::error_code> {
+    auto future = asio::co_spawn(bulk_strand_, async_dump_neighbors_impl(filter, pmr),
+            asio::use_future);
+    return future.get();
+}
+
+auto Control::async_dump_neighbors(std::pmr::memory_resource* pmr)
         -> asio::awaitable<std::expected<NeighborEventList, std::error_code>> {
-    co_return co_await asio::co_spawn(strand_, async_dump_neighbors_impl(),
+    const NeighborDumpFilter filter{};
+    co_return co_await async_dump_neighbors(filter, pmr);
+}
+
+auto Control::async_dump_neighbors(const NeighborDumpFilter& filter,
+        std::pmr::memory_resource* pmr)
+        -> asio::awaitable<std::expected<NeighborEventList, std::error_code>> {
+    co_return co_await asio::co_spawn(bulk_strand_,
+            async_dump_neighbors_impl(filter, pmr), asio::use_awaitable);
+}
+
+auto Control::dump_neighbors(NeighborEventChunkHandler on_chunk,
+        std::pmr::memory_resource* pmr)
+        -> std::expected<void, std::error_code> {
+    return dump_neighbors(NeighborDumpFilter{}, std::move(on_chunk), pmr);
+}
+
+auto Control::dump_neighbors(const NeighborDumpFilter& filter,
+        NeighborEventChunkHandler on_chunk,
+        std::pmr::memory_resource* pmr)
+        -> std::expected<void, std::error_code> {
+    auto future = asio::co_spawn(bulk_strand_,
+            async_stream_neighbors_impl(filter, std::move(on_chunk), pmr),
+            asio::use_future);
+
+    return future.get();
+}
+
+auto Control::async_dump_neighbors(NeighborEventChunkHandler on_chunk,
+        std::pmr::memory_resource* pmr)
+        -> asio::awaitable<std::expected<void, std::error_code>> {
+    const NeighborDumpFilter filter{};
+    co_return co_await async_dump_neighbors(filter, std::move(on_chunk), pmr);
+}
+
+auto Control::async_dump_neighbors(const NeighborDumpFilter& filter,
+        NeighborEventChunkHandler on_chunk,
+        std::pmr::memory_resource* pmr)
+        -> asio::awaitable<std::expected<void, std::error_code>> {
+    co_return co_await asio::co_spawn(bulk_strand_,
+            async_stream_neighbors_impl(filter, std::move(on_chunk), pmr),
+            asio::use_awaitable);
+}
+
+auto Control::dump_neighbors_compact(std::pmr::memory_resource* pmr)
+        -> compact_neighbor_list_result_t {
+    return dump_neighbors_compact(NeighborDumpFilter{}, pmr);
+}
+
+auto Control::dump_neighbors_compact(const NeighborDumpFilter& filter,
+        std::pmr::memory_resource* pmr)
+        -> compact_neighbor_list_result_t {
+    auto future = asio::co_spawn(bulk_strand_,
+            async_dump_neighbors_compact_impl(filter, pmr), asio::use_future);
+
+    return future.get();
+}
+
+auto Control::async_dump_neighbors_compact(std::pmr::memory_resource* pmr)
+        -> asio::awaitable<compact_neighbor_list_result_t> {
+    const NeighborDumpFilter filter{};
+    co_return co_await async_dump_neighbors_compact(filter, pmr);
+}
+
+auto Control::async_dump_neighbors_compact(const NeighborDumpFilter& filter,
+        std::pmr::memory_resource* pmr)
+        -> asio::awaitable<compact_neighbor_list_result_t> {
+    co_return co_await asio::co_spawn(bulk_strand_,
+            async_dump_neighbors_compact_impl(filter, pmr),
+            asio::use_awaitable);
+}
+
+auto Control::dump_routes(std::span<const RouteDumpFilter> shards, ShardOrder order,
+        std::pmr::memory_resource* pmr) -> route_list_result_t {
+    auto future = asio::co_spawn(bulk_strand_,
+            async_dump_route_shards_impl({shards.begin(), shards.end()}, order, pmr),
+            asio::use_future);
+
+    return future.get();
+}
+
+auto Control::async_dump_routes(std::span<const RouteDumpFilter> shards,
+        ShardOrder order, std::pmr::memory_resource* pmr)
+        -> asio::awaitable<route_list_result_t> {
+    co_return co_await asio::co_spawn(bulk_strand_,
+            async_dump_route_shards_impl({shards.begin(), shards.end()}, order, pmr),
+            asio::use_awaitable);
+}
+
+auto Control::dump_routes_compact(std::span<const RouteDumpFilter> shards,
+        ShardOrder order, std::pmr::memory_resource* pmr)
+        -> compact_route_list_result_t {
+    auto future = asio::co_spawn(bulk_strand_,
+            async_dump_route_shards_compact_impl({shards.begin(), shards.end()}, order,
+                    pmr),
+            asio::use_future);
+
+    return future.get();
+}
+
+auto Control::async_dump_routes_compact(std::span<const RouteDumpFilter> shards,
+        ShardOrder order, std::pmr::memory_resource* pmr)
+        -> asio::awaitable<compact_route_list_result_t> {
+    co_return co_await asio::co_spawn(bulk_strand_,
+            async_dump_route_shards_compact_impl({shards.begin(), shards.end()}, order,
+                    pmr),
+            asio::use_awaitable);
+}
+
+auto Control::dump_neighbors(std::span<const NeighborDumpFilter> shards,
+        ShardOrder order, std::pmr::memory_resource* pmr) -> neighbor_list_result {
+    auto future = asio::co_spawn(bulk_strand_,
+            async_dump_neighbor_shards_impl({shards.begin(), shards.end()}, order, pmr),
+            asio::use_future);
+
+    return future.get();
+}
+
+auto Control::async_dump_neighbors(std::span<const NeighborDumpFilter> shards,
+        ShardOrder order, std::pmr::memory_resource* pmr)
+        -> asio::awaitable<neighbor_list_result> {
+    co_return co_await asio::co_spawn(bulk_strand_,
+            async_dump_neighbor_shards_impl({shards.begin(), shards.end()}, order, pmr),
+            asio::use_awaitable);
+}
+
+auto Control::dump_neighbors_compact(std::span<const NeighborDumpFilter> shards,
+        ShardOrder order, std::pmr::memory_resource* pmr)
+        -> compact_neighbor_list_result_t {
+    auto future = asio::co_spawn(bulk_strand_,
+            async_dump_neighbor_shards_compact_impl({shards.begin(), shards.end()},
+                    order, pmr),
+            asio::use_future);
+
+    return future.get();
+}
+
+auto Control::async_dump_neighbors_compact(std::span<const NeighborDumpFilter> shards,
+        ShardOrder order, std::pmr::memory_resource* pmr)
+        -> asio::awaitable<compact_neighbor_list_result_t> {
+    co_return co_await asio::co_spawn(bulk_strand_,
+            async_dump_neighbor_shards_compact_impl({shards.begin(), shards.end()},
+                    order, pmr),
             asio::use_awaitable);
 }
 
@@ -134,127 +623,492 @@ auto Control::async_get_neighbor(uint16_t ifindex, std::span<uint8_t, 16> addres
             asio::use_awaitable);
 }
 
-void Control::stop() {
-    socket_guard_.stop();
+auto Control::add_route(const RouteSpec& route) -> std::expected<void, std::error_code> {
+    auto future = asio::co_spawn(strand_, async_route_impl(RouteOp::ADD, route),
+            asio::use_future);
+
+    return future.get();
+}
+
+auto Control::replace_route(const RouteSpec& route)
+        -> std::expected<void, std::error_code> {
+    auto future = asio::co_spawn(strand_, async_route_impl(RouteOp::REPLACE, route),
+            asio::use_future);
+
+    return future.get();
+}
+
+auto Control::delete_route(const RouteSpec& route)
+        -> std::expected<void, std::error_code> {
+    auto future = asio::co_spawn(strand_, async_route_impl(RouteOp::DELETE, route),
+            asio::use_future);
+
+    return future.get();
+}
+
+auto Control::async_add_route(const RouteSpec& route)
+        -> asio::awaitable<std::expected<void, std::error_code>> {
+    co_return co_await asio::co_spawn(strand_, async_route_impl(RouteOp::ADD, route),
+            asio::use_awaitable);
+}
+
+auto Control::async_replace_route(const RouteSpec& route)
+        -> asio::awaitable<std::expected<void, std::error_code>> {
+    co_return co_await asio::co_spawn(strand_,
+            async_route_impl(RouteOp::REPLACE, route), asio::use_awaitable);
+}
+
+auto Control::async_delete_route(const RouteSpec& route)
+        -> asio::awaitable<std::expected<void, std::error_code>> {
+    co_return co_await asio::co_spawn(strand_,
+            async_route_impl(RouteOp::DELETE, route), asio::use_awaitable);
+}
+
+auto Control::apply_routes(RouteOp op, std::span<const RouteSpec> routes,
+        RouteBulkOptions options) -> route_bulk_result_t {
+    auto future = asio::co_spawn(bulk_strand_,
+            async_apply_routes_impl(op, routes, options), asio::use_future);
+
+    return future.get();
+}
+
+auto Control::async_apply_routes(RouteOp op, std::span<const RouteSpec> routes,
+        RouteBulkOptions options) -> asio::awaitable<route_bulk_result_t> {
+    co_return co_await asio::co_spawn(bulk_strand_,
+            async_apply_routes_impl(op, routes, options), asio::use_awaitable);
+}
+
+auto Control::commit(const TransactionBuilder& transaction) -> transaction_result_t {
+    auto future = asio::co_spawn(strand_, async_commit_impl(transaction),
+            asio::use_future);
+
+    return future.get();
+}
+
+auto Control::async_commit(const TransactionBuilder& transaction)
+        -> asio::awaitable<transaction_result_t> {
+    co_return co_await asio::co_spawn(strand_, async_commit_impl(transaction),
+            asio::use_awaitable);
 }
 
-auto Control::async_dump_routes_impl() -> asio::awaitable<route_list_result_t> {
-    co_await acquire_socket_token();
-    SocketGuard guard{io_, "nl-control-route"};
+auto Control::post(const TransactionBuilder& transaction, WriteErrorHandler on_error)
+        -> void_result_t {
+    auto future = asio::co_spawn(strand_,
+            async_post_impl(transaction, std::move(on_error)), asio::use_future);
+
+    return future.get();
+}
 
-    if (auto result = guard.ensure_open(); !result) {
-        co_return std::unexpected(result.error());
+auto Control::async_post(const TransactionBuilder& transaction,
+        WriteErrorHandler on_error) -> asio::awaitable<void_result_t> {
+    co_return co_await asio::co_spawn(strand_,
+            async_post_impl(transaction, std::move(on_error)), asio::use_awaitable);
+}
+
+auto Control::barrier() -> void_result_t {
+    auto future = asio::co_spawn(strand_, async_barrier_impl(), asio::use_future);
+
+    return future.get();
+}
+
+auto Control::async_barrier() -> asio::awaitable<void_result_t> {
+    co_return co_await asio::co_spawn(strand_, async_barrier_impl(),
+            asio::use_awaitable);
+}
+
+void Control::stop() {
+    // Control may be gone by the time the strands run these.
+    asio::dispatch(bulk_strand_, [this, alive = alive_]()
+    {
+        if (*alive) {
+            bulk_pool_.stop();
+        }
+    });
+    asio::dispatch(strand_, [this, alive = alive_]()
+    {
+        if (*alive) {
+            transport_.stop();
+        }
+    });
+}
+
+auto Control::async_dump_routes_impl(RouteDumpFilter filter,
+        std::pmr::memory_resource* pmr)
+        -> asio::awaitable<route_list_result_t> {
+    auto lease = co_await bulk_pool_.async_acquire();
+    if (!lease) {
+        co_return std::unexpected{lease.error()};
     }
 
     auto sequence = sequence_.fetch_add(1, std::memory_order_relaxed);
-    RouteDumpTask task{guard, std::pmr::get_default_resource(), 0, sequence};
+    RouteDumpTask task{lease->transport().socket_guard(), pmr, 0, sequence};
+    task.set_filter(std::move(filter));
 
-    co_return co_await task.async_run();
+    co_return co_await run_on(lease->transport(), task.async_run(lease->transport()));
 }
 
-auto Control::async_dump_addresses_impl() -> asio::awaitable<address_list_result_t> {
-    co_await acquire_socket_token();
+auto Control::async_dump_addresses_impl(AddressDumpFilter filter,
+        std::pmr::memory_resource* pmr)
+        -> asio::awaitable<address_list_result_t> {
+    auto lease = co_await bulk_pool_.async_acquire();
+    if (!lease) {
+        co_return std::unexpected{lease.error()};
+    }
 
-    SocketGuard guard{io_, "nl-control-address"};
+    auto sequence = sequence_.fetch_add(1, std::memory_order_relaxed);
+    AddressDumpTask task{lease->transport().socket_guard(), pmr, 0, sequence};
+    task.set_filter(std::move(filter));
 
-    if (auto result = guard.ensure_open(); !result) {
-        co_return std::unexpected(result.error());
+    co_return co_await run_on(lease->transport(), task.async_run(lease->transport()));
+}
+
+auto Control::async_dump_links_impl(LinkDumpFilter filter, std::pmr::memory_resource* pmr)
+        -> asio::awaitable<link_list_result_t> {
+    auto lease = co_await bulk_pool_.async_acquire();
+    if (!lease) {
+        co_return std::unexpected{lease.error()};
     }
 
     auto sequence = sequence_.fetch_add(1, std::memory_order_relaxed);
-    AddressDumpTask task{guard, std::pmr::get_default_resource(), 0, sequence};
+    LinkDumpTask task{lease->transport().socket_guard(), pmr, 0, sequence};
+    task.set_filter(std::move(filter));
 
-    co_return co_await task.async_run();
+    co_return co_await run_on(lease->transport(), task.async_run(lease->transport()));
 }
 
-auto Control::async_dump_neighbors_impl() -> asio::awaitable<neighbor_list_result> {
-    co_await acquire_socket_token();
+auto Control::async_dump_neighbors_impl(NeighborDumpFilter filter,
+        std::pmr::memory_resource* pmr)
+        -> asio::awaitable<neighbor_list_result> {
+    auto lease = co_await bulk_pool_.async_acquire();
+    if (!lease) {
+        co_return std::unexpected{lease.error()};
+    }
+
+    auto sequence = sequence_.fetch_add(1, std::memory_order_relaxed);
+    NeighborDumpTask task{lease->transport().socket_guard(), pmr, 0, sequence};
+    task.set_filter(std::move(filter));
 
-    SocketGuard guard{io_, "nl-control-neighbor"};
+    co_return co_await run_on(lease->transport(), task.async_run(lease->transport()));
+}
 
-    if (auto result = guard.ensure_open(); !result) {
-        co_return std::unexpected(result.error());
+auto Control::async_stream_routes_impl(RouteDumpFilter filter,
+        RouteEventChunkHandler on_chunk,
+        std::pmr::memory_resource* pmr)
+        -> asio::awaitable<void_result_t> {
+    auto lease = co_await bulk_pool_.async_acquire();
+    if (!lease) {
+        co_return std::unexpected{lease.error()};
     }
 
     auto sequence = sequence_.fetch_add(1, std::memory_order_relaxed);
-    NeighborDumpTask task{guard, std::pmr::get_default_resource(), 0, sequence};
+    RouteDumpTask task{lease->transport().socket_guard(), pmr, 0, sequence};
+    task.set_filter(std::move(filter));
+    task.set_chunk_handler(std::move(on_chunk));
 
-    co_return co_await task.async_run();
+    auto result = co_await run_on(lease->transport(), task.async_run(lease->transport()));
+    if (!result) {
+        co_return std::unexpected{result.error()};
+    }
+
+    co_return void_result_t{};
 }
 
-auto Control::async_dump_links_impl() -> asio::awaitable<link_list_result_t> {
-    co_await acquire_socket_token();
+auto Control::async_stream_addresses_impl(AddressDumpFilter filter,
+        AddressEventChunkHandler on_chunk,
+        std::pmr::memory_resource* pmr)
+        -> asio::awaitable<void_result_t> {
+    auto lease = co_await bulk_pool_.async_acquire();
+    if (!lease) {
+        co_return std::unexpected{lease.error()};
+    }
 
-    SocketGuard guard{io_, "nl-control-link"};
+    auto sequence = sequence_.fetch_add(1, std::memory_order_relaxed);
+    AddressDumpTask task{lease->transport().socket_guard(), pmr, 0, sequence};
+    task.set_filter(std::move(filter));
+    task.set_chunk_handler(std::move(on_chunk));
 
-    if (auto result = guard.ensure_open(); !result) {
-        co_return std::unexpected(result.error());
+    auto result = co_await run_on(lease->transport(), task.async_run(lease->transport()));
+    if (!result) {
+        co_return std::unexpected{result.error()};
+    }
+
+    co_return void_result_t{};
+}
+
+auto Control::async_stream_links_impl(LinkDumpFilter filter,
+        LinkEventChunkHandler on_chunk,
+        std::pmr::memory_resource* pmr)
+        -> asio::awaitable<void_result_t> {
+    auto lease = co_await bulk_pool_.async_acquire();
+    if (!lease) {
+        co_return std::unexpected{lease.error()};
     }
 
     auto sequence = sequence_.fetch_add(1, std::memory_order_relaxed);
-    LinkDumpTask task{guard, std::pmr::get_default_resource(), 0, sequence};
+    LinkDumpTask task{lease->transport().socket_guard(), pmr, 0, sequence};
+    task.set_filter(std::move(filter));
+    task.set_chunk_handler(std::move(on_chunk));
 
-    co_return co_await task.async_run();
+    auto result = co_await run_on(lease->transport(), task.async_run(lease->transport()));
+    if (!result) {
+        co_return std::unexpected{result.error()};
+    }
+
+    co_return void_result_t{};
 }
 
-auto Control::async_probe_neighbor_impl(uint16_t ifindex, std::span<uint8_t, 16> address)
+auto Control::async_stream_neighbors_impl(NeighborDumpFilter filter,
+        NeighborEventChunkHandler on_chunk,
+        std::pmr::memory_resource* pmr)
         -> asio::awaitable<void_result_t> {
-    co_await acquire_socket_token();
+    auto lease = co_await bulk_pool_.async_acquire();
+    if (!lease) {
+        co_return std::unexpected{lease.error()};
+    }
+
+    auto sequence = sequence_.fetch_add(1, std::memory_order_relaxed);
+    NeighborDumpTask task{lease->transport().socket_guard(), pmr, 0, sequence};
+    task.set_filter(std::move(filter));
+    task.set_chunk_handler(std::move(on_chunk));
 
-    if (auto result = socket_guard_.ensure_open(); !result) {
-        co_return std::unexpected(result.error());
+    auto result = co_await run_on(lease->transport(), task.async_run(lease->transport()));
+    if (!result) {
+        co_return std::unexpected{result.error()};
+    }
+
+    co_return void_result_t{};
+}
+
+auto Control::async_dump_routes_compact_impl(RouteDumpFilter filter,
+        std::pmr::memory_resource* pmr)
+        -> asio::awaitable<compact_route_list_result_t> {
+    auto lease = co_await bulk_pool_.async_acquire();
+    if (!lease) {
+        co_return std::unexpected{lease.error()};
     }
 
     auto sequence = sequence_.fetch_add(1, std::memory_order_relaxed);
-    NeighborProbeTask task{socket_guard_, ifindex, sequence, address};
+    RouteDumpTask task{lease->transport().socket_guard(), pmr, 0, sequence};
+    task.set_filter(std::move(filter));
 
-    co_return co_await task.async_run();
+    CompactRouteEventList routes{pmr};
+    task.set_view_handler([&routes](const RouteEventView& view)
+    {
+        routes.push_back(view.compact());
+    });
+
+    auto result = co_await run_on(lease->transport(), task.async_run(lease->transport()));
+    if (!result) {
+        co_return std::unexpected{result.error()};
+    }
+
+    co_return routes;
 }
 
-auto Control::async_flush_neighbor_impl(uint16_t ifindex, std::span<uint8_t, 16> address)
-        -> asio::awaitable<void_result_t> {
-    co_await acquire_socket_token();
+auto Control::async_dump_addresses_compact_impl(AddressDumpFilter filter,
+        std::pmr::memory_resource* pmr)
+        -> asio::awaitable<compact_address_list_result_t> {
+    auto lease = co_await bulk_pool_.async_acquire();
+    if (!lease) {
+        co_return std::unexpected{lease.error()};
+    }
+
+    auto sequence = sequence_.fetch_add(1, std::memory_order_relaxed);
+    AddressDumpTask task{lease->transport().socket_guard(), pmr, 0, sequence};
+    task.set_filter(std::move(filter));
+
+    CompactAddressEventList addresses{pmr};
+    task.set_view_handler([&addresses](const AddressEventView& view)
+    {
+        addresses.push_back(view.compact());
+    });
+
+    auto result = co_await run_on(lease->transport(), task.async_run(lease->transport()));
+    if (!result) {
+        co_return std::unexpected{result.error()};
+    }
+
+    co_return addresses;
+}
 
-    if (auto result = socket_guard_.ensure_open(); !result) {
-        co_return std::unexpected(result.error());
+auto Control::async_dump_links_compact_impl(LinkDumpFilter filter,
+        std::pmr::memory_resource* pmr)
+        -> asio::awaitable<compact_link_list_result_t> {
+    auto lease = co_await bulk_pool_.async_acquire();
+    if (!lease) {
+        co_return std::unexpected{lease.error()};
     }
 
     auto sequence = sequence_.fetch_add(1, std::memory_order_relaxed);
-    NeighborFlushTask task{socket_guard_, ifindex, sequence, address};
+    LinkDumpTask task{lease->transport().socket_guard(), pmr, 0, sequence};
+    task.set_filter(std::move(filter));
 
-    co_return co_await task.async_run();
+    CompactLinkEventList links{pmr};
+    task.set_view_handler([&links](const LinkEventView& view)
+    {
+        links.push_back(view.compact());
+    });
+
+    auto result = co_await run_on(lease->transport(), task.async_run(lease->transport()));
+    if (!result) {
+        co_return std::unexpected{result.error()};
+    }
+
+    co_return links;
 }
 
-auto Control::async_get_neighbor_impl(uint16_t ifindex, std::span<uint8_t, 16> address)
-        -> asio::awaitable<neighbor_result_t> {
-    co_await acquire_socket_token();
+auto Control::async_dump_neighbors_compact_impl(NeighborDumpFilter filter,
+        std::pmr::memory_resource* pmr)
+        -> asio::awaitable<compact_neighbor_list_result_t> {
+    auto lease = co_await bulk_pool_.async_acquire();
+    if (!lease) {
+        co_return std::unexpected{lease.error()};
+    }
+
+    auto sequence = sequence_.fetch_add(1, std::memory_order_relaxed);
+    NeighborDumpTask task{lease->transport().socket_guard(), pmr, 0, sequence};
+    task.set_filter(std::move(filter));
+
+    CompactNeighborEventList neighbors{pmr};
+    task.set_view_handler([&neighbors](const NeighborEventView& view)
+    {
+        neighbors.push_back(view.compact());
+    });
 
-    if (auto result = socket_guard_.ensure_open(); !result) {
-        co_return std::unexpected(result.error());
+    auto result = co_await run_on(lease->transport(), task.async_run(lease->transport()));
+    if (!result) {
+        co_return std::unexpected{result.error()};
     }
 
+    co_return neighbors;
+}
+
+auto Control::async_dump_route_shards_impl(std::vector<RouteDumpFilter> shards,
+        ShardOrder order, std::pmr::memory_resource* pmr)
+        -> asio::awaitable<route_list_result_t> {
+    co_return co_await dump_shards<RouteEventList>(bulk_strand_, std::move(shards),
+            order, pmr, [this, pmr](RouteDumpFilter shard)
+    {
+        return async_dump_routes_impl(std::move(shard), pmr);
+    });
+}
+
+auto Control::async_dump_route_shards_compact_impl(std::vector<RouteDumpFilter> shards,
+        ShardOrder order, std::pmr::memory_resource* pmr)
+        -> asio::awaitable<compact_route_list_result_t> {
+    co_return co_await dump_shards<CompactRouteEventList>(bulk_strand_,
+            std::move(shards), order, pmr, [this, pmr](RouteDumpFilter shard)
+    {
+        return async_dump_routes_compact_impl(std::move(shard), pmr);
+    });
+}
+
+auto Control::async_dump_neighbor_shards_impl(std::vector<NeighborDumpFilter> shards,
+        ShardOrder order, std::pmr::memory_resource* pmr)
+        -> asio::awaitable<neighbor_list_result> {
+    co_return co_await dump_shards<NeighborEventList>(bulk_strand_, std::move(shards),
+            order, pmr, [this, pmr](NeighborDumpFilter shard)
+    {
+        return async_dump_neighbors_impl(std::move(shard), pmr);
+    });
+}
+
+auto Control::async_dump_neighbor_shards_compact_impl(
+        std::vector<NeighborDumpFilter> shards, ShardOrder order,
+        std::pmr::memory_resource* pmr)
+        -> asio::awaitable<compact_neighbor_list_result_t> {
+    co_return co_await dump_shards<CompactNeighborEventList>(bulk_strand_,
+            std::move(shards), order, pmr, [this, pmr](NeighborDumpFilter shard)
+    {
+        return async_dump_neighbors_compact_impl(std::move(shard), pmr);
+    });
+}
+
+auto Control::async_probe_neighbor_impl(uint16_t ifindex, std::span<uint8_t, 16> address)
+        -> asio::awaitable<void_result_t> {
     auto sequence = sequence_.fetch_add(1, std::memory_order_relaxed);
-    NeighborGetTask task{socket_guard_, ifindex, sequence, address};
+    NeighborProbeTask task{transport_.socket_guard(), ifindex, sequence, address};
 
-    co_return co_await task.async_run();
+    co_return co_await task.async_run(transport_);
+}
+
+auto Control::async_flush_neighbor_impl(uint16_t ifindex, std::span<uint8_t, 16> address)
+        -> asio::awaitable<void_result_t> {
+    auto sequence = sequence_.fetch_add(1, std::memory_order_relaxed);
+    NeighborFlushTask task{transport_.socket_guard(), ifindex, sequence, address};
+
+    co_return co_await task.async_run(transport_);
+}
+
+auto Control::async_get_neighbor_impl(uint16_t ifindex, std::span<uint8_t, 16> address)
+        -> asio::awaitable<neighbor_result_t> {
+    auto sequence = sequence_.fetch_add(1, std::memory_order_relaxed);
+    NeighborGetTask task{transport_.socket_guard(), ifindex, sequence, address};
+
+    co_return co_await task.async_run(transport_);
 }
 
-auto Control::acquire_socket_token() -> asio::awaitable<void> {
-    auto next = gate_.expiry() + std::chrono::nanoseconds{1};
-    auto now = asio::steady_timer::clock_type::now();
+auto Control::async_route_impl(RouteOp op, RouteSpec route)
+        -> asio::awaitable<void_result_t> {
+    auto sequence = sequence_.fetch_add(1, std::memory_order_relaxed);
+    RouteBulkTask task{transport_, op, std::span{&route, 1U}, sequence};
 
-    if (next <= now) {
-        next = now + std::chrono::nanoseconds{1};
+    auto result = co_await task.async_run();
+    if (!result) {
+        co_return std::unexpected{result.error()};
     }
 
-    gate_.expires_at(next);
+    if (!result->ok()) {
+        co_return std::unexpected{result->failures.front().error};
+    }
 
-    boost::system::error_code ec;
-    co_await gate_.async_wait(asio::redirect_error(asio::use_awaitable, ec));
+    co_return void_result_t{};
+}
 
-    if (ec && ec != asio::error::operation_aborted) {
-        throw std::runtime_error("gate wait failed: " + ec.message());
+auto Control::async_apply_routes_impl(RouteOp op, std::span<const RouteSpec> routes,
+        RouteBulkOptions options) -> asio::awaitable<route_bulk_result_t> {
+    auto lease = co_await bulk_pool_.async_acquire();
+    if (!lease) {
+        co_return std::unexpected{lease.error()};
     }
+
+    // Reserve one sequence number per route so acks map back to their index.
+    auto sequence = sequence_.fetch_add(static_cast<uint32_t>(routes.size()),
+            std::memory_order_relaxed);
+    RouteBulkTask task{lease->transport(), op, routes, sequence, options};
+
+    co_return co_await run_on(lease->transport(), task.async_run());
+}
+
+auto Control::async_commit_impl(const TransactionBuilder& transaction)
+        -> asio::awaitable<transaction_result_t> {
+    // One sequence number per operation, rejected ones included, so an ack's
+    // sequence is its operation's index.
+    auto sequence = sequence_.fetch_add(static_cast<uint32_t>(transaction.size()),
+            std::memory_order_relaxed);
+    TransactionTask task{transport_, transaction, sequence};
+
+    co_return co_await task.async_run();
+}
+
+auto Control::async_post_impl(const TransactionBuilder& transaction,
+        WriteErrorHandler on_error) -> asio::awaitable<void_result_t> {
+    auto sequence = sequence_.fetch_add(
+            static_cast<uint32_t>(TransactionTask::sequences(transaction)),
+            std::memory_order_relaxed);
+    TransactionTask task{transport_, transaction, sequence};
+
+    co_return co_await task.async_post(std::move(on_error));
+}
+
+auto Control::async_barrier_impl() -> asio::awaitable<void_result_t> {
+    auto sequence = sequence_.fetch_add(1, std::memory_order_relaxed);
+    MessageBuilder request{};
+    request.begin(NLMSG_NOOP, NLM_F_REQUEST | NLM_F_ACK, sequence);
+    request.end();
+
+    co_return co_await transport_.async_transact(request.data(),
+            [](const nlmsghdr& header) { return header.nlmsg_type == NLMSG_ERROR; });
 }
 
 } // namespace rtaco
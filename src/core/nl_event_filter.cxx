@@ -0,0 +1,341 @@
+#include "rtaco/core/nl_event_filter.hxx"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <limits>
+#include <span>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <linux/filter.h>
+#include <linux/neighbour.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+
+namespace llmx {
+namespace rtaco {
+
+namespace {
+constexpr uint32_t ACCEPT = std::numeric_limits<uint32_t>::max();
+constexpr uint32_t REJECT = 0U;
+
+/** Attributes searched for RTA_TABLE / RTA_OIF before giving up. */
+constexpr size_t MAX_ATTRIBUTE_HOPS = 16U;
+
+// Netlink headers are in host byte order but BPF_H / BPF_W loads read
+// big-endian, so constants are compared in the order the loads produce.
+constexpr auto wire16(uint16_t value) noexcept -> uint32_t {
+    if constexpr (std::endian::native == std::endian::little) {
+        return std::byteswap(value);
+    }
+    return value;
+}
+
+constexpr auto wire32(uint32_t value) noexcept -> uint32_t {
+    if constexpr (std::endian::native == std::endian::little) {
+        return std::byteswap(value);
+    }
+    return value;
+}
+
+constexpr auto payload(size_t offset) noexcept -> uint32_t {
+    return static_cast<uint32_t>(NLMSG_HDRLEN + offset);
+}
+
+template<typename Value>
+auto contains(const std::vector<Value>& values, Value value) noexcept -> bool {
+    return values.empty() || std::ranges::find(values, value) != values.end();
+}
+
+/** Instruction buffer with forward labels.
+ *
+ * Conditional jumps only ever skip the next instruction; longer distances
+ * go through BPF_JA, whose 32-bit offset is patched in `finish`.
+ */
+class Program {
+public:
+    auto label() -> size_t {
+        targets_.push_back(0U);
+        return targets_.size() - 1U;
+    }
+
+    void bind(size_t label) {
+        targets_[label] = code_.size();
+    }
+
+    void emit(uint16_t code, uint32_t k = 0U, uint8_t jt = 0U, uint8_t jf = 0U) {
+        code_.push_back(sock_filter{code, jt, jf, k});
+    }
+
+    void jump(size_t label) {
+        fixups_.emplace_back(code_.size(), label);
+        emit(BPF_JMP | BPF_JA);
+    }
+
+    /** Go to `label` if A == k. */
+    void jump_if(uint32_t k, size_t label) {
+        emit(BPF_JMP | BPF_JEQ | BPF_K, k, 0U, 1U);
+        jump(label);
+    }
+
+    /** Fall through if `A <op> k` holds, otherwise drop the datagram. */
+    void require(uint16_t op, uint32_t k) {
+        emit(BPF_JMP | op | BPF_K, k, 1U, 0U);
+        emit(BPF_RET | BPF_K, REJECT);
+    }
+
+    /** Fall through if A equals one of `values`, otherwise drop the datagram. */
+    void require_any(std::span<const uint32_t> values) {
+        const auto matched = label();
+        for (const auto value : values) {
+            jump_if(value, matched);
+        }
+        emit(BPF_RET | BPF_K, REJECT);
+        bind(matched);
+    }
+
+    auto finish() -> std::vector<sock_filter> {
+        for (const auto& [at, label] : fixups_) {
+            code_[at].k = static_cast<uint32_t>(targets_[label] - at - 1U);
+        }
+        return std::move(code_);
+    }
+
+private:
+    std::vector<sock_filter> code_{};
+    std::vector<size_t> targets_{};
+    std::vector<std::pair<size_t, size_t>> fixups_{};
+};
+
+auto wire_indexes(const std::vector<int>& indexes) -> std::vector<uint32_t> {
+    std::vector<uint32_t> values{};
+    values.reserve(indexes.size());
+    for (const auto index : indexes) {
+        values.push_back(wire32(static_cast<uint32_t>(index)));
+    }
+    return values;
+}
+
+void require_family(Program& program, uint8_t family) {
+    if (family != AF_UNSPEC) {
+        // Every rtnetlink family header starts with its address family.
+        program.emit(BPF_LD | BPF_B | BPF_ABS, payload(0U));
+        program.require(BPF_JEQ, family);
+    }
+}
+
+void require_index(Program& program, const std::vector<int>& indexes, size_t offset) {
+    if (!indexes.empty()) {
+        program.emit(BPF_LD | BPF_W | BPF_ABS, payload(offset));
+        program.require_any(wire_indexes(indexes));
+    }
+}
+
+/** Load the host-order rta_len at X into A. Clobbers M[1], M[2] and X. */
+void load_attribute_length(Program& program) {
+    program.emit(BPF_LD | BPF_H | BPF_IND, offsetof(rtattr, rta_len));
+
+    if constexpr (std::endian::native == std::endian::little) {
+        program.emit(BPF_ST, 1U);
+        program.emit(BPF_ALU | BPF_RSH | BPF_K, 8U);
+        program.emit(BPF_ST, 2U);
+        program.emit(BPF_LD | BPF_MEM, 1U);
+        program.emit(BPF_ALU | BPF_AND | BPF_K, 0xFFU);
+        program.emit(BPF_ALU | BPF_LSH | BPF_K, 8U);
+        program.emit(BPF_LDX | BPF_MEM, 2U);
+        program.emit(BPF_ALU | BPF_OR | BPF_X);
+    }
+}
+
+/** Point X at the first attribute of `type` or drop the datagram.
+ *
+ * Classic BPF has no backward jumps, so the walk is unrolled.
+ */
+void find_attribute(Program& program, uint32_t first, uint16_t type) {
+    const auto found = program.label();
+    const auto type_mask = wire16(static_cast<uint16_t>(NLA_TYPE_MASK));
+
+    program.emit(BPF_LDX | BPF_W | BPF_IMM, first);
+    for (size_t hop = 0; hop < MAX_ATTRIBUTE_HOPS; ++hop) {
+        program.emit(BPF_LD | BPF_H | BPF_IND, offsetof(rtattr, rta_type));
+        program.emit(BPF_ALU | BPF_AND | BPF_K, type_mask);
+        program.jump_if(wire16(type), found);
+
+        program.emit(BPF_STX, 0U);
+        load_attribute_length(program);
+        program.require(BPF_JGE, sizeof(rtattr));
+        program.emit(BPF_ALU | BPF_ADD | BPF_K, RTA_ALIGNTO - 1U);
+        program.emit(BPF_ALU | BPF_AND | BPF_K, ~(RTA_ALIGNTO - 1U));
+        program.emit(BPF_LDX | BPF_MEM, 0U);
+        program.emit(BPF_ALU | BPF_ADD | BPF_X);
+        program.emit(BPF_MISC | BPF_TAX);
+    }
+    program.emit(BPF_RET | BPF_K, REJECT);
+
+    program.bind(found);
+}
+
+/** Load the u32 payload of attribute `type` into A or drop the datagram. */
+void load_route_attribute(Program& program, uint16_t type) {
+    find_attribute(program, NLMSG_SPACE(sizeof(rtmsg)), type);
+    program.emit(BPF_LD | BPF_W | BPF_IND, RTA_LENGTH(0U));
+}
+
+void emit_link(Program& program, const LinkFilter& filter) {
+    require_index(program, filter.indexes, offsetof(ifinfomsg, ifi_index));
+}
+
+void emit_address(Program& program, const AddressFilter& filter) {
+    require_family(program, filter.family);
+    require_index(program, filter.indexes, offsetof(ifaddrmsg, ifa_index));
+}
+
+void emit_route(Program& program, const RouteFilter& filter) {
+    require_family(program, filter.family);
+
+    if (filter.protocol != RTPROT_UNSPEC) {
+        program.emit(BPF_LD | BPF_B | BPF_ABS, payload(offsetof(rtmsg, rtm_protocol)));
+        program.require(BPF_JEQ, filter.protocol);
+    }
+
+    // rtm_table holds ids below 256; larger ones only appear in RTA_TABLE.
+    if (filter.table != RT_TABLE_UNSPEC && filter.table < 256U) {
+        program.emit(BPF_LD | BPF_B | BPF_ABS, payload(offsetof(rtmsg, rtm_table)));
+        program.require(BPF_JEQ, filter.table);
+    } else if (filter.table != RT_TABLE_UNSPEC) {
+        load_route_attribute(program, RTA_TABLE);
+        program.require(BPF_JEQ, wire32(filter.table));
+    }
+
+    if (!filter.oif_indexes.empty()) {
+        load_route_attribute(program, RTA_OIF);
+        program.require_any(wire_indexes(filter.oif_indexes));
+    }
+}
+
+void emit_neighbor(Program& program, const NeighborFilter& filter) {
+    require_family(program, filter.family);
+    require_index(program, filter.indexes, offsetof(ndmsg, ndm_ifindex));
+
+    if (filter.states != 0U) {
+        program.emit(BPF_LD | BPF_H | BPF_ABS, payload(offsetof(ndmsg, ndm_state)));
+        program.require(BPF_JSET, wire16(filter.states));
+    }
+}
+
+auto match_family(uint8_t wanted, uint8_t family) noexcept -> bool {
+    return wanted == AF_UNSPEC || wanted == family;
+}
+
+auto match_route(const RouteFilter& filter, uint8_t family, uint32_t table,
+        uint8_t protocol, uint32_t oif) noexcept -> bool {
+    return match_family(filter.family, family) &&
+           (filter.table == RT_TABLE_UNSPEC || filter.table == table) &&
+           (filter.protocol == RTPROT_UNSPEC || filter.protocol == protocol) &&
+           contains(filter.oif_indexes, static_cast<int>(oif));
+}
+
+auto match_neighbor(const NeighborFilter& filter, int index, uint8_t family,
+        NeighborEvent::State state) noexcept -> bool {
+    return match_family(filter.family, family) && contains(filter.indexes, index) &&
+           (filter.states == 0U || (static_cast<uint16_t>(state) & filter.states) != 0U);
+}
+} // namespace
+
+auto LinkFilter::matches(const LinkEventView& view) const noexcept -> bool {
+    return contains(indexes, view.index());
+}
+
+auto LinkFilter::matches(const CompactLinkEvent& event) const noexcept -> bool {
+    return contains(indexes, event.index);
+}
+
+auto AddressFilter::matches(const AddressEventView& view) const noexcept -> bool {
+    return match_family(family, view.family()) && contains(indexes, view.index());
+}
+
+auto AddressFilter::matches(const CompactAddressEvent& event) const noexcept -> bool {
+    return match_family(family, event.family) && contains(indexes, event.index);
+}
+
+auto RouteFilter::matches(const RouteEventView& view) const noexcept -> bool {
+    return match_route(*this, view.family(), view.table(), view.protocol(),
+            view.oif_index());
+}
+
+auto RouteFilter::matches(const CompactRouteEvent& event) const noexcept -> bool {
+    return match_route(*this, event.family, event.table, event.protocol,
+            event.oif_index);
+}
+
+auto NeighborFilter::matches(const NeighborEventView& view) const noexcept -> bool {
+    return match_neighbor(*this, view.index(), view.family(), view.state());
+}
+
+auto NeighborFilter::matches(const CompactNeighborEvent& event) const noexcept -> bool {
+    return match_neighbor(*this, event.index, event.family, event.state);
+}
+
+auto compile_filter(const EventFilter& filter)
+        -> std::expected<std::vector<sock_filter>, std::error_code> {
+    Program program{};
+
+    const auto link = program.label();
+    const auto address = program.label();
+    const auto route = program.label();
+    const auto neighbor = program.label();
+
+    program.emit(BPF_LD | BPF_H | BPF_ABS, offsetof(nlmsghdr, nlmsg_type));
+    if (filter.link) {
+        program.jump_if(wire16(RTM_NEWLINK), link);
+        program.jump_if(wire16(RTM_DELLINK), link);
+    }
+    if (filter.address) {
+        program.jump_if(wire16(RTM_NEWADDR), address);
+        program.jump_if(wire16(RTM_DELADDR), address);
+    }
+    if (filter.route) {
+        program.jump_if(wire16(RTM_NEWROUTE), route);
+        program.jump_if(wire16(RTM_DELROUTE), route);
+    }
+    if (filter.neighbor) {
+        program.jump_if(wire16(RTM_NEWNEIGH), neighbor);
+        program.jump_if(wire16(RTM_DELNEIGH), neighbor);
+    }
+    program.emit(BPF_RET | BPF_K, ACCEPT);
+
+    if (filter.link) {
+        program.bind(link);
+        emit_link(program, *filter.link);
+        program.emit(BPF_RET | BPF_K, ACCEPT);
+    }
+    if (filter.address) {
+        program.bind(address);
+        emit_address(program, *filter.address);
+        program.emit(BPF_RET | BPF_K, ACCEPT);
+    }
+    if (filter.route) {
+        program.bind(route);
+        emit_route(program, *filter.route);
+        program.emit(BPF_RET | BPF_K, ACCEPT);
+    }
+    if (filter.neighbor) {
+        program.bind(neighbor);
+        emit_neighbor(program, *filter.neighbor);
+        program.emit(BPF_RET | BPF_K, ACCEPT);
+    }
+
+    auto code = program.finish();
+    if (code.size() > BPF_MAXINSNS) {
+        return std::unexpected(std::make_error_code(std::errc::value_too_large));
+    }
+
+    return code;
+}
+
+} // namespace rtaco
+} // namespace llmx
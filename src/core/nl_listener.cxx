@@ -1,28 +1,52 @@
 #include "rtaco/core/nl_listener.hxx"
 
+#include <algorithm>
 #include <array>
 #include <atomic>
+#include <cerrno>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <exception>
 #include <expected>
+#include <functional>
 #include <iostream>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <optional>
 #include <span>
+#include <string_view>
 #include <system_error>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include <boost/asio/error.hpp>
 #include <boost/system/error_code.hpp>
 #include <boost/asio/any_io_executor.hpp>
 #include <boost/asio/buffer.hpp>
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/dispatch.hpp>
 #include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/strand.hpp>
 
 #include <linux/neighbour.h>
 #include <linux/netlink.h>
 #include <linux/rtnetlink.h>
+#include <sys/socket.h>
 
+#include "rtaco/core/nl_dispatch_table.hxx"
 #include "rtaco/events/nl_address_event.hxx"
 #include "rtaco/events/nl_link_event.hxx"
 #include "rtaco/events/nl_route_event.hxx"
 #include "rtaco/events/nl_neighbor_event.hxx"
+#include "rtaco/tasks/nl_address_dump_task.hxx"
+#include "rtaco/tasks/nl_link_dump_task.hxx"
+#include "rtaco/tasks/nl_neighbor_dump_task.hxx"
+#include "rtaco/tasks/nl_route_dump_task.hxx"
 
 namespace llmx {
 namespace rtaco {
@@ -30,25 +54,271 @@ namespace rtaco {
 namespace asio = boost::asio;
 
 namespace {
-auto has_payload(const nlmsghdr& header, size_t min_len) noexcept -> bool {
-    if (header.nlmsg_len < NLMSG_LENGTH(min_len)) {
-        return false;
+// Dumps report `ifi_change == 0`, notifications the changed flag bits; the
+// field is not part of a link's state.
+auto normalized(CompactLinkEvent event) noexcept -> CompactLinkEvent {
+    event.change = 0U;
+    return event;
+}
+
+template<typename Event>
+auto normalized(const Event& event) noexcept -> Event {
+    return event;
+}
+
+template<typename Key, typename Event>
+void apply(std::unordered_map<Key, Event>& known, const Event& event, bool removed) {
+    if (removed) {
+        known.erase(Key::from(event));
+        return;
+    }
+
+    known.insert_or_assign(Key::from(event), normalized(event));
+}
+
+/** Dump one table through `transport` into a map keyed by entry identity,
+ * keeping only the entries `filter` would let through. */
+template<typename Task, typename Key, typename Event, typename Filter>
+auto async_snapshot(Transport& transport, uint32_t sequence,
+        std::optional<Filter> filter) -> asio::awaitable<
+        std::expected<std::unordered_map<Key, Event>, std::error_code>> {
+    std::unordered_map<Key, Event> snapshot{};
+
+    Task task{transport.socket_guard(), std::pmr::get_default_resource(), 0, sequence};
+    task.set_view_handler([&snapshot, &filter](const auto& view)
+    {
+        if (filter && !filter->matches(view)) {
+            return;
+        }
+
+        const auto event = normalized(view.compact());
+        snapshot.insert_or_assign(Key::from(event), event);
+    });
+
+    if (auto result = co_await task.async_run(transport); !result) {
+        co_return std::unexpected(result.error());
+    }
+
+    co_return snapshot;
+}
+
+auto family_groups(uint8_t family, uint32_t ipv4_group, uint32_t ipv6_group)
+        -> std::vector<uint32_t> {
+    switch (family) {
+    case AF_INET: return {ipv4_group};
+    case AF_INET6: return {ipv6_group};
+    default: return {ipv4_group, ipv6_group};
+    }
+}
+
+template<typename Arg>
+concept has_family = requires(const Arg& arg) { arg.family; } ||
+        requires(const Arg& arg) { arg.family(); };
+
+template<has_family Arg>
+auto family_of(const Arg& arg) noexcept -> uint8_t {
+    if constexpr (requires { arg.family(); }) {
+        return arg.family();
+    } else {
+        return arg.family;
+    }
+}
+
+/** Wrap `slot` so it owns `lease` and only sees arguments of `family`. */
+template<typename Arg, typename Lease>
+auto leased_slot(std::function<void(Arg)>&& slot, std::shared_ptr<Lease> lease,
+        uint8_t family = AF_UNSPEC) -> std::function<void(Arg)> {
+    return [slot = std::move(slot), lease = std::move(lease), family](Arg arg)
+    {
+        if constexpr (has_family<std::remove_cvref_t<Arg>>) {
+            if (family != AF_UNSPEC && family_of(arg) != family) {
+                return;
+            }
+        }
+        slot(arg);
+    };
+}
+
+/** Adapt a per-event slot to a batch signal; it sees the events one by one. */
+template<typename Event>
+auto each_of(std::function<void(const Event&)>&& slot)
+        -> std::function<void(std::span<const Event>)> {
+    return [slot = std::move(slot)](std::span<const Event> batch)
+    {
+        for (const auto& event : batch) {
+            slot(event);
+        }
+    };
+}
+
+/** Hand `events` to every subscriber of `signal` from one posted handler. */
+template<typename Event>
+void post_batch(asio::io_context& io, std::shared_ptr<std::atomic_bool> alive,
+        Dispatcher<void(std::span<const Event>)>& signal, std::vector<Event>&& events) {
+    if (events.empty()) {
+        return;
+    }
+
+    auto batch = std::make_shared<const std::vector<Event>>(std::move(events));
+    events.clear();
+
+    // The handler holds the slots rather than the listener's dispatcher.
+    asio::post(io, [emit = signal.emitter(), batch = std::move(batch),
+                           alive = std::move(alive)]() {
+        if (*alive) {
+            emit(std::span<const Event>{*batch});
+        }
+    });
+}
+
+auto default_shard_key(const LinkEvent& event) noexcept -> size_t {
+    return static_cast<size_t>(event.index);
+}
+
+auto default_shard_key(const AddressEvent& event) noexcept -> size_t {
+    return static_cast<size_t>(event.index);
+}
+
+auto default_shard_key(const NeighborEvent& event) noexcept -> size_t {
+    return static_cast<size_t>(event.index);
+}
+
+auto default_shard_key(const RouteEvent& event) noexcept -> size_t {
+    size_t seed = std::hash<std::string_view>{}(event.dst);
+    hash_combine(seed, event.family);
+    hash_combine(seed, event.dst_prefix_len);
+    hash_combine(seed, event.table);
+    return seed;
+}
+
+auto make_shards(const ShardOptions& options, asio::io_context& io)
+        -> std::vector<asio::strand<asio::any_io_executor>> {
+    const auto executor = options.executor ? options.executor
+                                           : asio::any_io_executor{io.get_executor()};
+    const auto count = options.count != 0U
+            ? options.count
+            : std::max<size_t>(std::thread::hardware_concurrency(), 1U);
+
+    std::vector<asio::strand<asio::any_io_executor>> shards{};
+    shards.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        shards.push_back(asio::make_strand(executor));
     }
+    return shards;
+}
 
-    return NLMSG_PAYLOAD(&header, 0) >= min_len;
+/** Forget mirrored entries `filter` no longer lets through; the kernel stops
+ * reporting their changes once the filter is attached. */
+template<typename Key, typename Event, typename Filter>
+void retain(std::unordered_map<Key, Event>& known, const std::optional<Filter>& filter) {
+    if (filter) {
+        std::erase_if(known, [&filter](const auto& entry) {
+            return !filter->matches(entry.second);
+        });
+    }
+}
+
+/** Replace `known` with `fresh`, reporting every entry that differs. */
+template<typename Key, typename Event, typename Emit>
+void reconcile(std::unordered_map<Key, Event>& known,
+        std::unordered_map<Key, Event>&& fresh, Emit&& emit) {
+    for (const auto& [key, event] : fresh) {
+        const auto it = known.find(key);
+        if (it == known.end() || it->second != event) {
+            emit(event, false);
+        }
+    }
+
+    for (const auto& [key, event] : known) {
+        if (!fresh.contains(key)) {
+            emit(event, true);
+        }
+    }
+
+    known = std::move(fresh);
 }
 } // namespace
 
-Listener::Listener(asio::io_context& io) noexcept
+/** @brief Keeps a set of multicast groups joined while it is alive.
+ *
+ * Owned by the slots connected through the listener; a slot is destroyed
+ * once it is disconnected and no emission still holds it, which leaves the
+ * groups.
+ */
+class Listener::GroupLease {
+public:
+    GroupLease(Listener& listener, std::vector<uint32_t> groups)
+        : listener_{listener}
+        , alive_{listener.alive_}
+        , groups_{std::move(groups)} {
+        listener_.join_groups(groups_);
+    }
+
+    ~GroupLease() {
+        if (*alive_) {
+            listener_.leave_groups(groups_);
+        }
+    }
+
+    GroupLease(const GroupLease&) = delete;
+    GroupLease& operator=(const GroupLease&) = delete;
+
+private:
+    Listener& listener_;
+    std::shared_ptr<std::atomic_bool> alive_;
+    std::vector<uint32_t> groups_;
+};
+
+Listener::Listener(asio::io_context& io, ListenerOptions options) noexcept
     : io_{io}
-    , socket_guard_{io_, "nl-listener"}
+    , socket_guard_{io_, "nl-listener", 0U}
     , on_link_event_{io_.get_executor()}
     , on_address_event_{io_.get_executor()}
     , on_route_event_{io_.get_executor()}
     , on_neighbor_event_{io_.get_executor()}
-    , on_nlmsgerr_event_{io_.get_executor()} {}
+    , on_nlmsgerr_event_{io_.get_executor()}
+    , on_link_view_{io_.get_executor()}
+    , on_address_view_{io_.get_executor()}
+    , on_route_view_{io_.get_executor()}
+    , on_neighbor_view_{io_.get_executor()}
+    , on_message_{io_.get_executor()}
+    , on_link_batch_{io_.get_executor()}
+    , on_address_batch_{io_.get_executor()}
+    , on_route_batch_{io_.get_executor()}
+    , on_neighbor_batch_{io_.get_executor()}
+    , on_link_sharded_{io_.get_executor()}
+    , on_address_sharded_{io_.get_executor()}
+    , on_route_sharded_{io_.get_executor()}
+    , on_neighbor_sharded_{io_.get_executor()}
+    , on_link_coalesced_{io_.get_executor()}
+    , on_address_coalesced_{io_.get_executor()}
+    , on_route_coalesced_{io_.get_executor()}
+    , on_neighbor_coalesced_{io_.get_executor()}
+    , buffer_{options.receive_buffer}
+    , batch_{options.batch_size, options.receive_buffer}
+    , batched_{options.batch_size > 1U}
+    , resync_on_overrun_{options.resync_on_overrun}
+    , resync_strand_{asio::make_strand(io_)}
+    , alive_{std::make_shared<std::atomic_bool>(true)}
+    , batch_options_{options.batch}
+    , batch_timer_{io_}
+    , shard_options_{std::move(options.shards)}
+    , shards_{make_shards(shard_options_, io_)}
+    , coalesce_options_{options.coalesce}
+    , coalesce_timer_{io_}
+    , filter_{std::move(options.filter)} {
+    if (resync_on_overrun_) {
+        resync_transport_ = std::make_shared<Transport>(io_, resync_strand_,
+                "nl-listener-resync");
+
+        // The mirrored state has to follow every table, subscribed or not.
+        join_groups({RTNLGRP_LINK, RTNLGRP_IPV4_IFADDR, RTNLGRP_IPV6_IFADDR,
+                RTNLGRP_IPV4_ROUTE, RTNLGRP_IPV6_ROUTE, RTNLGRP_NEIGH});
+    }
+}
 
 Listener::~Listener() {
+    *alive_ = false;
     stop();
 }
 
@@ -67,6 +337,16 @@ void Listener::start() {
 
     running_.store(true, std::memory_order_release);
 
+    if (resync_on_overrun_) {
+        if (auto rc = socket_guard_.socket().set_overrun_reporting(true); !rc) {
+            std::cerr << "Failed to enable overrun reporting: " << rc.error().message()
+                      << "\n";
+        }
+
+        start_resync(false);
+        return;
+    }
+
     request_read();
 }
 
@@ -77,6 +357,15 @@ void Listener::stop() {
 
     running_.store(false, std::memory_order_release);
     socket_guard_.stop();
+
+    if (resync_transport_) {
+        asio::dispatch(resync_strand_,
+                [transport = resync_transport_]() { transport->stop(); });
+    }
+}
+
+auto Listener::overruns() const noexcept -> uint64_t {
+    return overruns_.load(std::memory_order_relaxed);
 }
 
 auto Listener::open_socket() -> std::expected<void, std::error_code> {
@@ -85,15 +374,275 @@ auto Listener::open_socket() -> std::expected<void, std::error_code> {
         return rc;
     }
 
+    {
+        const std::lock_guard lock{filter_mutex_};
+        if (auto rc = apply_filter(filter_); !rc) {
+            std::cerr << "Failed to attach netlink filter: " << rc.error().message()
+                      << "\n";
+        }
+    }
+
+    const std::lock_guard lock{groups_mutex_};
+    for (const auto& [group, refs] : group_refs_) {
+        if (auto rc = socket_guard_.socket().join_group(group); !rc) {
+            std::cerr << "Failed to join netlink group " << group << ": "
+                      << rc.error().message() << "\n";
+        }
+    }
+
     return {};
 }
 
+auto Listener::set_filter(EventFilter filter) -> std::expected<void, std::error_code> {
+    const std::lock_guard lock{filter_mutex_};
+
+    if (socket_guard_.socket().is_open()) {
+        if (auto rc = apply_filter(filter); !rc) {
+            return rc;
+        }
+    } else if (auto program = compile_filter(filter); !program) {
+        return std::unexpected(program.error());
+    }
+
+    filter_ = std::move(filter);
+    return {};
+}
+
+auto Listener::filter() const -> EventFilter {
+    const std::lock_guard lock{filter_mutex_};
+    return filter_;
+}
+
+auto Listener::apply_filter(const EventFilter& filter)
+        -> std::expected<void, std::error_code> {
+    if (filter.empty()) {
+        return socket_guard_.socket().detach_filter();
+    }
+
+    auto program = compile_filter(filter);
+    if (!program) {
+        return std::unexpected(program.error());
+    }
+
+    return socket_guard_.socket().attach_filter(*program);
+}
+
+auto Listener::lease_groups(std::vector<uint32_t> groups) -> std::shared_ptr<GroupLease> {
+    return std::make_shared<GroupLease>(*this, std::move(groups));
+}
+
+void Listener::join_groups(const std::vector<uint32_t>& groups) {
+    const std::lock_guard lock{groups_mutex_};
+
+    for (const auto group : groups) {
+        if (group_refs_[group]++ != 0U || !socket_guard_.socket().is_open()) {
+            continue;
+        }
+
+        if (auto rc = socket_guard_.socket().join_group(group); !rc) {
+            std::cerr << "Failed to join netlink group " << group << ": "
+                      << rc.error().message() << "\n";
+        }
+    }
+}
+
+void Listener::leave_groups(const std::vector<uint32_t>& groups) {
+    const std::lock_guard lock{groups_mutex_};
+
+    for (const auto group : groups) {
+        const auto it = group_refs_.find(group);
+        if (it == group_refs_.end() || --it->second != 0U) {
+            continue;
+        }
+
+        group_refs_.erase(it);
+        if (socket_guard_.socket().is_open()) {
+            (void)socket_guard_.socket().leave_group(group);
+        }
+    }
+}
+
+auto Listener::connect_to_event(link_signal_t::slot_t&& slot, ExecPolicy policy)
+        -> Connection {
+    auto leased = leased_slot(std::move(slot), lease_groups({RTNLGRP_LINK}));
+    if (policy == ExecPolicy::Batched) {
+        return on_link_batch_.connect(each_of(std::move(leased)), policy);
+    }
+    if (policy == ExecPolicy::Sharded) {
+        return on_link_sharded_.connect(std::move(leased), policy);
+    }
+    return on_link_event_.connect(std::move(leased), policy);
+}
+
+auto Listener::connect_to_event(address_signal_t::slot_t&& slot, ExecPolicy policy,
+        uint8_t family) -> Connection {
+    auto lease = lease_groups(
+            family_groups(family, RTNLGRP_IPV4_IFADDR, RTNLGRP_IPV6_IFADDR));
+    auto leased = leased_slot(std::move(slot), std::move(lease), family);
+    if (policy == ExecPolicy::Batched) {
+        return on_address_batch_.connect(each_of(std::move(leased)), policy);
+    }
+    if (policy == ExecPolicy::Sharded) {
+        return on_address_sharded_.connect(std::move(leased), policy);
+    }
+    return on_address_event_.connect(std::move(leased), policy);
+}
+
+auto Listener::connect_to_event(route_signal_t::slot_t&& slot, ExecPolicy policy,
+        uint8_t family) -> Connection {
+    auto lease = lease_groups(
+            family_groups(family, RTNLGRP_IPV4_ROUTE, RTNLGRP_IPV6_ROUTE));
+    auto leased = leased_slot(std::move(slot), std::move(lease), family);
+    if (policy == ExecPolicy::Batched) {
+        return on_route_batch_.connect(each_of(std::move(leased)), policy);
+    }
+    if (policy == ExecPolicy::Sharded) {
+        return on_route_sharded_.connect(std::move(leased), policy);
+    }
+    return on_route_event_.connect(std::move(leased), policy);
+}
+
+auto Listener::connect_to_event(neighbor_signal_t::slot_t&& slot, ExecPolicy policy,
+        uint8_t family) -> Connection {
+    auto leased = leased_slot(std::move(slot), lease_groups({RTNLGRP_NEIGH}), family);
+    if (policy == ExecPolicy::Batched) {
+        return on_neighbor_batch_.connect(each_of(std::move(leased)), policy);
+    }
+    if (policy == ExecPolicy::Sharded) {
+        return on_neighbor_sharded_.connect(std::move(leased), policy);
+    }
+    return on_neighbor_event_.connect(std::move(leased), policy);
+}
+
+auto Listener::connect_to_batch(link_batch_signal_t::slot_t&& slot) -> Connection {
+    return on_link_batch_.connect(
+            leased_slot(std::move(slot), lease_groups({RTNLGRP_LINK})),
+            ExecPolicy::Batched);
+}
+
+auto Listener::connect_to_batch(address_batch_signal_t::slot_t&& slot) -> Connection {
+    return on_address_batch_.connect(
+            leased_slot(std::move(slot),
+                    lease_groups({RTNLGRP_IPV4_IFADDR, RTNLGRP_IPV6_IFADDR})),
+            ExecPolicy::Batched);
+}
+
+auto Listener::connect_to_batch(route_batch_signal_t::slot_t&& slot) -> Connection {
+    return on_route_batch_.connect(
+            leased_slot(std::move(slot),
+                    lease_groups({RTNLGRP_IPV4_ROUTE, RTNLGRP_IPV6_ROUTE})),
+            ExecPolicy::Batched);
+}
+
+auto Listener::connect_to_batch(neighbor_batch_signal_t::slot_t&& slot) -> Connection {
+    return on_neighbor_batch_.connect(
+            leased_slot(std::move(slot), lease_groups({RTNLGRP_NEIGH})),
+            ExecPolicy::Batched);
+}
+
+auto Listener::connect_to_coalesced(link_coalesced_signal_t::slot_t&& slot,
+        ExecPolicy policy) -> Connection {
+    return on_link_coalesced_.connect(
+            leased_slot(std::move(slot), lease_groups({RTNLGRP_LINK})), policy);
+}
+
+auto Listener::connect_to_coalesced(address_coalesced_signal_t::slot_t&& slot,
+        ExecPolicy policy) -> Connection {
+    return on_address_coalesced_.connect(
+            leased_slot(std::move(slot),
+                    lease_groups({RTNLGRP_IPV4_IFADDR, RTNLGRP_IPV6_IFADDR})),
+            policy);
+}
+
+auto Listener::connect_to_coalesced(route_coalesced_signal_t::slot_t&& slot,
+        ExecPolicy policy) -> Connection {
+    return on_route_coalesced_.connect(
+            leased_slot(std::move(slot),
+                    lease_groups({RTNLGRP_IPV4_ROUTE, RTNLGRP_IPV6_ROUTE})),
+            policy);
+}
+
+auto Listener::connect_to_coalesced(neighbor_coalesced_signal_t::slot_t&& slot,
+        ExecPolicy policy) -> Connection {
+    return on_neighbor_coalesced_.connect(
+            leased_slot(std::move(slot), lease_groups({RTNLGRP_NEIGH})), policy);
+}
+
+auto Listener::connect_to_view(link_view_signal_t::slot_t&& slot) -> Connection {
+    return on_link_view_.connect(
+            leased_slot(std::move(slot), lease_groups({RTNLGRP_LINK})), ExecPolicy::Sync);
+}
+
+auto Listener::connect_to_view(address_view_signal_t::slot_t&& slot, uint8_t family)
+        -> Connection {
+    auto lease = lease_groups(
+            family_groups(family, RTNLGRP_IPV4_IFADDR, RTNLGRP_IPV6_IFADDR));
+    return on_address_view_.connect(
+            leased_slot(std::move(slot), std::move(lease), family), ExecPolicy::Sync);
+}
+
+auto Listener::connect_to_view(route_view_signal_t::slot_t&& slot, uint8_t family)
+        -> Connection {
+    auto lease = lease_groups(
+            family_groups(family, RTNLGRP_IPV4_ROUTE, RTNLGRP_IPV6_ROUTE));
+    return on_route_view_.connect(
+            leased_slot(std::move(slot), std::move(lease), family), ExecPolicy::Sync);
+}
+
+auto Listener::connect_to_view(neighbor_view_signal_t::slot_t&& slot, uint8_t family)
+        -> Connection {
+    return on_neighbor_view_.connect(
+            leased_slot(std::move(slot), lease_groups({RTNLGRP_NEIGH}), family),
+            ExecPolicy::Sync);
+}
+
+auto Listener::connect_to_group(uint32_t group, message_signal_t::slot_t&& slot)
+        -> Connection {
+    return on_message_.connect(leased_slot(std::move(slot), lease_groups({group})),
+            ExecPolicy::Sync);
+}
+
 void Listener::request_read() {
     if (!running()) {
         return;
     }
 
-    socket_guard_.socket().async_receive(asio::buffer(buffer_),
+    if (batched_) {
+        socket_guard_.socket().async_wait(Socket::socket_t::wait_read,
+                [this](const auto& ec) { handle_readable(ec); });
+        return;
+    }
+
+    if (buffer_.needs_peek()) {
+        socket_guard_.socket().async_receive(asio::mutable_buffer{},
+                MSG_PEEK | MSG_TRUNC,
+                [this](const auto& ec, size_t pending) { handle_peek(ec, pending); });
+        return;
+    }
+
+    receive_datagram();
+}
+
+void Listener::handle_peek(const boost::system::error_code& ec, size_t pending) {
+    if (!running()) {
+        return;
+    }
+
+    if (ec == asio::error::operation_aborted) {
+        return;
+    }
+
+    if (ec) {
+        handle_receive_error(ec.value());
+        return;
+    }
+
+    buffer_.reserve(pending);
+    receive_datagram();
+}
+
+void Listener::receive_datagram() {
+    socket_guard_.socket().async_receive(buffer_.buffer(), MSG_TRUNC,
             [this](const auto& ec, size_t bytes) { handle_read(ec, bytes); });
 }
 
@@ -106,12 +655,83 @@ void Listener::handle_read(const boost::system::error_code& ec, size_t bytes) {
         return;
     }
 
+    if (ec) {
+        handle_receive_error(ec.value());
+        return;
+    }
+
+    const auto datagram = buffer_.received(bytes);
+    if (!datagram) {
+        std::cerr << "Warning: dropped truncated netlink datagram of " << bytes
+                  << " bytes (buffer holds " << buffer_.capacity() << ")\n";
+        if (!resync_after_loss()) {
+            request_read();
+        }
+        return;
+    }
+
+    process_messages(*datagram);
+    schedule_batches();
+    request_read();
+}
+
+void Listener::handle_readable(const boost::system::error_code& ec) {
+    if (!running()) {
+        return;
+    }
+
+    if (ec == asio::error::operation_aborted) {
+        return;
+    }
+
     if (ec) {
         request_read();
         return;
     }
 
-    process_messages(std::span<const uint8_t>(buffer_.data(), bytes));
+    const auto received = batch_.receive(socket_guard_.socket().native_handle());
+    if (!received) {
+        handle_receive_error(received.error().value());
+        return;
+    }
+
+    bool truncated = false;
+    for (size_t i = 0; i < *received && running(); ++i) {
+        const auto datagram = batch_.datagram(i);
+        if (!datagram) {
+            std::cerr << "Warning: dropped truncated netlink datagram (batch slot holds "
+                      << batch_.slot_size() << " bytes)\n";
+            truncated = true;
+            continue;
+        }
+
+        process_messages(*datagram);
+    }
+
+    schedule_batches();
+    if (truncated && resync_after_loss()) {
+        return;
+    }
+    request_read();
+}
+
+void Listener::handle_receive_error(int error) {
+    if (error == ENOBUFS && resync_after_loss()) {
+        return;
+    }
+
+    request_read();
+}
+
+auto Listener::resync_after_loss() -> bool {
+    if (!resync_on_overrun_) {
+        return false;
+    }
+
+    // Reading resumes once the resync is done.
+    overruns_.fetch_add(1U, std::memory_order_relaxed);
+    start_resync(true);
+    return true;
 }
 
 void Listener::process_messages(std::span<const uint8_t> data) {
@@ -128,36 +748,23 @@ void Listener::process_messages(std::span<const uint8_t> data) {
         std::cerr << "Warning: " << remaining
                   << " bytes of unread data remaining in netlink message buffer\n";
     }
-
-    request_read();
 }
 
 void Listener::handle_message(const nlmsghdr& header) {
-    using HandlerEntry12 = std::pair<size_t, void (Listener::*)(const nlmsghdr&)>;
-
-    static std::unordered_map<int, HandlerEntry12> handlers;
-
-    handlers[RTM_NEWLINK] = {sizeof(ifinfomsg), &Listener::handle_link_message};
-    handlers[RTM_DELLINK] = {sizeof(ifinfomsg), &Listener::handle_link_message};
-    handlers[RTM_NEWADDR] = {sizeof(ifaddrmsg), &Listener::handle_address_message};
-    handlers[RTM_DELADDR] = {sizeof(ifaddrmsg), &Listener::handle_address_message};
-    handlers[RTM_NEWROUTE] = {sizeof(rtmsg), &Listener::handle_route_message};
-    handlers[RTM_DELROUTE] = {sizeof(rtmsg), &Listener::handle_route_message};
-    handlers[RTM_NEWNEIGH] = {sizeof(ndmsg), &Listener::handle_neighbor_message};
-    handlers[RTM_DELNEIGH] = {sizeof(ndmsg), &Listener::handle_neighbor_message};
-    handlers[NLMSG_ERROR] = {sizeof(nlmsgerr), &Listener::handle_error_message};
+    static constexpr auto handlers = DispatchTable<Listener>::make<
+            MessageRoute<NLMSG_ERROR, nlmsgerr, &Listener::handle_error_message>,
+            MessageRoute<RTM_NEWLINK, ifinfomsg, &Listener::handle_link_message>,
+            MessageRoute<RTM_DELLINK, ifinfomsg, &Listener::handle_link_message>,
+            MessageRoute<RTM_NEWADDR, ifaddrmsg, &Listener::handle_address_message>,
+            MessageRoute<RTM_DELADDR, ifaddrmsg, &Listener::handle_address_message>,
+            MessageRoute<RTM_NEWROUTE, rtmsg, &Listener::handle_route_message>,
+            MessageRoute<RTM_DELROUTE, rtmsg, &Listener::handle_route_message>,
+            MessageRoute<RTM_NEWNEIGH, ndmsg, &Listener::handle_neighbor_message>,
+            MessageRoute<RTM_DELNEIGH, ndmsg, &Listener::handle_neighbor_message>>();
 
-    if (!handlers.contains(header.nlmsg_type)) {
-        return;
-    }
-
-    auto handler = handlers.at(header.nlmsg_type);
-
-    if (handler.first > 0 && !has_payload(header, handler.first)) {
-        return;
+    if (!handlers.dispatch(*this, header) && !on_message_.empty()) {
+        on_message_(header);
     }
-
-    (this->*handler.second)(header);
 }
 
 void Listener::handle_error_message(const nlmsghdr& header) {
@@ -168,43 +775,459 @@ void Listener::handle_error_message(const nlmsghdr& header) {
 }
 
 void Listener::handle_link_message(const nlmsghdr& header) {
-    const auto event = LinkEvent::from_nlmsghdr(header);
+    if (!resync_on_overrun_ && on_link_view_.empty() && on_link_event_.empty() &&
+            on_link_batch_.empty() && on_link_sharded_.empty() &&
+            on_link_coalesced_.empty()) {
+        return;
+    }
 
-    if (event.type == LinkEvent::Type::UNKNOWN) {
+    const LinkEventView view{header};
+
+    if (view.type() == LinkEvent::Type::UNKNOWN) {
         return;
     }
 
-    on_link_event_(event);
+    if (resync_on_overrun_) {
+        track(view);
+    }
+
+    if (!on_link_view_.empty()) {
+        on_link_view_(view);
+    }
+
+    if (!on_link_event_.empty()) {
+        on_link_event_(view.materialize());
+    }
+
+    if (!on_link_batch_.empty()) {
+        enqueue(link_batch_, view.materialize(), on_link_batch_);
+    }
+
+    if (!on_link_sharded_.empty()) {
+        post_sharded(view.materialize(), on_link_sharded_, shard_options_.link_key);
+    }
+
+    if (!on_link_coalesced_.empty()) {
+        coalesce(link_coalescer_, LinkKey::from(view.compact()), view.materialize());
+    }
 }
 
 void Listener::handle_address_message(const nlmsghdr& header) {
-    auto event = AddressEvent::from_nlmsghdr(header);
+    if (!resync_on_overrun_ && on_address_view_.empty() && on_address_event_.empty() &&
+            on_address_batch_.empty() && on_address_sharded_.empty() &&
+            on_address_coalesced_.empty()) {
+        return;
+    }
+
+    const AddressEventView view{header};
 
-    if (event.type == AddressEvent::Type::UNKNOWN) {
+    if (view.type() == AddressEvent::Type::UNKNOWN) {
         return;
     }
 
-    on_address_event_(event);
+    if (resync_on_overrun_) {
+        track(view);
+    }
+
+    if (!on_address_view_.empty()) {
+        on_address_view_(view);
+    }
+
+    if (!on_address_event_.empty()) {
+        on_address_event_(view.materialize());
+    }
+
+    if (!on_address_batch_.empty()) {
+        enqueue(address_batch_, view.materialize(), on_address_batch_);
+    }
+
+    if (!on_address_sharded_.empty()) {
+        post_sharded(view.materialize(), on_address_sharded_, shard_options_.address_key);
+    }
+
+    if (!on_address_coalesced_.empty()) {
+        coalesce(address_coalescer_, AddressKey::from(view.compact()),
+                view.materialize());
+    }
 }
 
 void Listener::handle_route_message(const nlmsghdr& header) {
-    const auto event = RouteEvent::from_nlmsghdr(header);
+    if (!resync_on_overrun_ && on_route_view_.empty() && on_route_event_.empty() &&
+            on_route_batch_.empty() && on_route_sharded_.empty() &&
+            on_route_coalesced_.empty()) {
+        return;
+    }
 
-    if (event.type == RouteEvent::Type::UNKNOWN) {
+    const RouteEventView view{header};
+
+    if (view.type() == RouteEvent::Type::UNKNOWN) {
         return;
     }
 
-    on_route_event_(event);
+    if (resync_on_overrun_) {
+        track(view);
+    }
+
+    if (!on_route_view_.empty()) {
+        on_route_view_(view);
+    }
+
+    if (!on_route_event_.empty()) {
+        on_route_event_(view.materialize());
+    }
+
+    if (!on_route_batch_.empty()) {
+        enqueue(route_batch_, view.materialize(), on_route_batch_);
+    }
+
+    if (!on_route_sharded_.empty()) {
+        post_sharded(view.materialize(), on_route_sharded_, shard_options_.route_key);
+    }
+
+    if (!on_route_coalesced_.empty()) {
+        coalesce(route_coalescer_, RouteKey::from(view.compact()), view.materialize());
+    }
 }
 
 void Listener::handle_neighbor_message(const nlmsghdr& header) {
-    const auto event = NeighborEvent::from_nlmsghdr(header);
+    if (!resync_on_overrun_ && on_neighbor_view_.empty() && on_neighbor_event_.empty() &&
+            on_neighbor_batch_.empty() && on_neighbor_sharded_.empty() &&
+            on_neighbor_coalesced_.empty()) {
+        return;
+    }
+
+    const NeighborEventView view{header};
+
+    if (view.type() == NeighborEvent::Type::UNKNOWN) {
+        return;
+    }
+
+    if (resync_on_overrun_) {
+        track(view);
+    }
+
+    if (!on_neighbor_view_.empty()) {
+        on_neighbor_view_(view);
+    }
+
+    if (!on_neighbor_event_.empty()) {
+        on_neighbor_event_(view.materialize());
+    }
+
+    if (!on_neighbor_batch_.empty()) {
+        enqueue(neighbor_batch_, view.materialize(), on_neighbor_batch_);
+    }
+
+    if (!on_neighbor_sharded_.empty()) {
+        post_sharded(view.materialize(), on_neighbor_sharded_,
+                shard_options_.neighbor_key);
+    }
+
+    if (!on_neighbor_coalesced_.empty()) {
+        coalesce(neighbor_coalescer_, NeighborKey::from(view.compact()),
+                view.materialize());
+    }
+}
 
-    if (event.type == NeighborEvent::Type::UNKNOWN) {
+template<typename Event>
+void Listener::enqueue(std::vector<Event>& pending, Event&& event,
+        Dispatcher<void(std::span<const Event>)>& signal) {
+    const std::lock_guard lock{batch_mutex_};
+    pending.push_back(std::move(event));
+
+    if (pending.size() >= batch_options_.max_events) {
+        post_batch(io_, alive_, signal, std::move(pending));
+    }
+}
+
+void Listener::schedule_batches() {
+    if (batch_options_.max_delay <= std::chrono::microseconds::zero()) {
+        flush_batches();
         return;
     }
 
-    on_neighbor_event_(event);
+    const std::lock_guard lock{batch_mutex_};
+    if (batch_timer_armed_ || (link_batch_.empty() && address_batch_.empty() &&
+                                      route_batch_.empty() && neighbor_batch_.empty())) {
+        return;
+    }
+
+    // Only the receive path arms the timer, so it is never used concurrently.
+    batch_timer_armed_ = true;
+    batch_timer_.expires_after(batch_options_.max_delay);
+    batch_timer_.async_wait([this, alive = alive_](const boost::system::error_code& ec) {
+        if (!*alive || ec == asio::error::operation_aborted) {
+            return;
+        }
+
+        {
+            const std::lock_guard lock{batch_mutex_};
+            batch_timer_armed_ = false;
+        }
+        flush_batches();
+    });
+}
+
+void Listener::flush_batches() {
+    const std::lock_guard lock{batch_mutex_};
+    post_batch(io_, alive_, on_link_batch_, std::move(link_batch_));
+    post_batch(io_, alive_, on_address_batch_, std::move(address_batch_));
+    post_batch(io_, alive_, on_route_batch_, std::move(route_batch_));
+    post_batch(io_, alive_, on_neighbor_batch_, std::move(neighbor_batch_));
+}
+
+template<typename Key, typename Event>
+void Listener::coalesce(Coalescer<Key, Event>& coalescer, const Key& key, Event&& event) {
+    const std::lock_guard lock{coalesce_mutex_};
+    coalescer.add(key, std::move(event));
+
+    if (coalesce_timer_armed_) {
+        return;
+    }
+
+    // Armed under the lock only, so the timer is never used concurrently.
+    coalesce_timer_armed_ = true;
+    coalesce_timer_.expires_after(coalesce_options_.window);
+    coalesce_timer_.async_wait(
+            [this, alive = alive_](const boost::system::error_code& ec) {
+        if (*alive && ec != asio::error::operation_aborted) {
+            flush_coalesced();
+        }
+    });
+}
+
+void Listener::flush_coalesced() {
+    std::vector<Coalesced<LinkEvent>> links{};
+    std::vector<Coalesced<AddressEvent>> addresses{};
+    std::vector<Coalesced<RouteEvent>> routes{};
+    std::vector<Coalesced<NeighborEvent>> neighbors{};
+
+    {
+        const std::lock_guard lock{coalesce_mutex_};
+        coalesce_timer_armed_ = false;
+        links = link_coalescer_.take();
+        addresses = address_coalescer_.take();
+        routes = route_coalescer_.take();
+        neighbors = neighbor_coalescer_.take();
+    }
+
+    for (const auto& entry : links) {
+        on_link_coalesced_(entry);
+    }
+    for (const auto& entry : addresses) {
+        on_address_coalesced_(entry);
+    }
+    for (const auto& entry : routes) {
+        on_route_coalesced_(entry);
+    }
+    for (const auto& entry : neighbors) {
+        on_neighbor_coalesced_(entry);
+    }
+}
+
+template<typename Event>
+void Listener::post_sharded(Event&& event, Dispatcher<void(const Event&)>& signal,
+        const std::function<size_t(const Event&)>& key) {
+    const auto shard = (key ? key(event) : default_shard_key(event)) % shards_.size();
+
+    // Shards may run on a pool that outlives the listener: the handler holds
+    // the slots rather than the listener's dispatcher.
+    asio::post(shards_[shard],
+            [emit = signal.emitter(), event = std::move(event), alive = alive_]() {
+        if (*alive) {
+            emit(event);
+        }
+    });
+}
+
+void Listener::start_resync(bool emit) {
+    // Whatever is still queued predates the dump and would roll its result
+    // back; everything received after this point is applied on top of it.
+    socket_guard_.socket().discard_pending();
+
+    // Batched subscribers get the changes read so far ahead of the delta,
+    // which is computed against them.
+    flush_batches();
+
+    asio::co_spawn(resync_strand_, resync(resync_transport_, alive_, emit, filter()),
+            [this, alive = alive_](std::exception_ptr)
+    {
+        if (*alive) {
+            asio::dispatch(io_, [this, alive]() {
+                if (*alive) {
+                    request_read();
+                }
+            });
+        }
+    });
+}
+
+auto Listener::resync(std::shared_ptr<Transport> transport,
+        std::shared_ptr<std::atomic_bool> alive, bool emit, EventFilter filter)
+        -> asio::awaitable<void> {
+    // `this` may be gone once a dump returns; only touch it after `alive`.
+    const auto sequence = sequence_.fetch_add(4U);
+
+    auto links = co_await async_snapshot<LinkDumpTask, LinkKey, CompactLinkEvent>(
+            *transport, sequence, filter.link);
+    auto addresses = co_await async_snapshot<AddressDumpTask, AddressKey,
+            CompactAddressEvent>(*transport, sequence + 1U, filter.address);
+    auto routes = co_await async_snapshot<RouteDumpTask, RouteKey, CompactRouteEvent>(
+            *transport, sequence + 2U, filter.route);
+    auto neighbors = co_await async_snapshot<NeighborDumpTask, NeighborKey,
+            CompactNeighborEvent>(*transport, sequence + 3U, filter.neighbor);
+
+    if (!*alive || !running()) {
+        co_return;
+    }
+
+    const auto report = [](std::string_view table, const std::error_code& error)
+    {
+        std::cerr << "Warning: " << table << " resync failed: " << error.message()
+                  << "\n";
+    };
+
+    if (links) {
+        std::vector<LinkEvent> changes{};
+        retain(known_links_, filter.link);
+        reconcile(known_links_, std::move(*links), [&](auto event, bool removed) {
+            if (!emit) {
+                return;
+            }
+
+            event.type = removed ? LinkEvent::Type::DELETE_LINK
+                                 : LinkEvent::Type::NEW_LINK;
+            if (!on_link_event_.empty()) {
+                on_link_event_(event.to_event());
+            }
+            if (!on_link_batch_.empty()) {
+                changes.push_back(event.to_event());
+            }
+            if (!on_link_sharded_.empty()) {
+                post_sharded(event.to_event(), on_link_sharded_, shard_options_.link_key);
+            }
+            if (!on_link_coalesced_.empty()) {
+                coalesce(link_coalescer_, LinkKey::from(event), event.to_event());
+            }
+        });
+        post_batch(io_, alive_, on_link_batch_, std::move(changes));
+    } else {
+        report("link", links.error());
+    }
+
+    if (addresses) {
+        std::vector<AddressEvent> changes{};
+        retain(known_addresses_, filter.address);
+        reconcile(known_addresses_, std::move(*addresses), [&](auto event, bool removed) {
+            if (!emit) {
+                return;
+            }
+
+            event.type = removed ? AddressEvent::Type::DELETE_ADDRESS
+                                 : AddressEvent::Type::NEW_ADDRESS;
+            if (!on_address_event_.empty()) {
+                on_address_event_(event.to_event());
+            }
+            if (!on_address_batch_.empty()) {
+                changes.push_back(event.to_event());
+            }
+            if (!on_address_sharded_.empty()) {
+                post_sharded(event.to_event(), on_address_sharded_,
+                        shard_options_.address_key);
+            }
+            if (!on_address_coalesced_.empty()) {
+                coalesce(address_coalescer_, AddressKey::from(event), event.to_event());
+            }
+        });
+        post_batch(io_, alive_, on_address_batch_, std::move(changes));
+    } else {
+        report("address", addresses.error());
+    }
+
+    if (routes) {
+        std::vector<RouteEvent> changes{};
+        retain(known_routes_, filter.route);
+        reconcile(known_routes_, std::move(*routes), [&](auto event, bool removed) {
+            if (!emit) {
+                return;
+            }
+
+            event.type = removed ? RouteEvent::Type::DELETE_ROUTE
+                                 : RouteEvent::Type::NEW_ROUTE;
+            if (!on_route_event_.empty()) {
+                on_route_event_(event.to_event());
+            }
+            if (!on_route_batch_.empty()) {
+                changes.push_back(event.to_event());
+            }
+            if (!on_route_sharded_.empty()) {
+                post_sharded(event.to_event(), on_route_sharded_,
+                        shard_options_.route_key);
+            }
+            if (!on_route_coalesced_.empty()) {
+                coalesce(route_coalescer_, RouteKey::from(event), event.to_event());
+            }
+        });
+        post_batch(io_, alive_, on_route_batch_, std::move(changes));
+    } else {
+        report("route", routes.error());
+    }
+
+    if (neighbors) {
+        std::vector<NeighborEvent> changes{};
+        retain(known_neighbors_, filter.neighbor);
+        reconcile(known_neighbors_, std::move(*neighbors), [&](auto event, bool removed) {
+            if (!emit) {
+                return;
+            }
+
+            event.type = removed ? NeighborEvent::Type::DELETE_NEIGHBOR
+                                 : NeighborEvent::Type::NEW_NEIGHBOR;
+            if (!on_neighbor_event_.empty()) {
+                on_neighbor_event_(event.to_event());
+            }
+            if (!on_neighbor_batch_.empty()) {
+                changes.push_back(event.to_event());
+            }
+            if (!on_neighbor_sharded_.empty()) {
+                post_sharded(event.to_event(), on_neighbor_sharded_,
+                        shard_options_.neighbor_key);
+            }
+            if (!on_neighbor_coalesced_.empty()) {
+                coalesce(neighbor_coalescer_, NeighborKey::from(event), event.to_event());
+            }
+        });
+        post_batch(io_, alive_, on_neighbor_batch_, std::move(changes));
+    } else {
+        report("neighbor", neighbors.error());
+    }
+}
+
+void Listener::track(const LinkEventView& view) {
+    if (LinkDumpTask::in_scope(view)) {
+        apply(known_links_, view.compact(), view.type() == LinkEvent::Type::DELETE_LINK);
+    }
+}
+
+void Listener::track(const AddressEventView& view) {
+    if (AddressDumpTask::in_scope(view)) {
+        apply(known_addresses_, view.compact(),
+                view.type() == AddressEvent::Type::DELETE_ADDRESS);
+    }
+}
+
+void Listener::track(const RouteEventView& view) {
+    if (RouteDumpTask::in_scope(view)) {
+        apply(known_routes_, view.compact(),
+                view.type() == RouteEvent::Type::DELETE_ROUTE);
+    }
+}
+
+void Listener::track(const NeighborEventView& view) {
+    if (NeighborDumpTask::in_scope(view)) {
+        apply(known_neighbors_, view.compact(),
+                view.type() == NeighborEvent::Type::DELETE_NEIGHBOR);
+    }
 }
 
 } // namespace rtaco
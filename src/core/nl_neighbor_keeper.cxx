@@ -0,0 +1,282 @@
+#include "rtaco/core/nl_neighbor_keeper.hxx"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <string_view>
+#include <utility>
+
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/dispatch.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/redirect_error.hpp>
+#include <boost/asio/use_awaitable.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <linux/neighbour.h>
+
+#include "rtaco/core/nl_common.hxx"
+#include "rtaco/core/nl_control.hxx"
+#include "rtaco/core/nl_listener.hxx"
+
+namespace llmx {
+namespace rtaco {
+
+namespace asio = boost::asio;
+
+namespace {
+constexpr uint16_t REPROBE_STATES = NUD_STALE | NUD_DELAY | NUD_FAILED;
+} // namespace
+
+auto NeighborKeeper::KeyHash::operator()(const Key& key) const noexcept -> size_t {
+    const auto bytes = std::string_view{
+            reinterpret_cast<const char*>(key.address.data()), key.address.size()};
+    return std::hash<std::string_view>{}(bytes) ^
+            (static_cast<size_t>(key.ifindex) << 1U);
+}
+
+NeighborKeeper::NeighborKeeper(asio::io_context& io, Control& control, Listener& listener,
+        NeighborKeeperOptions options)
+    : io_{io}
+    , strand_{asio::make_strand(io_)}
+    , control_{control}
+    , listener_{listener}
+    , options_{options}
+    , wakeup_{std::make_shared<asio::steady_timer>(strand_)}
+    , alive_{std::make_shared<std::atomic_bool>(true)} {}
+
+NeighborKeeper::~NeighborKeeper() {
+    *alive_ = false;
+    connection_.disconnect();
+
+    // The pace loop may be using the timer on another thread; it wakes up,
+    // sees `alive_` and exits.
+    asio::dispatch(strand_, [wakeup = wakeup_]() { wakeup->cancel(); });
+}
+
+void NeighborKeeper::start() {
+    connection_.disconnect();
+    connection_ = listener_.connect_to_event(
+            [this, alive = alive_](const NeighborEvent& event)
+    {
+        if (*alive) {
+            on_neighbor_event(event);
+        }
+    });
+
+    asio::dispatch(strand_, [this, alive = alive_]()
+    {
+        if (!*alive || running_) {
+            return;
+        }
+
+        running_ = true;
+        for (const auto& [key, entry] : entries_) {
+            enqueue(key);
+        }
+
+        // A loop left over from before a stop() may not have seen it yet;
+        // the new generation makes it exit instead of pacing alongside.
+        asio::co_spawn(strand_, pace_loop(++generation_), asio::detached);
+    });
+}
+
+void NeighborKeeper::stop() {
+    connection_.disconnect();
+
+    asio::dispatch(strand_, [this, alive = alive_]()
+    {
+        if (!*alive) {
+            return;
+        }
+
+        running_ = false;
+        queue_.clear();
+        deferred_.clear();
+        for (auto& [key, entry] : entries_) {
+            entry.queued = false;
+        }
+        wakeup_->cancel();
+    });
+}
+
+void NeighborKeeper::add(uint16_t ifindex, std::span<const uint8_t, 16> address) {
+    Key key{ifindex, {}};
+    std::memcpy(key.address.data(), address.data(), address.size());
+
+    asio::dispatch(strand_, [this, alive = alive_, key]()
+    {
+        if (!*alive) {
+            return;
+        }
+
+        if (!entries_.try_emplace(key).second) {
+            return;
+        }
+
+        size_.store(entries_.size(), std::memory_order_relaxed);
+        if (running_) {
+            enqueue(key);
+        }
+    });
+}
+
+void NeighborKeeper::remove(uint16_t ifindex, std::span<const uint8_t, 16> address) {
+    Key key{ifindex, {}};
+    std::memcpy(key.address.data(), address.data(), address.size());
+
+    asio::dispatch(strand_, [this, alive = alive_, key]()
+    {
+        if (!*alive) {
+            return;
+        }
+
+        entries_.erase(key);
+        size_.store(entries_.size(), std::memory_order_relaxed);
+    });
+}
+
+auto NeighborKeeper::size() const noexcept -> size_t {
+    return size_.load(std::memory_order_relaxed);
+}
+
+auto NeighborKeeper::probes_sent() const noexcept -> uint64_t {
+    return probes_sent_.load(std::memory_order_relaxed);
+}
+
+auto NeighborKeeper::probe_errors() const noexcept -> uint64_t {
+    return probe_errors_.load(std::memory_order_relaxed);
+}
+
+void NeighborKeeper::on_neighbor_event(const NeighborEvent& event) {
+    if (event.type == NeighborEvent::Type::UNKNOWN) {
+        return;
+    }
+
+    if (event.index <= 0 || event.index > std::numeric_limits<uint16_t>::max()) {
+        return;
+    }
+
+    const auto address = parse_address(event.address, event.family);
+    if (!address) {
+        return;
+    }
+
+    const Key key{static_cast<uint16_t>(event.index), *address};
+    asio::post(strand_, [this, alive = alive_, key, type = event.type,
+                                state = event.state]()
+    {
+        if (*alive) {
+            update_state(key, type, state);
+        }
+    });
+}
+
+void NeighborKeeper::update_state(const Key& key, NeighborEvent::Type type,
+        NeighborEvent::State state) {
+    auto it = entries_.find(key);
+    if (it == entries_.end()) {
+        return;
+    }
+
+    it->second.state = state;
+
+    if (type == NeighborEvent::Type::DELETE_NEIGHBOR ||
+            (std::to_underlying(state) & REPROBE_STATES) != 0U) {
+        enqueue(key);
+    }
+}
+
+void NeighborKeeper::enqueue(const Key& key) {
+    auto it = entries_.find(key);
+    if (it == entries_.end() || it->second.queued || !running_) {
+        return;
+    }
+
+    it->second.queued = true;
+
+    const auto due = it->second.last_probe + options_.min_reprobe_interval;
+    if (due <= std::chrono::steady_clock::now()) {
+        queue_.push_back(key);
+    } else {
+        deferred_.emplace(due, key);
+    }
+    wakeup_->cancel();
+}
+
+auto NeighborKeeper::pace_loop(uint64_t generation) -> asio::awaitable<void> {
+    using clock = std::chrono::steady_clock;
+
+    const auto alive = alive_;
+    const auto wakeup = wakeup_;
+    const auto interval = std::chrono::duration_cast<clock::duration>(
+            std::chrono::seconds{1}) /
+            std::max<uint32_t>(options_.probes_per_second, 1U);
+    auto next_slot = clock::now();
+
+    while (*alive && running_ && generation == generation_) {
+        const auto now = clock::now();
+        while (!deferred_.empty() && deferred_.begin()->first <= now) {
+            queue_.push_back(deferred_.begin()->second);
+            deferred_.erase(deferred_.begin());
+        }
+
+        auto due = asio::steady_timer::time_point::max();
+
+        if (!queue_.empty() && outstanding_ < options_.max_outstanding) {
+            const auto key = queue_.front();
+            auto it = entries_.find(key);
+
+            if (it == entries_.end()) {
+                queue_.pop_front();
+                continue;
+            }
+
+            if (next_slot <= now) {
+                queue_.pop_front();
+                it->second.queued = false;
+                it->second.last_probe = now;
+                next_slot = std::max(next_slot, now) + interval;
+
+                ++outstanding_;
+                asio::co_spawn(strand_, probe(key), asio::detached);
+                continue;
+            }
+
+            due = next_slot;
+        }
+
+        if (!deferred_.empty()) {
+            due = std::min(due, deferred_.begin()->first);
+        }
+
+        boost::system::error_code ec;
+        wakeup->expires_at(due);
+        co_await wakeup->async_wait(asio::redirect_error(asio::use_awaitable, ec));
+    }
+}
+
+auto NeighborKeeper::probe(Key key) -> asio::awaitable<void> {
+    const auto alive = alive_;
+    probes_sent_.fetch_add(1U, std::memory_order_relaxed);
+
+    auto result = co_await control_.async_probe_neighbor(key.ifindex, key.address);
+
+    if (!*alive) {
+        co_return;
+    }
+
+    if (!result) {
+        probe_errors_.fetch_add(1U, std::memory_order_relaxed);
+    }
+
+    --outstanding_;
+    wakeup_->cancel();
+}
+
+} // namespace rtaco
+} // namespace llmx
@@ -0,0 +1,437 @@
+#include "rtaco/core/nl_route_index.hxx"
+
+#include <algorithm>
+#include <bit>
+#include <utility>
+
+namespace llmx {
+namespace rtaco {
+
+namespace {
+
+constexpr size_t SLOTS = 256U;
+
+auto test_bit(const std::array<uint64_t, 4>& bits, uint8_t slot) noexcept -> bool {
+    return ((bits[slot >> 6U] >> (slot & 63U)) & 1U) != 0U;
+}
+
+void set_bit(std::array<uint64_t, 4>& bits, uint8_t slot) noexcept {
+    bits[slot >> 6U] |= uint64_t{1} << (slot & 63U);
+}
+
+void clear_bit(std::array<uint64_t, 4>& bits, uint8_t slot) noexcept {
+    bits[slot >> 6U] &= ~(uint64_t{1} << (slot & 63U));
+}
+
+// Number of set bits at positions up to and including `slot`.
+auto rank(const std::array<uint64_t, 4>& bits, uint8_t slot) noexcept -> uint32_t {
+    const auto word = static_cast<size_t>(slot >> 6U);
+    uint32_t count = 0U;
+    for (size_t i = 0; i < word; ++i) {
+        count += static_cast<uint32_t>(std::popcount(bits[i]));
+    }
+    return count +
+            static_cast<uint32_t>(std::popcount(bits[word] << (63U - (slot & 63U))));
+}
+
+auto count_bits(const std::array<uint64_t, 4>& bits) noexcept -> size_t {
+    size_t count = 0U;
+    for (const auto word : bits) {
+        count += static_cast<size_t>(std::popcount(word));
+    }
+    return count;
+}
+
+auto size_class(size_t count) noexcept -> size_t {
+    return static_cast<size_t>(std::countr_zero(std::bit_ceil(count)));
+}
+
+// Take a block for `count` entries from `free`, or grow `pool` by one.
+template<typename Pool>
+auto allocate(Pool& pool, std::array<std::vector<uint32_t>, 9>& free, size_t count)
+        -> uint32_t {
+    auto& blocks = free[size_class(count)];
+    if (!blocks.empty()) {
+        const auto base = blocks.back();
+        blocks.pop_back();
+        return base;
+    }
+
+    const auto base = static_cast<uint32_t>(pool.size());
+    pool.resize(pool.size() + std::bit_ceil(count));
+    return base;
+}
+
+void release(std::array<std::vector<uint32_t>, 9>& free, uint32_t base, size_t count) {
+    free[size_class(count)].push_back(base);
+}
+
+// The node a prefix of `length` bits ends in, and how many bits of that
+// node's byte it covers.
+auto placement(uint8_t length) noexcept -> std::pair<uint8_t, uint8_t> {
+    if (length == 0U) {
+        return {0U, 0U};
+    }
+
+    const auto depth = static_cast<uint8_t>((length - 1U) / 8U);
+    return {depth, static_cast<uint8_t>(length - depth * 8U)};
+}
+
+auto to_compact(const RouteEventList& routes) -> std::vector<CompactRouteEvent> {
+    std::vector<CompactRouteEvent> compact{};
+    compact.reserve(routes.size());
+    for (const auto& route : routes) {
+        compact.push_back(CompactRouteEvent::from_event(route));
+    }
+    return compact;
+}
+
+} // namespace
+
+RouteIndex::RouteIndex(RouteIndexOptions options) {
+    tables_.reserve(options.tables.size());
+    for (const auto id : options.tables) {
+        tables_.push_back(Table{id, Trie{}, Trie{}});
+    }
+}
+
+RouteIndex::RouteIndex(std::span<const CompactRouteEvent> routes,
+        RouteIndexOptions options)
+    : RouteIndex{std::move(options)} {
+    routes_.reserve(routes.size());
+    ids_.reserve(routes.size());
+
+    // Nodes are painted once at the end instead of after every insert.
+    for (const auto& route : routes) {
+        if (route.type != RouteEvent::Type::DELETE_ROUTE && indexable(route)) {
+            insert(route, false);
+        }
+    }
+    repaint_all();
+}
+
+RouteIndex::RouteIndex(const RouteEventList& routes, RouteIndexOptions options)
+    : RouteIndex{to_compact(routes), std::move(options)} {}
+
+void RouteIndex::update(const CompactRouteEvent& event) {
+    if (!indexable(event)) {
+        return;
+    }
+
+    if (event.type == RouteEvent::Type::NEW_ROUTE) {
+        insert(event, true);
+    } else if (event.type == RouteEvent::Type::DELETE_ROUTE) {
+        erase(event);
+    }
+}
+
+void RouteIndex::update(const RouteEvent& event) {
+    update(CompactRouteEvent::from_event(event));
+}
+
+auto RouteIndex::lookup(const IpAddress& address) const noexcept
+        -> const CompactRouteEvent* {
+    if (address.family != AF_INET && address.family != AF_INET6) {
+        return nullptr;
+    }
+
+    // A throw route ends the lookup in its table, as if nothing had matched
+    // there, and the next table is consulted.
+    for (const auto& table : tables_) {
+        const auto id = find(address.family == AF_INET ? table.v4 : table.v6, address);
+        if (id != NONE && routes_[id].route_type != RTN_THROW) {
+            return &routes_[id];
+        }
+    }
+    return nullptr;
+}
+
+void RouteIndex::lookup(std::span<const IpAddress> addresses,
+        std::span<const CompactRouteEvent*> results) const noexcept {
+    const auto count = std::min(addresses.size(), results.size());
+    for (size_t i = 0; i < count; ++i) {
+        results[i] = lookup(addresses[i]);
+    }
+}
+
+void RouteIndex::clear() {
+    for (auto& table : tables_) {
+        table.v4 = Trie{};
+        table.v6 = Trie{};
+    }
+    routes_.clear();
+    free_routes_.clear();
+    ids_.clear();
+}
+
+auto RouteIndex::trie_for(uint32_t table, uint8_t family) noexcept -> Trie* {
+    for (auto& entry : tables_) {
+        if (entry.id == table) {
+            return family == AF_INET ? &entry.v4 : &entry.v6;
+        }
+    }
+    return nullptr;
+}
+
+auto RouteIndex::indexable(const CompactRouteEvent& event) const noexcept -> bool {
+    const auto bits = event.family == AF_INET   ? 32U
+                      : event.family == AF_INET6 ? 128U
+                                                 : 0U;
+    if (bits == 0U || event.dst_prefix_len > bits || event.src_prefix_len != 0U) {
+        return false;
+    }
+
+    if (event.dst_prefix_len != 0U && event.dst.family != event.family) {
+        return false;
+    }
+
+    if ((event.flags & RouteEvent::Flags::CLONED) != RouteEvent::Flags::NONE) {
+        return false;
+    }
+
+    return std::ranges::any_of(tables_,
+            [&event](const Table& table) { return table.id == event.table; });
+}
+
+auto RouteIndex::insert(const CompactRouteEvent& event, bool repaint_node) -> bool {
+    const auto key = RouteKey::from(event);
+    if (const auto it = ids_.find(key); it != ids_.end()) {
+        // Same identity, so the route stays where it is in the trie.
+        routes_[it->second] = event;
+        return false;
+    }
+
+    uint32_t id = 0U;
+    if (!free_routes_.empty()) {
+        id = free_routes_.back();
+        free_routes_.pop_back();
+        routes_[id] = event;
+    } else {
+        id = static_cast<uint32_t>(routes_.size());
+        routes_.push_back(event);
+    }
+    ids_.emplace(key, id);
+
+    auto& trie = *trie_for(event.table, event.family);
+    const auto [depth, bits] = placement(event.dst_prefix_len);
+
+    uint32_t node = 0U;
+    for (uint8_t d = 0U; d < depth; ++d) {
+        node = child_or_create(trie, node, event.dst.bytes[d]);
+    }
+
+    const auto mask = bits == 0U ? 0U : (0xFFU << (8U - bits)) & 0xFFU;
+    const auto value = static_cast<uint8_t>(event.dst.bytes[depth] & mask);
+    trie.prefixes[node].push_back(Prefix{value, bits, event.priority, id});
+
+    if (repaint_node) {
+        repaint(trie, node);
+    }
+    return true;
+}
+
+void RouteIndex::erase(const CompactRouteEvent& event) {
+    const auto it = ids_.find(RouteKey::from(event));
+    if (it == ids_.end()) {
+        return;
+    }
+
+    const auto id = it->second;
+    ids_.erase(it);
+    free_routes_.push_back(id);
+
+    const auto& route = routes_[id];
+    auto& trie = *trie_for(route.table, route.family);
+    const auto depth = placement(route.dst_prefix_len).first;
+
+    std::array<std::pair<uint32_t, uint8_t>, 16> path{};
+    uint32_t node = 0U;
+    for (uint8_t d = 0U; d < depth; ++d) {
+        const auto& current = trie.nodes[node];
+        const auto slot = route.dst.bytes[d];
+        path[d] = {node, slot};
+        node = current.child_base + rank(current.child_bits, slot) - 1U;
+    }
+
+    std::erase_if(trie.prefixes[node],
+            [id](const Prefix& prefix) { return prefix.route == id; });
+    repaint(trie, node);
+    prune(trie, std::span{path.data(), depth});
+}
+
+void RouteIndex::repaint_all() {
+    for (auto& table : tables_) {
+        for (auto* trie : {&table.v4, &table.v6}) {
+            for (uint32_t node = 0U; node < trie->nodes.size(); ++node) {
+                if (!trie->prefixes[node].empty()) {
+                    repaint(*trie, node);
+                }
+            }
+        }
+    }
+}
+
+auto RouteIndex::child_or_create(Trie& trie, uint32_t node, uint8_t slot) -> uint32_t {
+    const auto bits = trie.nodes[node].child_bits;
+    const auto old_base = trie.nodes[node].child_base;
+    if (test_bit(bits, slot)) {
+        return old_base + rank(bits, slot) - 1U;
+    }
+
+    const auto count = count_bits(bits);
+    const auto position = static_cast<size_t>(rank(bits, slot));
+    auto base = old_base;
+
+    if (count == 0U || std::has_single_bit(count)) {
+        // The block is full: move the siblings to one twice as large. Only
+        // the parent refers to them, so nothing else needs fixing up.
+        base = allocate(trie.nodes, trie.free_nodes, count + 1U);
+        trie.prefixes.resize(trie.nodes.size());
+        for (size_t i = 0; i < count; ++i) {
+            const auto to = base + i + (i >= position ? 1U : 0U);
+            trie.nodes[to] = trie.nodes[old_base + i];
+            trie.prefixes[to] = std::move(trie.prefixes[old_base + i]);
+        }
+        if (count != 0U) {
+            release(trie.free_nodes, old_base, count);
+        }
+    } else {
+        for (size_t i = count; i > position; --i) {
+            trie.nodes[base + i] = trie.nodes[base + i - 1U];
+            trie.prefixes[base + i] = std::move(trie.prefixes[base + i - 1U]);
+        }
+    }
+
+    const auto child = static_cast<uint32_t>(base + position);
+    trie.nodes[child] = Node{};
+    trie.prefixes[child].clear();
+
+    auto& parent = trie.nodes[node];
+    parent.child_base = base;
+    set_bit(parent.child_bits, slot);
+    return child;
+}
+
+void RouteIndex::remove_child(Trie& trie, uint32_t node, uint8_t slot) {
+    const auto bits = trie.nodes[node].child_bits;
+    const auto old_base = trie.nodes[node].child_base;
+    const auto count = count_bits(bits);
+    const auto position = static_cast<size_t>(rank(bits, slot) - 1U);
+    const auto remaining = count - 1U;
+    auto base = old_base;
+
+    if (remaining == 0U) {
+        release(trie.free_nodes, old_base, count);
+        base = NONE;
+    } else if (std::has_single_bit(remaining)) {
+        // Keep every block exactly `bit_ceil(children)` large.
+        base = allocate(trie.nodes, trie.free_nodes, remaining);
+        trie.prefixes.resize(trie.nodes.size());
+        for (size_t i = 0; i < count; ++i) {
+            if (i != position) {
+                const auto to = base + i - (i > position ? 1U : 0U);
+                trie.nodes[to] = trie.nodes[old_base + i];
+                trie.prefixes[to] = std::move(trie.prefixes[old_base + i]);
+            }
+        }
+        release(trie.free_nodes, old_base, count);
+    } else {
+        for (size_t i = position; i < remaining; ++i) {
+            trie.nodes[base + i] = trie.nodes[base + i + 1U];
+            trie.prefixes[base + i] = std::move(trie.prefixes[base + i + 1U]);
+        }
+    }
+
+    auto& parent = trie.nodes[node];
+    parent.child_base = base;
+    clear_bit(parent.child_bits, slot);
+}
+
+void RouteIndex::prune(Trie& trie, std::span<const std::pair<uint32_t, uint8_t>> path) {
+    for (auto it = path.rbegin(); it != path.rend(); ++it) {
+        const auto [node, slot] = *it;
+        const auto& parent = trie.nodes[node];
+        const auto child = parent.child_base + rank(parent.child_bits, slot) - 1U;
+
+        if (!trie.prefixes[child].empty() || trie.nodes[child].child_base != NONE) {
+            return;
+        }
+        remove_child(trie, node, slot);
+    }
+}
+
+void RouteIndex::repaint(Trie& trie, uint32_t node) {
+    auto& prefixes = trie.prefixes[node];
+    const auto old_base = trie.nodes[node].leaf_base;
+    const auto old_count = old_base == NONE ? 0U : count_bits(trie.nodes[node].leaf_bits);
+
+    if (prefixes.empty()) {
+        if (old_count != 0U) {
+            release(trie.free_leaves, old_base, old_count);
+        }
+        trie.nodes[node].leaf_bits = {};
+        trie.nodes[node].leaf_base = NONE;
+        return;
+    }
+
+    // Shorter prefixes first and, for one prefix, the lowest metric last:
+    // whatever is painted last over a slot is the FIB's choice for it.
+    std::ranges::sort(prefixes, [](const Prefix& lhs, const Prefix& rhs)
+    {
+        return lhs.bits != rhs.bits ? lhs.bits < rhs.bits : lhs.priority > rhs.priority;
+    });
+
+    std::array<uint32_t, SLOTS> painted{};
+    painted.fill(NONE);
+    for (const auto& prefix : prefixes) {
+        std::fill_n(painted.begin() + prefix.value, size_t{1} << (8U - prefix.bits),
+                prefix.route);
+    }
+
+    // Collapse equal neighbours into runs, one leaf per run.
+    bitmap_t bits{};
+    std::array<uint32_t, SLOTS> runs{};
+    size_t count = 0U;
+    for (size_t slot = 0; slot < SLOTS; ++slot) {
+        if (slot == 0U || painted[slot] != painted[slot - 1U]) {
+            set_bit(bits, static_cast<uint8_t>(slot));
+            runs[count++] = painted[slot];
+        }
+    }
+
+    auto base = old_base;
+    if (old_count == 0U || std::bit_ceil(old_count) != std::bit_ceil(count)) {
+        if (old_count != 0U) {
+            release(trie.free_leaves, old_base, old_count);
+        }
+        base = allocate(trie.leaves, trie.free_leaves, count);
+    }
+
+    std::copy_n(runs.begin(), count, trie.leaves.begin() + base);
+    trie.nodes[node].leaf_bits = bits;
+    trie.nodes[node].leaf_base = base;
+}
+
+auto RouteIndex::find(const Trie& trie, const IpAddress& address) noexcept -> uint32_t {
+    uint32_t best = NONE;
+    uint32_t index = 0U;
+
+    for (size_t depth = 0; depth < address.size(); ++depth) {
+        const auto& node = trie.nodes[index];
+        const auto slot = address.bytes[depth];
+
+        if (node.leaf_base != NONE) {
+            const auto leaf = node.leaf_base + rank(node.leaf_bits, slot) - 1U;
+            best = trie.leaves[leaf] != NONE ? trie.leaves[leaf] : best;
+        }
+
+        if (!test_bit(node.child_bits, slot)) {
+            break;
+        }
+        index = node.child_base + rank(node.child_bits, slot) - 1U;
+    }
+    return best;
+}
+
+} // namespace rtaco
+} // namespace llmx
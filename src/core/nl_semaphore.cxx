@@ -0,0 +1,123 @@
+#include "rtaco/core/nl_semaphore.hxx"
+
+#include <algorithm>
+#include <expected>
+#include <memory>
+#include <system_error>
+
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/redirect_error.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/use_awaitable.hpp>
+#include <boost/system/error_code.hpp>
+
+namespace llmx {
+namespace rtaco {
+
+namespace asio = boost::asio;
+
+Semaphore::Semaphore(asio::any_io_executor executor, size_t capacity) noexcept
+    : executor_{std::move(executor)}
+    , capacity_{capacity} {}
+
+auto Semaphore::async_acquire() -> asio::awaitable<std::expected<void, std::error_code>> {
+    if (try_acquire()) {
+        co_return std::expected<void, std::error_code>{};
+    }
+
+    auto waiter = std::make_shared<Waiter>(executor_);
+    waiter->timer.expires_at(asio::steady_timer::time_point::max());
+    waiters_.push_back(waiter);
+
+    // Runs when the coroutine frame goes away without taking ownership of the
+    // permit, e.g. because the io_context was destroyed mid-wait.
+    struct WaitGuard {
+        Semaphore& semaphore;
+        std::shared_ptr<Waiter> waiter;
+        bool owned{false};
+
+        ~WaitGuard() {
+            // cancel() already dropped the waiter; the semaphore may be gone.
+            if (owned || waiter->cancelled) {
+                return;
+            }
+
+            if (waiter->granted) {
+                semaphore.release();
+                return;
+            }
+
+            std::erase(semaphore.waiters_, waiter);
+        }
+    } guard{*this, waiter};
+
+    while (!waiter->granted && !waiter->cancelled) {
+        boost::system::error_code ec;
+        co_await waiter->timer.async_wait(asio::redirect_error(asio::use_awaitable, ec));
+    }
+
+    if (!waiter->granted) {
+        co_return std::unexpected{std::make_error_code(std::errc::operation_canceled)};
+    }
+
+    guard.owned = true;
+    co_return std::expected<void, std::error_code>{};
+}
+
+auto Semaphore::try_acquire() noexcept -> bool {
+    if (!waiters_.empty() || in_use_ >= capacity_) {
+        return false;
+    }
+
+    ++in_use_;
+    return true;
+}
+
+void Semaphore::release() {
+    if (!waiters_.empty() && in_use_ <= capacity_) {
+        auto waiter = std::move(waiters_.front());
+        waiters_.pop_front();
+
+        waiter->granted = true;
+        waiter->timer.cancel();
+        return;
+    }
+
+    if (in_use_ > 0) {
+        --in_use_;
+    }
+}
+
+void Semaphore::cancel() {
+    auto waiters = std::move(waiters_);
+    waiters_.clear();
+
+    for (auto& waiter : waiters) {
+        waiter->cancelled = true;
+        waiter->timer.cancel();
+    }
+}
+
+void Semaphore::set_capacity(size_t capacity) {
+    capacity_ = capacity;
+
+    while (!waiters_.empty() && in_use_ < capacity_) {
+        auto waiter = std::move(waiters_.front());
+        waiters_.pop_front();
+
+        ++in_use_;
+        waiter->granted = true;
+        waiter->timer.cancel();
+    }
+}
+
+auto Semaphore::available() const noexcept -> size_t {
+    return capacity_ > in_use_ ? capacity_ - in_use_ : 0U;
+}
+
+auto Semaphore::waiting() const noexcept -> size_t {
+    return waiters_.size();
+}
+
+} // namespace rtaco
+} // namespace llmx
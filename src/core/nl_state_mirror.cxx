@@ -0,0 +1,367 @@
+#include "rtaco/core/nl_state_mirror.hxx"
+
+#include <algorithm>
+#include <iostream>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/dispatch.hpp>
+#include <boost/asio/post.hpp>
+
+#include "rtaco/core/nl_control.hxx"
+#include "rtaco/core/nl_listener.hxx"
+
+namespace llmx {
+namespace rtaco {
+
+namespace asio = boost::asio;
+
+namespace {
+
+template<typename Compact, typename Event>
+auto to_compact(std::span<const Event> events) -> std::vector<Compact> {
+    std::vector<Compact> compact{};
+    compact.reserve(events.size());
+    for (const auto& event : events) {
+        compact.push_back(Compact::from_event(event));
+    }
+    return compact;
+}
+
+template<typename Key, typename Table, typename Compact, typename Type>
+auto apply_entries(const Table& table, std::span<const Compact> events, Type removal)
+        -> std::shared_ptr<const Table> {
+    auto next = std::make_shared<Table>(table);
+    for (const auto& event : events) {
+        if (event.type == Type::UNKNOWN) {
+            continue;
+        }
+
+        if (event.type == removal) {
+            next->erase(Key::from(event));
+        } else {
+            next->insert_or_assign(Key::from(event), event);
+        }
+    }
+    return next;
+}
+
+// Drop the entries left on deleted interfaces; the table is only copied if
+// one of them actually had any.
+template<typename Table>
+void drop_interfaces(std::shared_ptr<const Table>& table,
+        const std::vector<int>& removed) {
+    const auto on_removed = [&removed](const auto& entry)
+    {
+        return std::ranges::find(removed, entry.first.index) != removed.end();
+    };
+
+    if (std::ranges::none_of(*table, on_removed)) {
+        return;
+    }
+
+    auto next = std::make_shared<Table>(*table);
+    std::erase_if(*next, on_removed);
+    table = std::move(next);
+}
+
+void erase_name(StateSnapshot::LinkTable& links, const InterfaceName& name, int index) {
+    const auto it = links.by_name.find(name);
+    if (it != links.by_name.end() && it->second == index) {
+        links.by_name.erase(it);
+    }
+}
+
+} // namespace
+
+StateSnapshot::StateSnapshot()
+    : links_{std::make_shared<const LinkTable>()}
+    , addresses_{std::make_shared<const AddressTable>()}
+    , neighbors_{std::make_shared<const NeighborTable>()} {}
+
+auto StateSnapshot::link(int index) const noexcept -> const CompactLinkEvent* {
+    const auto it = links_->by_index.find(index);
+    return it != links_->by_index.end() ? &it->second : nullptr;
+}
+
+auto StateSnapshot::link(std::string_view name) const noexcept
+        -> const CompactLinkEvent* {
+    const auto index = index_of(name);
+    return index != 0 ? link(index) : nullptr;
+}
+
+auto StateSnapshot::name_of(int index) const noexcept -> std::string_view {
+    const auto* entry = link(index);
+    return entry != nullptr ? entry->name.view() : std::string_view{};
+}
+
+auto StateSnapshot::index_of(std::string_view name) const noexcept -> int {
+    const auto it = links_->by_name.find(InterfaceName::from_string(name));
+    return it != links_->by_name.end() ? it->second : 0;
+}
+
+auto StateSnapshot::address(const AddressKey& key) const noexcept
+        -> const CompactAddressEvent* {
+    const auto it = addresses_->find(key);
+    return it != addresses_->end() ? &it->second : nullptr;
+}
+
+auto StateSnapshot::addresses_of(int index) const -> std::vector<CompactAddressEvent> {
+    std::vector<CompactAddressEvent> result{};
+    for (const auto& [key, entry] : *addresses_) {
+        if (key.index == index) {
+            result.push_back(entry);
+        }
+    }
+    return result;
+}
+
+auto StateSnapshot::neighbor(int index, const IpAddress& address) const noexcept
+        -> const CompactNeighborEvent* {
+    const auto it = neighbors_->find(NeighborKey{index, address});
+    return it != neighbors_->end() ? &it->second : nullptr;
+}
+
+auto StateSnapshot::resolve(RouteEvent& event) const -> bool {
+    const auto name = name_of(static_cast<int>(event.oif_index));
+    if (name.empty()) {
+        return false;
+    }
+
+    event.oif.assign(name.data(), name.size());
+    return true;
+}
+
+auto StateSnapshot::apply(std::span<const CompactLinkEvent> events) const
+        -> std::shared_ptr<const StateSnapshot> {
+    if (events.empty()) {
+        return std::make_shared<const StateSnapshot>(*this);
+    }
+
+    auto next = std::make_shared<StateSnapshot>(*this);
+    ++next->generation_;
+
+    auto links = std::make_shared<LinkTable>(*links_);
+    std::vector<int> removed{};
+
+    for (const auto& event : events) {
+        if (event.type == LinkEvent::Type::UNKNOWN) {
+            continue;
+        }
+
+        // A NEW for a known index may carry a new name (rename).
+        if (const auto it = links->by_index.find(event.index);
+                it != links->by_index.end()) {
+            erase_name(*links, it->second.name, event.index);
+            links->by_index.erase(it);
+        }
+
+        if (event.type == LinkEvent::Type::DELETE_LINK) {
+            removed.push_back(event.index);
+            continue;
+        }
+
+        links->by_index.insert_or_assign(event.index, event);
+        if (!event.name.empty()) {
+            links->by_name.insert_or_assign(event.name, event.index);
+        }
+    }
+
+    next->links_ = std::move(links);
+    if (!removed.empty()) {
+        drop_interfaces(next->addresses_, removed);
+        drop_interfaces(next->neighbors_, removed);
+    }
+    return next;
+}
+
+auto StateSnapshot::apply(std::span<const CompactAddressEvent> events) const
+        -> std::shared_ptr<const StateSnapshot> {
+    if (events.empty()) {
+        return std::make_shared<const StateSnapshot>(*this);
+    }
+
+    auto next = std::make_shared<StateSnapshot>(*this);
+    ++next->generation_;
+    next->addresses_ = apply_entries<AddressKey>(*addresses_, events,
+            AddressEvent::Type::DELETE_ADDRESS);
+    return next;
+}
+
+auto StateSnapshot::apply(std::span<const CompactNeighborEvent> events) const
+        -> std::shared_ptr<const StateSnapshot> {
+    if (events.empty()) {
+        return std::make_shared<const StateSnapshot>(*this);
+    }
+
+    auto next = std::make_shared<StateSnapshot>(*this);
+    ++next->generation_;
+    next->neighbors_ = apply_entries<NeighborKey>(*neighbors_, events,
+            NeighborEvent::Type::DELETE_NEIGHBOR);
+    return next;
+}
+
+StateMirror::StateMirror(asio::io_context& io, Control& control, Listener& listener)
+    : io_{io}
+    , strand_{asio::make_strand(io_)}
+    , control_{control}
+    , listener_{listener}
+    , snapshot_{std::make_shared<const StateSnapshot>()}
+    , current_{snapshot_.load()}
+    , alive_{std::make_shared<bool>(true)} {}
+
+StateMirror::~StateMirror() {
+    *alive_ = false;
+    link_connection_.disconnect();
+    address_connection_.disconnect();
+    neighbor_connection_.disconnect();
+}
+
+void StateMirror::start() {
+    stop();
+
+    // Queued ahead of any change the connections below can deliver, so the
+    // strand holds changes back until the seed dumps are in.
+    asio::dispatch(strand_, [this, alive = alive_]()
+    {
+        if (!*alive || seeding_) {
+            return;
+        }
+
+        seeding_ = true;
+        asio::co_spawn(strand_, seed(), asio::detached);
+    });
+
+    link_connection_ = listener_.connect_to_batch(
+            [this, alive = alive_](std::span<const LinkEvent> batch)
+    {
+        if (*alive) {
+            on_changes(to_compact<CompactLinkEvent>(batch));
+        }
+    });
+
+    address_connection_ = listener_.connect_to_batch(
+            [this, alive = alive_](std::span<const AddressEvent> batch)
+    {
+        if (*alive) {
+            on_changes(to_compact<CompactAddressEvent>(batch));
+        }
+    });
+
+    neighbor_connection_ = listener_.connect_to_batch(
+            [this, alive = alive_](std::span<const NeighborEvent> batch)
+    {
+        if (*alive) {
+            on_changes(to_compact<CompactNeighborEvent>(batch));
+        }
+    });
+}
+
+void StateMirror::stop() {
+    link_connection_.disconnect();
+    address_connection_.disconnect();
+    neighbor_connection_.disconnect();
+}
+
+auto StateMirror::ready() const noexcept -> bool {
+    return ready_.load(std::memory_order_acquire);
+}
+
+auto StateMirror::snapshot() const noexcept -> std::shared_ptr<const StateSnapshot> {
+    return snapshot_.load(std::memory_order_acquire);
+}
+
+auto StateMirror::resolve(RouteEvent& event) const -> bool {
+    return snapshot()->resolve(event);
+}
+
+template<typename Compact>
+void StateMirror::on_changes(std::vector<Compact> events) {
+    asio::post(strand_, [this, alive = alive_, events = std::move(events)]() mutable
+    {
+        if (!*alive) {
+            return;
+        }
+
+        if (!seeding_) {
+            publish(current_->apply(std::span<const Compact>{events}));
+            return;
+        }
+
+        auto& pending = [this]() -> std::vector<Compact>& {
+            if constexpr (std::is_same_v<Compact, CompactLinkEvent>) {
+                return pending_links_;
+            } else if constexpr (std::is_same_v<Compact, CompactAddressEvent>) {
+                return pending_addresses_;
+            } else {
+                return pending_neighbors_;
+            }
+        }();
+        pending.insert(pending.end(), events.begin(), events.end());
+    });
+}
+
+auto StateMirror::seed() -> asio::awaitable<void> {
+    // `this` may be gone once a dump returns; only touch it after `alive`.
+    const auto alive = alive_;
+
+    auto links = co_await control_.async_dump_links_compact();
+    if (!*alive) {
+        co_return;
+    }
+    auto addresses = co_await control_.async_dump_addresses_compact();
+    if (!*alive) {
+        co_return;
+    }
+    auto neighbors = co_await control_.async_dump_neighbors_compact();
+    if (!*alive) {
+        co_return;
+    }
+
+    const auto report = [](std::string_view table, const std::error_code& error)
+    {
+        std::cerr << "Warning: " << table << " mirror seed failed: " << error.message()
+                  << "\n";
+    };
+
+    auto next = std::make_shared<const StateSnapshot>();
+    if (links) {
+        next = next->apply(std::span<const CompactLinkEvent>{*links});
+    } else {
+        report("link", links.error());
+    }
+    if (addresses) {
+        next = next->apply(std::span<const CompactAddressEvent>{*addresses});
+    } else {
+        report("address", addresses.error());
+    }
+    if (neighbors) {
+        next = next->apply(std::span<const CompactNeighborEvent>{*neighbors});
+    } else {
+        report("neighbor", neighbors.error());
+    }
+
+    // Changes seen while dumping are at least as recent as the dumps.
+    next = next->apply(std::span<const CompactLinkEvent>{pending_links_});
+    next = next->apply(std::span<const CompactAddressEvent>{pending_addresses_});
+    next = next->apply(std::span<const CompactNeighborEvent>{pending_neighbors_});
+    pending_links_.clear();
+    pending_addresses_.clear();
+    pending_neighbors_.clear();
+
+    seeding_ = false;
+    publish(std::move(next));
+    ready_.store(true, std::memory_order_release);
+}
+
+void StateMirror::publish(std::shared_ptr<const StateSnapshot> next) {
+    current_ = next;
+    snapshot_.store(std::move(next), std::memory_order_release);
+}
+
+} // namespace rtaco
+} // namespace llmx
@@ -0,0 +1,414 @@
+#include "rtaco/core/nl_transport.hxx"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <span>
+#include <system_error>
+#include <utility>
+
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/redirect_error.hpp>
+#include <boost/asio/use_awaitable.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <linux/netlink.h>
+
+namespace llmx {
+namespace rtaco {
+
+namespace asio = boost::asio;
+
+namespace {
+constexpr uint32_t NO_GROUPS = 0U;
+} // namespace
+
+Transport::Transport(asio::io_context& io, asio::any_io_executor executor,
+        std::string_view label, size_t max_in_flight,
+        ReceiveBufferOptions receive_buffer,
+        std::chrono::steady_clock::duration time_slice) noexcept
+    : executor_{std::move(executor)}
+    , socket_guard_{io, label, NO_GROUPS}
+    , dump_gate_{executor_, 1U}
+    , window_{executor_, max_in_flight > 0U ? max_in_flight : 1U}
+    , buffer_{receive_buffer}
+    , time_slice_{time_slice}
+    , post_room_{executor_}
+    , alive_{std::make_shared<bool>(true)} {
+    post_room_.expires_at(asio::steady_timer::time_point::max());
+}
+
+Transport::~Transport() {
+    *alive_ = false;
+    stop();
+}
+
+auto Transport::socket_guard() noexcept -> SocketGuard& {
+    return socket_guard_;
+}
+
+auto Transport::pending() const noexcept -> size_t {
+    return pending_.size();
+}
+
+auto Transport::async_transact(std::span<const uint8_t> request,
+        message_handler_t handler, batch_handler_t on_batch)
+        -> asio::awaitable<std::expected<void, std::error_code>> {
+    auto transaction = std::make_shared<Transaction>(executor_, std::move(handler),
+            std::move(on_batch));
+    bool dump = false;
+
+    if (!parse(request, *transaction, dump)) {
+        co_return std::unexpected{std::make_error_code(std::errc::invalid_argument)};
+    }
+
+    // Runs on every exit path. A frame resumed after the transport is gone
+    // (its destructor cancels every wait) must not touch it: the permits are
+    // dropped instead of released and the transaction is left alone.
+    struct PendingGuard {
+        Transport& transport;
+        std::shared_ptr<bool> alive;
+        const transaction_ptr& transaction;
+        bool dump;
+        bool enlisted{false};
+        SemaphorePermit dump_permit{};
+        SemaphorePermit window_permit{};
+
+        ~PendingGuard() {
+            if (!*alive) {
+                dump_permit.abandon();
+                window_permit.abandon();
+                return;
+            }
+
+            if (!enlisted) {
+                return;
+            }
+
+            // Unregister so that a late reply for an abandoned transaction is
+            // dropped instead of reaching a destroyed handler.
+            transport.unregister(transaction);
+            // The kernel keeps feeding an unfinished dump into the socket and
+            // refuses to start another one on it until it is read to the end.
+            if (dump && !transaction->done) {
+                transport.stale_ = true;
+            }
+        }
+    } guard{*this, alive_, transaction, dump};
+
+    const auto canceled = std::make_error_code(std::errc::operation_canceled);
+
+    if (dump) {
+        auto acquired = co_await dump_gate_.async_acquire();
+        if (!*guard.alive) {
+            co_return std::unexpected{canceled};
+        }
+        if (!acquired) {
+            co_return std::unexpected{acquired.error()};
+        }
+        guard.dump_permit = SemaphorePermit{dump_gate_};
+    }
+
+    auto acquired = co_await window_.async_acquire();
+    if (!*guard.alive) {
+        co_return std::unexpected{canceled};
+    }
+    if (!acquired) {
+        co_return std::unexpected{acquired.error()};
+    }
+    guard.window_permit = SemaphorePermit{window_};
+
+    transaction->wakeup.expires_at(asio::steady_timer::time_point::max());
+
+    if (auto enlisted = enlist(transaction); !enlisted) {
+        co_return std::unexpected{enlisted.error()};
+    }
+    guard.enlisted = true;
+
+    auto sent = co_await send(request);
+    if (!*guard.alive) {
+        co_return std::unexpected{canceled};
+    }
+    if (!sent) {
+        co_return std::unexpected{sent.error()};
+    }
+
+    ensure_reader();
+
+    while (!transaction->done) {
+        boost::system::error_code ec;
+        co_await transaction->wakeup.async_wait(
+                asio::redirect_error(asio::use_awaitable, ec));
+    }
+
+    if (transaction->error) {
+        co_return std::unexpected{transaction->error};
+    }
+
+    co_return std::expected<void, std::error_code>{};
+}
+
+auto Transport::async_post(std::span<const uint8_t> request, message_handler_t handler)
+        -> asio::awaitable<std::expected<void, std::error_code>> {
+    auto transaction = std::make_shared<Transaction>(executor_, std::move(handler),
+            batch_handler_t{});
+    bool dump = false;
+
+    if (!parse(request, *transaction, dump) || dump ||
+            transaction->sequences.size() > MAX_UNACKED) {
+        co_return std::unexpected{std::make_error_code(std::errc::invalid_argument)};
+    }
+
+    const auto alive = alive_;
+    const auto stops = stops_;
+    const auto count = transaction->sequences.size();
+    while (posted_ + count > MAX_UNACKED) {
+        boost::system::error_code ec;
+        co_await post_room_.async_wait(asio::redirect_error(asio::use_awaitable, ec));
+
+        if (!*alive || stops != stops_) {
+            co_return std::unexpected{
+                    std::make_error_code(std::errc::operation_canceled)};
+        }
+    }
+
+    if (auto enlisted = enlist(transaction); !enlisted) {
+        co_return std::unexpected{enlisted.error()};
+    }
+
+    transaction->posted = count;
+    posted_ += count;
+
+    // Nobody awaits the transaction: it stays registered until the barrier's
+    // ack completes it or the transport fails it.
+    if (auto sent = co_await send(request); !sent) {
+        if (*alive) {
+            complete(transaction, sent.error());
+        }
+        co_return std::unexpected{sent.error()};
+    }
+
+    if (!*alive) {
+        co_return std::unexpected{std::make_error_code(std::errc::operation_canceled)};
+    }
+
+    ensure_reader();
+    co_return std::expected<void, std::error_code>{};
+}
+
+void Transport::stop() {
+    ++stops_;
+    post_room_.cancel();
+    dump_gate_.cancel();
+    window_.cancel();
+    fail_all(std::make_error_code(std::errc::operation_canceled));
+    socket_guard_.stop();
+}
+
+auto Transport::parse(std::span<const uint8_t> request, Transaction& transaction,
+        bool& dump) -> bool {
+    if (request.size() < sizeof(nlmsghdr)) {
+        return false;
+    }
+
+    auto remaining = static_cast<unsigned int>(request.size());
+    const auto* header = reinterpret_cast<const nlmsghdr*>(request.data());
+    while (remaining >= sizeof(nlmsghdr) && NLMSG_OK(header, remaining)) {
+        transaction.sequences.push_back(header->nlmsg_seq);
+        dump = dump || (header->nlmsg_flags & NLM_F_DUMP) == NLM_F_DUMP;
+        header = NLMSG_NEXT(header, remaining);
+    }
+
+    return !transaction.sequences.empty();
+}
+
+auto Transport::enlist(const transaction_ptr& transaction)
+        -> std::expected<void, std::error_code> {
+    // Start over on a fresh socket once nothing depends on the stale one.
+    if (stale_ && pending_.empty()) {
+        socket_guard_.stop();
+        stale_ = false;
+        ++generation_;
+    }
+
+    if (auto result = socket_guard_.ensure_open(); !result) {
+        return std::unexpected{result.error()};
+    }
+
+    for (size_t i = 0; i < transaction->sequences.size(); ++i) {
+        if (!pending_.emplace(transaction->sequences[i], transaction).second) {
+            transaction->sequences.resize(i);
+            unregister(transaction);
+            return std::unexpected{
+                    std::make_error_code(std::errc::device_or_resource_busy)};
+        }
+    }
+
+    return {};
+}
+
+auto Transport::send(std::span<const uint8_t> request)
+        -> asio::awaitable<std::expected<void, std::error_code>> {
+    size_t offset = 0;
+
+    while (offset < request.size()) {
+        boost::system::error_code ec{};
+        const auto sent = co_await socket_guard_.socket().async_send(
+                asio::buffer(request.data() + offset, request.size() - offset),
+                asio::redirect_error(asio::use_awaitable, ec));
+
+        if (ec) {
+            co_return std::unexpected(
+                    std::error_code{ec.value(), std::generic_category()});
+        }
+
+        offset += sent;
+    }
+
+    co_return std::expected<void, std::error_code>{};
+}
+
+void Transport::ensure_reader() {
+    if (reading_ || pending_.empty()) {
+        return;
+    }
+
+    reading_ = true;
+    asio::co_spawn(executor_, read_loop(), asio::detached);
+}
+
+auto Transport::read_loop() -> asio::awaitable<void> {
+    const auto alive = alive_;
+    const auto generation = generation_;
+
+    while (*alive && !pending_.empty()) {
+        const auto datagram = co_await buffer_.async_receive(socket_guard_.socket());
+
+        if (!*alive) {
+            co_return;
+        }
+
+        // The socket was replaced while this receive was pending; its
+        // cancellation says nothing about the transactions on the new one.
+        if (generation != generation_) {
+            break;
+        }
+
+        if (!datagram) {
+            // A truncated datagram may have carried the terminating message of
+            // any transaction, so none of them can be trusted to complete.
+            fail_all(datagram.error());
+            stale_ = true;
+            break;
+        }
+
+        auto remaining = static_cast<unsigned int>(datagram->size());
+        const auto header_size = static_cast<unsigned int>(sizeof(nlmsghdr));
+        const auto* header = reinterpret_cast<const nlmsghdr*>(datagram->data());
+
+        auto turn_end = std::chrono::steady_clock::now() + time_slice_;
+        while (remaining >= header_size && NLMSG_OK(header, remaining)) {
+            dispatch(*header);
+            header = NLMSG_NEXT(header, remaining);
+
+            // Yield between slices of a large datagram. Nothing else receives
+            // into the buffer meanwhile, so the rest of it stays valid.
+            if (time_slice_ != time_slice_.zero() && remaining >= header_size &&
+                    std::chrono::steady_clock::now() >= turn_end) {
+                co_await asio::post(executor_, asio::use_awaitable);
+                turn_end = std::chrono::steady_clock::now() + time_slice_;
+                if (!*alive) {
+                    co_return;
+                }
+                if (generation != generation_) {
+                    break;
+                }
+            }
+        }
+
+        if (generation != generation_) {
+            batch_.clear();
+            break;
+        }
+
+        for (const auto& transaction : batch_) {
+            if (!transaction->done) {
+                transaction->on_batch();
+            }
+        }
+        batch_.clear();
+    }
+
+    reading_ = false;
+
+    // A transaction may have registered after the last receive completed but
+    // before the loop condition was re-evaluated.
+    ensure_reader();
+}
+
+void Transport::dispatch(const nlmsghdr& header) {
+    auto it = pending_.find(header.nlmsg_seq);
+    if (it == pending_.end()) {
+        return;
+    }
+
+    // Keep the transaction alive while its handler runs.
+    auto transaction = it->second;
+    if (transaction->handler(header)) {
+        complete(transaction, {});
+        return;
+    }
+
+    if (transaction->on_batch && (batch_.empty() || batch_.back() != transaction) &&
+            std::find(batch_.begin(), batch_.end(), transaction) == batch_.end()) {
+        batch_.push_back(std::move(transaction));
+    }
+}
+
+void Transport::unregister(const transaction_ptr& transaction) {
+    for (const auto sequence : transaction->sequences) {
+        if (auto it = pending_.find(sequence);
+                it != pending_.end() && it->second == transaction) {
+            pending_.erase(it);
+        }
+    }
+}
+
+void Transport::complete(const transaction_ptr& transaction, std::error_code error) {
+    unregister(transaction);
+    settle(*transaction);
+
+    transaction->error = error;
+    transaction->done = true;
+    transaction->wakeup.cancel();
+}
+
+void Transport::fail_all(std::error_code error) {
+    auto pending = std::move(pending_);
+    pending_.clear();
+
+    for (auto& [sequence, transaction] : pending) {
+        settle(*transaction);
+        transaction->error = error;
+        transaction->done = true;
+        transaction->wakeup.cancel();
+    }
+}
+
+void Transport::settle(Transaction& transaction) {
+    if (transaction.posted == 0U) {
+        return;
+    }
+
+    posted_ -= std::exchange(transaction.posted, 0U);
+    post_room_.cancel();
+}
+
+} // namespace rtaco
+} // namespace llmx
@@ -0,0 +1,71 @@
+#include "rtaco/core/nl_transport_pool.hxx"
+
+#include <algorithm>
+#include <expected>
+#include <memory>
+#include <system_error>
+#include <utility>
+
+#include <boost/asio/dispatch.hpp>
+#include <boost/asio/strand.hpp>
+
+namespace llmx {
+namespace rtaco {
+
+namespace asio = boost::asio;
+
+void TransportPool::Lease::reset() {
+    if (pool_ != nullptr) {
+        std::exchange(pool_, nullptr)->release(*std::exchange(transport_, nullptr));
+    }
+}
+
+TransportPool::TransportPool(asio::io_context& io, asio::any_io_executor executor,
+        std::string_view label, TransportPoolOptions options) noexcept
+    : io_{io}
+    , executor_{std::move(executor)}
+    , label_{label}
+    , options_{options}
+    , slots_{executor_, std::max<size_t>(options.max_sockets, 1U)} {}
+
+TransportPool::~TransportPool() {
+    // The transports stop themselves as they are destroyed.
+    slots_.cancel();
+}
+
+auto TransportPool::async_acquire()
+        -> asio::awaitable<std::expected<Lease, std::error_code>> {
+    if (auto acquired = co_await slots_.async_acquire(); !acquired) {
+        co_return std::unexpected{acquired.error()};
+    }
+
+    // Reuse the most recently returned transport: its socket is already open.
+    if (!idle_.empty()) {
+        auto* transport = idle_.back();
+        idle_.pop_back();
+        co_return Lease{*this, *transport};
+    }
+
+    transports_.push_back(std::make_shared<Transport>(io_, asio::make_strand(io_),
+            label_, options_.max_in_flight, options_.receive_buffer,
+            options_.time_slice));
+    co_return Lease{*this, *transports_.back()};
+}
+
+void TransportPool::stop() {
+    slots_.cancel();
+    for (const auto& transport : transports_) {
+        asio::dispatch(transport->get_executor(), [transport]()
+        {
+            transport->stop();
+        });
+    }
+}
+
+void TransportPool::release(Transport& transport) {
+    idle_.push_back(&transport);
+    slots_.release();
+}
+
+} // namespace rtaco
+} // namespace llmx
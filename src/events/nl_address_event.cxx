@@ -2,6 +2,7 @@
 
 #include <linux/if_addr.h>
 #include <linux/netlink.h>
+#include <memory_resource>
 #include <string>
 #include <linux/rtnetlink.h>
 #include <utility>
@@ -11,49 +12,118 @@
 namespace llmx {
 namespace rtaco {
 
-auto AddressEvent::from_nlmsghdr(const nlmsghdr& header) -> AddressEvent {
-    using enum AddressEvent::Type;
+AddressEvent::AddressEvent(const allocator_type& allocator) noexcept
+    : address{allocator}
+    , label{allocator} {}
 
-    AddressEvent event{};
-    switch (header.nlmsg_type) {
-    case RTM_NEWADDR: event.type = NEW_ADDRESS; break;
-    case RTM_DELADDR: event.type = DELETE_ADDRESS; break;
-    default: event.type = UNKNOWN; break;
-    }
+AddressEvent::AddressEvent(const AddressEvent& other, const allocator_type& allocator)
+    : AddressEvent{allocator} {
+    *this = other;
+}
 
-    if (event.type == UNKNOWN) {
-        return event;
+AddressEvent::AddressEvent(AddressEvent&& other, const allocator_type& allocator)
+    : AddressEvent{allocator} {
+    *this = std::move(other);
+}
+
+auto AddressEvent::from_nlmsghdr(const nlmsghdr& header, const allocator_type& allocator)
+        -> AddressEvent {
+    return AddressEventView{header}.materialize(allocator);
+}
+
+AddressEventView::AddressEventView(const nlmsghdr& header) noexcept
+    : header_{&header} {
+    switch (header.nlmsg_type) {
+    case RTM_NEWADDR: type_ = AddressEvent::Type::NEW_ADDRESS; break;
+    case RTM_DELADDR: type_ = AddressEvent::Type::DELETE_ADDRESS; break;
+    default: return;
     }
 
     const auto* info = get_msg_payload<ifaddrmsg>(header);
     if (info == nullptr) {
-        event.type = UNKNOWN;
+        type_ = AddressEvent::Type::UNKNOWN;
+        return;
+    }
+
+    info_ = *info;
+}
+
+auto AddressEventView::address() const -> std::string {
+    const auto* attr = index_.find(*header_, IFA_LOCAL);
+    if (attr == nullptr) {
+        attr = index_.find(*header_, IFA_ADDRESS);
+    }
+
+    return attr != nullptr ? attribute_address(*attr, info_.ifa_family) : std::string{};
+}
+
+auto AddressEventView::label() const noexcept -> std::string_view {
+    const auto* attr = index_.find(*header_, IFA_LABEL);
+    return attr != nullptr ? attribute_string_view(*attr) : std::string_view{};
+}
+
+auto AddressEventView::materialize(const AddressEvent::allocator_type& allocator) const
+        -> AddressEvent {
+    return compact().to_event(allocator);
+}
+
+auto AddressEventView::compact() const noexcept -> CompactAddressEvent {
+    CompactAddressEvent event{};
+    event.type = type_;
+
+    if (type_ == AddressEvent::Type::UNKNOWN) {
         return event;
     }
 
-    event.family = info->ifa_family;
-    event.prefix_len = info->ifa_prefixlen;
-    event.scope = info->ifa_scope;
-    event.flags = static_cast<Flags>(info->ifa_flags);
-    event.index = static_cast<int>(info->ifa_index);
-
-    std::string local_address;
-    std::string peer_address;
-    std::string label;
-
-    for_each_attr(header, info, [&](const rtattr* attr)
-    {
-        switch (attr->rta_type) {
-        case IFA_LOCAL: local_address = attribute_address(*attr, event.family); break;
-        case IFA_ADDRESS: peer_address = attribute_address(*attr, event.family); break;
-        case IFA_LABEL: label = attribute_string(*attr); break;
-        default: break;
-        }
-    });
-
-    event.address = !local_address.empty() ? std::move(local_address) :
-                                             std::move(peer_address);
-    event.label = std::move(label);
+    event.family = family();
+    event.prefix_len = prefix_len();
+    event.scope = scope();
+    event.flags = flags();
+    event.index = index();
+
+    auto bytes = attribute(IFA_LOCAL);
+    if (bytes.empty()) {
+        bytes = attribute(IFA_ADDRESS);
+    }
+    event.address = IpAddress::from_bytes(bytes, event.family);
+    event.label = InterfaceName::from_string(label());
+
+    return event;
+}
+
+auto CompactAddressEvent::from_nlmsghdr(const nlmsghdr& header) noexcept
+        -> CompactAddressEvent {
+    return AddressEventView{header}.compact();
+}
+
+auto CompactAddressEvent::from_event(const AddressEvent& event) noexcept
+        -> CompactAddressEvent {
+    CompactAddressEvent compact{};
+    compact.type = event.type;
+    compact.index = event.index;
+    compact.prefix_len = event.prefix_len;
+    compact.scope = event.scope;
+    compact.family = event.family;
+    compact.flags = event.flags;
+    compact.address = IpAddress::from_string(event.address, event.family);
+    compact.label = InterfaceName::from_string(event.label);
+
+    return compact;
+}
+
+auto CompactAddressEvent::to_event(const AddressEvent::allocator_type& allocator) const
+        -> AddressEvent {
+    const std::pmr::polymorphic_allocator<char> chars{allocator};
+
+    AddressEvent event{allocator};
+    event.type = type;
+    event.index = index;
+    event.prefix_len = prefix_len;
+    event.scope = scope;
+    event.flags = flags;
+    event.family = family;
+    event.address = address.to_string(chars);
+    event.label = label.to_string(chars);
 
     return event;
 }
@@ -1,5 +1,10 @@
 #include "rtaco/events/nl_link_event.hxx"
 
+#include <memory_resource>
+#include <string>
+#include <utility>
+#include <string_view>
+
 #include <linux/netlink.h>
 #include <linux/rtnetlink.h>
 
@@ -8,28 +13,94 @@
 namespace llmx {
 namespace rtaco {
 
-auto LinkEvent::from_nlmsghdr(const nlmsghdr& header) -> LinkEvent {
-    LinkEvent event{};
-    switch (header.nlmsg_type) {
-    case RTM_NEWLINK: event.type = Type::NEW_LINK; break;
-    case RTM_DELLINK: event.type = Type::DELETE_LINK; break;
-    default: event.type = Type::UNKNOWN; break;
-    }
+LinkEvent::LinkEvent(const allocator_type& allocator) noexcept
+    : name{allocator} {}
 
-    if (event.type == Type::UNKNOWN) {
-        return event;
+LinkEvent::LinkEvent(const LinkEvent& other, const allocator_type& allocator)
+    : LinkEvent{allocator} {
+    *this = other;
+}
+
+LinkEvent::LinkEvent(LinkEvent&& other, const allocator_type& allocator)
+    : LinkEvent{allocator} {
+    *this = std::move(other);
+}
+
+auto LinkEvent::from_nlmsghdr(const nlmsghdr& header, const allocator_type& allocator)
+        -> LinkEvent {
+    return LinkEventView{header}.materialize(allocator);
+}
+
+LinkEventView::LinkEventView(const nlmsghdr& header) noexcept
+    : header_{&header} {
+    switch (header.nlmsg_type) {
+    case RTM_NEWLINK: type_ = LinkEvent::Type::NEW_LINK; break;
+    case RTM_DELLINK: type_ = LinkEvent::Type::DELETE_LINK; break;
+    default: return;
     }
 
     const auto* info = get_msg_payload<ifinfomsg>(header);
     if (info == nullptr) {
-        event.type = Type::UNKNOWN;
+        type_ = LinkEvent::Type::UNKNOWN;
+        return;
+    }
+
+    info_ = *info;
+}
+
+auto LinkEventView::name() const noexcept -> std::string_view {
+    const auto* attr = index_.find(*header_, IFLA_IFNAME);
+    return attr != nullptr ? attribute_string_view(*attr) : std::string_view{};
+}
+
+auto LinkEventView::materialize(const LinkEvent::allocator_type& allocator) const
+        -> LinkEvent {
+    return compact().to_event(allocator);
+}
+
+auto LinkEventView::compact() const noexcept -> CompactLinkEvent {
+    CompactLinkEvent event{};
+    event.type = type_;
+
+    if (type_ == LinkEvent::Type::UNKNOWN) {
         return event;
     }
 
-    event.index = info->ifi_index;
-    event.flags = static_cast<Flags>(info->ifi_flags);
-    event.change = info->ifi_change;
-    event.name = extract_ifname(header);
+    event.index = index();
+    event.flags = flags();
+    event.change = change();
+    event.name = InterfaceName::from_string(name());
+
+    return event;
+}
+
+auto CompactLinkEvent::from_nlmsghdr(const nlmsghdr& header) noexcept
+        -> CompactLinkEvent {
+    return LinkEventView{header}.compact();
+}
+
+auto CompactLinkEvent::from_event(const LinkEvent& event) noexcept
+        -> CompactLinkEvent {
+    CompactLinkEvent compact{};
+    compact.type = event.type;
+    compact.index = event.index;
+    compact.flags = event.flags;
+    compact.change = event.change;
+    compact.name = InterfaceName::from_string(event.name);
+
+    return compact;
+}
+
+auto CompactLinkEvent::to_event(const LinkEvent::allocator_type& allocator) const
+        -> LinkEvent {
+    const std::pmr::polymorphic_allocator<char> chars{allocator};
+
+    LinkEvent event{allocator};
+    event.type = type;
+    event.index = index;
+    event.flags = flags;
+    event.change = change;
+    event.name = name.to_string(chars);
 
     return event;
 }
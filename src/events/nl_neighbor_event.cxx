@@ -1,5 +1,9 @@
 #include "rtaco/events/nl_neighbor_event.hxx"
 
+#include <memory_resource>
+#include <string>
+#include <utility>
+
 #include <linux/neighbour.h>
 #include <linux/netlink.h>
 #include <linux/rtnetlink.h>
@@ -9,40 +13,109 @@
 namespace llmx {
 namespace rtaco {
 
-auto NeighborEvent::from_nlmsghdr(const nlmsghdr& header) -> NeighborEvent {
-    using enum NeighborEvent::Type;
+NeighborEvent::NeighborEvent(const allocator_type& allocator) noexcept
+    : address{allocator}
+    , lladdr{allocator} {}
 
-    NeighborEvent event{};
-    switch (header.nlmsg_type) {
-    case RTM_NEWNEIGH: event.type = NEW_NEIGHBOR; break;
-    case RTM_DELNEIGH: event.type = DELETE_NEIGHBOR; break;
-    default: event.type = UNKNOWN; break;
-    }
+NeighborEvent::NeighborEvent(const NeighborEvent& other, const allocator_type& allocator)
+    : NeighborEvent{allocator} {
+    *this = other;
+}
 
-    if (event.type == UNKNOWN) {
-        return event;
+NeighborEvent::NeighborEvent(NeighborEvent&& other, const allocator_type& allocator)
+    : NeighborEvent{allocator} {
+    *this = std::move(other);
+}
+
+auto NeighborEvent::from_nlmsghdr(const nlmsghdr& header, const allocator_type& allocator)
+        -> NeighborEvent {
+    return NeighborEventView{header}.materialize(allocator);
+}
+
+NeighborEventView::NeighborEventView(const nlmsghdr& header) noexcept
+    : header_{&header} {
+    switch (header.nlmsg_type) {
+    case RTM_NEWNEIGH: type_ = NeighborEvent::Type::NEW_NEIGHBOR; break;
+    case RTM_DELNEIGH: type_ = NeighborEvent::Type::DELETE_NEIGHBOR; break;
+    default: return;
     }
 
     const auto* info = get_msg_payload<ndmsg>(header);
     if (info == nullptr) {
-        event.type = UNKNOWN;
+        type_ = NeighborEvent::Type::UNKNOWN;
+        return;
+    }
+
+    info_ = *info;
+}
+
+auto NeighborEventView::address() const -> std::string {
+    const auto* attr = index_.find(*header_, NDA_DST);
+    return attr != nullptr ? attribute_address(*attr, info_.ndm_family) : std::string{};
+}
+
+auto NeighborEventView::lladdr() const -> std::string {
+    const auto* attr = index_.find(*header_, NDA_LLADDR);
+    return attr != nullptr ? attribute_hwaddr(*attr) : std::string{};
+}
+
+auto NeighborEventView::materialize(const NeighborEvent::allocator_type& allocator) const
+        -> NeighborEvent {
+    return compact().to_event(allocator);
+}
+
+auto NeighborEventView::compact() const noexcept -> CompactNeighborEvent {
+    CompactNeighborEvent event{};
+    event.type = type_;
+
+    if (type_ == NeighborEvent::Type::UNKNOWN) {
         return event;
     }
 
-    event.family = info->ndm_family;
-    event.index = info->ndm_ifindex;
-    event.state = static_cast<NeighborEvent::State>(info->ndm_state);
-    event.flags = info->ndm_flags;
-    event.neighbor_type = info->ndm_type;
-
-    for_each_attr(header, info, [&](const rtattr* attr)
-    {
-        switch (attr->rta_type) {
-        case NDA_DST: event.address = attribute_address(*attr, event.family); break;
-        case NDA_LLADDR: event.lladdr = attribute_hwaddr(*attr); break;
-        default: break;
-        }
-    });
+    event.family = family();
+    event.index = index();
+    event.state = state();
+    event.flags = flags();
+    event.neighbor_type = neighbor_type();
+    event.address = IpAddress::from_bytes(attribute(NDA_DST), event.family);
+    event.lladdr = LinkLayerAddress::from_bytes(attribute(NDA_LLADDR));
+
+    return event;
+}
+
+auto CompactNeighborEvent::from_nlmsghdr(const nlmsghdr& header) noexcept
+        -> CompactNeighborEvent {
+    return NeighborEventView{header}.compact();
+}
+
+auto CompactNeighborEvent::from_event(const NeighborEvent& event) noexcept
+        -> CompactNeighborEvent {
+    CompactNeighborEvent compact{};
+    compact.type = event.type;
+    compact.index = event.index;
+    compact.family = event.family;
+    compact.state = event.state;
+    compact.flags = event.flags;
+    compact.neighbor_type = event.neighbor_type;
+    compact.address = IpAddress::from_string(event.address, event.family);
+    compact.lladdr = LinkLayerAddress::from_string(event.lladdr);
+
+    return compact;
+}
+
+auto CompactNeighborEvent::to_event(const NeighborEvent::allocator_type& allocator) const
+        -> NeighborEvent {
+    const std::pmr::polymorphic_allocator<char> chars{allocator};
+
+    NeighborEvent event{allocator};
+    event.type = type;
+    event.index = index;
+    event.family = family;
+    event.state = state;
+    event.flags = flags;
+    event.neighbor_type = neighbor_type;
+    event.address = address.to_string(chars);
+    event.lladdr = lladdr.to_string(chars);
 
     return event;
 }
@@ -1,57 +1,182 @@
 #include "rtaco/events/nl_route_event.hxx"
 
+#include <array>
+#include <charconv>
+#include <memory_resource>
+#include <string>
+#include <utility>
+
 #include <linux/netlink.h>
 #include <linux/rtnetlink.h>
-#include <string>
 
 #include "rtaco/core/nl_common.hxx"
 
 namespace llmx {
 namespace rtaco {
 
-auto RouteEvent::from_nlmsghdr(const nlmsghdr& header) -> RouteEvent {
-    RouteEvent event{};
-    switch (header.nlmsg_type) {
-    case RTM_NEWROUTE: event.type = Type::NEW_ROUTE; break;
-    case RTM_DELROUTE: event.type = Type::DELETE_ROUTE; break;
-    default: event.type = Type::UNKNOWN; break;
-    }
+RouteEvent::RouteEvent(const allocator_type& allocator) noexcept
+    : dst{allocator}
+    , src{allocator}
+    , gateway{allocator}
+    , prefsrc{allocator}
+    , oif{allocator} {}
 
-    if (event.type == Type::UNKNOWN) {
-        return event;
+RouteEvent::RouteEvent(const RouteEvent& other, const allocator_type& allocator)
+    : RouteEvent{allocator} {
+    *this = other;
+}
+
+RouteEvent::RouteEvent(RouteEvent&& other, const allocator_type& allocator)
+    : RouteEvent{allocator} {
+    *this = std::move(other);
+}
+
+auto RouteEvent::from_nlmsghdr(const nlmsghdr& header, const allocator_type& allocator)
+        -> RouteEvent {
+    return RouteEventView{header}.materialize(allocator);
+}
+
+RouteEventView::RouteEventView(const nlmsghdr& header) noexcept
+    : header_{&header} {
+    switch (header.nlmsg_type) {
+    case RTM_NEWROUTE: type_ = RouteEvent::Type::NEW_ROUTE; break;
+    case RTM_DELROUTE: type_ = RouteEvent::Type::DELETE_ROUTE; break;
+    default: return;
     }
 
     const auto* info = get_msg_payload<rtmsg>(header);
     if (info == nullptr) {
-        event.type = Type::UNKNOWN;
+        type_ = RouteEvent::Type::UNKNOWN;
+        return;
+    }
+
+    info_ = *info;
+}
+
+auto RouteEventView::table() const noexcept -> uint32_t {
+    if (const auto* attr = index_.find(*header_, RTA_TABLE); attr != nullptr) {
+        return attribute_uint32(*attr);
+    }
+    return info_.rtm_table;
+}
+
+auto RouteEventView::priority() const noexcept -> uint32_t {
+    return uint32(RTA_PRIORITY);
+}
+
+auto RouteEventView::oif_index() const noexcept -> uint32_t {
+    return uint32(RTA_OIF);
+}
+
+auto RouteEventView::dst() const -> std::string {
+    return address(RTA_DST);
+}
+
+auto RouteEventView::src() const -> std::string {
+    return address(RTA_SRC);
+}
+
+auto RouteEventView::gateway() const -> std::string {
+    return address(RTA_GATEWAY);
+}
+
+auto RouteEventView::prefsrc() const -> std::string {
+    return address(RTA_PREFSRC);
+}
+
+auto RouteEventView::materialize(const RouteEvent::allocator_type& allocator) const
+        -> RouteEvent {
+    return compact().to_event(allocator);
+}
+
+auto RouteEventView::address(uint16_t type) const -> std::string {
+    const auto* attr = index_.find(*header_, type);
+    return attr != nullptr ? attribute_address(*attr, info_.rtm_family) : std::string{};
+}
+
+auto RouteEventView::uint32(uint16_t type) const noexcept -> uint32_t {
+    const auto* attr = index_.find(*header_, type);
+    return attr != nullptr ? attribute_uint32(*attr) : 0U;
+}
+
+auto RouteEventView::compact() const noexcept -> CompactRouteEvent {
+    CompactRouteEvent event{};
+    event.type = type_;
+
+    if (type_ == RouteEvent::Type::UNKNOWN) {
         return event;
     }
 
-    event.family = info->rtm_family;
-    event.dst_prefix_len = info->rtm_dst_len;
-    event.src_prefix_len = info->rtm_src_len;
-    event.scope = info->rtm_scope;
-    event.protocol = info->rtm_protocol;
-    event.route_type = info->rtm_type;
-    event.flags = static_cast<Flags>(info->rtm_flags);
-    event.table = info->rtm_table;
-
-    for_each_attr(header, info, [&](const rtattr* attr)
-    {
-        switch (attr->rta_type) {
-        case RTA_TABLE: event.table = attribute_uint32(*attr); break;
-        case RTA_DST: event.dst = attribute_address(*attr, event.family); break;
-        case RTA_SRC: event.src = attribute_address(*attr, event.family); break;
-        case RTA_GATEWAY: event.gateway = attribute_address(*attr, event.family); break;
-        case RTA_PREFSRC: event.prefsrc = attribute_address(*attr, event.family); break;
-        case RTA_OIF: event.oif_index = attribute_uint32(*attr); break;
-        case RTA_PRIORITY: event.priority = attribute_uint32(*attr); break;
-        default: break;
-        }
-    });
-
-    if (event.oif_index != 0U) {
-        event.oif = std::to_string(event.oif_index);
+    event.family = family();
+    event.dst_prefix_len = dst_prefix_len();
+    event.src_prefix_len = src_prefix_len();
+    event.scope = scope();
+    event.protocol = protocol();
+    event.route_type = route_type();
+    event.flags = flags();
+    event.table = table();
+    event.priority = priority();
+    event.oif_index = oif_index();
+    event.dst = IpAddress::from_bytes(attribute(RTA_DST), event.family);
+    event.src = IpAddress::from_bytes(attribute(RTA_SRC), event.family);
+    event.gateway = IpAddress::from_bytes(attribute(RTA_GATEWAY), event.family);
+    event.prefsrc = IpAddress::from_bytes(attribute(RTA_PREFSRC), event.family);
+
+    return event;
+}
+
+auto CompactRouteEvent::from_nlmsghdr(const nlmsghdr& header) noexcept
+        -> CompactRouteEvent {
+    return RouteEventView{header}.compact();
+}
+
+auto CompactRouteEvent::from_event(const RouteEvent& event) noexcept
+        -> CompactRouteEvent {
+    CompactRouteEvent compact{};
+    compact.type = event.type;
+    compact.family = event.family;
+    compact.dst_prefix_len = event.dst_prefix_len;
+    compact.src_prefix_len = event.src_prefix_len;
+    compact.scope = event.scope;
+    compact.protocol = event.protocol;
+    compact.route_type = event.route_type;
+    compact.flags = event.flags;
+    compact.table = event.table;
+    compact.priority = event.priority;
+    compact.oif_index = event.oif_index;
+    compact.dst = IpAddress::from_string(event.dst, event.family);
+    compact.src = IpAddress::from_string(event.src, event.family);
+    compact.gateway = IpAddress::from_string(event.gateway, event.family);
+    compact.prefsrc = IpAddress::from_string(event.prefsrc, event.family);
+
+    return compact;
+}
+
+auto CompactRouteEvent::to_event(const RouteEvent::allocator_type& allocator) const
+        -> RouteEvent {
+    const std::pmr::polymorphic_allocator<char> chars{allocator};
+
+    RouteEvent event{allocator};
+    event.type = type;
+    event.family = family;
+    event.dst_prefix_len = dst_prefix_len;
+    event.src_prefix_len = src_prefix_len;
+    event.scope = scope;
+    event.protocol = protocol;
+    event.route_type = route_type;
+    event.flags = flags;
+    event.table = table;
+    event.priority = priority;
+    event.oif_index = oif_index;
+    event.dst = dst.to_string(chars);
+    event.src = src.to_string(chars);
+    event.gateway = gateway.to_string(chars);
+    event.prefsrc = prefsrc.to_string(chars);
+
+    if (oif_index != 0U) {
+        std::array<char, 10> digits{};
+        const auto [end, ec] = std::to_chars(digits.begin(), digits.end(), oif_index);
+        event.oif.assign(digits.data(), end);
     }
 
     return event;
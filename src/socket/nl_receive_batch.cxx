@@ -0,0 +1,89 @@
+#include "rtaco/socket/nl_receive_batch.hxx"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <span>
+#include <system_error>
+
+#include <sys/socket.h>
+
+namespace llmx {
+namespace rtaco {
+
+ReceiveBatch::ReceiveBatch(size_t count, ReceiveBufferOptions options) noexcept
+    : count_{std::max<size_t>(count, 1U)}
+    , options_{options} {
+    options_.initial_size = std::max<size_t>(options_.initial_size, 1U);
+    options_.max_size = std::max(options_.max_size, options_.initial_size);
+    wanted_slot_size_ = options_.initial_size;
+}
+
+auto ReceiveBatch::count() const noexcept -> size_t {
+    return count_;
+}
+
+auto ReceiveBatch::slot_size() const noexcept -> size_t {
+    return slot_size_;
+}
+
+void ReceiveBatch::allocate(size_t slot_size) {
+    slot_size_ = slot_size;
+    storage_.assign(count_ * slot_size_, 0U);
+    iovecs_.resize(count_);
+    headers_.resize(count_);
+
+    for (size_t i = 0; i < count_; ++i) {
+        iovecs_[i] = iovec{storage_.data() + i * slot_size_, slot_size_};
+    }
+}
+
+auto ReceiveBatch::receive(int fd) -> std::expected<size_t, std::error_code> {
+    if (wanted_slot_size_ != slot_size_) {
+        allocate(wanted_slot_size_);
+    }
+
+    // recvmmsg overwrites msg_len and msg_flags, so the headers are reset on
+    // every call.
+    for (size_t i = 0; i < count_; ++i) {
+        headers_[i] = mmsghdr{};
+        headers_[i].msg_hdr.msg_iov = &iovecs_[i];
+        headers_[i].msg_hdr.msg_iovlen = 1U;
+    }
+
+    int received = 0;
+    do {
+        received = ::recvmmsg(fd, headers_.data(), static_cast<unsigned int>(count_),
+                MSG_DONTWAIT | MSG_TRUNC, nullptr);
+    } while (received < 0 && errno == EINTR);
+
+    if (received < 0) {
+        return std::unexpected(std::error_code{errno, std::generic_category()});
+    }
+
+    for (int i = 0; i < received; ++i) {
+        if (headers_[i].msg_len > slot_size_) {
+            wanted_slot_size_ = std::clamp<size_t>(headers_[i].msg_len,
+                    wanted_slot_size_, options_.max_size);
+        }
+    }
+
+    return static_cast<size_t>(received);
+}
+
+auto ReceiveBatch::datagram(size_t index) const
+        -> std::expected<std::span<const uint8_t>, std::error_code> {
+    const auto& header = headers_[index];
+
+    if ((header.msg_hdr.msg_flags & MSG_TRUNC) != 0 || header.msg_len > slot_size_) {
+        return std::unexpected(std::make_error_code(std::errc::message_size));
+    }
+
+    return std::span<const uint8_t>{storage_.data() + index * slot_size_,
+            header.msg_len};
+}
+
+} // namespace rtaco
+} // namespace llmx
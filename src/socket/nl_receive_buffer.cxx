@@ -0,0 +1,94 @@
+#include "rtaco/socket/nl_receive_buffer.hxx"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <span>
+#include <system_error>
+
+#include <sys/socket.h>
+
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/redirect_error.hpp>
+#include <boost/asio/use_awaitable.hpp>
+#include <boost/system/error_code.hpp>
+
+#include "rtaco/socket/nl_socket.hxx"
+
+namespace llmx {
+namespace rtaco {
+
+namespace asio = boost::asio;
+
+ReceiveBuffer::ReceiveBuffer(ReceiveBufferOptions options) noexcept
+    : options_{options} {
+    options_.initial_size = std::max<size_t>(options_.initial_size, 1U);
+    options_.max_size = std::max(options_.max_size, options_.initial_size);
+}
+
+auto ReceiveBuffer::needs_peek() const noexcept -> bool {
+    return storage_.size() < options_.max_size;
+}
+
+void ReceiveBuffer::reserve(size_t pending) {
+    const auto wanted = std::max(pending, options_.initial_size);
+    if (wanted <= storage_.size()) {
+        return;
+    }
+
+    // Grow geometrically so a run of slightly larger datagrams does not
+    // reallocate every time.
+    const auto grown = std::max(wanted, storage_.size() * 2U);
+    storage_.resize(std::min(grown, options_.max_size));
+}
+
+auto ReceiveBuffer::buffer() -> asio::mutable_buffer {
+    if (storage_.empty()) {
+        storage_.resize(options_.initial_size);
+    }
+
+    return asio::buffer(storage_);
+}
+
+auto ReceiveBuffer::capacity() const noexcept -> size_t {
+    return storage_.size();
+}
+
+auto ReceiveBuffer::received(size_t bytes) const
+        -> std::expected<std::span<const uint8_t>, std::error_code> {
+    if (bytes > storage_.size()) {
+        return std::unexpected(std::make_error_code(std::errc::message_size));
+    }
+
+    return std::span<const uint8_t>{storage_.data(), bytes};
+}
+
+auto ReceiveBuffer::async_receive(Socket& socket)
+        -> asio::awaitable<std::expected<std::span<const uint8_t>, std::error_code>> {
+    boost::system::error_code ec{};
+
+    if (needs_peek()) {
+        const auto pending = co_await socket.async_receive(asio::mutable_buffer{},
+                MSG_PEEK | MSG_TRUNC, asio::redirect_error(asio::use_awaitable, ec));
+
+        if (ec) {
+            co_return std::unexpected(
+                    std::error_code{ec.value(), std::generic_category()});
+        }
+
+        reserve(pending);
+    }
+
+    const auto bytes = co_await socket.async_receive(buffer(), MSG_TRUNC,
+            asio::redirect_error(asio::use_awaitable, ec));
+
+    if (ec) {
+        co_return std::unexpected(std::error_code{ec.value(), std::generic_category()});
+    }
+
+    co_return received(bytes);
+}
+
+} // namespace rtaco
+} // namespace llmx
@@ -2,13 +2,14 @@
 
 #include <cerrno>
 #include <cstdint>
-#include <cstring>
 #include <expected>
-#include <iostream>
+#include <span>
 #include <stdexcept>
+#include <string>
 #include <string_view>
 #include <system_error>
 
+#include <linux/filter.h>
 #include <linux/netlink.h>
 #include <sys/socket.h>
 
@@ -94,22 +95,84 @@ auto Socket::open(int proto, uint32_t groups) -> std::expected<void, std::error_
                 " socket: " + ec.message());
     }
 
-    // TODO: remove in production code
-    {
-        sockaddr_nl sa{};
-        socklen_t salen = sizeof(sa);
-        if (getsockname(socket_.native_handle(), reinterpret_cast<sockaddr*>(&sa),
-                    &salen) == 0) {
-            std::cout << label_ << ": bound nl_pid=" << sa.nl_pid << " nl_groups=0x"
-                      << std::hex << sa.nl_groups << std::dec << "\n";
-        } else {
-            std::cout << label_ << ": getsockname failed: " << strerror(errno) << "\n";
-        }
+    return {};
+}
+
+auto Socket::set_overrun_reporting(bool enabled) -> std::expected<void, std::error_code> {
+    boost::system::error_code ec;
+
+    if (socket_.set_option(no_enobufs_option{enabled ? 0 : 1}, ec); ec) {
+        return std::unexpected{ec};
+    }
+
+    return {};
+}
+
+auto Socket::join_group(uint32_t group) -> std::expected<void, std::error_code> {
+    boost::system::error_code ec;
+
+    if (socket_.set_option(add_membership_option{static_cast<int>(group)}, ec); ec) {
+        return std::unexpected{ec};
+    }
+
+    return {};
+}
+
+auto Socket::leave_group(uint32_t group) -> std::expected<void, std::error_code> {
+    boost::system::error_code ec;
+
+    if (socket_.set_option(drop_membership_option{static_cast<int>(group)}, ec); ec) {
+        return std::unexpected{ec};
+    }
+
+    return {};
+}
+
+auto Socket::attach_filter(std::span<const sock_filter> program)
+        -> std::expected<void, std::error_code> {
+    const sock_fprog fprog{static_cast<unsigned short>(program.size()),
+            const_cast<sock_filter*>(program.data())};
+
+    if (::setsockopt(socket_.native_handle(), SOL_SOCKET, SO_ATTACH_FILTER, &fprog,
+                sizeof(fprog)) < 0) {
+        return std::unexpected(std::error_code{errno, std::generic_category()});
+    }
+
+    return {};
+}
+
+auto Socket::detach_filter() -> std::expected<void, std::error_code> {
+    const int unused = 0;
+
+    if (::setsockopt(socket_.native_handle(), SOL_SOCKET, SO_DETACH_FILTER, &unused,
+                sizeof(unused)) < 0 &&
+            errno != ENOENT) {
+        return std::unexpected(std::error_code{errno, std::generic_category()});
     }
 
     return {};
 }
 
+auto Socket::discard_pending() -> size_t {
+    size_t discarded = 0;
+
+    while (true) {
+        uint8_t byte = 0;
+        const auto rc = ::recv(socket_.native_handle(), &byte, sizeof(byte),
+                MSG_DONTWAIT | MSG_TRUNC);
+
+        if (rc >= 0) {
+            ++discarded;
+            continue;
+        }
+
+        // ENOBUFS only reports the overrun; the queue may still hold data.
+        if (errno != EINTR && errno != ENOBUFS) {
+            return discarded;
+        }
+    }
+}
+
 auto Socket::native_handle() -> native_t {
     return socket_.native_handle();
 }
@@ -26,7 +26,43 @@ AddressDumpTask::AddressDumpTask(SocketGuard& socket_guard,
     , learned_{pmr} {}
 
 void AddressDumpTask::prepare_request() {
-    build_request();
+    build_request(NLM_F_REQUEST | NLM_F_DUMP, filter_.family);
+
+    if (filter_.index != 0U) {
+        request_.message.ifa_index = filter_.index;
+    }
+}
+
+void AddressDumpTask::set_chunk_handler(AddressEventChunkHandler on_chunk) {
+    on_chunk_ = std::move(on_chunk);
+}
+
+void AddressDumpTask::set_view_handler(AddressEventViewHandler on_view) {
+    on_view_ = std::move(on_view);
+}
+
+void AddressDumpTask::set_filter(AddressDumpFilter filter) {
+    filter_ = filter;
+}
+
+auto AddressDumpTask::in_scope(const AddressEventView& view,
+        const AddressDumpFilter& filter) noexcept -> bool {
+    const auto index = view.index();
+    if (index <= 0 || index > std::numeric_limits<uint16_t>::max()) {
+        return false;
+    }
+
+    return (filter.family == AF_UNSPEC || view.family() == filter.family) &&
+           (filter.index == 0U || static_cast<uint32_t>(index) == filter.index);
+}
+
+void AddressDumpTask::flush_batch() {
+    if (!on_chunk_ || learned_.empty()) {
+        return;
+    }
+
+    on_chunk_(std::span<const AddressEvent>{learned_.data(), learned_.size()});
+    learned_.clear();
 }
 
 auto AddressDumpTask::process_message(const nlmsghdr& header)
@@ -44,6 +80,7 @@ auto AddressDumpTask::process_message(const nlmsghdr& header)
 }
 
 auto AddressDumpTask::handle_done() -> std::expected<AddressEventList, std::error_code> {
+    flush_batch();
     return std::move(learned_);
 }
 
@@ -54,6 +91,7 @@ auto AddressDumpTask::handle_error(const nlmsghdr& header)
     const auto error_code = std::make_error_code(static_cast<std::errc>(code));
 
     if (!error_code) {
+        flush_batch();
         return std::move(learned_);
     }
 
@@ -62,21 +100,22 @@ auto AddressDumpTask::handle_error(const nlmsghdr& header)
 
 auto AddressDumpTask::dispatch_address(const nlmsghdr& header)
         -> std::optional<std::expected<AddressEventList, std::error_code>> {
-    const auto event = AddressEvent::from_nlmsghdr(header);
+    const AddressEventView view{header};
 
-    if (event.type != AddressEvent::Type::NEW_ADDRESS) {
+    if (view.type() != AddressEvent::Type::NEW_ADDRESS) {
         return std::nullopt;
     }
 
-    if (event.index <= 0) {
+    if (!in_scope(view, filter_)) {
         return std::nullopt;
     }
 
-    if (event.index > std::numeric_limits<uint16_t>::max()) {
+    if (on_view_) {
+        on_view_(view);
         return std::nullopt;
     }
 
-    learned_.push_back(event);
+    learned_.push_back(view.materialize(learned_.get_allocator()));
     return std::nullopt;
 }
 
@@ -1,24 +1,48 @@
 #include "rtaco/tasks/nl_link_dump_task.hxx"
 
+#include <algorithm>
+#include <array>
 #include <cstdint>
 #include <expected>
 #include <limits>
 #include <memory_resource>
 #include <optional>
+#include <span>
+#include <string_view>
 #include <system_error>
 #include <utility>
 #include <cstring>
 #include <cerrno>
 
+#include <linux/if_link.h>
 #include <linux/netlink.h>
 #include <linux/rtnetlink.h>
+#include <net/if.h>
 
+#include "rtaco/core/nl_common.hxx"
 #include "rtaco/events/nl_link_event.hxx"
 #include "rtaco/tasks/nl_link_task.hxx"
 
 namespace llmx {
 namespace rtaco {
 
+namespace {
+/** IFLA_INFO_KIND nested in IFLA_LINKINFO, or empty for plain devices. */
+auto link_kind(const LinkEventView& view) noexcept -> std::string_view {
+    const auto info = view.attribute(IFLA_LINKINFO);
+    auto remaining = static_cast<int>(info.size());
+
+    for (const auto* attr = reinterpret_cast<const rtattr*>(info.data());
+            RTA_OK(attr, remaining); attr = RTA_NEXT(attr, remaining)) {
+        if (attr->rta_type == IFLA_INFO_KIND) {
+            return attribute_string_view(*attr);
+        }
+    }
+
+    return {};
+}
+} // namespace
+
 LinkDumpTask::LinkDumpTask(SocketGuard& socket_guard, std::pmr::memory_resource* pmr,
         uint16_t ifindex, uint32_t sequence) noexcept
     : LinkTask{socket_guard, ifindex, sequence}
@@ -28,6 +52,66 @@ void LinkDumpTask::prepare_request() {
     std::memset(&request_, 0, sizeof(request_));
 
     build_request(NLM_F_REQUEST | NLM_F_DUMP);
+
+    if (filter_.master != 0U) {
+        append_attribute(request_, IFLA_MASTER, filter_.master);
+    }
+
+    if (!filter_.kind.empty()) {
+        // IFLA_LINKINFO { IFLA_INFO_KIND "<kind>" }
+        std::array<uint8_t, RTA_SPACE(IFNAMSIZ)> info{};
+        const auto length = std::min<size_t>(filter_.kind.size(), IFNAMSIZ - 1U);
+
+        auto* kind = reinterpret_cast<rtattr*>(info.data());
+        kind->rta_type = IFLA_INFO_KIND;
+        kind->rta_len = static_cast<unsigned short>(RTA_LENGTH(length + 1U));
+        std::memcpy(RTA_DATA(kind), filter_.kind.data(), length);
+
+        append_attribute(request_, IFLA_LINKINFO,
+                std::span<const uint8_t>{info.data(), RTA_ALIGN(kind->rta_len)});
+    }
+}
+
+void LinkDumpTask::set_chunk_handler(LinkEventChunkHandler on_chunk) {
+    on_chunk_ = std::move(on_chunk);
+}
+
+void LinkDumpTask::set_view_handler(LinkEventViewHandler on_view) {
+    on_view_ = std::move(on_view);
+}
+
+void LinkDumpTask::set_filter(LinkDumpFilter filter) {
+    filter_ = std::move(filter);
+}
+
+auto LinkDumpTask::in_scope(const LinkEventView& view,
+        const LinkDumpFilter& filter) noexcept -> bool {
+    const auto index = view.index();
+    if (index <= 0 || index > std::numeric_limits<uint16_t>::max()) {
+        return false;
+    }
+
+    if (filter.master != 0U) {
+        const auto master = view.attribute(IFLA_MASTER);
+        uint32_t value = 0U;
+        if (master.size() >= sizeof(value)) {
+            std::memcpy(&value, master.data(), sizeof(value));
+        }
+        if (value != filter.master) {
+            return false;
+        }
+    }
+
+    return filter.kind.empty() || link_kind(view) == filter.kind;
+}
+
+void LinkDumpTask::flush_batch() {
+    if (!on_chunk_ || learned_.empty()) {
+        return;
+    }
+
+    on_chunk_(std::span<const LinkEvent>{learned_.data(), learned_.size()});
+    learned_.clear();
 }
 
 auto LinkDumpTask::process_message(const nlmsghdr& header)
@@ -45,6 +129,7 @@ auto LinkDumpTask::process_message(const nlmsghdr& header)
 }
 
 auto LinkDumpTask::handle_done() -> std::expected<LinkEventList, std::error_code> {
+    flush_batch();
     return std::move(learned_);
 }
 
@@ -55,6 +140,7 @@ auto LinkDumpTask::handle_error(const nlmsghdr& header)
     const auto error_code = std::make_error_code(static_cast<std::errc>(code));
 
     if (!error_code) {
+        flush_batch();
         return std::move(learned_);
     }
 
@@ -63,21 +149,22 @@ auto LinkDumpTask::handle_error(const nlmsghdr& header)
 
 auto LinkDumpTask::dispatch_link(const nlmsghdr& header)
         -> std::optional<std::expected<LinkEventList, std::error_code>> {
-    const auto event = LinkEvent::from_nlmsghdr(header);
+    const LinkEventView view{header};
 
-    if (event.type != LinkEvent::Type::NEW_LINK) {
+    if (view.type() != LinkEvent::Type::NEW_LINK) {
         return std::nullopt;
     }
 
-    if (event.index <= 0) {
+    if (!in_scope(view, filter_)) {
         return std::nullopt;
     }
 
-    if (event.index > std::numeric_limits<uint16_t>::max()) {
+    if (on_view_) {
+        on_view_(view);
         return std::nullopt;
     }
 
-    learned_.push_back(event);
+    learned_.push_back(view.materialize(learned_.get_allocator()));
     return std::nullopt;
 }
 
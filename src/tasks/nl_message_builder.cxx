@@ -0,0 +1,119 @@
+#include "rtaco/tasks/nl_message_builder.hxx"
+
+#include <cstring>
+#include <span>
+
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+
+namespace llmx {
+namespace rtaco {
+
+void MessageBuilder::reserve(size_t bytes) {
+    buffer_.reserve(bytes);
+}
+
+void MessageBuilder::clear() noexcept {
+    buffer_.clear();
+    start_ = 0U;
+    end_ = 0U;
+    count_ = 0U;
+}
+
+void MessageBuilder::open(uint16_t type, uint16_t flags, uint32_t sequence,
+        size_t family_size) {
+    // Anything after `end_` is a message that was opened but never closed.
+    start_ = end_;
+    buffer_.resize(start_ + NLMSG_SPACE(family_size));
+    std::memset(buffer_.data() + start_, 0, buffer_.size() - start_);
+
+    auto& message = header();
+    message.nlmsg_len = static_cast<uint32_t>(NLMSG_LENGTH(family_size));
+    message.nlmsg_type = type;
+    message.nlmsg_flags = flags;
+    message.nlmsg_seq = sequence;
+}
+
+void MessageBuilder::begin(uint16_t type, uint16_t flags, uint32_t sequence) {
+    open(type, flags, sequence, 0U);
+}
+
+void MessageBuilder::attribute(uint16_t type, std::span<const uint8_t> payload) {
+    const auto offset = buffer_.size();
+    buffer_.resize(offset + RTA_SPACE(payload.size()));
+
+    auto* attr = reinterpret_cast<rtattr*>(buffer_.data() + offset);
+    attr->rta_type = type;
+    attr->rta_len = static_cast<unsigned short>(RTA_LENGTH(payload.size()));
+    if (!payload.empty()) {
+        std::memcpy(RTA_DATA(attr), payload.data(), payload.size());
+    }
+
+    header().nlmsg_len = static_cast<uint32_t>(buffer_.size() - start_);
+}
+
+void MessageBuilder::attribute(uint16_t type, uint32_t value) {
+    attribute(type, {reinterpret_cast<const uint8_t*>(&value), sizeof(value)});
+}
+
+auto MessageBuilder::begin_nested(uint16_t type) -> size_t {
+    const auto nest = buffer_.size();
+    attribute(type, std::span<const uint8_t>{});
+    return nest;
+}
+
+void MessageBuilder::end_nested(size_t nest) {
+    const auto length = buffer_.size() - nest;
+    if (length == RTA_LENGTH(0U)) {
+        buffer_.resize(nest);
+        header().nlmsg_len = static_cast<uint32_t>(buffer_.size() - start_);
+        return;
+    }
+
+    reinterpret_cast<rtattr*>(buffer_.data() + nest)->rta_len =
+            static_cast<unsigned short>(length);
+}
+
+void MessageBuilder::end() {
+    end_ = buffer_.size();
+    ++count_;
+}
+
+void MessageBuilder::append(std::span<const uint8_t> messages) {
+    buffer_.resize(end_);
+    buffer_.insert(buffer_.end(), messages.begin(), messages.end());
+
+    auto remaining = static_cast<unsigned int>(messages.size());
+    auto* message = reinterpret_cast<const nlmsghdr*>(buffer_.data() + end_);
+    while (NLMSG_OK(message, remaining)) {
+        ++count_;
+        message = NLMSG_NEXT(message, remaining);
+    }
+
+    end_ = buffer_.size();
+}
+
+void MessageBuilder::rebase(uint32_t base) noexcept {
+    auto remaining = static_cast<unsigned int>(end_);
+    auto* message = reinterpret_cast<nlmsghdr*>(buffer_.data());
+    while (NLMSG_OK(message, remaining)) {
+        message->nlmsg_seq += base;
+        message = NLMSG_NEXT(message, remaining);
+    }
+}
+
+void MessageBuilder::clear_flags(uint16_t flags) noexcept {
+    auto remaining = static_cast<unsigned int>(end_);
+    auto* message = reinterpret_cast<nlmsghdr*>(buffer_.data());
+    while (NLMSG_OK(message, remaining)) {
+        message->nlmsg_flags &= static_cast<uint16_t>(~flags);
+        message = NLMSG_NEXT(message, remaining);
+    }
+}
+
+auto MessageBuilder::header() noexcept -> nlmsghdr& {
+    return *reinterpret_cast<nlmsghdr*>(buffer_.data() + start_);
+}
+
+} // namespace rtaco
+} // namespace llmx
@@ -11,6 +11,7 @@
 #include <utility>
 #include <cerrno>
 
+#include <linux/neighbour.h>
 #include <linux/netlink.h>
 #include <linux/rtnetlink.h>
 
@@ -30,6 +31,50 @@ void NeighborDumpTask::prepare_request() {
 
     build_request(RTM_GETNEIGH, NLM_F_REQUEST | NLM_F_DUMP, 0, 0,
             std::span<uint8_t, 16>{request_.dst});
+    request_.message.ndm_family = filter_.family;
+
+    // Strict checking rejects a dump with ndm_ifindex set; the interface
+    // and master filters travel as attributes.
+    if (filter_.index != 0U) {
+        append_attribute(request_, NDA_IFINDEX, filter_.index);
+    }
+
+    if (filter_.master != 0U) {
+        append_attribute(request_, NDA_MASTER, filter_.master);
+    }
+}
+
+void NeighborDumpTask::set_chunk_handler(NeighborEventChunkHandler on_chunk) {
+    on_chunk_ = std::move(on_chunk);
+}
+
+void NeighborDumpTask::set_view_handler(NeighborEventViewHandler on_view) {
+    on_view_ = std::move(on_view);
+}
+
+void NeighborDumpTask::set_filter(NeighborDumpFilter filter) {
+    filter_ = filter;
+}
+
+auto NeighborDumpTask::in_scope(const NeighborEventView& view,
+        const NeighborDumpFilter& filter) noexcept -> bool {
+    const auto index = view.index();
+    if (index <= 0 || index > std::numeric_limits<uint16_t>::max()) {
+        return false;
+    }
+
+    // The master is not part of the reply; that filter is kernel-side only.
+    return (filter.family == AF_UNSPEC || view.family() == filter.family) &&
+           (filter.index == 0U || static_cast<uint32_t>(index) == filter.index);
+}
+
+void NeighborDumpTask::flush_batch() {
+    if (!on_chunk_ || learned_.empty()) {
+        return;
+    }
+
+    on_chunk_(std::span<const NeighborEvent>{learned_.data(), learned_.size()});
+    learned_.clear();
 }
 
 auto NeighborDumpTask::process_message(const nlmsghdr& header)
@@ -48,6 +93,7 @@ auto NeighborDumpTask::process_message(const nlmsghdr& header)
 
 auto NeighborDumpTask::handle_done()
         -> std::expected<NeighborEventList, std::error_code> {
+    flush_batch();
     return std::move(learned_);
 }
 
@@ -58,6 +104,7 @@ auto NeighborDumpTask::handle_error(const nlmsghdr& header)
     const auto error_code = std::make_error_code(static_cast<std::errc>(code));
 
     if (!error_code) {
+        flush_batch();
         return std::move(learned_);
     }
 
@@ -66,21 +113,22 @@ auto NeighborDumpTask::handle_error(const nlmsghdr& header)
 
 auto NeighborDumpTask::dispatch_neighbor(const nlmsghdr& header)
         -> std::optional<std::expected<NeighborEventList, std::error_code>> {
-    const auto event = NeighborEvent::from_nlmsghdr(header);
+    const NeighborEventView view{header};
 
-    if (event.type != NeighborEvent::Type::NEW_NEIGHBOR) {
+    if (view.type() != NeighborEvent::Type::NEW_NEIGHBOR) {
         return std::nullopt;
     }
 
-    if (event.index <= 0) {
+    if (!in_scope(view, filter_)) {
         return std::nullopt;
     }
 
-    if (event.index > std::numeric_limits<uint16_t>::max()) {
+    if (on_view_) {
+        on_view_(view);
         return std::nullopt;
     }
 
-    learned_.push_back(event);
+    learned_.push_back(view.materialize(learned_.get_allocator()));
     return std::nullopt;
 }
 
@@ -73,7 +73,9 @@ auto NeighborGetTask::handle_neighbor(const nlmsghdr& header)
         return event;
     }
 
-    return std::nullopt;
+    // A non-dump get is answered by exactly one message; an entry without a
+    // link-layer address is unresolved rather than something to wait for.
+    return std::unexpected{std::make_error_code(static_cast<std::errc>(ENOENT))};
 }
 
 } // namespace rtaco
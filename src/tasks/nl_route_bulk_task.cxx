@@ -0,0 +1,132 @@
+#include "rtaco/tasks/nl_route_bulk_task.hxx"
+
+#include <algorithm>
+#include <expected>
+#include <memory>
+#include <system_error>
+#include <utility>
+
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/redirect_error.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/this_coro.hpp>
+#include <boost/asio/use_awaitable.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <linux/netlink.h>
+
+namespace llmx {
+namespace rtaco {
+
+namespace asio = boost::asio;
+
+struct RouteBulkTask::State {
+    explicit State(const asio::any_io_executor& executor)
+        : done{executor} {}
+
+    size_t next{0};
+    size_t workers{0};
+    RouteBulkResult result{};
+    std::error_code error{};
+    asio::steady_timer done;
+};
+
+RouteBulkTask::RouteBulkTask(Transport& transport, RouteOp op,
+        std::span<const RouteSpec> routes, uint32_t first_sequence,
+        RouteBulkOptions options) noexcept
+    : transport_{transport}
+    , op_{op}
+    , routes_{routes}
+    , first_sequence_{first_sequence}
+    , options_{options} {}
+
+auto RouteBulkTask::async_run()
+        -> asio::awaitable<std::expected<RouteBulkResult, std::error_code>> {
+    const auto executor = co_await asio::this_coro::executor;
+    auto state = std::make_shared<State>(executor);
+    state->done.expires_at(asio::steady_timer::time_point::max());
+
+    const auto batch_size = std::clamp<size_t>(options_.batch_size, 1U,
+            Transport::MAX_UNACKED);
+    const auto window = std::clamp<size_t>(options_.window, 1U,
+            Transport::MAX_UNACKED / batch_size);
+    const auto batches = (routes_.size() + batch_size - 1U) / batch_size;
+
+    state->workers = std::min(window, batches);
+    for (size_t i = 0; i < state->workers; ++i) {
+        asio::co_spawn(executor, worker(state, batch_size), asio::detached);
+    }
+
+    while (state->workers != 0U) {
+        boost::system::error_code ec;
+        co_await state->done.async_wait(asio::redirect_error(asio::use_awaitable, ec));
+    }
+
+    if (state->error) {
+        co_return std::unexpected{state->error};
+    }
+
+    std::ranges::sort(state->result.failures, {}, &RouteFailure::index);
+    co_return std::move(state->result);
+}
+
+auto RouteBulkTask::worker(std::shared_ptr<State> state, size_t batch_size)
+        -> asio::awaitable<void> {
+    auto& result = state->result;
+    MessageBuilder builder{};
+    builder.reserve(batch_size * MAX_ROUTE_MESSAGE_SIZE);
+
+    // Batches are handed out one at a time, so a worker that is waiting on a
+    // slow batch does not hold up the rest.
+    while (!state->error && state->next < routes_.size()) {
+        const auto begin = state->next;
+        const auto end = std::min(begin + batch_size, routes_.size());
+        state->next = end;
+
+        builder.clear();
+        for (auto i = begin; i < end; ++i) {
+            const auto sequence = first_sequence_ + static_cast<uint32_t>(i);
+            if (auto appended = append_route(builder, op_, routes_[i], sequence);
+                    !appended) {
+                result.failures.push_back(RouteFailure{i, 0U, appended.error()});
+            }
+        }
+
+        if (builder.empty()) {
+            continue;
+        }
+
+        size_t acked = 0U;
+        auto status = co_await transport_.async_transact(builder.data(),
+                [this, &result, &acked, &builder](const nlmsghdr& header) -> bool
+        {
+            if (header.nlmsg_type != NLMSG_ERROR ||
+                    header.nlmsg_len < NLMSG_LENGTH(sizeof(nlmsgerr))) {
+                return false;
+            }
+
+            const auto* ack = reinterpret_cast<const nlmsgerr*>(NLMSG_DATA(&header));
+            if (ack->error == 0) {
+                ++result.succeeded;
+            } else {
+                result.failures.push_back(RouteFailure{
+                        static_cast<size_t>(header.nlmsg_seq - first_sequence_),
+                        header.nlmsg_seq,
+                        std::make_error_code(static_cast<std::errc>(-ack->error))});
+            }
+            return ++acked == builder.count();
+        });
+
+        if (!status) {
+            state->error = status.error();
+        }
+    }
+
+    if (--state->workers == 0U) {
+        state->done.cancel();
+    }
+}
+
+} // namespace rtaco
+} // namespace llmx
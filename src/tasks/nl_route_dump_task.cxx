@@ -5,6 +5,7 @@
 #include <limits>
 #include <memory_resource>
 #include <optional>
+#include <span>
 #include <system_error>
 #include <utility>
 
@@ -23,8 +24,54 @@ RouteDumpTask::RouteDumpTask(SocketGuard& socket_guard, std::pmr::memory_resourc
     , learned_{pmr} {}
 
 void RouteDumpTask::prepare_request() {
-    build_request(NLM_F_REQUEST | NLM_F_DUMP, RTN_UNSPEC, RT_TABLE_MAIN,
-            RT_SCOPE_UNIVERSE, RTN_UNSPEC);
+    // rtm_table only holds ids below 256; larger ones go in RTA_TABLE.
+    const auto short_table = filter_.table <= std::numeric_limits<uint8_t>::max();
+
+    build_request(NLM_F_REQUEST | NLM_F_DUMP, filter_.family,
+            short_table ? static_cast<uint8_t>(filter_.table)
+                        : static_cast<uint8_t>(RT_TABLE_UNSPEC),
+            RT_SCOPE_UNIVERSE, filter_.protocol);
+    request_.message.rtm_type = filter_.type;
+
+    if (!short_table) {
+        append_attribute(request_, RTA_TABLE, filter_.table);
+    }
+
+    if (filter_.oif != 0U) {
+        append_attribute(request_, RTA_OIF, filter_.oif);
+    }
+}
+
+void RouteDumpTask::set_chunk_handler(RouteEventChunkHandler on_chunk) {
+    on_chunk_ = std::move(on_chunk);
+}
+
+void RouteDumpTask::set_view_handler(RouteEventViewHandler on_view) {
+    on_view_ = std::move(on_view);
+}
+
+void RouteDumpTask::set_filter(RouteDumpFilter filter) {
+    filter_ = filter;
+}
+
+auto RouteDumpTask::in_scope(const RouteEventView& view,
+        const RouteDumpFilter& filter) noexcept -> bool {
+    // Multipath, blackhole, unreachable and prohibit routes carry no RTA_OIF;
+    // only an interface filter may drop them.
+    return (filter.family == AF_UNSPEC || view.family() == filter.family) &&
+           (filter.table == RT_TABLE_UNSPEC || view.table() == filter.table) &&
+           (filter.oif == 0U || view.oif_index() == filter.oif) &&
+           (filter.protocol == RTPROT_UNSPEC || view.protocol() == filter.protocol) &&
+           (filter.type == RTN_UNSPEC || view.route_type() == filter.type);
+}
+
+void RouteDumpTask::flush_batch() {
+    if (!on_chunk_ || learned_.empty()) {
+        return;
+    }
+
+    on_chunk_(std::span<const RouteEvent>{learned_.data(), learned_.size()});
+    learned_.clear();
 }
 
 auto RouteDumpTask::process_message(const nlmsghdr& header)
@@ -42,6 +89,7 @@ auto RouteDumpTask::process_message(const nlmsghdr& header)
 }
 
 auto RouteDumpTask::handle_done() -> std::expected<RouteEventList, std::error_code> {
+    flush_batch();
     return std::move(learned_);
 }
 
@@ -52,6 +100,7 @@ auto RouteDumpTask::handle_error(const nlmsghdr& header)
     const auto error_code = std::make_error_code(static_cast<std::errc>(code));
 
     if (!error_code) {
+        flush_batch();
         return std::move(learned_);
     }
 
@@ -60,25 +109,22 @@ auto RouteDumpTask::handle_error(const nlmsghdr& header)
 
 auto RouteDumpTask::dispatch_route(const nlmsghdr& header)
         -> std::optional<std::expected<RouteEventList, std::error_code>> {
-    const auto event = RouteEvent::from_nlmsghdr(header);
-
-    if (event.type != RouteEvent::Type::NEW_ROUTE) {
-        return std::nullopt;
-    }
+    const RouteEventView view{header};
 
-    if (event.table != RT_TABLE_MAIN) {
+    if (view.type() != RouteEvent::Type::NEW_ROUTE) {
         return std::nullopt;
     }
 
-    if (event.oif_index <= 0) {
+    if (!in_scope(view, filter_)) {
         return std::nullopt;
     }
 
-    if (event.oif_index > std::numeric_limits<uint16_t>::max()) {
+    if (on_view_) {
+        on_view_(view);
         return std::nullopt;
     }
 
-    learned_.push_back(event);
+    learned_.push_back(view.materialize(learned_.get_allocator()));
     return std::nullopt;
 }
 
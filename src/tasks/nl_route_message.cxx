@@ -0,0 +1,122 @@
+#include "rtaco/tasks/nl_route_message.hxx"
+
+#include <expected>
+#include <span>
+#include <system_error>
+#include <utility>
+
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+
+namespace llmx {
+namespace rtaco {
+
+namespace {
+
+auto valid(const RouteSpec& route) noexcept -> bool {
+    const auto bits = route.family == AF_INET   ? 32U
+                      : route.family == AF_INET6 ? 128U
+                                                 : 0U;
+    if (bits == 0U || route.dst_prefix_len > bits) {
+        return false;
+    }
+
+    const auto matches = [&route](const IpAddress& address)
+    {
+        return address.empty() || address.family == route.family;
+    };
+
+    // A default route may leave `dst` empty; anything longer needs it.
+    if (route.dst_prefix_len != 0U && route.dst.empty()) {
+        return false;
+    }
+    return matches(route.dst) && matches(route.gateway) && matches(route.prefsrc);
+}
+
+} // namespace
+
+auto RouteSpec::from_event(const CompactRouteEvent& event) noexcept -> RouteSpec {
+    RouteSpec route{};
+    route.family = event.family;
+    route.dst_prefix_len = event.dst_prefix_len;
+    route.scope = event.scope;
+    route.protocol = event.protocol;
+    route.route_type = event.route_type;
+    route.table = event.table;
+    route.priority = event.priority;
+    route.oif_index = event.oif_index;
+    route.dst = event.dst;
+    route.gateway = event.gateway;
+    route.prefsrc = event.prefsrc;
+    return route;
+}
+
+auto append_route(MessageBuilder& builder, RouteOp op, const RouteSpec& route,
+        uint32_t sequence, uint16_t flags) -> std::expected<void, std::error_code> {
+    if (!valid(route)) {
+        return std::unexpected{std::make_error_code(std::errc::invalid_argument)};
+    }
+
+    uint16_t type = RTM_NEWROUTE;
+    flags |= NLM_F_REQUEST;
+    switch (op) {
+    case RouteOp::ADD:
+        flags |= NLM_F_CREATE | NLM_F_EXCL;
+        break;
+    case RouteOp::REPLACE:
+        flags |= NLM_F_CREATE | NLM_F_REPLACE;
+        break;
+    case RouteOp::DELETE:
+        type = RTM_DELROUTE;
+        break;
+    }
+
+    auto& message = builder.begin<rtmsg>(type, flags, sequence);
+    message.rtm_family = route.family;
+    message.rtm_dst_len = route.dst_prefix_len;
+    message.rtm_table = route.table < 256U ? static_cast<uint8_t>(route.table)
+                                           : static_cast<uint8_t>(RT_TABLE_UNSPEC);
+    message.rtm_protocol = route.protocol;
+    message.rtm_scope = op == RouteOp::DELETE ? static_cast<uint8_t>(RT_SCOPE_NOWHERE)
+                                              : route.scope;
+    message.rtm_type = route.route_type;
+
+    const auto address = [&builder](uint16_t attr, const IpAddress& value)
+    {
+        builder.attribute(attr, {value.bytes.data(), value.size()});
+    };
+
+    builder.attribute(RTA_TABLE, route.table);
+    if (route.dst_prefix_len != 0U) {
+        address(RTA_DST, route.dst);
+    }
+    if (!route.gateway.empty()) {
+        address(RTA_GATEWAY, route.gateway);
+    }
+    if (!route.prefsrc.empty()) {
+        address(RTA_PREFSRC, route.prefsrc);
+    }
+    if (route.oif_index != 0U) {
+        builder.attribute(RTA_OIF, route.oif_index);
+    }
+    if (route.priority != 0U) {
+        builder.attribute(RTA_PRIORITY, route.priority);
+    }
+
+    const auto metrics = builder.begin_nested(RTA_METRICS);
+    const std::pair<uint16_t, uint32_t> values[] = {{RTAX_MTU, route.metrics.mtu},
+            {RTAX_ADVMSS, route.metrics.advmss}, {RTAX_HOPLIMIT, route.metrics.hoplimit},
+            {RTAX_INITCWND, route.metrics.initcwnd}};
+    for (const auto& [metric, value] : values) {
+        if (value != 0U) {
+            builder.attribute(metric, value);
+        }
+    }
+    builder.end_nested(metrics);
+
+    builder.end();
+    return {};
+}
+
+} // namespace rtaco
+} // namespace llmx
@@ -0,0 +1,198 @@
+#include "rtaco/tasks/nl_transaction.hxx"
+
+#include <span>
+#include <system_error>
+
+#include <linux/if_addr.h>
+#include <linux/if_link.h>
+#include <linux/neighbour.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+
+namespace llmx {
+namespace rtaco {
+
+namespace {
+
+auto bytes(const IpAddress& address) noexcept -> std::span<const uint8_t> {
+    return {address.bytes.data(), address.size()};
+}
+
+auto bytes(const LinkLayerAddress& address) noexcept -> std::span<const uint8_t> {
+    return {address.bytes.data(), address.length};
+}
+
+auto bytes(const InterfaceName& name) noexcept -> std::span<const uint8_t> {
+    // IFA_LABEL and IFLA_IFNAME are NUL-terminated strings.
+    return {reinterpret_cast<const uint8_t*>(name.chars.data()), name.view().size() + 1U};
+}
+
+auto valid(const AddressSpec& address) noexcept -> bool {
+    const auto bits = address.family == AF_INET   ? 32U
+                      : address.family == AF_INET6 ? 128U
+                                                   : 0U;
+    const auto matches = [&address](const IpAddress& value)
+    {
+        return value.empty() || value.family == address.family;
+    };
+
+    return bits != 0U && address.index > 0 && address.prefix_len <= bits &&
+           address.address.family == address.family && matches(address.peer) &&
+           matches(address.broadcast);
+}
+
+auto valid(const NeighborSpec& neighbor) noexcept -> bool {
+    return neighbor.index > 0 && !neighbor.address.empty();
+}
+
+} // namespace
+
+auto TransactionBuilder::add_route(const RouteSpec& route) -> size_t {
+    return this->route(RouteOp::ADD, route);
+}
+
+auto TransactionBuilder::replace_route(const RouteSpec& route) -> size_t {
+    return this->route(RouteOp::REPLACE, route);
+}
+
+auto TransactionBuilder::delete_route(const RouteSpec& route) -> size_t {
+    return this->route(RouteOp::DELETE, route);
+}
+
+auto TransactionBuilder::add_address(const AddressSpec& address) -> size_t {
+    return this->address(RTM_NEWADDR, NLM_F_CREATE | NLM_F_EXCL, address);
+}
+
+auto TransactionBuilder::replace_address(const AddressSpec& address) -> size_t {
+    return this->address(RTM_NEWADDR, NLM_F_CREATE | NLM_F_REPLACE, address);
+}
+
+auto TransactionBuilder::delete_address(const AddressSpec& address) -> size_t {
+    return this->address(RTM_DELADDR, 0U, address);
+}
+
+auto TransactionBuilder::add_neighbor(const NeighborSpec& neighbor) -> size_t {
+    return this->neighbor(RTM_NEWNEIGH, NLM_F_CREATE | NLM_F_EXCL, neighbor);
+}
+
+auto TransactionBuilder::replace_neighbor(const NeighborSpec& neighbor) -> size_t {
+    return this->neighbor(RTM_NEWNEIGH, NLM_F_CREATE | NLM_F_REPLACE, neighbor);
+}
+
+auto TransactionBuilder::delete_neighbor(const NeighborSpec& neighbor) -> size_t {
+    return this->neighbor(RTM_DELNEIGH, 0U, neighbor);
+}
+
+auto TransactionBuilder::probe_neighbor(int index, const IpAddress& address) -> size_t {
+    NeighborSpec neighbor{};
+    neighbor.index = index;
+    neighbor.address = address;
+    neighbor.state = NUD_PROBE;
+    neighbor.flags = NTF_USE;
+    return this->neighbor(RTM_NEWNEIGH, NLM_F_CREATE | NLM_F_REPLACE, neighbor);
+}
+
+auto TransactionBuilder::set_link(const LinkSpec& link) -> size_t {
+    if (link.index <= 0) {
+        return push(false);
+    }
+
+    const auto sequence = static_cast<uint32_t>(size());
+    auto& message = messages_.begin<ifinfomsg>(RTM_NEWLINK, NLM_F_REQUEST | NLM_F_ACK,
+            sequence);
+    message.ifi_family = AF_UNSPEC;
+    message.ifi_index = link.index;
+    if (link.up) {
+        message.ifi_flags = *link.up ? static_cast<unsigned>(IFF_UP) : 0U;
+        message.ifi_change = IFF_UP;
+    }
+
+    if (link.mtu != 0U) {
+        messages_.attribute(IFLA_MTU, link.mtu);
+    }
+    if (!link.name.empty()) {
+        messages_.attribute(IFLA_IFNAME, bytes(link.name));
+    }
+    if (!link.address.empty()) {
+        messages_.attribute(IFLA_ADDRESS, bytes(link.address));
+    }
+
+    messages_.end();
+    return push(true);
+}
+
+void TransactionBuilder::clear() noexcept {
+    messages_.clear();
+    errors_.clear();
+}
+
+auto TransactionBuilder::route(RouteOp op, const RouteSpec& route) -> size_t {
+    const auto sequence = static_cast<uint32_t>(size());
+    return push(append_route(messages_, op, route, sequence).has_value());
+}
+
+auto TransactionBuilder::address(uint16_t type, uint16_t flags,
+        const AddressSpec& address) -> size_t {
+    if (!valid(address)) {
+        return push(false);
+    }
+
+    const auto sequence = static_cast<uint32_t>(size());
+    auto& message = messages_.begin<ifaddrmsg>(type, NLM_F_REQUEST | NLM_F_ACK | flags,
+            sequence);
+    message.ifa_family = address.family;
+    message.ifa_prefixlen = address.prefix_len;
+    message.ifa_flags = static_cast<uint8_t>(address.flags & 0xffU);
+    message.ifa_scope = address.scope;
+    message.ifa_index = static_cast<uint32_t>(address.index);
+
+    // IFA_ADDRESS is the prefix address; it only differs from IFA_LOCAL on a
+    // point-to-point link.
+    messages_.attribute(IFA_LOCAL, bytes(address.address));
+    messages_.attribute(IFA_ADDRESS,
+            bytes(address.peer.empty() ? address.address : address.peer));
+    if (!address.broadcast.empty()) {
+        messages_.attribute(IFA_BROADCAST, bytes(address.broadcast));
+    }
+    if (!address.label.empty()) {
+        messages_.attribute(IFA_LABEL, bytes(address.label));
+    }
+    if (address.flags != 0U) {
+        messages_.attribute(IFA_FLAGS, address.flags);
+    }
+
+    messages_.end();
+    return push(true);
+}
+
+auto TransactionBuilder::neighbor(uint16_t type, uint16_t flags,
+        const NeighborSpec& neighbor) -> size_t {
+    if (!valid(neighbor)) {
+        return push(false);
+    }
+
+    const auto sequence = static_cast<uint32_t>(size());
+    auto& message = messages_.begin<ndmsg>(type, NLM_F_REQUEST | NLM_F_ACK | flags,
+            sequence);
+    message.ndm_family = neighbor.address.family;
+    message.ndm_ifindex = neighbor.index;
+    message.ndm_state = neighbor.state;
+    message.ndm_flags = neighbor.flags;
+
+    messages_.attribute(NDA_DST, bytes(neighbor.address));
+    if (!neighbor.lladdr.empty()) {
+        messages_.attribute(NDA_LLADDR, bytes(neighbor.lladdr));
+    }
+
+    messages_.end();
+    return push(true);
+}
+
+auto TransactionBuilder::push(bool encoded) -> size_t {
+    errors_.push_back(encoded ? std::error_code{}
+                              : std::make_error_code(std::errc::invalid_argument));
+    return errors_.size() - 1U;
+}
+
+} // namespace rtaco
+} // namespace llmx
@@ -0,0 +1,152 @@
+#include "rtaco/tasks/nl_transaction_task.hxx"
+
+#include <algorithm>
+#include <cstddef>
+#include <expected>
+#include <span>
+#include <system_error>
+#include <utility>
+
+#include <boost/asio/use_awaitable.hpp>
+
+#include <linux/netlink.h>
+
+namespace llmx {
+namespace rtaco {
+
+namespace asio = boost::asio;
+
+namespace {
+
+/** Posted operations per datagram; the barrier takes the last ack slot. */
+constexpr size_t POST_BATCH = Transport::MAX_UNACKED - 1U;
+
+/** Bytes and messages of the next datagram, cut at a message boundary. */
+auto next_batch(std::span<const uint8_t> messages, size_t limit) noexcept
+        -> std::pair<size_t, size_t> {
+    size_t length = 0U;
+    size_t count = 0U;
+    while (length < messages.size() && count < limit) {
+        const auto* header = reinterpret_cast<const nlmsghdr*>(messages.data() + length);
+        length += NLMSG_ALIGN(header->nlmsg_len);
+        ++count;
+    }
+    return {std::min(length, messages.size()), count};
+}
+
+} // namespace
+
+TransactionTask::TransactionTask(Transport& transport,
+        const TransactionBuilder& transaction, uint32_t first_sequence) noexcept
+    : transport_{transport}
+    , transaction_{transaction}
+    , first_sequence_{first_sequence} {}
+
+auto TransactionTask::async_run()
+        -> asio::awaitable<std::expected<TransactionResult, std::error_code>> {
+    TransactionResult result(transaction_.size());
+    for (size_t i = 0; i < result.size(); ++i) {
+        result[i].error = transaction_.rejected(i);
+        if (!result[i].error) {
+            result[i].sequence = first_sequence_ + static_cast<uint32_t>(i);
+        }
+    }
+
+    auto messages = transaction_.messages();
+    messages.rebase(first_sequence_);
+
+    auto remaining = messages.data();
+    while (!remaining.empty()) {
+        const auto [length, count] = next_batch(remaining, Transport::MAX_UNACKED);
+
+        size_t acked = 0U;
+        auto status = co_await transport_.async_transact(remaining.first(length),
+                [this, &result, &acked, count](const nlmsghdr& header) -> bool
+        {
+            if (header.nlmsg_type != NLMSG_ERROR ||
+                    header.nlmsg_len < NLMSG_LENGTH(sizeof(nlmsgerr))) {
+                return false;
+            }
+
+            const auto* ack = reinterpret_cast<const nlmsgerr*>(NLMSG_DATA(&header));
+            result[header.nlmsg_seq - first_sequence_].error =
+                    std::make_error_code(static_cast<std::errc>(-ack->error));
+            return ++acked == count;
+        });
+
+        if (!status) {
+            co_return std::unexpected{status.error()};
+        }
+
+        remaining = remaining.subspan(length);
+    }
+
+    co_return std::move(result);
+}
+
+auto TransactionTask::async_post(WriteErrorHandler on_error)
+        -> asio::awaitable<std::expected<void, std::error_code>> {
+    for (size_t i = 0; i < transaction_.size(); ++i) {
+        if (const auto error = transaction_.rejected(i)) {
+            on_error(WriteError{i, 0U, 0U, error});
+        }
+    }
+
+    auto messages = transaction_.messages();
+    messages.rebase(first_sequence_);
+    messages.clear_flags(NLM_F_ACK);
+
+    MessageBuilder batch{};
+    auto barrier = first_sequence_ + static_cast<uint32_t>(transaction_.size());
+    auto remaining = messages.data();
+    while (!remaining.empty()) {
+        const auto [length, count] = next_batch(remaining, POST_BATCH);
+
+        batch.clear();
+        batch.append(remaining.first(length));
+        batch.begin(NLMSG_NOOP, NLM_F_REQUEST | NLM_F_ACK, barrier);
+        batch.end();
+
+        // The handler outlives this task, so it captures nothing of it.
+        auto status = co_await transport_.async_post(batch.data(),
+                [first = first_sequence_, barrier, on_error](const nlmsghdr& header)
+                        -> bool
+        {
+            if (header.nlmsg_type != NLMSG_ERROR ||
+                    header.nlmsg_len < NLMSG_LENGTH(sizeof(nlmsgerr))) {
+                return false;
+            }
+
+            if (header.nlmsg_seq == barrier) {
+                return true;
+            }
+
+            const auto* ack = reinterpret_cast<const nlmsgerr*>(NLMSG_DATA(&header));
+            if (ack->error != 0) {
+                on_error(WriteError{static_cast<size_t>(header.nlmsg_seq - first),
+                        header.nlmsg_seq, ack->msg.nlmsg_type,
+                        std::make_error_code(static_cast<std::errc>(-ack->error))});
+            }
+            return false;
+        });
+
+        if (!status) {
+            co_return std::unexpected{status.error()};
+        }
+
+        ++barrier;
+        remaining = remaining.subspan(length);
+    }
+
+    co_return std::expected<void, std::error_code>{};
+}
+
+auto TransactionTask::sequences(const TransactionBuilder& transaction) noexcept
+        -> size_t {
+    const auto batches = (transaction.messages().count() + POST_BATCH - 1U) /
+                         POST_BATCH;
+    return transaction.size() + batches;
+}
+
+} // namespace rtaco
+} // namespace llmx
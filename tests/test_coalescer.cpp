@@ -0,0 +1,51 @@
+#include <gtest/gtest.h>
+#include <string>
+
+#include "rtaco/core/nl_coalescer.hxx"
+
+using namespace llmx::rtaco;
+
+TEST(CoalescerTest, FoldsEqualKeysIntoLastEvent) {
+    Coalescer<int, std::string> coalescer{};
+    EXPECT_TRUE(coalescer.empty());
+
+    coalescer.add(1, "up");
+    coalescer.add(1, "down");
+    coalescer.add(1, "up again");
+    EXPECT_FALSE(coalescer.empty());
+
+    const auto entries = coalescer.take();
+    ASSERT_EQ(entries.size(), 1U);
+    EXPECT_EQ(entries[0].event, "up again");
+    EXPECT_EQ(entries[0].count, 3U);
+}
+
+TEST(CoalescerTest, KeepsFirstSeenOrder) {
+    Coalescer<int, int> coalescer{};
+    coalescer.add(7, 70);
+    coalescer.add(3, 30);
+    coalescer.add(7, 71);
+    coalescer.add(5, 50);
+
+    const auto entries = coalescer.take();
+    ASSERT_EQ(entries.size(), 3U);
+    EXPECT_EQ(entries[0].event, 71);
+    EXPECT_EQ(entries[0].count, 2U);
+    EXPECT_EQ(entries[1].event, 30);
+    EXPECT_EQ(entries[1].count, 1U);
+    EXPECT_EQ(entries[2].event, 50);
+}
+
+TEST(CoalescerTest, TakeStartsNewWindow) {
+    Coalescer<int, int> coalescer{};
+    coalescer.add(1, 10);
+    coalescer.add(1, 11);
+    EXPECT_EQ(coalescer.take().size(), 1U);
+    EXPECT_TRUE(coalescer.empty());
+
+    coalescer.add(1, 12);
+    const auto entries = coalescer.take();
+    ASSERT_EQ(entries.size(), 1U);
+    EXPECT_EQ(entries[0].event, 12);
+    EXPECT_EQ(entries[0].count, 1U);
+}
@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/io_context.hpp>
+
+#include <algorithm>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+
+#include "rtaco/core/nl_control.hxx"
+
+using namespace llmx::rtaco;
+
+TEST(ControlLanesTest, DumpsRunOnBulkContext) {
+    boost::asio::io_context io;
+    boost::asio::io_context bulk_io;
+    auto work = boost::asio::make_work_guard(io);
+    auto bulk_work = boost::asio::make_work_guard(bulk_io);
+    std::thread thread{[&io] { io.run(); }};
+    std::thread bulk_thread{[&bulk_io] { bulk_io.run(); }};
+
+    {
+        Control control{io, ControlOptions{.bulk = {.context = &bulk_io}}};
+
+        size_t links = 0U;
+        bool on_bulk_thread = true;
+        auto streamed = control.dump_links([&](std::span<const LinkEvent> chunk)
+        {
+            links += chunk.size();
+            on_bulk_thread = on_bulk_thread &&
+                             std::this_thread::get_id() == bulk_thread.get_id();
+        });
+
+        EXPECT_TRUE(streamed.has_value());
+        EXPECT_GT(links, 0U); // at least the loopback device
+        EXPECT_TRUE(on_bulk_thread);
+
+        control.stop();
+    }
+
+    work.reset();
+    bulk_work.reset();
+    thread.join();
+    bulk_thread.join();
+}
+
+TEST(ControlLanesTest, ShardedDumpKeepsShardOrder) {
+    boost::asio::io_context io;
+    boost::asio::io_context bulk_io;
+    auto work = boost::asio::make_work_guard(io);
+    auto bulk_work = boost::asio::make_work_guard(bulk_io);
+    std::thread thread{[&io] { io.run(); }};
+    std::vector<std::thread> bulk_threads;
+    for (int i = 0; i < 2; ++i) {
+        bulk_threads.emplace_back([&bulk_io] { bulk_io.run(); });
+    }
+
+    {
+        Control control{io, ControlOptions{.bulk = {.context = &bulk_io}}};
+
+        // IPv6 first, to tell the given order from the kernel's.
+        const std::vector<RouteDumpFilter> shards{
+                {.family = AF_INET6, .table = RT_TABLE_LOCAL},
+                {.family = AF_INET, .table = RT_TABLE_LOCAL},
+        };
+        auto v6 = control.dump_routes_compact(shards[0]);
+        auto v4 = control.dump_routes_compact(shards[1]);
+        auto sharded = control.dump_routes_compact(shards, ShardOrder::GIVEN);
+
+        EXPECT_TRUE(v6.has_value());
+        EXPECT_TRUE(v4.has_value());
+        EXPECT_TRUE(sharded.has_value());
+        if (v6 && v4 && sharded) {
+            EXPECT_FALSE(v4->empty()); // at least 127.0.0.1
+            EXPECT_EQ(sharded->size(), v6->size() + v4->size());
+            const auto is_v6 = [](const CompactRouteEvent& route)
+            {
+                return route.family == AF_INET6;
+            };
+            EXPECT_TRUE(std::is_partitioned(sharded->begin(), sharded->end(), is_v6));
+        }
+
+        auto any_order = control.dump_routes(shards, ShardOrder::COMPLETION);
+        EXPECT_TRUE(any_order.has_value());
+        if (any_order && sharded) {
+            EXPECT_EQ(any_order->size(), sharded->size());
+        }
+
+        control.stop();
+    }
+
+    work.reset();
+    bulk_work.reset();
+    thread.join();
+    for (auto& bulk_thread : bulk_threads) {
+        bulk_thread.join();
+    }
+}
+
+TEST(ControlLanesTest, ApplyRoutesRunsOnBulkLane) {
+    boost::asio::io_context io;
+    boost::asio::io_context bulk_io;
+    auto bulk_work = boost::asio::make_work_guard(bulk_io);
+    std::thread bulk_thread{[&bulk_io] { bulk_io.run(); }};
+
+    {
+        // Nothing runs `io`: only the bulk lane can answer.
+        Control control{io, ControlOptions{.bulk = {.context = &bulk_io}}};
+
+        // Deleting routes that do not exist changes nothing.
+        std::vector<RouteSpec> routes(3U);
+        for (auto& route : routes) {
+            route.table = 4242U;
+            route.dst_prefix_len = 32U;
+            route.dst = IpAddress::from_string("198.18.0.1", AF_INET);
+        }
+
+        auto applied = control.apply_routes(RouteOp::DELETE, routes);
+        ASSERT_TRUE(applied.has_value());
+        EXPECT_EQ(applied->failures.size(), routes.size());
+
+        control.stop();
+    }
+
+    bulk_work.reset();
+    bulk_thread.join();
+    io.run();
+}
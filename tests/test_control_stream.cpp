@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/io_context.hpp>
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <net/if.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "rtaco/core/nl_control.hxx"
+#include "rtaco/tasks/nl_message_builder.hxx"
+
+using namespace llmx::rtaco;
+
+namespace {
+
+// Only ever holds the routes of this test, spread over many datagrams.
+constexpr uint32_t STREAM_TABLE = 4243U;
+constexpr uint32_t ROUTES = 2048U;
+// Large enough that the kernel sizes every dump datagram to its maximum.
+constexpr size_t RECEIVE_SIZE = 64U * 1024U;
+
+auto host_route(uint32_t offset) -> RouteSpec {
+    RouteSpec route{};
+    route.dst_prefix_len = 32U;
+    route.scope = RT_SCOPE_LINK;
+    route.protocol = RTPROT_STATIC;
+    route.table = STREAM_TABLE;
+    route.oif_index = ::if_nametoindex("lo");
+    route.dst = IpAddress::from_string("198.18." + std::to_string(offset >> 8U) + "." +
+                    std::to_string(offset & 0xffU),
+            AF_INET);
+    return route;
+}
+
+/** Dump the table on a socket of its own and count the routes in each
+ * datagram that carries any. */
+auto datagram_sizes(int fd, uint32_t sequence) -> std::vector<size_t> {
+    MessageBuilder request{};
+    auto& message = request.begin<rtmsg>(RTM_GETROUTE, NLM_F_REQUEST | NLM_F_DUMP,
+            sequence);
+    message.rtm_table = RT_TABLE_UNSPEC;
+    request.attribute(RTA_TABLE, STREAM_TABLE);
+    request.end();
+
+    const auto data = request.data();
+    if (::send(fd, data.data(), data.size(), 0) < 0) {
+        return {};
+    }
+
+    std::vector<size_t> sizes{};
+    std::vector<uint8_t> buffer(RECEIVE_SIZE);
+    for (;;) {
+        const auto received = ::recv(fd, buffer.data(), buffer.size(), 0);
+        if (received <= 0) {
+            return {};
+        }
+
+        size_t routes = 0U;
+        auto remaining = static_cast<unsigned int>(received);
+        const auto* header = reinterpret_cast<const nlmsghdr*>(buffer.data());
+        for (; NLMSG_OK(header, remaining); header = NLMSG_NEXT(header, remaining)) {
+            if (header->nlmsg_type == NLMSG_DONE || header->nlmsg_type == NLMSG_ERROR) {
+                if (routes != 0U) {
+                    sizes.push_back(routes);
+                }
+                return sizes;
+            }
+            routes += header->nlmsg_type == RTM_NEWROUTE ? 1U : 0U;
+        }
+
+        if (routes != 0U) {
+            sizes.push_back(routes);
+        }
+    }
+}
+
+/** Fills a table of its own and removes it again. */
+class ControlStreamTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        for (uint32_t i = 0; i < ROUTES; ++i) {
+            routes.push_back(host_route(i));
+        }
+
+        auto added = control.apply_routes(RouteOp::ADD, routes);
+        installed = added.has_value();
+        if (!added || !added->ok()) {
+            GTEST_SKIP() << "needs CAP_NET_ADMIN";
+        }
+    }
+
+    void TearDown() override {
+        if (installed) {
+            (void)control.apply_routes(RouteOp::DELETE, routes);
+        }
+        control.stop();
+        work.reset();
+        thread.join();
+    }
+
+    boost::asio::io_context io{};
+    boost::asio::executor_work_guard<boost::asio::io_context::executor_type> work{
+            boost::asio::make_work_guard(io)};
+    std::thread thread{[this] { io.run(); }};
+    Control control{io};
+
+    std::vector<RouteSpec> routes{};
+    bool installed{false};
+};
+
+} // namespace
+
+TEST_F(ControlStreamTest, RouteChunksFollowReceivedDatagrams) {
+    const RouteDumpFilter filter{.table = STREAM_TABLE};
+
+    // Also leaves the bulk socket sized for full datagrams; the streaming
+    // dump below reuses it.
+    const auto dumped = control.dump_routes(filter);
+    ASSERT_TRUE(dumped.has_value());
+    ASSERT_EQ(dumped->size(), ROUTES);
+
+    std::vector<std::string> streamed{};
+    std::vector<size_t> chunks{};
+    auto rc = control.dump_routes(filter, [&](std::span<const RouteEvent> chunk)
+    {
+        chunks.push_back(chunk.size());
+        for (const auto& event : chunk) {
+            streamed.emplace_back(event.dst);
+        }
+    });
+    ASSERT_TRUE(rc.has_value());
+
+    ASSERT_EQ(streamed.size(), dumped->size());
+    for (size_t i = 0; i < streamed.size(); ++i) {
+        EXPECT_EQ(streamed[i], std::string_view{(*dumped)[i].dst}) << "route " << i;
+    }
+
+    // A plain socket sized the same way receives the dump in the same
+    // datagrams, once its first receive has set the size.
+    const int fd = ::socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_ROUTE);
+    ASSERT_GE(fd, 0);
+    const int on = 1;
+    ::setsockopt(fd, SOL_NETLINK, NETLINK_GET_STRICT_CHK, &on, sizeof(on));
+    (void)datagram_sizes(fd, 1U);
+    const auto datagrams = datagram_sizes(fd, 2U);
+    ::close(fd);
+
+    EXPECT_GT(chunks.size(), 1U);
+    EXPECT_EQ(chunks, datagrams);
+}
@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+#include <vector>
+
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+
+#include "rtaco/core/nl_dispatch_table.hxx"
+
+using namespace llmx::rtaco;
+
+namespace {
+
+struct Recorder {
+    std::vector<uint16_t> routes{};
+    std::vector<uint16_t> raw{};
+
+    void on_route(const nlmsghdr& header) {
+        routes.push_back(header.nlmsg_type);
+    }
+
+    void on_raw(const nlmsghdr& header) {
+        raw.push_back(header.nlmsg_type);
+    }
+};
+
+constexpr auto table = DispatchTable<Recorder>::make<
+        MessageRoute<RTM_NEWROUTE, rtmsg, &Recorder::on_route>,
+        MessageRoute<RTM_DELROUTE, rtmsg, &Recorder::on_route>,
+        MessageRoute<RTM_NEWNEXTHOP, void, &Recorder::on_raw>>();
+
+static_assert(table.contains(RTM_NEWROUTE));
+static_assert(table.contains(RTM_NEWNEXTHOP));
+static_assert(!table.contains(RTM_NEWLINK));
+static_assert(!table.contains(0xFFFFU));
+
+auto header_of(uint16_t type, uint32_t payload) -> nlmsghdr {
+    nlmsghdr header{};
+    header.nlmsg_type = type;
+    header.nlmsg_len = static_cast<uint32_t>(NLMSG_LENGTH(payload));
+    return header;
+}
+
+} // namespace
+
+TEST(DispatchTableTest, RoutesByTypeAndChecksLength) {
+    Recorder recorder{};
+
+    // Dispatch reads only the header, so a bare header whose length claims a
+    // payload stands in for a full message.
+    EXPECT_TRUE(table.dispatch(recorder, header_of(RTM_DELROUTE, sizeof(rtmsg))));
+    EXPECT_TRUE(table.dispatch(recorder, header_of(RTM_NEWROUTE, sizeof(rtmsg) - 1U)));
+    EXPECT_TRUE(table.dispatch(recorder, header_of(RTM_NEWNEXTHOP, 0U)));
+
+    EXPECT_EQ(recorder.routes, std::vector<uint16_t>{RTM_DELROUTE});
+    EXPECT_EQ(recorder.raw, std::vector<uint16_t>{RTM_NEWNEXTHOP});
+}
+
+TEST(DispatchTableTest, UnroutedTypesAreLeftToCaller) {
+    Recorder recorder{};
+
+    EXPECT_FALSE(table.dispatch(recorder, header_of(RTM_NEWLINK, sizeof(ifinfomsg))));
+    EXPECT_FALSE(table.dispatch(recorder, header_of(0xFFFFU, 0U)));
+    EXPECT_TRUE(recorder.routes.empty());
+    EXPECT_TRUE(recorder.raw.empty());
+}
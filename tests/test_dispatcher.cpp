@@ -0,0 +1,172 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include <boost/asio/io_context.hpp>
+
+#include "rtaco/core/nl_dispatcher.hxx"
+
+using namespace llmx::rtaco;
+
+namespace {
+
+struct Counted {
+    static inline int copies = 0;
+
+    int value{0};
+
+    explicit Counted(int v)
+        : value{v} {}
+    Counted(const Counted& other)
+        : value{other.value} {
+        ++copies;
+    }
+    Counted& operator=(const Counted&) = delete;
+};
+
+} // namespace
+
+TEST(DispatcherTest, SyncSlotsRunInlineUntilDisconnected) {
+    boost::asio::io_context io;
+    Dispatcher<void(int)> dispatcher{io.get_executor()};
+    EXPECT_TRUE(dispatcher.empty());
+
+    std::vector<int> seen{};
+    auto first = dispatcher.connect([&seen](int value) { seen.push_back(value); });
+    auto second = dispatcher.connect([&seen](int value) { seen.push_back(-value); });
+    EXPECT_FALSE(dispatcher.empty());
+
+    dispatcher(1);
+    first.disconnect();
+    EXPECT_FALSE(first.connected());
+    EXPECT_TRUE(second.connected());
+    dispatcher(2);
+    second.disconnect();
+    dispatcher(3);
+
+    EXPECT_TRUE(dispatcher.empty());
+    EXPECT_EQ(seen, (std::vector<int>{1, -1, -2}));
+}
+
+TEST(DispatcherTest, AsyncSlotsShareOneCopy) {
+    boost::asio::io_context io;
+    Dispatcher<void(const Counted&)> dispatcher{io.get_executor()};
+
+    int sum = 0;
+    dispatcher.connect([&sum](const Counted& event) { sum += event.value; },
+            ExecPolicy::Async);
+    dispatcher.connect([&sum](const Counted& event) { sum += event.value; },
+            ExecPolicy::Async);
+    dispatcher.connect([&sum](const Counted& event) { sum += event.value; });
+
+    Counted::copies = 0;
+    dispatcher.emit(Counted{5});
+    EXPECT_EQ(sum, 5);
+    EXPECT_EQ(Counted::copies, 1);
+
+    io.run();
+    EXPECT_EQ(sum, 15);
+}
+
+TEST(DispatcherTest, DisconnectSkipsPendingAsyncCalls) {
+    boost::asio::io_context io;
+    Dispatcher<void(int)> dispatcher{io.get_executor()};
+
+    int calls = 0;
+    auto connection = dispatcher.connect([&calls](int) { ++calls; }, ExecPolicy::Async);
+    dispatcher(1);
+    connection.disconnect();
+
+    io.run();
+    EXPECT_EQ(calls, 0);
+}
+
+TEST(DispatcherTest, SlotReleasedAfterDisconnect) {
+    boost::asio::io_context io;
+    Dispatcher<void(int)> dispatcher{io.get_executor()};
+
+    auto token = std::make_shared<int>(0);
+    std::weak_ptr<int> watch = token;
+
+    // Larger than the inline buffer, so the delegate stores it on the heap.
+    std::array<char, 256> padding{};
+    Connection connection{};
+    connection = dispatcher.connect(
+            [token = std::move(token), padding, &connection](int value) {
+        *token += value + padding[0];
+        connection.disconnect();
+    });
+
+    dispatcher(4);
+    EXPECT_FALSE(connection.connected());
+    EXPECT_TRUE(watch.expired());
+}
+
+TEST(DispatcherTest, BatchedSlotsRunInline) {
+    boost::asio::io_context io;
+    Dispatcher<void(std::span<const int>)> dispatcher{io.get_executor()};
+
+    int sum = 0;
+    const auto add_all = [&sum](std::span<const int> batch)
+    {
+        for (const auto value : batch) {
+            sum += value;
+        }
+    };
+    dispatcher.connect(add_all, ExecPolicy::Batched);
+
+    const std::array<int, 3> batch{1, 2, 3};
+    dispatcher(batch);
+    EXPECT_EQ(sum, 6);
+}
+
+TEST(DispatcherTest, EmitterOutlivesDispatcher) {
+    boost::asio::io_context io;
+    auto dispatcher = std::make_unique<Dispatcher<void(int)>>(io.get_executor());
+
+    int sum = 0;
+    dispatcher->connect([&sum](int value) { sum += value; }, ExecPolicy::Sharded);
+    dispatcher->connect([&sum](int value) { sum += 10 * value; }, ExecPolicy::Async);
+
+    const auto emit = dispatcher->emitter();
+    dispatcher.reset();
+
+    emit(1);
+    io.run();
+    EXPECT_EQ(sum, 11);
+
+    Dispatcher<void(int)>::Emitter unbound{};
+    unbound(2);
+    EXPECT_EQ(sum, 11);
+}
+
+TEST(DispatcherTest, ScopedConnectionDisconnectsOnDestruction) {
+    boost::asio::io_context io;
+    Dispatcher<void(int)> dispatcher{io.get_executor()};
+
+    int sum = 0;
+    auto slot = [&sum](int value) { sum += value; };
+
+    {
+        ScopedConnection scoped = dispatcher.connect(slot);
+        dispatcher.emit(1);
+
+        ScopedConnection moved{std::move(scoped)};
+        EXPECT_FALSE(scoped.connected());
+        EXPECT_TRUE(moved.connected());
+        dispatcher.emit(2);
+    }
+    dispatcher.emit(4);
+    EXPECT_EQ(sum, 3);
+
+    Connection kept;
+    {
+        ScopedConnection scoped = dispatcher.connect(slot);
+        kept = scoped.release();
+    }
+    EXPECT_TRUE(kept.connected());
+    dispatcher.emit(8);
+    EXPECT_EQ(sum, 11);
+}
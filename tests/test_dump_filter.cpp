@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include <vector>
+
+#include <linux/rtnetlink.h>
+
+#include "rtaco/tasks/nl_address_dump_task.hxx"
+#include "rtaco/tasks/nl_route_dump_task.hxx"
+#include "rtaco/tasks/nl_route_task.hxx"
+
+using namespace llmx::rtaco;
+
+namespace {
+
+auto make_route(uint32_t table, uint8_t protocol, uint32_t oif) -> std::vector<uint8_t> {
+    std::vector<uint8_t> buf(NLMSG_SPACE(sizeof(rtmsg)), 0);
+    auto* header = reinterpret_cast<nlmsghdr*>(buf.data());
+    header->nlmsg_len = static_cast<uint32_t>(NLMSG_LENGTH(sizeof(rtmsg)));
+    header->nlmsg_type = RTM_NEWROUTE;
+
+    auto* info = reinterpret_cast<rtmsg*>(NLMSG_DATA(header));
+    info->rtm_family = AF_INET;
+    info->rtm_table = table < 256U ? static_cast<uint8_t>(table)
+                                   : static_cast<uint8_t>(RT_TABLE_COMPAT);
+    info->rtm_protocol = protocol;
+    info->rtm_type = RTN_UNICAST;
+
+    for (const auto& [type, value] :
+            {std::pair{RTA_TABLE, table}, std::pair{RTA_OIF, oif}}) {
+        if (type == RTA_OIF && value == 0U) {
+            continue;
+        }
+        const auto offset = NLMSG_ALIGN(header->nlmsg_len);
+        buf.resize(offset + RTA_SPACE(sizeof(value)), 0);
+        header = reinterpret_cast<nlmsghdr*>(buf.data());
+
+        auto* attr = reinterpret_cast<rtattr*>(buf.data() + offset);
+        attr->rta_len = static_cast<unsigned short>(RTA_LENGTH(sizeof(value)));
+        attr->rta_type = type;
+        std::memcpy(RTA_DATA(attr), &value, sizeof(value));
+        header->nlmsg_len = static_cast<uint32_t>(offset + RTA_LENGTH(sizeof(value)));
+    }
+
+    return buf;
+}
+
+auto view_of(const std::vector<uint8_t>& buf) -> RouteEventView {
+    return RouteEventView{*reinterpret_cast<const nlmsghdr*>(buf.data())};
+}
+
+} // namespace
+
+TEST(DumpFilterTest, AppendAttributeExtendsRequestUntilFull) {
+    RouteRequest request{};
+    request.header.nlmsg_len = NLMSG_LENGTH(sizeof(rtmsg));
+
+    ASSERT_TRUE(append_attribute(request, RTA_TABLE, 1000U));
+    ASSERT_TRUE(append_attribute(request, RTA_OIF, 7U));
+    EXPECT_EQ(request.header.nlmsg_len, sizeof(RouteRequest));
+    EXPECT_FALSE(append_attribute(request, RTA_PRIORITY, 1U));
+
+    const auto* attr = reinterpret_cast<const rtattr*>(request.attributes.data());
+    EXPECT_EQ(attr->rta_type, RTA_TABLE);
+    EXPECT_EQ(*reinterpret_cast<const uint32_t*>(RTA_DATA(attr)), 1000U);
+}
+
+TEST(DumpFilterTest, RouteScopeFollowsFilter) {
+    const auto route = make_route(1000U, RTPROT_STATIC, 3U);
+
+    EXPECT_FALSE(RouteDumpTask::in_scope(view_of(route)));
+    EXPECT_TRUE(RouteDumpTask::in_scope(view_of(route), RouteDumpFilter{.table = 1000U}));
+    EXPECT_TRUE(RouteDumpTask::in_scope(view_of(route),
+            RouteDumpFilter{.table = RT_TABLE_UNSPEC, .oif = 3U}));
+    EXPECT_FALSE(RouteDumpTask::in_scope(view_of(route),
+            RouteDumpFilter{.table = 1000U, .oif = 4U}));
+    EXPECT_FALSE(RouteDumpTask::in_scope(view_of(route),
+            RouteDumpFilter{.table = 1000U, .protocol = RTPROT_BOOT}));
+    EXPECT_FALSE(RouteDumpTask::in_scope(view_of(route),
+            RouteDumpFilter{.family = AF_INET6, .table = RT_TABLE_UNSPEC}));
+
+    const auto main_route = make_route(RT_TABLE_MAIN, RTPROT_KERNEL, 3U);
+    EXPECT_TRUE(RouteDumpTask::in_scope(view_of(main_route)));
+}
+
+TEST(DumpFilterTest, RoutesWithoutOifStayInScope) {
+    auto blackhole = make_route(RT_TABLE_MAIN, RTPROT_STATIC, 0U);
+    reinterpret_cast<rtmsg*>(NLMSG_DATA(blackhole.data()))->rtm_type = RTN_BLACKHOLE;
+
+    EXPECT_TRUE(RouteDumpTask::in_scope(view_of(blackhole)));
+    EXPECT_TRUE(RouteDumpTask::in_scope(view_of(blackhole),
+            RouteDumpFilter{.type = RTN_BLACKHOLE}));
+    EXPECT_FALSE(RouteDumpTask::in_scope(view_of(blackhole), RouteDumpFilter{.oif = 3U}));
+}
+
+TEST(DumpFilterTest, AddressScopeFollowsFilter) {
+    std::vector<uint8_t> buf(NLMSG_SPACE(sizeof(ifaddrmsg)), 0);
+    auto* header = reinterpret_cast<nlmsghdr*>(buf.data());
+    header->nlmsg_len = static_cast<uint32_t>(NLMSG_LENGTH(sizeof(ifaddrmsg)));
+    header->nlmsg_type = RTM_NEWADDR;
+    auto* info = reinterpret_cast<ifaddrmsg*>(NLMSG_DATA(header));
+    info->ifa_family = AF_INET6;
+    info->ifa_index = 5;
+
+    const AddressEventView view{*header};
+    EXPECT_TRUE(AddressDumpTask::in_scope(view));
+    EXPECT_TRUE(AddressDumpTask::in_scope(view, AddressDumpFilter{.index = 5U}));
+    EXPECT_FALSE(AddressDumpTask::in_scope(view, AddressDumpFilter{.index = 6U}));
+    EXPECT_FALSE(AddressDumpTask::in_scope(view, AddressDumpFilter{.family = AF_INET}));
+}
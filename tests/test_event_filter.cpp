@@ -0,0 +1,190 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <linux/neighbour.h>
+#include <linux/rtnetlink.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "rtaco/core/nl_event_filter.hxx"
+
+using namespace llmx::rtaco;
+
+namespace {
+
+template<typename MsgT>
+auto make_message(uint16_t type, const MsgT& payload) -> std::vector<uint8_t> {
+    std::vector<uint8_t> buf(NLMSG_SPACE(sizeof(MsgT)), 0);
+    auto* header = reinterpret_cast<nlmsghdr*>(buf.data());
+    header->nlmsg_len = static_cast<uint32_t>(NLMSG_LENGTH(sizeof(MsgT)));
+    header->nlmsg_type = type;
+    std::memcpy(NLMSG_DATA(header), &payload, sizeof(MsgT));
+    return buf;
+}
+
+void add_attr(std::vector<uint8_t>& buf, uint16_t type, const void* data, size_t len) {
+    const auto offset = NLMSG_ALIGN(reinterpret_cast<nlmsghdr*>(buf.data())->nlmsg_len);
+    buf.resize(offset + RTA_SPACE(len), 0);
+
+    auto* attr = reinterpret_cast<rtattr*>(buf.data() + offset);
+    attr->rta_len = static_cast<unsigned short>(RTA_LENGTH(len));
+    attr->rta_type = type;
+    std::memcpy(RTA_DATA(attr), data, len);
+
+    reinterpret_cast<nlmsghdr*>(buf.data())->nlmsg_len =
+            static_cast<uint32_t>(offset + RTA_LENGTH(len));
+}
+
+auto header_of(const std::vector<uint8_t>& buf) -> const nlmsghdr& {
+    return *reinterpret_cast<const nlmsghdr*>(buf.data());
+}
+
+auto make_route(uint32_t table, uint8_t protocol, uint32_t oif) -> std::vector<uint8_t> {
+    rtmsg info{};
+    info.rtm_family = AF_INET;
+    info.rtm_dst_len = 24;
+    info.rtm_table = table < 256U ? static_cast<uint8_t>(table)
+                                  : static_cast<uint8_t>(RT_TABLE_COMPAT);
+    info.rtm_protocol = protocol;
+    auto buf = make_message(RTM_NEWROUTE, info);
+
+    // Same attribute order as the kernel's IPv4 notifications.
+    const uint32_t priority = 100;
+    in_addr dst{};
+    in_addr gateway{};
+    ::inet_pton(AF_INET, "198.51.100.0", &dst);
+    ::inet_pton(AF_INET, "192.0.2.1", &gateway);
+    add_attr(buf, RTA_TABLE, &table, sizeof(table));
+    add_attr(buf, RTA_DST, &dst, sizeof(dst));
+    add_attr(buf, RTA_PRIORITY, &priority, sizeof(priority));
+    add_attr(buf, RTA_GATEWAY, &gateway, sizeof(gateway));
+    add_attr(buf, RTA_OIF, &oif, sizeof(oif));
+    return buf;
+}
+
+/** Runs compiled programs on datagrams sent through an AF_UNIX pair. */
+class EventFilterTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ASSERT_EQ(::socketpair(AF_UNIX, SOCK_DGRAM, 0, fds_.data()), 0);
+    }
+
+    void TearDown() override {
+        ::close(fds_[0]);
+        ::close(fds_[1]);
+    }
+
+    void attach(const EventFilter& filter) {
+        auto program = compile_filter(filter);
+        ASSERT_TRUE(program.has_value());
+
+        const sock_fprog fprog{static_cast<unsigned short>(program->size()),
+                program->data()};
+        ASSERT_EQ(::setsockopt(fds_[1], SOL_SOCKET, SO_ATTACH_FILTER, &fprog,
+                          sizeof(fprog)),
+                0);
+    }
+
+    auto delivered(const std::vector<uint8_t>& message) -> bool {
+        EXPECT_EQ(::send(fds_[0], message.data(), message.size(), 0),
+                static_cast<ssize_t>(message.size()));
+
+        std::array<uint8_t, 512> buf{};
+        const auto rc = ::recv(fds_[1], buf.data(), buf.size(), MSG_DONTWAIT);
+        return rc == static_cast<ssize_t>(message.size());
+    }
+
+private:
+    std::array<int, 2> fds_{-1, -1};
+};
+
+} // namespace
+
+TEST_F(EventFilterTest, LinkIndexesDropOtherLinksOnly) {
+    EventFilter filter{};
+    filter.link = LinkFilter{.indexes = {3, 7}};
+    attach(filter);
+
+    ifinfomsg link{};
+    link.ifi_index = 7;
+    const auto kept = make_message(RTM_NEWLINK, link);
+    link.ifi_index = 4;
+    const auto dropped = make_message(RTM_DELLINK, link);
+
+    EXPECT_TRUE(delivered(kept));
+    EXPECT_TRUE(filter.link->matches(LinkEventView{header_of(kept)}));
+    EXPECT_FALSE(delivered(dropped));
+    EXPECT_FALSE(filter.link->matches(LinkEventView{header_of(dropped)}));
+
+    // Kinds without a predicate pass untouched.
+    EXPECT_TRUE(delivered(make_route(RT_TABLE_MAIN, RTPROT_STATIC, 4)));
+}
+
+TEST_F(EventFilterTest, RouteTableProtocolAndOutputInterface) {
+    EventFilter filter{};
+    filter.route = RouteFilter{.oif_indexes = {2, 9}, .family = AF_INET,
+            .table = RT_TABLE_MAIN, .protocol = RTPROT_STATIC};
+    attach(filter);
+
+    const auto kept = make_route(RT_TABLE_MAIN, RTPROT_STATIC, 9);
+    EXPECT_TRUE(delivered(kept));
+    EXPECT_TRUE(filter.route->matches(RouteEventView{header_of(kept)}));
+
+    for (const auto& dropped : {make_route(RT_TABLE_MAIN, RTPROT_STATIC, 5),
+                 make_route(RT_TABLE_LOCAL, RTPROT_STATIC, 9),
+                 make_route(RT_TABLE_MAIN, RTPROT_KERNEL, 9)}) {
+        EXPECT_FALSE(delivered(dropped));
+        EXPECT_FALSE(filter.route->matches(RouteEventView{header_of(dropped)}));
+    }
+}
+
+TEST_F(EventFilterTest, RouteTablesAboveByteRangeUseAttribute) {
+    EventFilter filter{};
+    filter.route = RouteFilter{.table = 1000U};
+    attach(filter);
+
+    EXPECT_TRUE(delivered(make_route(1000U, RTPROT_STATIC, 1)));
+    EXPECT_FALSE(delivered(make_route(1001U, RTPROT_STATIC, 1)));
+    EXPECT_FALSE(delivered(make_route(RT_TABLE_MAIN, RTPROT_STATIC, 1)));
+}
+
+TEST_F(EventFilterTest, NeighborStateMask) {
+    EventFilter filter{};
+    filter.neighbor = NeighborFilter{.indexes = {5},
+            .states = NUD_STALE | NUD_FAILED};
+    attach(filter);
+
+    ndmsg neighbor{};
+    neighbor.ndm_family = AF_INET;
+    neighbor.ndm_ifindex = 5;
+    neighbor.ndm_state = NUD_FAILED;
+    const auto failed = make_message(RTM_NEWNEIGH, neighbor);
+    neighbor.ndm_state = NUD_REACHABLE;
+    const auto reachable = make_message(RTM_NEWNEIGH, neighbor);
+    neighbor.ndm_state = NUD_STALE;
+    neighbor.ndm_ifindex = 6;
+    const auto elsewhere = make_message(RTM_NEWNEIGH, neighbor);
+
+    EXPECT_TRUE(delivered(failed));
+    EXPECT_TRUE(filter.neighbor->matches(NeighborEventView{header_of(failed)}));
+    EXPECT_FALSE(delivered(reachable));
+    EXPECT_FALSE(filter.neighbor->matches(NeighborEventView{header_of(reachable)}));
+    EXPECT_FALSE(delivered(elsewhere));
+}
+
+TEST(EventFilterCompileTest, RejectsOversizedPrograms) {
+    EventFilter filter{};
+    filter.link = LinkFilter{};
+    for (int index = 1; index <= 3000; ++index) {
+        filter.link->indexes.push_back(index);
+    }
+
+    const auto program = compile_filter(filter);
+    ASSERT_FALSE(program.has_value());
+    EXPECT_EQ(program.error(), std::make_error_code(std::errc::value_too_large));
+}
@@ -0,0 +1,206 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <memory_resource>
+#include <vector>
+
+#include <arpa/inet.h>
+
+#include "rtaco/core/nl_address.hxx"
+#include "rtaco/events/nl_event_key.hxx"
+#include "rtaco/events/nl_link_event.hxx"
+#include "rtaco/events/nl_neighbor_event.hxx"
+#include "rtaco/events/nl_route_event.hxx"
+
+using namespace llmx::rtaco;
+
+namespace {
+
+template<typename MsgT>
+auto make_message(uint16_t type, const MsgT& payload) -> std::vector<uint8_t> {
+    std::vector<uint8_t> buf(NLMSG_SPACE(sizeof(MsgT)), 0);
+    auto* header = reinterpret_cast<nlmsghdr*>(buf.data());
+    header->nlmsg_len = static_cast<uint32_t>(NLMSG_LENGTH(sizeof(MsgT)));
+    header->nlmsg_type = type;
+    std::memcpy(NLMSG_DATA(header), &payload, sizeof(MsgT));
+    return buf;
+}
+
+void add_attr(std::vector<uint8_t>& buf, uint16_t type, const void* data, size_t len) {
+    const auto offset = NLMSG_ALIGN(reinterpret_cast<nlmsghdr*>(buf.data())->nlmsg_len);
+    buf.resize(offset + RTA_SPACE(len), 0);
+
+    auto* attr = reinterpret_cast<rtattr*>(buf.data() + offset);
+    attr->rta_len = static_cast<unsigned short>(RTA_LENGTH(len));
+    attr->rta_type = type;
+    std::memcpy(RTA_DATA(attr), data, len);
+
+    reinterpret_cast<nlmsghdr*>(buf.data())->nlmsg_len =
+            static_cast<uint32_t>(offset + RTA_LENGTH(len));
+}
+
+} // namespace
+
+TEST(EventViewTest, RouteViewDecodesOnDemand) {
+    rtmsg info{};
+    info.rtm_family = AF_INET;
+    info.rtm_dst_len = 24;
+    info.rtm_table = RT_TABLE_MAIN;
+    info.rtm_protocol = RTPROT_STATIC;
+    auto buf = make_message(RTM_NEWROUTE, info);
+
+    const uint32_t table = 1000;
+    const uint32_t oif = 7;
+    in_addr dst{};
+    ::inet_pton(AF_INET, "198.51.100.0", &dst);
+    add_attr(buf, RTA_TABLE, &table, sizeof(table));
+    add_attr(buf, RTA_DST, &dst, sizeof(dst));
+    add_attr(buf, RTA_OIF, &oif, sizeof(oif));
+
+    const auto& header = *reinterpret_cast<const nlmsghdr*>(buf.data());
+    const RouteEventView view{header};
+
+    EXPECT_EQ(view.type(), RouteEvent::Type::NEW_ROUTE);
+    EXPECT_EQ(view.dst_prefix_len(), 24);
+    EXPECT_EQ(view.table(), table);
+    EXPECT_EQ(view.oif_index(), oif);
+    EXPECT_EQ(view.dst(), "198.51.100.0");
+    EXPECT_TRUE(view.gateway().empty());
+    EXPECT_EQ(view.attribute(RTA_DST).size(), sizeof(dst));
+    EXPECT_TRUE(view.attribute(RTA_GATEWAY).empty());
+
+    const auto event = view.materialize();
+    EXPECT_EQ(event.table, table);
+    EXPECT_EQ(event.dst, "198.51.100.0");
+    EXPECT_EQ(event.oif, "7");
+    EXPECT_EQ(event.protocol, RTPROT_STATIC);
+}
+
+TEST(EventViewTest, LinkViewNameIsBorrowed) {
+    ifinfomsg info{};
+    info.ifi_index = 3;
+    auto buf = make_message(RTM_NEWLINK, info);
+    add_attr(buf, IFLA_IFNAME, "eth0", 5);
+
+    const auto& header = *reinterpret_cast<const nlmsghdr*>(buf.data());
+    const LinkEventView view{header};
+
+    EXPECT_EQ(view.index(), 3);
+    EXPECT_EQ(view.name(), "eth0");
+    EXPECT_GE(view.name().data(), reinterpret_cast<const char*>(buf.data()));
+    EXPECT_EQ(LinkEvent::from_nlmsghdr(header).name, "eth0");
+}
+
+TEST(EventViewTest, ForeignMessageIsUnknown) {
+    auto buf = make_message(RTM_NEWLINK, ifinfomsg{});
+    const auto& header = *reinterpret_cast<const nlmsghdr*>(buf.data());
+
+    EXPECT_EQ(RouteEventView{header}.type(), RouteEvent::Type::UNKNOWN);
+}
+
+TEST(EventViewTest, AddressesParseTheirPrintableForm) {
+    const auto v4 = IpAddress::from_string("192.0.2.7", AF_INET);
+    EXPECT_EQ(v4.family, AF_INET);
+    EXPECT_EQ(v4.to_string(), "192.0.2.7");
+
+    const auto v6 = IpAddress::from_string("2001:db8::1", AF_INET6);
+    EXPECT_EQ(v6.to_string(), "2001:db8::1");
+
+    EXPECT_TRUE(IpAddress::from_string("2001:db8::1", AF_INET).empty());
+    EXPECT_TRUE(IpAddress::from_string("", AF_INET).empty());
+
+    const auto mac = LinkLayerAddress::from_string("02:00:5E:10:00:01");
+    EXPECT_EQ(mac.length, 6U);
+    EXPECT_EQ(mac.to_string(), "02:00:5e:10:00:01");
+    EXPECT_TRUE(LinkLayerAddress::from_string("02:0").empty());
+    EXPECT_TRUE(LinkLayerAddress::from_string("02-00").empty());
+}
+
+TEST(EventViewTest, CompactEventRoundTrip) {
+    CompactNeighborEvent neighbor{};
+    neighbor.type = NeighborEvent::Type::NEW_NEIGHBOR;
+    neighbor.index = 3;
+    neighbor.family = AF_INET;
+    neighbor.address = IpAddress::from_string("198.51.100.1", AF_INET);
+    neighbor.state = NeighborEvent::State::REACHABLE;
+    neighbor.lladdr = LinkLayerAddress::from_string("02:00:00:00:00:01");
+
+    EXPECT_EQ(CompactNeighborEvent::from_event(neighbor.to_event()), neighbor);
+
+    CompactLinkEvent link{};
+    link.type = LinkEvent::Type::NEW_LINK;
+    link.index = 2;
+    link.name = InterfaceName::from_string("eth0");
+    EXPECT_EQ(CompactLinkEvent::from_event(link.to_event()), link);
+}
+
+TEST(EventViewTest, CompactRouteRoundTrip) {
+    rtmsg info{};
+    info.rtm_family = AF_INET6;
+    info.rtm_dst_len = 64;
+    info.rtm_table = RT_TABLE_MAIN;
+    auto buf = make_message(RTM_NEWROUTE, info);
+
+    in6_addr gateway{};
+    ::inet_pton(AF_INET6, "2001:db8::1", &gateway);
+    add_attr(buf, RTA_GATEWAY, &gateway, sizeof(gateway));
+
+    const auto& header = *reinterpret_cast<const nlmsghdr*>(buf.data());
+    const auto compact = CompactRouteEvent::from_nlmsghdr(header);
+
+    EXPECT_EQ(compact.gateway.family, AF_INET6);
+    EXPECT_TRUE(compact.dst.empty());
+    EXPECT_EQ(compact.to_event().gateway, RouteEvent::from_nlmsghdr(header).gateway);
+
+    auto copy = compact;
+    EXPECT_EQ(copy, compact);
+    const std::hash<CompactRouteEvent> hash{};
+    EXPECT_EQ(hash(copy), hash(compact));
+
+    copy.priority = 10;
+    EXPECT_LT(compact, copy);
+}
+
+TEST(EventViewTest, RouteKeyIgnoresNextHop) {
+    CompactRouteEvent route{};
+    route.family = AF_INET;
+    route.dst_prefix_len = 24;
+    route.table = RT_TABLE_MAIN;
+    route.dst = IpAddress::from_bytes(std::array<uint8_t, 4>{10, 0, 0, 0}, AF_INET);
+    route.oif_index = 2;
+
+    auto moved = route;
+    moved.oif_index = 3;
+    moved.gateway = IpAddress::from_bytes(std::array<uint8_t, 4>{10, 0, 0, 1}, AF_INET);
+    EXPECT_EQ(RouteKey::from(route), RouteKey::from(moved));
+    EXPECT_EQ(std::hash<RouteKey>{}(RouteKey::from(route)),
+            std::hash<RouteKey>{}(RouteKey::from(moved)));
+
+    auto other_metric = route;
+    other_metric.priority = 100;
+    EXPECT_NE(RouteKey::from(route), RouteKey::from(other_metric));
+}
+
+TEST(EventViewTest, MaterializeUsesCallerResource) {
+    rtmsg info{};
+    info.rtm_family = AF_INET6;
+    auto buf = make_message(RTM_NEWROUTE, info);
+
+    in6_addr gateway{};
+    ::inet_pton(AF_INET6, "2001:db8:ffff:ffff:ffff:ffff:ffff:1", &gateway);
+    add_attr(buf, RTA_GATEWAY, &gateway, sizeof(gateway));
+
+    std::array<std::byte, 4096> arena{};
+    std::pmr::monotonic_buffer_resource resource{arena.data(), arena.size(),
+            std::pmr::null_memory_resource()};
+
+    RouteEventList routes{&resource};
+    const auto& header = *reinterpret_cast<const nlmsghdr*>(buf.data());
+    routes.push_back(RouteEventView{header}.materialize(routes.get_allocator()));
+
+    ASSERT_EQ(routes.size(), 1U);
+    EXPECT_EQ(routes[0].gateway, "2001:db8:ffff:ffff:ffff:ffff:ffff:1");
+    EXPECT_EQ(routes[0].get_allocator().resource(), &resource);
+    EXPECT_EQ(routes[0].gateway.get_allocator().resource(), &resource);
+}
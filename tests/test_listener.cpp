@@ -0,0 +1,474 @@
+#include <gtest/gtest.h>
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <future>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <net/if.h>
+#include <sys/socket.h>
+
+#include "rtaco/core/nl_control.hxx"
+#include "rtaco/core/nl_listener.hxx"
+
+using namespace llmx::rtaco;
+using namespace std::chrono_literals;
+
+namespace {
+
+// Host routes on `lo` in 198.18.0.0/15, the benchmarking range. They go to
+// the main table: the listener mirrors what a default route dump returns.
+constexpr std::string_view TEST_RANGE = "198.18.";
+// Notified but never dumped, so its event is only seen once reading resumes.
+constexpr uint32_t BARRIER_TABLE = 4242U;
+// Far more notifications than fit the default receive buffer.
+constexpr uint32_t FLOOD = 2048U;
+constexpr uint32_t FLOOD_BASE = 256U; // 198.18.1.0
+
+auto host(uint32_t offset) -> std::string {
+    return "198.18." + std::to_string(offset >> 8U) + "." +
+           std::to_string(offset & 0xffU);
+}
+
+auto host_route(uint32_t offset, uint8_t protocol = RTPROT_STATIC,
+        uint32_t table = RT_TABLE_MAIN) -> RouteSpec {
+    RouteSpec route{};
+    route.dst_prefix_len = 32U;
+    route.scope = RT_SCOPE_LINK;
+    route.protocol = protocol;
+    route.table = table;
+    route.oif_index = ::if_nametoindex("lo");
+    route.dst = IpAddress::from_string(host(offset), AF_INET);
+    return route;
+}
+
+auto wait_for(const std::function<bool()>& done,
+        std::chrono::milliseconds timeout = 5s) -> bool {
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!done()) {
+        if (std::chrono::steady_clock::now() >= deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(2ms);
+    }
+    return true;
+}
+
+/** Descriptors of this process's NETLINK_ROUTE sockets. */
+auto route_sockets() -> std::vector<int> {
+    std::vector<int> fds{};
+    for (const auto& entry : std::filesystem::directory_iterator{"/proc/self/fd"}) {
+        const auto fd = std::stoi(entry.path().filename().string());
+        int domain = 0;
+        int protocol = -1;
+        socklen_t length = sizeof(int);
+        if (::getsockopt(fd, SOL_SOCKET, SO_DOMAIN, &domain, &length) == 0 &&
+                domain == AF_NETLINK &&
+                ::getsockopt(fd, SOL_SOCKET, SO_PROTOCOL, &protocol, &length) == 0 &&
+                protocol == NETLINK_ROUTE) {
+            fds.push_back(fd);
+        }
+    }
+    return fds;
+}
+
+/** Multicast groups `fd` is a member of, as NETLINK_LIST_MEMBERSHIPS reports. */
+auto joined_groups(int fd) -> std::vector<uint32_t> {
+    std::vector<uint32_t> words(8U, 0);
+    auto length = static_cast<socklen_t>(words.size() * sizeof(uint32_t));
+    const auto rc = ::getsockopt(fd, SOL_NETLINK, NETLINK_LIST_MEMBERSHIPS,
+            words.data(), &length);
+    if (rc != 0) {
+        return {};
+    }
+
+    std::vector<uint32_t> groups{};
+    const auto bits = std::min<size_t>(length, words.size() * sizeof(uint32_t)) * 8U;
+    for (size_t bit = 0; bit < bits; ++bit) {
+        if ((words[bit / 32U] & (1U << (bit % 32U))) != 0) {
+            groups.push_back(static_cast<uint32_t>(bit + 1U));
+        }
+    }
+    return groups;
+}
+
+/** Events of the test routes, in the order the listener emitted them. */
+class RouteLog {
+public:
+    void record(const RouteEvent& event) {
+        if ((event.table != RT_TABLE_MAIN && event.table != BARRIER_TABLE) ||
+                !event.dst.starts_with(TEST_RANGE)) {
+            return;
+        }
+
+        const std::lock_guard lock{mutex_};
+        events_.push_back(
+                {std::string{event.dst}, event.type == RouteEvent::Type::DELETE_ROUTE});
+    }
+
+    auto seen(const std::string& dst, bool removed) const -> size_t {
+        const std::lock_guard lock{mutex_};
+        return static_cast<size_t>(std::count_if(events_.begin(), events_.end(),
+                [&](const Entry& event) {
+            return event.dst == dst && event.removed == removed;
+        }));
+    }
+
+    auto seen(const std::string& dst) const -> size_t {
+        return seen(dst, false) + seen(dst, true);
+    }
+
+    /** Whether the last event of `dst` left the route in place. */
+    auto present(const std::string& dst) const -> bool {
+        const std::lock_guard lock{mutex_};
+        const auto last = std::find_if(events_.rbegin(), events_.rend(),
+                [&dst](const Entry& event) { return event.dst == dst; });
+        return last != events_.rend() && !last->removed;
+    }
+
+    /** Routes present once every event is applied in order. */
+    auto present() const -> size_t {
+        const std::lock_guard lock{mutex_};
+        std::map<std::string, bool> routes{};
+        for (const auto& event : events_) {
+            routes[event.dst] = !event.removed;
+        }
+        return static_cast<size_t>(std::count_if(routes.begin(), routes.end(),
+                [](const auto& entry) { return entry.second; }));
+    }
+
+private:
+    struct Entry {
+        std::string dst;
+        bool removed;
+    };
+
+    mutable std::mutex mutex_{};
+    std::vector<Entry> events_{};
+};
+
+/** Runs a listener and changes routes through a separate Control. */
+class ListenerTest : public ::testing::Test {
+protected:
+    explicit ListenerTest(ListenerOptions options)
+        : listener{io, std::move(options)} {}
+
+    void TearDown() override {
+        if (!threads.empty()) {
+            boost::asio::post(io, [this] { listener.stop(); });
+            work.reset();
+            for (auto& thread : threads) {
+                thread.join();
+            }
+        }
+
+        if (!installed.empty()) {
+            (void)control.apply_routes(RouteOp::DELETE, installed);
+        }
+        control.stop();
+        control_work.reset();
+        control_thread.join();
+    }
+
+    /** Add `routes`; false if the test may not change routes. */
+    auto install(const std::vector<RouteSpec>& routes) -> bool {
+        auto applied = control.apply_routes(RouteOp::ADD, routes);
+        if (!applied) {
+            return false;
+        }
+        for (size_t i = 0; i < routes.size(); ++i) {
+            installed.push_back(routes[i]);
+        }
+        return applied->ok();
+    }
+
+    void run(size_t thread_count) {
+        listener.start();
+        for (size_t i = 0; i < thread_count; ++i) {
+            threads.emplace_back([this] { io.run(); });
+        }
+    }
+
+    boost::asio::io_context control_io{};
+    boost::asio::executor_work_guard<boost::asio::io_context::executor_type>
+            control_work{boost::asio::make_work_guard(control_io)};
+    std::thread control_thread{[this] { control_io.run(); }};
+    Control control{control_io};
+
+    boost::asio::io_context io{};
+    boost::asio::executor_work_guard<boost::asio::io_context::executor_type> work{
+            boost::asio::make_work_guard(io)};
+    std::vector<std::thread> threads{};
+    Listener listener;
+
+    std::vector<RouteSpec> installed{};
+};
+
+class ListenerResyncTest : public ListenerTest {
+protected:
+    explicit ListenerResyncTest(ListenerOptions options = {.resync_on_overrun = true},
+            ExecPolicy policy = ExecPolicy::Sync)
+        : ListenerTest{std::move(options)}
+        , policy_{policy} {}
+
+    void SetUp() override {
+        listener.connect_to_event([this](const RouteEvent& event) { log.record(event); },
+                policy_);
+    }
+
+    /** Start listening and wait for the silent initial dump to finish. */
+    void start() {
+        run(1U);
+
+        // Notifications are only read once the dump is mirrored.
+        ASSERT_TRUE(install({host_route(1U)}));
+        ASSERT_TRUE(wait_for([this] { return log.seen(host(1U)) == 1U; }));
+    }
+
+    /** Change the test routes while the listener cannot read, so that the
+     * flood overruns its socket and `then` is lost as well. */
+    void overrun(const std::function<void()>& then = {}) {
+        std::promise<void> release{};
+        boost::asio::post(io, [blocked = release.get_future().share()]
+        {
+            blocked.wait();
+        });
+
+        std::vector<RouteSpec> flood{};
+        for (uint32_t i = 0; i < FLOOD; ++i) {
+            flood.push_back(host_route(FLOOD_BASE + i));
+        }
+        EXPECT_TRUE(install(flood));
+        if (then) {
+            then();
+        }
+
+        release.set_value();
+        ASSERT_TRUE(wait_for([this] { return listener.overruns() != 0U; }));
+
+        // The last route of the flood is only known from the re-dump, which
+        // is reported in one go; reading resumes after it.
+        const auto last = host(FLOOD_BASE + FLOOD - 1U);
+        ASSERT_TRUE(wait_for([this, &last] { return log.seen(last) != 0U; }));
+        ASSERT_TRUE(install({host_route(4U, RTPROT_STATIC, BARRIER_TABLE)}));
+        ASSERT_TRUE(wait_for([this] { return log.seen(host(4U)) == 1U; }));
+    }
+
+    RouteLog log{};
+
+private:
+    ExecPolicy policy_;
+};
+
+class ListenerBatchedResyncTest : public ListenerResyncTest {
+protected:
+    ListenerBatchedResyncTest()
+        : ListenerResyncTest{{.resync_on_overrun = true, .batch = {.max_delay = 500ms}},
+                  ExecPolicy::Batched} {}
+};
+
+class ListenerTruncationTest : public ListenerResyncTest {
+protected:
+    // Batch slots too small for any notification until the first one grows them.
+    ListenerTruncationTest()
+        : ListenerResyncTest{{.receive_buffer = {16U, 64U * 1024U},
+                .batch_size = 4U,
+                .resync_on_overrun = true}} {}
+};
+
+class ListenerShardTest : public ListenerTest {
+protected:
+    // Two strands on the listener's io_context, run by two threads.
+    ListenerShardTest()
+        : ListenerTest{{.shards = {.count = 2U}}} {}
+
+    void SetUp() override {
+        listener.connect_to_event([this](const RouteEvent& event)
+        {
+            if (std::string_view{event.dst} != host(1U)) {
+                return;
+            }
+
+            // Hold one route back so the other's strand can run ahead.
+            if (event.table == RT_TABLE_MAIN) {
+                std::this_thread::sleep_for(1ms);
+            }
+
+            const std::lock_guard lock{mutex};
+            removals[event.table].push_back(event.type == RouteEvent::Type::DELETE_ROUTE);
+            ++delivered;
+        }, ExecPolicy::Sharded);
+    }
+
+    auto delivered_count() -> size_t {
+        const std::lock_guard lock{mutex};
+        return delivered;
+    }
+
+    std::mutex mutex{};
+    std::map<uint32_t, std::vector<bool>> removals{};
+    size_t delivered{0U};
+};
+
+} // namespace
+
+TEST(ListenerGroupTest, RouteSlotJoinsOnlyTheRouteGroups) {
+    boost::asio::io_context io{};
+    Listener listener{io};
+
+    const auto before = route_sockets();
+    listener.start();
+    std::vector<int> opened{};
+    for (const auto fd : route_sockets()) {
+        if (std::ranges::find(before, fd) == before.end()) {
+            opened.push_back(fd);
+        }
+    }
+    ASSERT_EQ(opened.size(), 1U);
+    const auto fd = opened.front();
+    EXPECT_TRUE(joined_groups(fd).empty());
+
+    auto connection = listener.connect_to_event([](const RouteEvent&) {});
+    EXPECT_EQ(joined_groups(fd),
+            (std::vector<uint32_t>{RTNLGRP_IPV4_ROUTE, RTNLGRP_IPV6_ROUTE}));
+
+    connection.disconnect();
+    EXPECT_TRUE(joined_groups(fd).empty());
+
+    connection = listener.connect_to_event([](const RouteEvent&) {}, ExecPolicy::Sync,
+            AF_INET6);
+    EXPECT_EQ(joined_groups(fd), (std::vector<uint32_t>{RTNLGRP_IPV6_ROUTE}));
+
+    connection.disconnect();
+    EXPECT_TRUE(joined_groups(fd).empty());
+    listener.stop();
+}
+
+TEST_F(ListenerResyncTest, OverrunReportsChangesAgainstTheKnownState) {
+    const auto gone = host_route(2U);
+    const auto kept = host_route(3U);
+    if (!install({gone, kept})) {
+        GTEST_SKIP() << "needs CAP_NET_ADMIN";
+    }
+
+    ASSERT_NO_FATAL_FAILURE(start());
+    EXPECT_EQ(listener.overruns(), 0U);
+    EXPECT_EQ(log.seen(host(2U)), 0U);
+
+    // The deletion is queued behind a full buffer and dropped: only the
+    // re-dump can tell that the route went away.
+    ASSERT_NO_FATAL_FAILURE(overrun([&] {
+        auto removed = control.apply_routes(RouteOp::DELETE, {&gone, 1U});
+        ASSERT_TRUE(removed && removed->ok());
+    }));
+
+    EXPECT_EQ(log.present(), FLOOD + 2U); // with the first route and the barrier
+    EXPECT_EQ(log.seen(host(2U), true), 1U);
+    EXPECT_EQ(log.seen(host(2U), false), 0U);
+    EXPECT_EQ(log.seen(host(3U)), 0U); // unchanged across the gap
+    for (uint32_t i = 0; i < FLOOD; ++i) {
+        EXPECT_EQ(log.seen(host(FLOOD_BASE + i), true), 0U);
+    }
+}
+
+TEST_F(ListenerResyncTest, ResyncForgetsEntriesOutsideTheFilter) {
+    if (!install({host_route(2U, RTPROT_BOOT)})) {
+        GTEST_SKIP() << "needs CAP_NET_ADMIN";
+    }
+
+    ASSERT_NO_FATAL_FAILURE(start());
+
+    // The boot-protocol route is mirrored but no longer in scope; it must
+    // not come back as a deletion once the re-dump leaves it out.
+    ASSERT_TRUE(listener.set_filter({.route = RouteFilter{.protocol = RTPROT_STATIC}}));
+    ASSERT_NO_FATAL_FAILURE(overrun());
+
+    EXPECT_EQ(log.seen(host(2U)), 0U);
+}
+
+TEST_F(ListenerBatchedResyncTest, PendingBatchesGoOutBeforeTheResync) {
+    const auto route = host_route(2U);
+    if (!install({route})) {
+        GTEST_SKIP() << "needs CAP_NET_ADMIN";
+    }
+
+    ASSERT_NO_FATAL_FAILURE(start());
+
+    // The deletion is read but held in a batch when the overrun hits; the
+    // route comes back during the gap and the re-dump reports it as new.
+    auto removed = control.apply_routes(RouteOp::DELETE, {&route, 1U});
+    ASSERT_TRUE(removed && removed->ok());
+    std::this_thread::sleep_for(50ms);
+    EXPECT_EQ(log.seen(host(2U)), 0U);
+
+    ASSERT_NO_FATAL_FAILURE(overrun([&] { ASSERT_TRUE(install({route})); }));
+
+    EXPECT_EQ(log.seen(host(2U), true), 1U);
+    EXPECT_EQ(log.seen(host(2U), false), 1U);
+    EXPECT_TRUE(log.present(host(2U)));
+}
+
+TEST_F(ListenerTruncationTest, TruncatedDatagramTriggersResync) {
+    run(1U);
+    // Let the initial dump finish before the route exists.
+    std::this_thread::sleep_for(200ms);
+
+    // The notification is cut to the slot size and dropped; only the re-dump
+    // reports the route.
+    if (!install({host_route(2U)})) {
+        GTEST_SKIP() << "needs CAP_NET_ADMIN";
+    }
+    ASSERT_TRUE(wait_for([this] { return log.seen(host(2U)) != 0U; }));
+    EXPECT_EQ(listener.overruns(), 1U);
+    EXPECT_EQ(log.seen(host(2U), false), 1U);
+
+    // The slots have grown to fit, so the next notification is read as is.
+    ASSERT_TRUE(install({host_route(3U)}));
+    ASSERT_TRUE(wait_for([this] { return log.seen(host(3U)) != 0U; }));
+    EXPECT_EQ(listener.overruns(), 1U);
+    EXPECT_EQ(log.seen(host(2U)), 1U);
+}
+
+TEST_F(ListenerShardTest, DefaultRouteKeyKeepsEachRouteInOrder) {
+    run(2U);
+
+    // One prefix in two tables: two keys for the default route key.
+    const std::vector<RouteSpec> routes{
+            host_route(1U), host_route(1U, RTPROT_STATIC, BARRIER_TABLE)};
+    constexpr size_t ROUNDS = 25U;
+
+    if (!install(routes)) {
+        GTEST_SKIP() << "needs CAP_NET_ADMIN";
+    }
+    for (size_t round = 0; round < ROUNDS; ++round) {
+        if (round != 0U) {
+            ASSERT_TRUE(install(routes));
+        }
+        auto removed = control.apply_routes(RouteOp::DELETE, routes);
+        ASSERT_TRUE(removed && removed->ok());
+    }
+
+    ASSERT_TRUE(wait_for([this] { return delivered_count() == 4U * ROUNDS; }));
+
+    const std::lock_guard lock{mutex};
+    for (const auto table : {static_cast<uint32_t>(RT_TABLE_MAIN), BARRIER_TABLE}) {
+        const auto& sequence = removals[table];
+        ASSERT_EQ(sequence.size(), 2U * ROUNDS) << "table " << table;
+        for (size_t i = 0; i < sequence.size(); ++i) {
+            EXPECT_EQ(sequence[i], i % 2U == 1U) << "table " << table << ", event " << i;
+        }
+    }
+}
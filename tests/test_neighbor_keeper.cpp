@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/io_context.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <thread>
+
+#include "rtaco/core/nl_control.hxx"
+#include "rtaco/core/nl_listener.hxx"
+#include "rtaco/core/nl_neighbor_keeper.hxx"
+
+using namespace llmx::rtaco;
+using namespace std::chrono_literals;
+
+namespace {
+
+// No such interface: every probe fails with ENODEV and leaves no entry behind.
+constexpr uint16_t MISSING_IFINDEX = 65000U;
+
+auto mapped_address(uint8_t last) -> std::array<uint8_t, 16> {
+    // ::ffff:192.0.2.<last>
+    return {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0xff, 0xff, 192, 0, 2, last};
+}
+
+auto wait_for(const std::function<bool()>& done,
+        std::chrono::milliseconds timeout = 3s) -> bool {
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!done()) {
+        if (std::chrono::steady_clock::now() >= deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(2ms);
+    }
+    return true;
+}
+
+class NeighborKeeperTest : public ::testing::Test {
+protected:
+    void TearDown() override {
+        control.stop();
+        work.reset();
+        thread.join();
+    }
+
+    void add_entries(NeighborKeeper& keeper, uint8_t count) {
+        for (uint8_t i = 1U; i <= count; ++i) {
+            keeper.add(MISSING_IFINDEX, mapped_address(i));
+        }
+        ASSERT_TRUE(wait_for([&] { return keeper.size() == count; }));
+    }
+
+    boost::asio::io_context io{};
+    boost::asio::executor_work_guard<boost::asio::io_context::executor_type> work{
+            boost::asio::make_work_guard(io)};
+    std::thread thread{[this] { io.run(); }};
+    Control control{io};
+    Listener listener{io};
+};
+
+} // namespace
+
+TEST_F(NeighborKeeperTest, PacesProbes) {
+    NeighborKeeper keeper{io, control, listener, {.probes_per_second = 20U}};
+    add_entries(keeper, 8U);
+
+    const auto start = std::chrono::steady_clock::now();
+    keeper.start();
+
+    // One probe every 50 ms: two or three by 120 ms, all eight after 350 ms.
+    std::this_thread::sleep_for(120ms);
+    EXPECT_LE(keeper.probes_sent(), 4U);
+
+    ASSERT_TRUE(wait_for([&] { return keeper.probes_sent() == 8U; }));
+    EXPECT_GE(std::chrono::steady_clock::now() - start, 340ms);
+    EXPECT_TRUE(wait_for([&] { return keeper.probe_errors() == 8U; }));
+
+    keeper.stop();
+}
+
+TEST_F(NeighborKeeperTest, WaitsMinReprobeInterval) {
+    NeighborKeeper keeper{io, control, listener,
+            {.probes_per_second = 1000U, .min_reprobe_interval = 300ms}};
+    add_entries(keeper, 1U);
+
+    const auto start = std::chrono::steady_clock::now();
+    keeper.start();
+    ASSERT_TRUE(wait_for([&] { return keeper.probes_sent() == 1U; }));
+
+    // A restart queues every entry again, but not before the interval.
+    keeper.stop();
+    keeper.start();
+    std::this_thread::sleep_for(100ms);
+    EXPECT_EQ(keeper.probes_sent(), 1U);
+
+    ASSERT_TRUE(wait_for([&] { return keeper.probes_sent() == 2U; }));
+    EXPECT_GE(std::chrono::steady_clock::now() - start, 290ms);
+
+    keeper.stop();
+}
+
+TEST_F(NeighborKeeperTest, EntriesNotYetDueDoNotHoldUpOthers) {
+    NeighborKeeper keeper{io, control, listener,
+            {.probes_per_second = 100U, .min_reprobe_interval = 500ms}};
+    add_entries(keeper, 1U);
+
+    keeper.start();
+    ASSERT_TRUE(wait_for([&] { return keeper.probes_sent() == 1U; }));
+
+    // Requeued right after its probe, as a FAILED entry is; the entries
+    // added behind it are due now and must not wait for it.
+    const auto start = std::chrono::steady_clock::now();
+    keeper.stop();
+    keeper.start();
+    keeper.add(MISSING_IFINDEX, mapped_address(2));
+    keeper.add(MISSING_IFINDEX, mapped_address(3));
+
+    ASSERT_TRUE(wait_for([&] { return keeper.probes_sent() == 3U; }));
+    EXPECT_LT(std::chrono::steady_clock::now() - start, 250ms);
+
+    ASSERT_TRUE(wait_for([&] { return keeper.probes_sent() == 4U; }));
+    EXPECT_GE(std::chrono::steady_clock::now() - start, 450ms);
+
+    keeper.stop();
+}
+
+TEST_F(NeighborKeeperTest, RestartKeepsOnePaceLoop) {
+    NeighborKeeper keeper{io, control, listener,
+            {.probes_per_second = 5U, .min_reprobe_interval = 0ms}};
+    add_entries(keeper, 6U);
+
+    // The loop spawned by the first start() must not survive the restart:
+    // two loops would each pace at the full rate and keep waking each other.
+    keeper.start();
+    keeper.stop();
+    keeper.start();
+
+    // One loop probes at 0, 200 and 400 ms (and the first start() may have
+    // sent one more before the restart); two loops would reach six.
+    std::this_thread::sleep_for(500ms);
+    EXPECT_LE(keeper.probes_sent(), 4U);
+
+    keeper.stop();
+    ASSERT_TRUE(wait_for([&] { return keeper.probe_errors() == keeper.probes_sent(); }));
+    const auto sent = keeper.probes_sent();
+    std::this_thread::sleep_for(250ms);
+    EXPECT_EQ(keeper.probes_sent(), sent);
+}
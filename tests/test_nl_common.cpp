@@ -34,3 +34,20 @@ TEST(NLCommonTest, GetMsgPayloadShort) {
     auto ptr = get_msg_payload<ifinfomsg>(short_hdr);
     EXPECT_EQ(ptr, nullptr);
 }
+
+TEST(NLCommonTest, ParseAddressMapsIPv4) {
+    auto v4 = parse_address("192.0.2.1", AF_INET);
+    ASSERT_TRUE(v4.has_value());
+    EXPECT_EQ((*v4)[10], 0xff);
+    EXPECT_EQ((*v4)[11], 0xff);
+    EXPECT_EQ((*v4)[12], 192);
+    EXPECT_EQ((*v4)[15], 1);
+
+    auto v6 = parse_address("2001:db8::1", AF_INET6);
+    ASSERT_TRUE(v6.has_value());
+    EXPECT_EQ((*v6)[0], 0x20);
+    EXPECT_EQ((*v6)[15], 1);
+
+    EXPECT_FALSE(parse_address("not-an-address", AF_INET).has_value());
+    EXPECT_FALSE(parse_address("192.0.2.1", AF_UNSPEC).has_value());
+}
@@ -0,0 +1,248 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <linux/rtnetlink.h>
+
+#include "rtaco/core/nl_route_index.hxx"
+
+using namespace llmx::rtaco;
+
+namespace {
+
+auto make_route(const char* dst, uint8_t length, uint32_t oif, uint32_t priority = 0U,
+        uint32_t table = RT_TABLE_MAIN) -> CompactRouteEvent {
+    CompactRouteEvent route{};
+    route.type = RouteEvent::Type::NEW_ROUTE;
+    route.family = std::string_view{dst}.find(':') != std::string_view::npos ? AF_INET6
+                                                                           : AF_INET;
+    route.dst_prefix_len = length;
+    route.table = table;
+    route.priority = priority;
+    route.oif_index = oif;
+    if (length != 0U) {
+        route.dst = IpAddress::from_string(dst, route.family);
+    }
+    return route;
+}
+
+auto v4(const char* text) -> IpAddress {
+    return IpAddress::from_string(text, AF_INET);
+}
+
+auto oif_of(const RouteIndex& index, const IpAddress& address) -> uint32_t {
+    const auto* route = index.lookup(address);
+    return route != nullptr ? route->oif_index : 0U;
+}
+
+// Reference answer: scan every route for the longest match.
+auto linear_lookup(const std::vector<CompactRouteEvent>& routes, const IpAddress& address)
+        -> uint32_t {
+    const CompactRouteEvent* best = nullptr;
+    for (const auto& route : routes) {
+        bool match = true;
+        for (uint8_t bit = 0U; bit < route.dst_prefix_len && match; ++bit) {
+            const auto mask = static_cast<uint8_t>(0x80U >> (bit % 8U));
+            const auto byte = bit / 8U;
+            match = (route.dst.bytes[byte] & mask) == (address.bytes[byte] & mask);
+        }
+        if (match && (best == nullptr || route.dst_prefix_len > best->dst_prefix_len)) {
+            best = &route;
+        }
+    }
+    return best != nullptr ? best->oif_index : 0U;
+}
+
+} // namespace
+
+TEST(RouteIndexTest, LongestPrefixWins) {
+    const std::vector<CompactRouteEvent> routes{
+            make_route("0.0.0.0", 0U, 1U),
+            make_route("10.0.0.0", 8U, 2U),
+            make_route("10.1.0.0", 16U, 3U),
+            make_route("10.1.2.0", 24U, 4U),
+            make_route("10.1.2.128", 25U, 5U),
+            make_route("10.1.2.7", 32U, 6U),
+            make_route("2001:db8::", 32U, 7U),
+            make_route("2001:db8:0:1::", 64U, 8U),
+    };
+    const RouteIndex index{routes};
+
+    EXPECT_EQ(index.size(), routes.size());
+    EXPECT_EQ(oif_of(index, v4("192.0.2.1")), 1U);
+    EXPECT_EQ(oif_of(index, v4("10.200.0.1")), 2U);
+    EXPECT_EQ(oif_of(index, v4("10.1.9.9")), 3U);
+    EXPECT_EQ(oif_of(index, v4("10.1.2.1")), 4U);
+    EXPECT_EQ(oif_of(index, v4("10.1.2.200")), 5U);
+    EXPECT_EQ(oif_of(index, v4("10.1.2.7")), 6U);
+
+    EXPECT_EQ(oif_of(index, IpAddress::from_string("2001:db8:0:1::5", AF_INET6)), 8U);
+    EXPECT_EQ(oif_of(index, IpAddress::from_string("2001:db8:ffff::1", AF_INET6)), 7U);
+    EXPECT_EQ(index.lookup(IpAddress::from_string("2001:db9::1", AF_INET6)), nullptr);
+    EXPECT_EQ(index.lookup(IpAddress{}), nullptr);
+}
+
+TEST(RouteIndexTest, IncrementalUpdates) {
+    RouteIndex index{};
+    index.update(make_route("10.0.0.0", 8U, 2U));
+    index.update(make_route("10.1.2.0", 24U, 4U));
+    EXPECT_EQ(oif_of(index, v4("10.1.2.3")), 4U);
+
+    auto removed = make_route("10.1.2.0", 24U, 4U);
+    removed.type = RouteEvent::Type::DELETE_ROUTE;
+    index.update(removed);
+    EXPECT_EQ(index.size(), 1U);
+    EXPECT_EQ(oif_of(index, v4("10.1.2.3")), 2U);
+
+    // Replacing a route in place keeps a single entry.
+    index.update(make_route("10.0.0.0", 8U, 9U));
+    EXPECT_EQ(index.size(), 1U);
+    EXPECT_EQ(oif_of(index, v4("10.1.2.3")), 9U);
+}
+
+TEST(RouteIndexTest, LowestMetricAndFirstTableWin) {
+    RouteIndex index{};
+    index.update(make_route("10.0.0.0", 8U, 2U, 200U));
+    index.update(make_route("10.0.0.0", 8U, 3U, 100U));
+    EXPECT_EQ(oif_of(index, v4("10.9.9.9")), 3U);
+
+    index.update(make_route("10.9.9.9", 32U, 1U, 0U, RT_TABLE_LOCAL));
+    index.update(make_route("10.0.0.0", 8U, 7U, 0U, 1000U));
+    const auto* route = index.lookup(v4("10.9.9.9"));
+    ASSERT_NE(route, nullptr);
+    EXPECT_EQ(route->table, static_cast<uint32_t>(RT_TABLE_LOCAL));
+    EXPECT_EQ(index.size(), 3U);
+
+    auto better = make_route("10.0.0.0", 8U, 3U, 100U);
+    better.type = RouteEvent::Type::DELETE_ROUTE;
+    index.update(better);
+    EXPECT_EQ(oif_of(index, v4("10.1.1.1")), 2U);
+}
+
+TEST(RouteIndexTest, OwningDumpAndBatchLookup) {
+    RouteEventList dump{};
+    dump.push_back(make_route("192.168.0.0", 16U, 4U).to_event());
+    dump.push_back(make_route("192.168.7.0", 24U, 5U).to_event());
+    const RouteIndex index{dump};
+
+    const std::array<IpAddress, 3> addresses{v4("192.168.7.1"), v4("192.168.8.1"),
+            v4("172.16.0.1")};
+    std::array<const CompactRouteEvent*, 3> results{};
+    index.lookup(addresses, results);
+
+    ASSERT_NE(results[0], nullptr);
+    EXPECT_EQ(results[0]->oif_index, 5U);
+    ASSERT_NE(results[1], nullptr);
+    EXPECT_EQ(results[1]->oif_index, 4U);
+    EXPECT_EQ(results[2], nullptr);
+}
+
+TEST(RouteIndexTest, MatchesLinearScan) {
+    std::mt19937 rng{42U};
+    std::vector<CompactRouteEvent> routes{};
+    std::unordered_set<RouteKey> seen{};
+    RouteIndex index{};
+
+    for (uint32_t i = 0; i < 2000U; ++i) {
+        auto route = make_route("0.0.0.0", 0U, i + 1U);
+        route.dst_prefix_len = static_cast<uint8_t>(rng() % 33U);
+        route.dst.family = AF_INET;
+        // Cluster prefixes under 10/8 so many of them overlap.
+        const uint32_t value = (10U << 24U) | (rng() & 0x00FFFFFFU);
+        const uint32_t mask = route.dst_prefix_len == 0U
+                ? 0U
+                : ~uint32_t{0} << (32U - route.dst_prefix_len);
+        const uint32_t masked = htonl(value & mask);
+        std::memcpy(route.dst.bytes.data(), &masked, sizeof(masked));
+
+        if (!seen.insert(RouteKey::from(route)).second) {
+            continue;
+        }
+        routes.push_back(route);
+        index.update(route);
+    }
+
+    // Remove every third route again.
+    std::vector<CompactRouteEvent> kept{};
+    for (size_t i = 0; i < routes.size(); ++i) {
+        if (i % 3U == 0U) {
+            auto removed = routes[i];
+            removed.type = RouteEvent::Type::DELETE_ROUTE;
+            index.update(removed);
+        } else {
+            kept.push_back(routes[i]);
+        }
+    }
+
+    const RouteIndex rebuilt{kept};
+    EXPECT_EQ(index.size(), kept.size());
+    EXPECT_EQ(rebuilt.size(), kept.size());
+
+    for (int i = 0; i < 5000; ++i) {
+        const uint32_t value = htonl((10U << 24U) | (rng() & 0x00FFFFFFU));
+        IpAddress address{};
+        address.family = AF_INET;
+        std::memcpy(address.bytes.data(), &value, sizeof(value));
+
+        const auto expected = linear_lookup(kept, address);
+        ASSERT_EQ(oif_of(index, address), expected);
+        ASSERT_EQ(oif_of(rebuilt, address), expected);
+    }
+}
+
+TEST(RouteIndexTest, ThrowRoutesFallThroughToNextTable) {
+    RouteIndex index{};
+    index.update(make_route("10.0.0.0", 8U, 2U, 0U, RT_TABLE_DEFAULT));
+    index.update(make_route("10.0.0.0", 8U, 3U));
+
+    // The throw route shadows the main table's /8 for 10.1/16 only.
+    auto thrown = make_route("10.1.0.0", 16U, 0U);
+    thrown.route_type = RTN_THROW;
+    index.update(thrown);
+
+    EXPECT_EQ(oif_of(index, v4("10.2.0.1")), 3U);
+    EXPECT_EQ(oif_of(index, v4("10.1.0.1")), 2U);
+
+    // Nothing left to fall through to.
+    auto last = make_route("192.168.0.0", 16U, 0U, 0U, RT_TABLE_DEFAULT);
+    last.route_type = RTN_THROW;
+    index.update(last);
+    EXPECT_EQ(index.lookup(v4("192.168.0.1")), nullptr);
+}
+
+TEST(RouteIndexTest, RoutesWithoutOifAreReturned) {
+    RouteIndex index{};
+    index.update(make_route("0.0.0.0", 0U, 1U));
+
+    auto blackhole = make_route("10.0.0.0", 8U, 0U);
+    blackhole.route_type = RTN_BLACKHOLE;
+    index.update(blackhole);
+
+    auto prohibit = make_route("10.1.0.0", 16U, 0U);
+    prohibit.route_type = RTN_PROHIBIT;
+    index.update(prohibit);
+
+    // A multipath route keeps its next hops in RTA_MULTIPATH only.
+    auto multipath = make_route("172.16.0.0", 12U, 0U);
+    multipath.route_type = RTN_UNICAST;
+    index.update(multipath);
+
+    const auto* route = index.lookup(v4("10.2.0.1"));
+    ASSERT_NE(route, nullptr);
+    EXPECT_EQ(route->route_type, RTN_BLACKHOLE);
+
+    route = index.lookup(v4("10.1.0.1"));
+    ASSERT_NE(route, nullptr);
+    EXPECT_EQ(route->route_type, RTN_PROHIBIT);
+
+    route = index.lookup(v4("172.16.0.1"));
+    ASSERT_NE(route, nullptr);
+    EXPECT_EQ(route->dst_prefix_len, 12U);
+    EXPECT_EQ(route->oif_index, 0U);
+}
@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+
+#include "rtaco/tasks/nl_route_message.hxx"
+
+using namespace llmx::rtaco;
+
+namespace {
+
+auto make_spec(const char* dst, uint8_t length) -> RouteSpec {
+    RouteSpec route{};
+    route.family = AF_INET;
+    route.dst_prefix_len = length;
+    route.dst = IpAddress::from_string(dst, AF_INET);
+    return route;
+}
+
+auto messages_of(const MessageBuilder& builder) -> std::vector<const nlmsghdr*> {
+    std::vector<const nlmsghdr*> messages{};
+    const auto data = builder.data();
+    auto remaining = static_cast<unsigned int>(data.size());
+    const auto* header = reinterpret_cast<const nlmsghdr*>(data.data());
+    while (NLMSG_OK(header, remaining)) {
+        messages.push_back(header);
+        header = NLMSG_NEXT(header, remaining);
+    }
+    EXPECT_EQ(remaining, 0U);
+    return messages;
+}
+
+} // namespace
+
+TEST(RouteMessageTest, EncodesRouteAttributes) {
+    auto route = make_spec("198.51.100.0", 24U);
+    route.gateway = IpAddress::from_string("192.0.2.1", AF_INET);
+    route.oif_index = 3U;
+    route.priority = 50U;
+    route.table = 1000U;
+
+    MessageBuilder builder{};
+    ASSERT_TRUE(append_route(builder, RouteOp::REPLACE, route, 7U));
+    const auto messages = messages_of(builder);
+    ASSERT_EQ(messages.size(), 1U);
+
+    const auto& header = *messages.front();
+    EXPECT_EQ(header.nlmsg_type, RTM_NEWROUTE);
+    EXPECT_EQ(header.nlmsg_seq, 7U);
+    EXPECT_EQ(header.nlmsg_flags,
+            NLM_F_REQUEST | NLM_F_ACK | NLM_F_CREATE | NLM_F_REPLACE);
+
+    // The request parses back like a notification for the same route.
+    const auto event = CompactRouteEvent::from_nlmsghdr(header);
+    EXPECT_EQ(RouteSpec::from_event(event), route);
+    EXPECT_EQ(reinterpret_cast<const rtmsg*>(NLMSG_DATA(&header))->rtm_table,
+            RT_TABLE_UNSPEC);
+}
+
+TEST(RouteMessageTest, PacksMessagesBackToBack) {
+    MessageBuilder builder{};
+    auto v6 = make_spec("", 0U);
+    v6.family = AF_INET6;
+    v6.dst = IpAddress::from_string("2001:db8::", AF_INET6);
+    v6.dst_prefix_len = 32U;
+
+    ASSERT_TRUE(append_route(builder, RouteOp::ADD, make_spec("10.0.0.0", 8U), 1U));
+    ASSERT_TRUE(append_route(builder, RouteOp::DELETE, v6, 2U, 0U));
+    ASSERT_TRUE(append_route(builder, RouteOp::ADD, make_spec("", 0U), 3U));
+    EXPECT_EQ(builder.count(), 3U);
+
+    const auto messages = messages_of(builder);
+    ASSERT_EQ(messages.size(), 3U);
+    EXPECT_EQ(messages[0]->nlmsg_flags & NLM_F_EXCL, NLM_F_EXCL);
+    EXPECT_EQ(messages[1]->nlmsg_type, RTM_DELROUTE);
+    EXPECT_EQ(messages[1]->nlmsg_flags, NLM_F_REQUEST);
+    EXPECT_EQ(reinterpret_cast<const rtmsg*>(NLMSG_DATA(messages[1]))->rtm_scope,
+            RT_SCOPE_NOWHERE);
+    EXPECT_EQ(CompactRouteEvent::from_nlmsghdr(*messages[1]).dst, v6.dst);
+    EXPECT_EQ(messages[2]->nlmsg_seq, 3U);
+
+    builder.clear();
+    EXPECT_TRUE(builder.empty());
+    EXPECT_TRUE(builder.data().empty());
+}
+
+TEST(RouteMessageTest, NestsMetrics) {
+    auto route = make_spec("10.0.0.0", 8U);
+    route.metrics.mtu = 1400U;
+    route.metrics.initcwnd = 10U;
+
+    MessageBuilder builder{};
+    ASSERT_TRUE(append_route(builder, RouteOp::ADD, route, 1U));
+    const auto& header = *messages_of(builder).front();
+
+    const rtattr* metrics = nullptr;
+    auto length = static_cast<int>(RTM_PAYLOAD(&header));
+    for (const auto* attr = RTM_RTA(NLMSG_DATA(&header)); RTA_OK(attr, length);
+            attr = RTA_NEXT(attr, length)) {
+        if (attr->rta_type == RTA_METRICS) {
+            metrics = attr;
+        }
+    }
+    ASSERT_NE(metrics, nullptr);
+
+    std::vector<std::pair<uint16_t, uint32_t>> values{};
+    auto nested = static_cast<int>(RTA_PAYLOAD(metrics));
+    for (const auto* attr = static_cast<const rtattr*>(RTA_DATA(metrics));
+            RTA_OK(attr, nested); attr = RTA_NEXT(attr, nested)) {
+        const auto value = *static_cast<const uint32_t*>(RTA_DATA(attr));
+        values.emplace_back(attr->rta_type, value);
+    }
+    const std::vector<std::pair<uint16_t, uint32_t>> expected{{RTAX_MTU, 1400U},
+            {RTAX_INITCWND, 10U}};
+    EXPECT_EQ(values, expected);
+}
+
+TEST(RouteMessageTest, RejectsMismatchedRoutes) {
+    MessageBuilder builder{};
+
+    auto too_long = make_spec("10.0.0.0", 33U);
+    EXPECT_EQ(append_route(builder, RouteOp::ADD, too_long, 1U).error(),
+            std::make_error_code(std::errc::invalid_argument));
+
+    auto mixed = make_spec("10.0.0.0", 8U);
+    mixed.gateway = IpAddress::from_string("2001:db8::1", AF_INET6);
+    EXPECT_FALSE(append_route(builder, RouteOp::ADD, mixed, 2U));
+
+    EXPECT_FALSE(append_route(builder, RouteOp::ADD, make_spec("", 24U), 3U));
+    EXPECT_TRUE(builder.empty());
+}
@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/io_context.hpp>
+
+#include <vector>
+
+#include "rtaco/core/nl_semaphore.hxx"
+
+using namespace llmx::rtaco;
+
+TEST(SemaphoreTest, WaitersAreWokenInOrder) {
+    boost::asio::io_context io;
+    Semaphore semaphore(io.get_executor(), 1);
+
+    ASSERT_TRUE(semaphore.try_acquire());
+    EXPECT_EQ(semaphore.available(), 0U);
+
+    std::vector<int> order;
+    for (int i = 0; i < 3; ++i) {
+        boost::asio::co_spawn(io, [&, i]() -> boost::asio::awaitable<void>
+        {
+            auto rc = co_await semaphore.async_acquire();
+            EXPECT_TRUE(rc.has_value());
+            order.push_back(i);
+            semaphore.release();
+        }, boost::asio::detached);
+    }
+
+    io.poll();
+    EXPECT_EQ(semaphore.waiting(), 3U);
+    EXPECT_TRUE(order.empty());
+
+    semaphore.release();
+    io.run();
+
+    EXPECT_EQ(order, (std::vector<int>{0, 1, 2}));
+    EXPECT_EQ(semaphore.available(), 1U);
+}
+
+TEST(SemaphoreTest, CancelFailsWaiters) {
+    boost::asio::io_context io;
+    Semaphore semaphore(io.get_executor(), 0);
+
+    bool cancelled = false;
+    boost::asio::co_spawn(io, [&]() -> boost::asio::awaitable<void>
+    {
+        auto rc = co_await semaphore.async_acquire();
+        cancelled = !rc && rc.error() == std::errc::operation_canceled;
+    }, boost::asio::detached);
+
+    io.poll();
+    semaphore.cancel();
+    io.run();
+
+    EXPECT_TRUE(cancelled);
+    EXPECT_EQ(semaphore.waiting(), 0U);
+}
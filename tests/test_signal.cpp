@@ -31,3 +31,16 @@ TEST(SignalTest, SyncAndAsyncSlots) {
     io.stop();
     runner.join();
 }
+
+TEST(SignalTest, EmptyTracksConnections) {
+    boost::asio::io_context io;
+
+    Signal<void(int)> sig(io.get_executor());
+    EXPECT_TRUE(sig.empty());
+
+    auto conn = sig.connect([](int) {}, ExecPolicy::Sync);
+    EXPECT_FALSE(sig.empty());
+
+    conn.disconnect();
+    EXPECT_TRUE(sig.empty());
+}
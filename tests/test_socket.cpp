@@ -1,6 +1,13 @@
 #include <gtest/gtest.h>
 #include <boost/asio/io_context.hpp>
 
+#include <string_view>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "rtaco/socket/nl_receive_batch.hxx"
+#include "rtaco/socket/nl_receive_buffer.hxx"
 #include "rtaco/socket/nl_socket.hxx"
 #include "rtaco/socket/nl_socket_guard.hxx"
 
@@ -27,3 +34,76 @@ TEST(SocketGuardTest, StopNoThrow) {
     // stop should be safe even if socket not open
     EXPECT_NO_THROW(g.stop());
 }
+
+TEST(ReceiveBufferTest, AllocatesLazilyAndGrowsToFit) {
+    ReceiveBuffer buffer{{.initial_size = 1024U, .max_size = 8192U}};
+
+    EXPECT_EQ(buffer.capacity(), 0U);
+    EXPECT_TRUE(buffer.needs_peek());
+
+    buffer.reserve(100U);
+    EXPECT_EQ(buffer.capacity(), 1024U);
+
+    buffer.reserve(1500U);
+    EXPECT_EQ(buffer.capacity(), 2048U);
+
+    buffer.reserve(100000U);
+    EXPECT_EQ(buffer.capacity(), 8192U);
+    EXPECT_FALSE(buffer.needs_peek());
+}
+
+TEST(ReceiveBufferTest, ReportsTruncation) {
+    ReceiveBuffer buffer{{.initial_size = 512U, .max_size = 512U}};
+    EXPECT_EQ(boost::asio::buffer_size(buffer.buffer()), 512U);
+
+    auto fits = buffer.received(512U);
+    ASSERT_TRUE(fits.has_value());
+    EXPECT_EQ(fits->size(), 512U);
+
+    auto truncated = buffer.received(513U);
+    ASSERT_FALSE(truncated.has_value());
+    EXPECT_EQ(truncated.error(), std::make_error_code(std::errc::message_size));
+}
+
+TEST(ReceiveBatchTest, DrainsQueuedDatagramsAndFlagsTruncation) {
+    int fds[2];
+    ASSERT_EQ(::socketpair(AF_UNIX, SOCK_DGRAM, 0, fds), 0);
+
+    const std::string_view small{"abcd"};
+    const std::string_view large{"0123456789abcdef0123"};
+    ASSERT_GT(::send(fds[0], small.data(), small.size(), 0), 0);
+    ASSERT_GT(::send(fds[0], large.data(), large.size(), 0), 0);
+    ASSERT_GT(::send(fds[0], small.data(), small.size(), 0), 0);
+
+    ReceiveBatch batch{4U, {.initial_size = 16U, .max_size = 64U}};
+
+    auto received = batch.receive(fds[1]);
+    ASSERT_TRUE(received.has_value());
+    ASSERT_EQ(*received, 3U);
+    EXPECT_EQ(batch.slot_size(), 16U);
+
+    auto first = batch.datagram(0U);
+    ASSERT_TRUE(first.has_value());
+    EXPECT_EQ(first->size(), small.size());
+
+    auto cut = batch.datagram(1U);
+    ASSERT_FALSE(cut.has_value());
+    EXPECT_EQ(cut.error(), std::make_error_code(std::errc::message_size));
+
+    EXPECT_TRUE(batch.datagram(2U).has_value());
+
+    // The truncated datagram grows the slots for the next receive.
+    ASSERT_GT(::send(fds[0], large.data(), large.size(), 0), 0);
+    received = batch.receive(fds[1]);
+    ASSERT_TRUE(received.has_value());
+    EXPECT_EQ(batch.slot_size(), large.size());
+    ASSERT_TRUE(batch.datagram(0U).has_value());
+
+    auto empty = batch.receive(fds[1]);
+    ASSERT_FALSE(empty.has_value());
+    EXPECT_EQ(empty.error(),
+            std::make_error_code(std::errc::resource_unavailable_try_again));
+
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
@@ -0,0 +1,155 @@
+#include <gtest/gtest.h>
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
+
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <net/if.h>
+
+#include "rtaco/core/nl_control.hxx"
+#include "rtaco/core/nl_listener.hxx"
+#include "rtaco/core/nl_state_mirror.hxx"
+
+using namespace llmx::rtaco;
+using namespace std::chrono_literals;
+
+namespace {
+
+auto make_link(LinkEvent::Type type, int index, const char* name) -> CompactLinkEvent {
+    CompactLinkEvent event{};
+    event.type = type;
+    event.index = index;
+    event.name = InterfaceName::from_string(name);
+    return event;
+}
+
+auto make_neighbor(NeighborEvent::Type type, int index, const char* address)
+        -> CompactNeighborEvent {
+    CompactNeighborEvent event{};
+    event.type = type;
+    event.index = index;
+    event.family = AF_INET;
+    event.address = IpAddress::from_string(address, AF_INET);
+    return event;
+}
+
+} // namespace
+
+TEST(StateMirrorTest, LinksIndexedByIndexAndName) {
+    const auto empty = std::make_shared<const StateSnapshot>();
+    const std::vector<CompactLinkEvent> added{
+            make_link(LinkEvent::Type::NEW_LINK, 1, "lo"),
+            make_link(LinkEvent::Type::NEW_LINK, 2, "eth0"),
+    };
+    const auto first = empty->apply(added);
+
+    EXPECT_EQ(first->generation(), 1U);
+    EXPECT_EQ(first->name_of(2), "eth0");
+    EXPECT_EQ(first->index_of("lo"), 1);
+    ASSERT_NE(first->link("eth0"), nullptr);
+    EXPECT_EQ(first->link("eth0")->index, 2);
+
+    const std::vector<CompactLinkEvent> renamed{
+            make_link(LinkEvent::Type::NEW_LINK, 2, "wan0")};
+    const auto second = first->apply(renamed);
+    EXPECT_EQ(second->index_of("eth0"), 0);
+    EXPECT_EQ(second->index_of("wan0"), 2);
+
+    // Older snapshots are untouched.
+    EXPECT_EQ(first->name_of(2), "eth0");
+    EXPECT_TRUE(empty->links().by_index.empty());
+}
+
+TEST(StateMirrorTest, UntouchedTablesAreShared) {
+    const std::vector<CompactLinkEvent> links{
+            make_link(LinkEvent::Type::NEW_LINK, 2, "eth0")};
+    const auto base = std::make_shared<const StateSnapshot>()->apply(links);
+
+    const auto next = base->apply(std::vector<CompactNeighborEvent>{
+            make_neighbor(NeighborEvent::Type::NEW_NEIGHBOR, 2, "198.51.100.1")});
+
+    EXPECT_EQ(&next->links(), &base->links());
+    EXPECT_EQ(&next->addresses(), &base->addresses());
+    EXPECT_NE(&next->neighbors(), &base->neighbors());
+    EXPECT_NE(next->neighbor(2, IpAddress::from_string("198.51.100.1", AF_INET)),
+            nullptr);
+}
+
+TEST(StateMirrorTest, DeletedLinkDropsItsNeighbors) {
+    const std::vector<CompactLinkEvent> links{
+            make_link(LinkEvent::Type::NEW_LINK, 2, "eth0"),
+            make_link(LinkEvent::Type::NEW_LINK, 3, "eth1")};
+    auto state = std::make_shared<const StateSnapshot>()->apply(links);
+    state = state->apply(std::vector<CompactNeighborEvent>{
+            make_neighbor(NeighborEvent::Type::NEW_NEIGHBOR, 2, "198.51.100.1"),
+            make_neighbor(NeighborEvent::Type::NEW_NEIGHBOR, 3, "198.51.100.2")});
+
+    state = state->apply(std::vector<CompactLinkEvent>{
+            make_link(LinkEvent::Type::DELETE_LINK, 2, "eth0")});
+
+    EXPECT_EQ(state->link(2), nullptr);
+    EXPECT_EQ(state->index_of("eth0"), 0);
+    EXPECT_EQ(state->neighbors().size(), 1U);
+    EXPECT_NE(state->neighbor(3, IpAddress::from_string("198.51.100.2", AF_INET)),
+            nullptr);
+}
+
+TEST(StateMirrorTest, ResolvesRouteOutputInterface) {
+    const std::vector<CompactLinkEvent> links{
+            make_link(LinkEvent::Type::NEW_LINK, 2, "eth0")};
+    const auto state = std::make_shared<const StateSnapshot>()->apply(links);
+
+    RouteEvent route{};
+    route.oif_index = 2;
+    route.oif = "2";
+    EXPECT_TRUE(state->resolve(route));
+    EXPECT_EQ(route.oif, "eth0");
+
+    route.oif_index = 9;
+    EXPECT_FALSE(state->resolve(route));
+    EXPECT_EQ(route.oif, "eth0");
+}
+
+TEST(StateMirrorTest, SeedsFromTheKernel) {
+    boost::asio::io_context io{};
+    auto work = boost::asio::make_work_guard(io);
+    Control control{io};
+    Listener listener{io};
+    StateMirror mirror{io, control, listener};
+
+    mirror.start();
+    listener.start();
+    std::thread thread{[&io] { io.run(); }};
+
+    const auto deadline = std::chrono::steady_clock::now() + 5s;
+    while (!mirror.ready() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(2ms);
+    }
+    const bool ready = mirror.ready();
+
+    const auto snapshot = mirror.snapshot();
+    const auto lo = static_cast<int>(::if_nametoindex("lo"));
+    RouteEvent route{};
+    route.oif_index = static_cast<uint32_t>(lo);
+    const bool resolved = mirror.resolve(route);
+
+    boost::asio::post(io, [&] {
+        mirror.stop();
+        listener.stop();
+        control.stop();
+    });
+    work.reset();
+    thread.join();
+
+    ASSERT_TRUE(ready);
+    ASSERT_NE(lo, 0);
+    EXPECT_EQ(snapshot->index_of("lo"), lo);
+    EXPECT_EQ(snapshot->name_of(lo), "lo");
+    EXPECT_TRUE(resolved);
+    EXPECT_EQ(route.oif, "lo");
+}
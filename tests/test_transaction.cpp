@@ -0,0 +1,236 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <linux/if_link.h>
+#include <linux/neighbour.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <net/if.h>
+
+#include "rtaco/events/nl_address_event.hxx"
+#include "rtaco/events/nl_link_event.hxx"
+#include "rtaco/events/nl_neighbor_event.hxx"
+#include "rtaco/tasks/nl_transaction.hxx"
+#include "rtaco/tasks/nl_transaction_task.hxx"
+
+using namespace llmx::rtaco;
+
+namespace {
+
+auto messages_of(const MessageBuilder& builder) -> std::vector<const nlmsghdr*> {
+    std::vector<const nlmsghdr*> messages{};
+    const auto data = builder.data();
+    auto remaining = static_cast<unsigned int>(data.size());
+    const auto* header = reinterpret_cast<const nlmsghdr*>(data.data());
+    while (NLMSG_OK(header, remaining)) {
+        messages.push_back(header);
+        header = NLMSG_NEXT(header, remaining);
+    }
+    EXPECT_EQ(remaining, 0U);
+    return messages;
+}
+
+auto find_attribute(const nlmsghdr& header, size_t family_size, uint16_t type)
+        -> const rtattr* {
+    auto remaining = static_cast<int>(header.nlmsg_len - NLMSG_SPACE(family_size));
+    const auto* attr = reinterpret_cast<const rtattr*>(
+            reinterpret_cast<const uint8_t*>(&header) + NLMSG_SPACE(family_size));
+    for (; RTA_OK(attr, remaining); attr = RTA_NEXT(attr, remaining)) {
+        if (attr->rta_type == type) {
+            return attr;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace
+
+TEST(TransactionTest, NumbersOperationsInOrder) {
+    TransactionBuilder transaction{};
+
+    LinkSpec link{};
+    link.index = 4;
+    link.up = true;
+    EXPECT_EQ(transaction.set_link(link), 0U);
+
+    AddressSpec address{};
+    address.index = 4;
+    address.prefix_len = 24U;
+    address.address = IpAddress::from_string("192.0.2.1", AF_INET);
+    EXPECT_EQ(transaction.add_address(address), 1U);
+
+    RouteSpec route{};
+    route.dst_prefix_len = 24U;
+    route.dst = IpAddress::from_string("198.51.100.0", AF_INET);
+    route.gateway = IpAddress::from_string("192.0.2.254", AF_INET);
+    EXPECT_EQ(transaction.add_route(route), 2U);
+
+    const auto messages = messages_of(transaction.messages());
+    ASSERT_EQ(messages.size(), 3U);
+    EXPECT_EQ(transaction.size(), 3U);
+
+    const uint16_t types[] = {RTM_NEWLINK, RTM_NEWADDR, RTM_NEWROUTE};
+    for (uint32_t i = 0; i < messages.size(); ++i) {
+        EXPECT_EQ(messages[i]->nlmsg_type, types[i]);
+        EXPECT_EQ(messages[i]->nlmsg_seq, i);
+        EXPECT_TRUE(messages[i]->nlmsg_flags & NLM_F_ACK);
+        EXPECT_FALSE(transaction.rejected(i));
+    }
+
+    auto rebased = transaction.messages();
+    rebased.rebase(100U);
+    EXPECT_EQ(messages_of(rebased)[2]->nlmsg_seq, 102U);
+}
+
+TEST(TransactionTest, RecordsRejectedOperations) {
+    TransactionBuilder transaction{};
+
+    NeighborSpec neighbor{};
+    neighbor.index = 2;
+    EXPECT_EQ(transaction.add_neighbor(neighbor), 0U);
+
+    neighbor.address = IpAddress::from_string("192.0.2.7", AF_INET);
+    EXPECT_EQ(transaction.add_neighbor(neighbor), 1U);
+
+    AddressSpec address{};
+    address.index = 2;
+    address.prefix_len = 64U;
+    address.address = IpAddress::from_string("192.0.2.1", AF_INET);
+    EXPECT_EQ(transaction.add_address(address), 2U);
+
+    EXPECT_EQ(transaction.size(), 3U);
+    EXPECT_EQ(transaction.messages().count(), 1U);
+    EXPECT_EQ(transaction.rejected(0), std::errc::invalid_argument);
+    EXPECT_FALSE(transaction.rejected(1));
+    EXPECT_EQ(transaction.rejected(2), std::errc::invalid_argument);
+
+    // Rejected operations keep their number; the encoded one is sent as 1.
+    EXPECT_EQ(messages_of(transaction.messages()).front()->nlmsg_seq, 1U);
+
+    transaction.clear();
+    EXPECT_TRUE(transaction.empty());
+    EXPECT_TRUE(transaction.messages().empty());
+}
+
+TEST(TransactionTest, EncodesAddress) {
+    AddressSpec address{};
+    address.index = 5;
+    address.family = AF_INET6;
+    address.prefix_len = 64U;
+    address.flags = IFA_F_NODAD | IFA_F_NOPREFIXROUTE;
+    address.address = IpAddress::from_string("2001:db8::1", AF_INET6);
+
+    TransactionBuilder transaction{};
+    transaction.replace_address(address);
+    const auto& header = *messages_of(transaction.messages()).front();
+    EXPECT_EQ(header.nlmsg_flags,
+            NLM_F_REQUEST | NLM_F_ACK | NLM_F_CREATE | NLM_F_REPLACE);
+
+    const auto event = CompactAddressEvent::from_nlmsghdr(header);
+    EXPECT_EQ(event.type, AddressEvent::Type::NEW_ADDRESS);
+    EXPECT_EQ(event.index, 5);
+    EXPECT_EQ(event.family, AF_INET6);
+    EXPECT_EQ(event.prefix_len, 64U);
+    EXPECT_EQ(event.address, address.address);
+
+    // IFA_F_NOPREFIXROUTE does not fit the 8-bit ifa_flags.
+    const auto* flags = find_attribute(header, sizeof(ifaddrmsg), IFA_FLAGS);
+    ASSERT_NE(flags, nullptr);
+    EXPECT_EQ(*reinterpret_cast<const uint32_t*>(RTA_DATA(flags)), address.flags);
+}
+
+TEST(TransactionTest, EncodesNeighbor) {
+    NeighborSpec neighbor{};
+    neighbor.index = 3;
+    neighbor.address = IpAddress::from_string("192.0.2.9", AF_INET);
+    neighbor.lladdr = LinkLayerAddress::from_string("02:00:00:00:00:09");
+
+    TransactionBuilder transaction{};
+    transaction.add_neighbor(neighbor);
+    transaction.delete_neighbor(neighbor);
+    transaction.probe_neighbor(3, neighbor.address);
+    const auto messages = messages_of(transaction.messages());
+    ASSERT_EQ(messages.size(), 3U);
+
+    const auto added = CompactNeighborEvent::from_nlmsghdr(*messages[0]);
+    EXPECT_EQ(added.type, NeighborEvent::Type::NEW_NEIGHBOR);
+    EXPECT_EQ(added.index, 3);
+    EXPECT_EQ(added.family, AF_INET);
+    EXPECT_EQ(added.state, NeighborEvent::State::PERMANENT);
+    EXPECT_EQ(added.address, neighbor.address);
+    EXPECT_EQ(added.lladdr, neighbor.lladdr);
+    EXPECT_EQ(messages[0]->nlmsg_flags,
+            NLM_F_REQUEST | NLM_F_ACK | NLM_F_CREATE | NLM_F_EXCL);
+
+    EXPECT_EQ(messages[1]->nlmsg_type, RTM_DELNEIGH);
+
+    const auto probed = CompactNeighborEvent::from_nlmsghdr(*messages[2]);
+    EXPECT_EQ(probed.state, NeighborEvent::State::PROBE);
+    EXPECT_EQ(probed.flags, NTF_USE);
+    EXPECT_TRUE(probed.lladdr.empty());
+}
+
+TEST(TransactionTest, EncodesLinkChanges) {
+    LinkSpec link{};
+    link.index = 6;
+    link.up = false;
+    link.mtu = 9000U;
+    link.name = InterfaceName::from_string("uplink0");
+
+    TransactionBuilder transaction{};
+    transaction.set_link(link);
+    const auto& header = *messages_of(transaction.messages()).front();
+    EXPECT_EQ(header.nlmsg_flags, NLM_F_REQUEST | NLM_F_ACK);
+
+    const auto* info = reinterpret_cast<const ifinfomsg*>(NLMSG_DATA(&header));
+    EXPECT_EQ(info->ifi_flags, 0U);
+    EXPECT_EQ(info->ifi_change, static_cast<unsigned>(IFF_UP));
+
+    const auto event = CompactLinkEvent::from_nlmsghdr(header);
+    EXPECT_EQ(event.index, 6);
+    EXPECT_EQ(event.name.view(), "uplink0");
+
+    const auto* mtu = find_attribute(header, sizeof(ifinfomsg), IFLA_MTU);
+    ASSERT_NE(mtu, nullptr);
+    EXPECT_EQ(*reinterpret_cast<const uint32_t*>(RTA_DATA(mtu)), 9000U);
+
+    // Leaving `up` unset leaves the link state alone.
+    transaction.clear();
+    transaction.set_link(LinkSpec{.index = 6, .mtu = 1500U});
+    const auto* unchanged = reinterpret_cast<const ifinfomsg*>(
+            NLMSG_DATA(messages_of(transaction.messages()).front()));
+    EXPECT_EQ(unchanged->ifi_change, 0U);
+}
+
+TEST(TransactionTest, PreparesPostedBatches) {
+    TransactionBuilder transaction{};
+    NeighborSpec neighbor{};
+    neighbor.index = 3;
+    for (uint32_t i = 0; i < Transport::MAX_UNACKED; ++i) {
+        neighbor.address = IpAddress::from_string("192.0.2.9", AF_INET);
+        neighbor.address.bytes[3] = static_cast<uint8_t>(i);
+        transaction.probe_neighbor(neighbor.index, neighbor.address);
+    }
+
+    // 128 operations do not fit one datagram next to its barrier.
+    EXPECT_EQ(TransactionTask::sequences(transaction), Transport::MAX_UNACKED + 2U);
+
+    auto posted = transaction.messages();
+    posted.clear_flags(NLM_F_ACK);
+
+    MessageBuilder batch{};
+    batch.append(posted.data());
+    batch.begin(NLMSG_NOOP, NLM_F_REQUEST | NLM_F_ACK, 500U);
+    batch.end();
+    EXPECT_EQ(batch.count(), Transport::MAX_UNACKED + 1U);
+
+    const auto messages = messages_of(batch);
+    ASSERT_EQ(messages.size(), Transport::MAX_UNACKED + 1U);
+    EXPECT_EQ(messages.front()->nlmsg_flags,
+            NLM_F_REQUEST | NLM_F_CREATE | NLM_F_REPLACE);
+    EXPECT_EQ(messages.back()->nlmsg_type, NLMSG_NOOP);
+    EXPECT_EQ(messages.back()->nlmsg_len, NLMSG_HDRLEN);
+    EXPECT_EQ(messages.back()->nlmsg_seq, 500U);
+}
@@ -0,0 +1,320 @@
+#include <gtest/gtest.h>
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/io_context.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <optional>
+#include <system_error>
+#include <vector>
+
+#include <linux/fib_rules.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <sys/socket.h>
+
+#include "rtaco/core/nl_transport.hxx"
+#include "rtaco/tasks/nl_message_builder.hxx"
+
+using namespace llmx::rtaco;
+
+namespace {
+
+using result_t = std::optional<std::expected<void, std::error_code>>;
+
+auto link_dump(uint32_t sequence) -> MessageBuilder {
+    MessageBuilder request{};
+    request.begin<ifinfomsg>(RTM_GETLINK, NLM_F_REQUEST | NLM_F_DUMP, sequence);
+    request.end();
+    return request;
+}
+
+auto link_get(uint32_t sequence, int index) -> MessageBuilder {
+    MessageBuilder request{};
+    request.begin<ifinfomsg>(RTM_GETLINK, NLM_F_REQUEST, sequence).ifi_index = index;
+    request.end();
+    return request;
+}
+
+/** A message the kernel never answers, leaving its transaction waiting. */
+auto unanswered(uint32_t sequence, uint16_t flags = 0U) -> MessageBuilder {
+    MessageBuilder request{};
+    request.begin(NLMSG_NOOP, NLM_F_REQUEST | flags, sequence);
+    request.end();
+    return request;
+}
+
+auto finishes_dump(const nlmsghdr& header) -> bool {
+    return header.nlmsg_type == NLMSG_DONE || header.nlmsg_type == NLMSG_ERROR;
+}
+
+void transact(boost::asio::io_context& io, Transport& transport,
+        const MessageBuilder& request, Transport::message_handler_t handler,
+        result_t& result) {
+    boost::asio::co_spawn(io, [&transport, &request, &result,
+            handler = std::move(handler)]() mutable -> boost::asio::awaitable<void>
+    {
+        result = co_await transport.async_transact(request.data(), std::move(handler));
+    }, boost::asio::detached);
+}
+
+} // namespace
+
+TEST(TransportTest, RoutesRepliesBySequence) {
+    boost::asio::io_context io;
+    Transport transport(io, io.get_executor(), "test-transport");
+
+    const auto dump = link_dump(1U);
+    const auto first = link_get(2U, 1);
+    const auto second = link_get(3U, 1);
+
+    size_t dumped = 0U;
+    size_t answered = 0U;
+    result_t dump_result;
+    result_t first_result;
+    result_t second_result;
+
+    transact(io, transport, dump, [&](const nlmsghdr& header)
+    {
+        EXPECT_EQ(header.nlmsg_seq, 1U);
+        dumped += header.nlmsg_type == RTM_NEWLINK ? 1U : 0U;
+        return finishes_dump(header);
+    }, dump_result);
+    const auto answer = [&answered](uint32_t sequence)
+    {
+        return [&answered, sequence](const nlmsghdr& header)
+        {
+            EXPECT_EQ(header.nlmsg_seq, sequence);
+            EXPECT_EQ(header.nlmsg_type, RTM_NEWLINK);
+            ++answered;
+            return true;
+        };
+    };
+    transact(io, transport, first, answer(2U), first_result);
+    transact(io, transport, second, answer(3U), second_result);
+
+    io.run();
+
+    ASSERT_TRUE(dump_result && first_result && second_result);
+    EXPECT_TRUE(dump_result->has_value());
+    EXPECT_TRUE(first_result->has_value());
+    EXPECT_TRUE(second_result->has_value());
+    EXPECT_GT(dumped, 0U); // at least the loopback device
+    EXPECT_EQ(answered, 2U);
+    EXPECT_EQ(transport.pending(), 0U);
+}
+
+TEST(TransportTest, AdmitsOneDumpAtATime) {
+    boost::asio::io_context io;
+    Transport transport(io, io.get_executor(), "test-transport");
+
+    // Without the gate the kernel refuses the second dump with EBUSY.
+    std::vector<MessageBuilder> dumps{};
+    for (uint32_t sequence = 1U; sequence <= 3U; ++sequence) {
+        dumps.push_back(link_dump(sequence));
+    }
+
+    std::vector<uint32_t> order{};
+    std::vector<result_t> results(dumps.size());
+    for (size_t i = 0; i < dumps.size(); ++i) {
+        transact(io, transport, dumps[i], [&](const nlmsghdr& header)
+        {
+            order.push_back(header.nlmsg_seq);
+            return finishes_dump(header);
+        }, results[i]);
+    }
+
+    io.run();
+
+    for (const auto& result : results) {
+        ASSERT_TRUE(result.has_value());
+        EXPECT_TRUE(result->has_value());
+    }
+
+    // The replies of each dump form one run.
+    order.erase(std::unique(order.begin(), order.end()), order.end());
+    EXPECT_EQ(order.size(), dumps.size());
+}
+
+TEST(TransportTest, WindowBoundsTransactionsInFlight) {
+    boost::asio::io_context io;
+    Transport transport(io, io.get_executor(), "test-transport", 2U);
+
+    std::vector<MessageBuilder> requests{};
+    for (uint32_t sequence = 1U; sequence <= 6U; ++sequence) {
+        requests.push_back(link_get(sequence, 1));
+    }
+
+    size_t most_pending = 0U;
+    std::vector<result_t> results(requests.size());
+    for (size_t i = 0; i < requests.size(); ++i) {
+        transact(io, transport, requests[i], [&](const nlmsghdr&)
+        {
+            most_pending = std::max(most_pending, transport.pending());
+            return true;
+        }, results[i]);
+    }
+
+    io.run();
+
+    for (const auto& result : results) {
+        ASSERT_TRUE(result.has_value());
+        EXPECT_TRUE(result->has_value());
+    }
+    EXPECT_GE(most_pending, 1U);
+    EXPECT_LE(most_pending, 2U);
+}
+
+TEST(TransportTest, ReplacesSocketAfterUnfinishedDump) {
+    boost::asio::io_context io;
+    // Too small for a link dump datagram, large enough for the rule dump.
+    Transport transport(io, io.get_executor(), "test-transport",
+            Transport::DEFAULT_MAX_IN_FLIGHT,
+            ReceiveBufferOptions{.initial_size = 1024U, .max_size = 1024U});
+
+    const auto links = link_dump(1U);
+    result_t links_result;
+    transact(io, transport, links, finishes_dump, links_result);
+    io.run();
+
+    ASSERT_TRUE(links_result.has_value());
+    ASSERT_FALSE(links_result->has_value());
+    EXPECT_EQ(links_result->error(), std::errc::message_size);
+
+    // The kernel still considers the link dump running on the old socket.
+    MessageBuilder rules{};
+    rules.begin<fib_rule_hdr>(RTM_GETRULE, NLM_F_REQUEST | NLM_F_DUMP, 2U).family =
+            AF_INET;
+    rules.end();
+
+    size_t rule_count = 0U;
+    result_t rules_result;
+    transact(io, transport, rules, [&](const nlmsghdr& header)
+    {
+        EXPECT_NE(header.nlmsg_type, NLMSG_ERROR);
+        rule_count += header.nlmsg_type == RTM_NEWRULE ? 1U : 0U;
+        return finishes_dump(header);
+    }, rules_result);
+    io.restart();
+    io.run();
+
+    ASSERT_TRUE(rules_result.has_value());
+    EXPECT_TRUE(rules_result->has_value());
+    EXPECT_GT(rule_count, 0U); // local, main and default
+}
+
+TEST(TransportTest, PostsWaitForRoomInTheAckBudget) {
+    boost::asio::io_context io;
+    Transport transport(io, io.get_executor(), "test-transport");
+
+    // Ack-less gets of a missing link fail; the last message is the barrier.
+    constexpr auto barrier = static_cast<uint32_t>(Transport::MAX_UNACKED);
+    MessageBuilder full{};
+    for (uint32_t sequence = 1U; sequence < barrier; ++sequence) {
+        full.begin<ifinfomsg>(RTM_GETLINK, NLM_F_REQUEST, sequence).ifi_index =
+                0x7fffffff;
+        full.end();
+    }
+    full.begin(NLMSG_NOOP, NLM_F_REQUEST | NLM_F_ACK, barrier);
+    full.end();
+
+    MessageBuilder next{};
+    next.begin(NLMSG_NOOP, NLM_F_REQUEST, barrier + 1U);
+    next.end();
+    next.begin(NLMSG_NOOP, NLM_F_REQUEST | NLM_F_ACK, barrier + 2U);
+    next.end();
+
+    size_t errors = 0U;
+    bool settled = false;
+    bool waited_for_room = false;
+    boost::asio::co_spawn(io, [&]() -> boost::asio::awaitable<void>
+    {
+        auto posted = co_await transport.async_post(full.data(),
+                [&](const nlmsghdr& header)
+        {
+            const auto* error = reinterpret_cast<const nlmsgerr*>(NLMSG_DATA(&header));
+            if (header.nlmsg_seq == barrier) {
+                settled = error->error == 0;
+                return true;
+            }
+            errors += error->error != 0 ? 1U : 0U;
+            return false;
+        });
+        EXPECT_TRUE(posted.has_value());
+
+        // A full budget leaves no room for two more messages until the
+        // first barrier is acked.
+        auto again = co_await transport.async_post(next.data(),
+                [last = barrier + 2U](const nlmsghdr& header)
+        {
+            return header.nlmsg_seq == last;
+        });
+        EXPECT_TRUE(again.has_value());
+        waited_for_room = settled;
+    }, boost::asio::detached);
+
+    io.run();
+
+    EXPECT_TRUE(settled);
+    EXPECT_TRUE(waited_for_room);
+    EXPECT_EQ(errors, Transport::MAX_UNACKED - 1U);
+    EXPECT_EQ(transport.pending(), 0U);
+
+    // Over the budget or a dump: rejected outright.
+    MessageBuilder oversized{};
+    for (uint32_t sequence = 1U; sequence <= barrier + 1U; ++sequence) {
+        oversized.begin(NLMSG_NOOP, NLM_F_REQUEST, sequence);
+        oversized.end();
+    }
+    const auto dump = link_dump(1U);
+    std::vector<std::error_code> rejected{};
+    boost::asio::co_spawn(io, [&]() -> boost::asio::awaitable<void>
+    {
+        for (const auto request : {oversized.data(), dump.data()}) {
+            auto posted = co_await transport.async_post(request,
+                    [](const nlmsghdr&) { return true; });
+            rejected.push_back(posted ? std::error_code{} : posted.error());
+        }
+    }, boost::asio::detached);
+    io.restart();
+    io.run();
+
+    const auto invalid = std::make_error_code(std::errc::invalid_argument);
+    EXPECT_EQ(rejected, (std::vector<std::error_code>{invalid, invalid}));
+}
+
+TEST(TransportTest, DestructionCancelsWaitingTransactions) {
+    boost::asio::io_context io;
+    auto transport = std::make_unique<Transport>(io, io.get_executor(),
+            "test-transport", 2U);
+
+    // The first holds the dump gate and a window slot, the second waits for
+    // the gate, the third takes the other slot and the fourth waits for it.
+    const auto held_dump = unanswered(1U, NLM_F_DUMP);
+    const auto dump = link_dump(2U);
+    const auto held = unanswered(3U);
+    const auto waiting = unanswered(4U);
+
+    std::vector<result_t> results(4U);
+    size_t i = 0U;
+    for (const auto* request : {&held_dump, &dump, &held, &waiting}) {
+        transact(io, *transport, *request, finishes_dump, results[i++]);
+    }
+
+    io.poll();
+    EXPECT_EQ(transport->pending(), 2U);
+    EXPECT_TRUE(std::none_of(results.begin(), results.end(),
+            [](const result_t& result) { return result.has_value(); }));
+
+    transport.reset();
+    io.run();
+
+    for (const auto& result : results) {
+        ASSERT_TRUE(result.has_value());
+        ASSERT_FALSE(result->has_value());
+        EXPECT_EQ(result->error(), std::errc::operation_canceled);
+    }
+}
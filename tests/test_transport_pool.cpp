@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/io_context.hpp>
+
+#include <optional>
+#include <vector>
+
+#include "rtaco/core/nl_transport_pool.hxx"
+
+using namespace llmx::rtaco;
+
+TEST(TransportPoolTest, CapsAndReusesTransports) {
+    boost::asio::io_context io;
+    TransportPool pool(io, io.get_executor(), "test-pool", {.max_sockets = 2U});
+
+    std::vector<TransportPool::Lease> leases;
+    std::optional<TransportPool::Lease> waiting;
+    for (int i = 0; i < 3; ++i) {
+        boost::asio::co_spawn(io, [&, i]() -> boost::asio::awaitable<void>
+        {
+            auto lease = co_await pool.async_acquire();
+            EXPECT_TRUE(lease.has_value());
+            if (!lease) {
+                co_return;
+            }
+            if (i < 2) {
+                leases.push_back(std::move(*lease));
+            } else {
+                waiting = std::move(*lease);
+            }
+        }, boost::asio::detached);
+    }
+
+    io.poll();
+    ASSERT_EQ(leases.size(), 2U);
+    EXPECT_NE(&leases[0].transport(), &leases[1].transport());
+    EXPECT_FALSE(waiting.has_value());
+    EXPECT_EQ(pool.size(), 2U);
+
+    // The third caller gets the transport the first one gives back.
+    auto* returned = &leases[0].transport();
+    leases[0].reset();
+    io.poll();
+    ASSERT_TRUE(waiting.has_value());
+    EXPECT_EQ(&waiting->transport(), returned);
+    EXPECT_EQ(pool.size(), 2U);
+    EXPECT_EQ(pool.idle(), 0U);
+
+    waiting.reset();
+    leases.clear();
+    EXPECT_EQ(pool.idle(), 2U);
+}
+
+TEST(TransportPoolTest, StopFailsWaiters) {
+    boost::asio::io_context io;
+    TransportPool pool(io, io.get_executor(), "test-pool", {.max_sockets = 1U});
+
+    std::optional<TransportPool::Lease> held;
+    bool cancelled = false;
+    boost::asio::co_spawn(io, [&]() -> boost::asio::awaitable<void>
+    {
+        auto first = co_await pool.async_acquire();
+        if (!first) {
+            co_return;
+        }
+        held = std::move(*first);
+
+        auto second = co_await pool.async_acquire();
+        cancelled = !second && second.error() == std::errc::operation_canceled;
+    }, boost::asio::detached);
+
+    io.poll();
+    EXPECT_TRUE(held.has_value());
+    pool.stop();
+    io.run();
+
+    EXPECT_TRUE(cancelled);
+}